@@ -0,0 +1,2 @@
+#include <boost/system/error_code.hpp>
+int main() { boost::system::error_code c; }
\ No newline at end of file
@@ -0,0 +1,8 @@
+#! /usr/bin/env python
+
+# Programs that are runnable.
+ns3_runnable_programs = ['build/src/ndnSIM/tools/ns3-dev-rocketfuel-maps-cch-to-annotaded-debug', 'build/src/ndnSIM/tools/ns3-dev-ndn-trace-to-tsv-debug', 'build/src/ndnSIM/tools/ns3-dev-ndn-trace-merge-debug', 'build/scratch/SDN/ns3-dev-SDN-debug']
+
+# Scripts that are runnable.
+ns3_runnable_scripts = []
+
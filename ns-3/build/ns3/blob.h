@@ -0,0 +1,254 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2013, Regents of the University of California
+ *                     Alexander Afanasyev
+ *                     Zhenkai Zhu
+ *
+ * BSD license, See the LICENSE file for more information
+ *
+ * Author: Zhenkai Zhu <zhenkai@cs.ucla.edu>
+ *         Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef NDN_BLOB_H
+#define NDN_BLOB_H
+
+#include "ns3/ndn-common.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <string>
+
+NDN_NAMESPACE_BEGIN
+
+/**
+ * @ingroup ndn-cxx
+ * @brief Class representing a general-use binary blob
+ *
+ * Blobs of up to InlineSize bytes (most of name components, including sequence numbers)
+ * are stored inline, without any heap allocation.  Larger blobs are stored in a heap buffer.
+ * Size of the object is the same as of std::vector<char>.
+ */
+class Blob
+{
+public:
+  typedef char                                  value_type;
+  typedef char*                                 pointer;
+  typedef const char*                           const_pointer;
+  typedef char&                                 reference;
+  typedef const char&                           const_reference;
+  typedef char*                                 iterator;
+  typedef const char*                           const_iterator;
+  typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+  typedef std::reverse_iterator<iterator>       reverse_iterator;
+  typedef size_t                                size_type;
+  typedef ptrdiff_t                             difference_type;
+
+  /// @brief Maximum size of the blob that is stored without heap allocation
+  static const size_type InlineSize = 16;
+
+public:
+  /**
+   * @brief Creates an empty blob
+   */
+  Blob ()
+    : m_size (0)
+    , m_capacity (InlineSize)
+  {
+  }
+
+  Blob (const std::string &data)
+    : m_size (0)
+    , m_capacity (InlineSize)
+  {
+    assign (data.c_str (), data.size ());
+  }
+
+  Blob (const void *buf, size_t length)
+    : m_size (0)
+    , m_capacity (InlineSize)
+  {
+    assign (reinterpret_cast<const char*> (buf), length);
+  }
+
+  Blob (const Blob &other)
+    : m_size (0)
+    , m_capacity (InlineSize)
+  {
+    assign (other.buf (), other.size ());
+  }
+
+  ~Blob ()
+  {
+    if (!isInline ())
+      delete [] m_heap;
+  }
+
+  /**
+   * @brief Get pointer to the first byte of the binary blob
+   */
+  inline char*
+  buf ()
+  {
+    return isInline () ? m_inline : m_heap;
+  }
+
+  /**
+   * @brief Get const pointer to the first byte of the binary blob
+   */
+  inline const char*
+  buf () const
+  {
+    return isInline () ? m_inline : m_heap;
+  }
+
+  iterator begin () { return buf (); }
+  const_iterator begin () const { return buf (); }
+  iterator end () { return buf () + m_size; }
+  const_iterator end () const { return buf () + m_size; }
+  size_t size () const { return m_size; }
+
+  void swap (Blob &x)
+  {
+    Blob tmp;
+    tmp.steal (x);
+    x.steal (*this);
+    steal (tmp);
+  }
+
+  void push_back (value_type val)
+  {
+    if (m_size == m_capacity)
+      reserve (m_capacity * 2);
+    buf () [m_size++] = val;
+  }
+
+  bool empty () const { return m_size == 0; }
+
+  Blob &
+  operator = (const Blob &other)
+  {
+    if (this != &other)
+      {
+        m_size = 0;
+        assign (other.buf (), other.size ());
+      }
+    return *this;
+  }
+
+  reference operator [] (size_type pos) { return buf () [pos]; }
+  const_reference operator [] (size_type pos) const { return buf () [pos]; }
+
+  char getItem (size_type pos) const { return buf () [pos]; }
+
+  void clear () { m_size = 0; }
+
+  /**
+   * @brief Change size of the blob (new bytes are not initialized)
+   *
+   * Can be used to read data directly into the blob storage, e.g., blob.resize (n); read (blob.buf (), n)
+   */
+  void
+  resize (size_type size)
+  {
+    reserve (size);
+    m_size = size;
+  }
+
+  /**
+   * @brief Make sure that blob can hold at least capacity bytes without reallocation
+   */
+  void
+  reserve (size_type capacity)
+  {
+    if (capacity <= m_capacity)
+      return;
+
+    char *heap = new char [capacity];
+    std::memcpy (heap, buf (), m_size);
+    if (!isInline ())
+      delete [] m_heap;
+
+    m_heap = heap;
+    m_capacity = capacity;
+  }
+
+private:
+  inline bool
+  isInline () const
+  {
+    return m_capacity <= InlineSize;
+  }
+
+  void
+  assign (const char *data, size_type length)
+  {
+    reserve (length);
+    if (length > 0)
+      std::memcpy (buf (), data, length);
+    m_size = length;
+  }
+
+  /**
+   * @brief Move content of the other blob into this (empty inline) blob and leave the other one empty
+   */
+  void
+  steal (Blob &other)
+  {
+    if (other.isInline ())
+      {
+        std::memcpy (m_inline, other.m_inline, other.m_size);
+      }
+    else
+      {
+        m_heap = other.m_heap;
+        m_capacity = other.m_capacity;
+
+        other.m_capacity = InlineSize;
+      }
+    m_size = other.m_size;
+    other.m_size = 0;
+  }
+
+private:
+  friend bool operator == (const Blob &a, const Blob &b);
+  friend bool operator <  (const Blob &a, const Blob &b);
+
+private:
+  union
+  {
+    char m_inline [InlineSize];
+    char *m_heap;
+  };
+  uint32_t m_size;
+  uint32_t m_capacity;
+};
+
+inline bool operator == (const Blob &a, const Blob &b)
+{
+  return a.m_size == b.m_size && std::memcmp (a.buf (), b.buf (), a.m_size) == 0;
+}
+
+inline bool operator <  (const Blob &a, const Blob &b)
+{
+  return std::lexicographical_compare (a.begin (), a.end (), b.begin (), b.end ());
+}
+
+inline bool operator <= (const Blob &a, const Blob &b)  { return !(b < a); }
+inline bool operator >  (const Blob &a, const Blob &b)  { return b < a; }
+inline bool operator >= (const Blob &a, const Blob &b)  { return !(a < b); }
+
+NDN_NAMESPACE_END
+
+#include <boost/functional/hash.hpp>
+namespace boost
+{
+inline std::size_t
+hash_value (const ns3::ndn::Blob &v)
+{
+  return boost::hash_range (v.begin(), v.end());
+}
+}
+
+#endif // NDN_BLOB_H
@@ -0,0 +1,2 @@
+// forwarding header (stale build artifact replaced)
+#include "ns3/ndnSIM/apps/callback-based-app.h"
@@ -0,0 +1,131 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NDN_PARTITION_HELPER_H
+#define NDN_PARTITION_HELPER_H
+
+#include "ns3/ptr.h"
+#include "ns3/node.h"
+#include "ns3/node-container.h"
+
+#include <string>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Helper to split topology between processes of the distributed (MPI) simulation
+ *
+ * In the distributed simulation every process (rank) creates the whole topology, but only nodes
+ * whose SystemId is equal to the rank are simulated by the process.  Links between nodes of
+ * different ranks become remote channels, so the number of such links and the balance of
+ * nodes between ranks define how well the simulation scales.
+ *
+ * Partition assigns SystemId of nodes so that every rank has about the same number of nodes and
+ * the number of links between ranks is small, using multilevel graph partitioning similar to
+ * METIS: the graph is coarsened by collapsing heavy-edge matchings, the coarsest graph is split by
+ * greedy region growing, and the split is refined on every level while the graph is projected
+ * back.  The result depends only on the topology, so all ranks compute the same partitioning.
+ *
+ * Partitioning must be done before links are installed, e.g., using
+ * AnnotatedTopologyReader::SetPartitions.
+ *
+ * Static methods of the helper are used by other ndnSIM helpers and tracers to restrict
+ * themselves to nodes of the current rank.  If MPI is not enabled, all nodes are local.
+ */
+class PartitionHelper
+{
+public:
+  PartitionHelper ();
+
+  /**
+   * @brief Set maximum allowed ratio between the number of nodes in a partition and the
+   *        average number of nodes per partition (1.05 by default)
+   */
+  void
+  SetImbalance (double imbalance);
+
+  /**
+   * @brief Add link between two nodes to the partitioned graph
+   * @param node1 one node
+   * @param node2 another node
+   * @param weight relative cost of cutting the link (e.g., expected traffic)
+   */
+  void
+  AddLink (Ptr<Node> node1, Ptr<Node> node2, uint32_t weight = 1);
+
+  /**
+   * @brief Calculate partitioning of the nodes
+   * @param nodes nodes to partition (links to other nodes are ignored)
+   * @param partitions number of partitions
+   * @returns partition of each node in the container
+   */
+  std::vector<uint32_t>
+  Calculate (const NodeContainer &nodes, uint32_t partitions) const;
+
+  /**
+   * @brief Calculate partitioning of the nodes and set their SystemId attribute
+   * @returns total weight of links between different partitions
+   */
+  uint32_t
+  Partition (const NodeContainer &nodes, uint32_t partitions) const;
+
+  /**
+   * @brief Check if node is simulated by the current process
+   */
+  static bool
+  IsLocal (Ptr<const Node> node);
+
+  /**
+   * @brief Get rank of the current process (0 if MPI is not enabled)
+   */
+  static uint32_t
+  GetSystemId ();
+
+  /**
+   * @brief Get number of processes (1 if MPI is not enabled)
+   */
+  static uint32_t
+  GetSize ();
+
+  /**
+   * @brief Get name of the trace file to be written by the current process
+   *
+   * If the simulation is distributed between several processes, "-rank<N>" is inserted before
+   * the extension of the file name (e.g., rate-trace-rank1.txt), otherwise the name is unchanged
+   */
+  static std::string
+  GetRankFileName (const std::string &file);
+
+  /**
+   * @brief Get name of the trace file written by the specified rank (e.g., rate-trace-rank1.txt)
+   */
+  static std::string
+  GetRankFileName (const std::string &file, uint32_t systemId);
+
+private:
+  double m_imbalance;
+  std::vector< std::pair< std::pair< Ptr<Node>, Ptr<Node> >, uint32_t > > m_links;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_PARTITION_HELPER_H
@@ -0,0 +1,56 @@
+
+#ifdef NS3_MODULE_COMPILATION
+# error "Do not include ns3 module aggregator headers from other modules; these are meant only for end user scripts."
+#endif
+
+#ifndef NS3_MODULE_NDNSIM
+    
+
+// Module headers:
+#include "annotated-topology-reader.h"
+#include "binary-trace-writer.h"
+#include "blob.h"
+#include "callback-based-app.h"
+#include "exclude.h"
+#include "l2-rate-tracer.h"
+#include "l2-tracer.h"
+#include "name-component.h"
+#include "name.h"
+#include "ndn-api-face.h"
+#include "ndn-app-delay-tracer.h"
+#include "ndn-app-face.h"
+#include "ndn-app-helper.h"
+#include "ndn-app.h"
+#include "ndn-common.h"
+#include "ndn-content-store.h"
+#include "ndn-cs-tracer.h"
+#include "ndn-data.h"
+#include "ndn-face-container.h"
+#include "ndn-face.h"
+#include "ndn-fib-entry.h"
+#include "ndn-fib.h"
+#include "ndn-forwarding-strategy.h"
+#include "ndn-fw-tag.h"
+#include "ndn-global-routing-helper.h"
+#include "ndn-header-helper.h"
+#include "ndn-interest.h"
+#include "ndn-ip-faces-helper.h"
+#include "ndn-l3-aggregate-tracer.h"
+#include "ndn-l3-protocol.h"
+#include "ndn-l3-rate-tracer.h"
+#include "ndn-l3-tracer.h"
+#include "ndn-limits.h"
+#include "ndn-link-control-helper.h"
+#include "ndn-name-components.h"
+#include "ndn-name.h"
+#include "ndn-net-device-face.h"
+#include "ndn-partition-helper.h"
+#include "ndn-pit-entry-incoming-face.h"
+#include "ndn-pit-entry-outgoing-face.h"
+#include "ndn-pit-entry.h"
+#include "ndn-pit.h"
+#include "ndn-rtt-estimator.h"
+#include "ndn-stack-helper.h"
+#include "ndn-wire.h"
+#include "rocketfuel-weights-reader.h"
+#endif
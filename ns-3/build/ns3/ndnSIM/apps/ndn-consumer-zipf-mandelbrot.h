@@ -0,0 +1,149 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 Tsinghua University, P.R.China
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Xiaoke Jiang <shock.jiang@gmail.com>
+ */
+
+
+#ifndef NDN_CONSUMER_ZIPF_MANDELBROT_H_
+#define NDN_CONSUMER_ZIPF_MANDELBROT_H_
+
+#include "ndn-consumer.h"
+#include "ns3/ptr.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/packet.h"
+#include "ns3/callback.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+#include "ns3/double.h"
+#include "ndn-consumer-cbr.h"
+#include "ns3/random-variable.h"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief NDN app requesting contents following Zipf-Mandelbrot Distbituion
+ *
+ * The class implements an app which requests contents following Zipf-Mandelbrot Distribution
+ * Here is the explaination of Zipf-Mandelbrot Distribution: http://en.wikipedia.org/wiki/Zipf%E2%80%93Mandelbrot_law
+ *
+ * Content index can be sampled in one of the following ways (Sampling attribute):
+ * - cdf (default): binary search over the cumulative distribution, O(log N) per Interest, 8 bytes per content
+ * - alias: Walker's alias table, O(1) per Interest, 12 bytes per content
+ * - rejection: rejection-inversion sampling (Hormann and Derflinger), O(1) expected time per
+ *   Interest and no per-content memory, suitable for very large catalogues
+ *
+ * Tables are (re)built on the first request after any of the parameters changes.
+ */
+class ConsumerZipfMandelbrot: public ConsumerCbr
+{
+public:
+  static TypeId GetTypeId ();
+
+  /**
+   * \brief Default constructor
+   * Sets up randomized Number Generator (RNG)
+   * Note: m_seq of its parent class ConsumerCbr here is used to record the interest number
+   */
+  ConsumerZipfMandelbrot ();
+  virtual ~ConsumerZipfMandelbrot ();
+
+  virtual void SendPacket();
+  uint32_t GetNextSeq();
+
+protected:
+  virtual void
+  ScheduleNextPacket ();
+
+private:
+  void
+  SetNumberOfContents (uint32_t numOfContents);
+
+  uint32_t
+  GetNumberOfContents () const;
+
+  void
+  SetQ (double q);
+
+  double
+  GetQ () const;
+
+  void
+  SetS (double s);
+
+  double
+  GetS () const;
+
+  void
+  SetSampling (const std::string &sampling);
+
+  std::string
+  GetSampling () const;
+
+  /**
+   * @brief Build tables for the selected sampling method
+   */
+  void
+  PrepareSampler ();
+
+  uint32_t
+  GetNextSeqAlias ();
+
+  uint32_t
+  GetNextSeqRejection ();
+
+  // helpers for rejection-inversion sampling
+  double
+  H (double x) const;
+
+  double
+  HIntegral (double x) const;
+
+  double
+  HIntegralInverse (double x) const;
+
+private:
+  enum Sampling
+    {
+      SAMPLING_CDF,
+      SAMPLING_ALIAS,
+      SAMPLING_REJECTION
+    };
+
+  uint32_t m_N;  //number of the contents
+  double m_q;  //q in (k+q)^s
+  double m_s;  //s in (k+q)^s
+  Sampling m_sampling;
+  bool m_samplerReady; // false if tables need to be rebuilt
+  std::vector<double> m_Pcum;  //cumulative probability
+
+  std::vector<double> m_aliasProb;    // alias table: probability to stay in the column
+  std::vector<uint32_t> m_alias;      // alias table: alternative index for the column
+
+  double m_hIntegralX1;   // rejection-inversion: HIntegral (1.5) - H (1)
+  double m_hIntegralN;    // rejection-inversion: HIntegral (N + 0.5)
+  double m_squeeze;       // rejection-inversion: threshold for the quick acceptance
+
+  UniformVariable m_SeqRng; //RNG
+};
+
+} /* namespace ndn */
+} /* namespace ns3 */
+#endif /* NDN_CONSUMER_ZIPF_MANDELBROT_H_ */
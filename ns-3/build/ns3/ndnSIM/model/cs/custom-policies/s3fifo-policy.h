@@ -0,0 +1,275 @@
+/* -*- Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef S3FIFO_POLICY_H_
+#define S3FIFO_POLICY_H_
+
+#include <boost/intrusive/options.hpp>
+#include <boost/intrusive/list.hpp>
+
+#include "../../../utils/ghost-queue.h"
+
+#include <algorithm>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+/**
+ * @brief Traits for S3-FIFO replacement policy
+ *
+ * New items are placed into the small FIFO queue (10% of the cache).  When evicted from the
+ * small queue, items that were requested while in the queue are moved to the main FIFO queue,
+ * the rest are dropped and their hashes are remembered in the ghost queue.  Items that are in
+ * the ghost queue go directly to the main queue on the next insertion.  The main queue is
+ * managed by CLOCK-like algorithm with 2-bit access counters.  One-time items (e.g., scans)
+ * therefore stay only in the small queue.
+ *
+ * Cache hits do not move items within the queues.  Both queues are kept in one list (small
+ * queue followed by the main queue), so the policy container can be iterated as usual.
+ *
+ * The policy is intended for content stores: payload should provide GetName () method.
+ */
+struct s3fifo_policy_traits
+{
+  /// @brief Name that can be used to identify the policy (for NS-3 object model and logging)
+  static std::string GetName () { return "S3Fifo"; }
+
+  struct policy_hook_type : public boost::intrusive::list_member_hook<> { uint8_t main : 1; uint8_t frequency : 2; };
+
+  template<class Container>
+  struct container_hook
+  {
+    typedef boost::intrusive::member_hook< Container,
+                                           policy_hook_type,
+                                           &Container::policy_hook_ > type;
+  };
+
+  template<class Base,
+           class Container,
+           class Hook>
+  struct policy
+  {
+    static policy_hook_type& get_state (typename Container::iterator item)
+    {
+      return *static_cast<policy_hook_type*>
+        (policy_container::value_traits::to_node_ptr(*item));
+    }
+
+    typedef typename boost::intrusive::list< Container, Hook > policy_container;
+
+    // could be just typedef
+    class type : public policy_container
+    {
+    public:
+      typedef policy policy_base; // to get access to get_state methods from outside
+      typedef Container parent_trie;
+
+      type (Base &base)
+        : base_ (base)
+        , max_size_ (100)
+        , small_size_ (0)
+        , main_head_ (0)
+      {
+        set_max_size (max_size_);
+      }
+
+      inline void
+      update (typename parent_trie::iterator item)
+      {
+        lookup (item);
+      }
+
+      inline bool
+      insert (typename parent_trie::iterator item)
+      {
+        get_state (item).frequency = 0;
+
+        if (max_size_ != 0)
+          {
+            while (policy_container::size () >= max_size_)
+              evict ();
+          }
+
+        if (ghost_.erase (get_hash (item)))
+          push_main (item);
+        else
+          {
+            get_state (item).main = 0;
+            if (main_head_ != 0)
+              policy_container::insert (policy_container::s_iterator_to (*main_head_), *item);
+            else
+              policy_container::push_back (*item);
+            small_size_++;
+          }
+
+        return true;
+      }
+
+      inline void
+      lookup (typename parent_trie::iterator item)
+      {
+        policy_hook_type &state = get_state (item);
+        if (state.frequency < 3)
+          state.frequency++;
+      }
+
+      inline void
+      erase (typename parent_trie::iterator item)
+      {
+        typename policy_container::iterator position = policy_container::s_iterator_to (*item);
+        if (get_state (item).main)
+          {
+            if (main_head_ == &(*item))
+              {
+                typename policy_container::iterator next = position;
+                next++;
+                main_head_ = (next != policy_container::end ()) ? &(*next) : 0;
+              }
+          }
+        else
+          small_size_--;
+
+        policy_container::erase (position);
+      }
+
+      inline void
+      clear ()
+      {
+        policy_container::clear ();
+        small_size_ = 0;
+        main_head_ = 0;
+        ghost_.clear ();
+      }
+
+      inline void
+      set_max_size (size_t max_size)
+      {
+        max_size_ = max_size;
+        small_capacity_ = std::max<size_t> (max_size_ / 10, 1);
+        ghost_.set_capacity (max_size_ > small_capacity_ ? max_size_ - small_capacity_ : max_size_);
+      }
+
+      inline size_t
+      get_max_size () const
+      {
+        return max_size_;
+      }
+
+    private:
+      type () : base_(*((Base*)0)) { };
+
+      static size_t
+      get_hash (typename parent_trie::iterator item)
+      {
+        return item->payload ()->GetName ().getHash ();
+      }
+
+      void
+      push_main (typename parent_trie::iterator item)
+      {
+        get_state (item).main = 1;
+        policy_container::push_back (*item);
+        if (main_head_ == 0)
+          main_head_ = &(*item);
+      }
+
+      void
+      evict ()
+      {
+        if (small_size_ >= small_capacity_ || main_head_ == 0)
+          {
+            if (evict_small ())
+              return;
+          }
+        evict_main ();
+      }
+
+      /**
+       * @brief Evict from the small queue, moving requested items to the main queue
+       * @returns false if the small queue became empty before anything was evicted
+       */
+      bool
+      evict_small ()
+      {
+        while (small_size_ > 0)
+          {
+            typename policy_container::iterator position = policy_container::begin ();
+            typename parent_trie::iterator item = &(*position);
+
+            if (get_state (item).frequency > 0)
+              {
+                get_state (item).frequency = 0;
+                get_state (item).main = 1;
+                small_size_--;
+                policy_container::splice (policy_container::end (), *this, position);
+                if (main_head_ == 0)
+                  main_head_ = &(*item);
+              }
+            else
+              {
+                ghost_.push (get_hash (item));
+                base_.erase (item);
+                return true;
+              }
+          }
+        return false;
+      }
+
+      void
+      evict_main ()
+      {
+        while (main_head_ != 0)
+          {
+            typename parent_trie::iterator item = main_head_;
+            policy_hook_type &state = get_state (item);
+            if (state.frequency == 0)
+              {
+                base_.erase (item);
+                return;
+              }
+
+            // give the item another round
+            state.frequency--;
+            typename policy_container::iterator position = policy_container::s_iterator_to (*item);
+            typename policy_container::iterator next = position;
+            next++;
+            if (next != policy_container::end ())
+              {
+                main_head_ = &(*next);
+                policy_container::splice (policy_container::end (), *this, position);
+              }
+          }
+      }
+
+    private:
+      Base &base_;
+      size_t max_size_;
+      size_t small_capacity_;
+
+      size_t small_size_;       ///< @brief number of items in the small queue (the beginning of the list)
+      parent_trie *main_head_;  ///< @brief oldest item of the main queue (0 if the main queue is empty)
+      ghost_queue ghost_;       ///< @brief hashes of items recently evicted from the small queue
+    };
+  };
+};
+
+} // ndnSIM
+} // ndn
+} // ns3
+
+#endif // S3FIFO_POLICY_H_
@@ -0,0 +1,456 @@
+/* -*- Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef _NDN_FIB_ENTRY_H_
+#define	_NDN_FIB_ENTRY_H_
+
+#include "ns3/ptr.h"
+#include "ns3/nstime.h"
+#include "ns3/ndn-face.h"
+#include "ns3/ndn-name.h"
+#include "ns3/ndn-limits.h"
+#include "ns3/traced-value.h"
+
+#include <boost/iterator/indirect_iterator.hpp>
+
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+class Name;
+typedef Name NameComponents;
+
+class Fib;
+
+/**
+ * @ingroup ndn-fib
+ * @brief Namespace for FIB operations
+ */
+namespace fib {
+
+/**
+ * @ingroup ndn-fib
+ * \brief Structure holding various parameters associated with a (FibEntry, Face) tuple
+ */
+class FaceMetric
+{
+public:
+  /**
+   * @brief Color codes for FIB face status
+   */
+  enum Status { NDN_FIB_GREEN = 1,
+                NDN_FIB_YELLOW = 2,
+                NDN_FIB_RED = 3 };
+public:
+  /**
+   * \brief Metric constructor
+   *
+   * \param face Face for which metric
+   * \param cost Initial value for routing cost
+   */
+  FaceMetric (Ptr<Face> face, int32_t cost)
+    : m_face (face)
+    , m_status (NDN_FIB_YELLOW)
+    , m_routingCost (cost)
+    , m_sRtt   ()
+    , m_rttVar ()
+    , m_realDelay ()
+  { }
+
+  /**
+   * \brief Comparison operator used by boost::multi_index::identity<>
+   */
+  bool
+  operator< (const FaceMetric &fm) const { return *m_face < *fm.m_face; } // return identity of the face
+
+  /**
+   * @brief Comparison between FaceMetric and Face
+   */
+  bool
+  operator< (const Ptr<Face> &face) const { return *m_face < *face; }
+
+  /**
+   * @brief Return Face associated with FaceMetric
+   */
+  Ptr<Face>
+  GetFace () const { return m_face; }
+
+  /**
+   * \brief Recalculate smoothed RTT and RTT variation
+   * \param rttSample RTT sample
+   */
+  void
+  UpdateRtt (const Time &rttSample);
+
+  /**
+   * @brief Get current status of FIB entry
+   */
+  Status
+  GetStatus () const
+  {
+    return m_status;
+  }
+
+  /**
+   * @brief Set current status of FIB entry
+   */
+  void
+  SetStatus (Status status)
+  {
+    m_status.Set (status);
+  }
+
+  /**
+   * @brief Get current routing cost
+   */
+  int32_t
+  GetRoutingCost () const
+  {
+    return m_routingCost;
+  }
+
+  /**
+   * @brief Set routing cost
+   */
+  void
+  SetRoutingCost (int32_t routingCost)
+  {
+    m_routingCost = routingCost;
+  }
+
+  /**
+   * @brief Get current estimate for smoothed RTT value
+   */
+  Time
+  GetSRtt () const
+  {
+    return m_sRtt;
+  }
+
+  /**
+   * @brief Get current estimate for the RTT variation
+   */
+  Time
+  GetRttVar () const
+  {
+    return m_rttVar;
+  }
+  
+  /**
+   * @brief Get real propagation delay to the producer, calculated based on NS-3 p2p link delays
+   */
+  Time
+  GetRealDelay () const
+  {
+    return m_realDelay;
+  }
+
+  /**
+   * @brief Set real propagation delay to the producer, calculated based on NS-3 p2p link delays
+   */
+  void
+  SetRealDelay (Time realDelay)
+  {
+    m_realDelay = realDelay;
+  }
+
+  /**
+   * @brief Get direct access to status trace
+   */
+  TracedValue<Status> &
+  GetStatusTrace ()
+  {
+    return m_status;
+  }
+
+private:
+  friend std::ostream& operator<< (std::ostream& os, const FaceMetric &metric);
+  friend class FaceMetricContainer;
+
+private:
+  Ptr<Face> m_face; ///< Face
+
+  TracedValue<Status> m_status; ///< \brief Status of the next hop:
+				///<		- NDN_FIB_GREEN
+				///<		- NDN_FIB_YELLOW
+				///<		- NDN_FIB_RED
+
+  int32_t m_routingCost; ///< \brief routing protocol cost (interpretation of the value depends on the underlying routing protocol)
+
+  Time m_sRtt;         ///< \brief smoothed round-trip time
+  Time m_rttVar;       ///< \brief round-trip time variation
+
+  Time m_realDelay;    ///< \brief real propagation delay to the producer, calculated based on NS-3 p2p link delays
+};
+
+/// @cond include_hidden
+class i_metric {};
+class i_nth {};
+/// @endcond
+
+
+/**
+ * @ingroup ndn-fib
+ * @brief Compact face container of Entry
+ *
+ * Faces are kept in a single vector ordered by (status, m_routingCost), which is used both
+ * for face ranking and for fast lookup of the nth face.  Ties are ordered the same way as
+ * in the boost::multi_index container that was used before (a face, whose metric is
+ * changed, keeps its position if the order is still preserved, otherwise it is moved after
+ * all faces with the same metric).
+ *
+ * FaceMetric records are allocated individually and never move in memory, so references
+ * obtained through iterators (e.g., to connect to the status trace) stay valid until the
+ * face is removed.  Lookup by face is a linear scan for small entries; a sorted
+ * face-to-slot index is maintained only if there are more than LinearLookupLimit faces.
+ * The index is built once, when the entry grows past the limit, and then updated in place
+ * on every insert, erase, and reposition (no re-sorting).
+ *
+ * For compatibility, get<i_metric> () and get<i_nth> () return the container itself.
+ */
+class FaceMetricContainer
+{
+public:
+  /// @cond include_hidden
+  typedef FaceMetricContainer type;
+
+  template<class Tag>
+  struct index
+  {
+    typedef FaceMetricContainer type;
+  };
+  /// @endcond
+
+  typedef boost::indirect_iterator<std::vector<FaceMetric*>::const_iterator, const FaceMetric> iterator;
+  typedef iterator const_iterator;
+  typedef FaceMetric value_type;
+  typedef size_t size_type;
+
+  FaceMetricContainer ();
+  ~FaceMetricContainer ();
+
+  iterator begin () const { return iterator (m_slots.begin ()); }
+  iterator end () const { return iterator (m_slots.end ()); }
+  size_type size () const { return m_slots.size (); }
+  bool empty () const { return m_slots.empty (); }
+
+  /**
+   * @brief Get nth face in (status, m_routingCost) order
+   */
+  const FaceMetric &
+  operator [] (size_type n) const { return *m_slots [n]; }
+
+  template<class Tag>
+  FaceMetricContainer &
+  get () { return *this; }
+
+  template<class Tag>
+  const FaceMetricContainer &
+  get () const { return *this; }
+
+  /**
+   * @brief Find record for the face
+   * @returns iterator to the record or end ()
+   */
+  iterator
+  find (const Ptr<Face> &face) const;
+
+  /**
+   * @brief Insert a copy of the metric, if there is no record for the same face yet
+   */
+  std::pair<iterator, bool>
+  insert (const FaceMetric &metric);
+
+  /**
+   * @brief Insert a new record for the face with the specified routing cost, if there is no record for the face yet
+   */
+  std::pair<iterator, bool>
+  insert (const Ptr<Face> &face, int32_t cost);
+
+  /**
+   * @brief Apply modifier to the record and restore (status, m_routingCost) order
+   *
+   * Unlike boost::multi_index, the operation invalidates iterators
+   *
+   * @returns iterator to the modified record
+   */
+  template<class Modifier>
+  iterator
+  modify (iterator item, Modifier mod)
+  {
+    size_type slot = item.base () - m_slots.begin ();
+    mod (*m_slots [slot]);
+    return begin () + Reposition (slot);
+  }
+
+  /**
+   * @brief Remove record for the face
+   * @returns number of removed records (0 or 1)
+   */
+  size_type
+  erase (const Ptr<Face> &face);
+
+private:
+  FaceMetricContainer (const FaceMetricContainer &); ///< \brief Disabled copy constructor
+  FaceMetricContainer &operator = (const FaceMetricContainer &); ///< \brief Disabled copy operator
+
+  static bool
+  MetricLess (const FaceMetric *a, const FaceMetric *b);
+
+  iterator
+  Place (FaceMetric *item);
+
+  size_type
+  Reposition (size_type slot);
+
+  void
+  UpdateIndex (size_type from, size_type to);
+
+  void
+  RebuildIndex ();
+
+private:
+  enum { LinearLookupLimit = 8 };
+
+  typedef std::pair<const Face*, uint32_t> IndexRecord;
+
+  std::vector<FaceMetric*> m_slots; ///< \brief faces ordered by (status, m_routingCost)
+  std::vector<IndexRecord> m_index; ///< \brief face-to-slot index sorted by face (empty for small containers)
+};
+
+/**
+ * @ingroup ndn-fib
+ * \brief Structure for FIB table entry, holding indexed list of
+ *        available faces and their respective metrics
+ *
+ * Methods adding or removing faces are virtual, in case index rearrangement is necessary in the
+ * derived classes
+ */
+class Entry : public Object
+{
+public:
+  typedef Entry base_type;
+
+public:
+  class NoFaces {}; ///< @brief Exception class for the case when FIB entry is not found
+
+  /**
+   * \brief Constructor
+   * \param prefix smart pointer to the prefix for the FIB entry
+   */
+  Entry (Ptr<Fib> fib, const Ptr<const Name> &prefix)
+  : m_fib (fib)
+  , m_prefix (prefix)
+  , m_needsProbing (false)
+  {
+  }
+
+  /**
+   * \brief Update status of FIB next hop
+   * \param status Status to set on the FIB entry
+   */
+  void UpdateStatus (Ptr<Face> face, FaceMetric::Status status);
+
+  /**
+   * \brief Add or update routing metric of FIB next hop
+   *
+   * Initial status of the next hop is set to YELLOW
+   */
+  virtual void AddOrUpdateRoutingMetric (Ptr<Face> face, int32_t metric);
+
+  /**
+   * \brief Set real delay to the producer
+   */
+  void
+  SetRealDelayToProducer (Ptr<Face> face, Time delay);
+
+  /**
+   * @brief Invalidate face
+   *
+   * Set routing metric on all faces to max and status to RED.  Faces are invalidated in the
+   * order of the face index (i.e., by face pointer), not in the metric order of the container
+   */
+  void
+  Invalidate ();
+
+  /**
+   * @brief Invalidate one face
+   *
+   * Set routing metric of the face to max and status to RED (does nothing if face is not in the entry)
+   */
+  void
+  InvalidateFace (Ptr<Face> face);
+
+  /**
+   * @brief Update RTT averages for the face
+   */
+  void
+  UpdateFaceRtt (Ptr<Face> face, const Time &sample);
+
+  /**
+   * \brief Get prefix for the FIB entry
+   */
+  const Name&
+  GetPrefix () const { return *m_prefix; }
+
+  /**
+   * \brief Find "best route" candidate, skipping `skip' first candidates (modulo # of faces)
+   *
+   * throws Entry::NoFaces if m_faces.size()==0
+   */
+  const FaceMetric &
+  FindBestCandidate (uint32_t skip = 0) const;
+
+  /**
+   * @brief Remove record associated with `face`
+   */
+  virtual void
+  RemoveFace (const Ptr<Face> &face)
+  {
+    m_faces.erase (face);
+  }
+
+  /**
+   * @brief Get pointer to access FIB, to which this entry is added
+   */
+  Ptr<Fib>
+  GetFib ();
+  
+private:
+  friend std::ostream& operator<< (std::ostream& os, const Entry &entry);
+
+public:
+  Ptr<Fib> m_fib; ///< \brief FIB to which entry is added
+
+  Ptr<const Name> m_prefix; ///< \brief Prefix of the FIB entry
+  FaceMetricContainer m_faces; ///< \brief Indexed list of faces
+
+  bool m_needsProbing;      ///< \brief flag indicating that probing should be performed
+};
+
+std::ostream& operator<< (std::ostream& os, const Entry &entry);
+std::ostream& operator<< (std::ostream& os, const FaceMetric &metric);
+
+} // namespace fib
+} // namespace ndn
+} // namespace ns3
+
+#endif // _NDN_FIB_ENTRY_H_
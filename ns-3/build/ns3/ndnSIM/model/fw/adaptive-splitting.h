@@ -0,0 +1,150 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NDNSIM_ADAPTIVE_SPLITTING_H
+#define NDNSIM_ADAPTIVE_SPLITTING_H
+
+#include "green-yellow-red.h"
+#include "ns3/log.h"
+#include "ns3/nstime.h"
+
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+namespace fw {
+
+/**
+ * @ingroup ndn-fw
+ * @brief Strategy that splits Interests between all usable faces of the FIB entry proportionally
+ *        to the inverse of their smoothed RTT
+ *
+ * Smoothed RTT of each face is the per-prefix estimate kept in fib::FaceMetric.  Timed out Interest
+ * is counted as an RTT sample equal to the time it has been waiting for Data, so faces that lose
+ * Interests quickly lose their share.  Faces without measurements get the same share as the best
+ * face.  Faces are selected using smooth weighted round robin, which spreads Interests to the same
+ * face evenly (no random numbers involved).
+ *
+ * Similar to NFD's ASF strategy, once per ProbingInterval a copy of the Interest is additionally
+ * sent to the face whose RTT has not been measured for the longest time (faces without any
+ * measurements first), so that the estimates of alternative paths are kept fresh.
+ *
+ * RED faces are never used.  If the selected face cannot be used (e.g., per-face limit is reached
+ * when used with PerOutFaceLimits), other faces are tried in the FIB order.
+ */
+class AdaptiveSplitting :
+    public GreenYellowRed
+{
+private:
+  typedef GreenYellowRed super;
+
+public:
+  static TypeId
+  GetTypeId ();
+
+  /**
+   * @brief Helper function to retrieve logging name for the forwarding strategy
+   */
+  static std::string
+  GetLogName ();
+
+  /**
+   * @brief Default constructor
+   */
+  AdaptiveSplitting ();
+
+  // from super
+  virtual bool
+  DoPropagateInterest (Ptr<Face> incomingFace,
+                       Ptr<const Interest> interest,
+                       Ptr<pit::Entry> pitEntry);
+
+protected:
+  // from super
+  virtual void
+  WillSatisfyPendingInterest (Ptr<Face> inFace,
+                              Ptr<pit::Entry> pitEntry);
+
+  // from super
+  virtual void
+  WillEraseTimedOutPendingInterest (Ptr<pit::Entry> pitEntry);
+
+public:
+  /**
+   * @brief Per-FIB entry state of the strategy (aggregated to fib::Entry)
+   */
+  class Measurements : public Object
+  {
+  public:
+    static TypeId
+    GetTypeId ();
+
+    /**
+     * @brief State of one face of the FIB entry
+     */
+    struct FaceState
+    {
+      FaceState (Ptr<Face> face)
+        : m_face (face)
+        , m_credit (0)
+        , m_lastMeasured (Seconds (-1))
+      {
+      }
+
+      Ptr<Face> m_face;     ///< @brief the face
+      double m_credit;      ///< @brief current credit of smooth weighted round robin
+      Time m_lastMeasured;  ///< @brief time of the last RTT measurement (negative, if never measured)
+    };
+
+    Measurements ()
+      : m_lastProbe (Seconds (-1))
+    {
+    }
+
+    /**
+     * @brief Get index of the face state in m_faces (state is created if necessary)
+     */
+    int
+    Get (Ptr<Face> face);
+
+    /**
+     * @brief Get index of the face state in m_faces (-1, if there is no state for the face)
+     */
+    int
+    Find (Ptr<Face> face) const;
+
+    std::vector<FaceState> m_faces; ///< @brief state of faces (few entries, linear lookup)
+    Time m_lastProbe;               ///< @brief time of the last probe (negative, if never probed)
+  };
+
+protected:
+  static LogComponent g_log;
+
+private:
+  Ptr<Measurements>
+  GetMeasurements (Ptr<fib::Entry> fibEntry);
+
+private:
+  Time m_probingInterval;
+};
+
+} // namespace fw
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_ADAPTIVE_SPLITTING_H
@@ -0,0 +1,250 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NAME_HASH_INDEX_POLICY_H_
+#define NAME_HASH_INDEX_POLICY_H_
+
+#include "ns3/ndn-name.h"
+
+#include <boost/intrusive/options.hpp>
+#include <boost/intrusive/unordered_set.hpp>
+
+#include <algorithm>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+/**
+ * @brief Traits for the PIT index that keeps entries in a hash table keyed by precomputed name hashes
+ *
+ * This policy never rejects or evicts entries.  It is intended to be combined with a real
+ * replacement policy (via multi_policy_traits) and provides exact-match (find_exact) and
+ * longest-prefix match (longest_prefix_match_if) lookups that do not walk the trie.
+ * Hashes are taken from the name object (Name::getPrefixHash), which calculates them only once.
+ */
+struct name_hash_index_policy_traits
+{
+  /// @brief Name that can be used to identify the policy (for NS-3 object model and logging)
+  static std::string GetName () { return "NameHashIndex"; }
+
+  struct policy_hook_type : public boost::intrusive::unordered_set_member_hook<> { size_t hash; };
+
+  template<class Container>
+  struct container_hook
+  {
+    typedef boost::intrusive::member_hook< Container,
+                                           policy_hook_type,
+                                           &Container::policy_hook_ > type;
+  };
+
+  template<class Base,
+           class Container,
+           class Hook>
+  struct policy
+  {
+    static size_t& get_hash (typename Container::iterator item)
+    {
+      return static_cast<typename policy_container::value_traits::hook_type*>
+        (policy_container::value_traits::to_node_ptr(*item))->hash;
+    }
+
+    static const size_t& get_hash (typename Container::const_iterator item)
+    {
+      return static_cast<const typename policy_container::value_traits::hook_type*>
+        (policy_container::value_traits::to_node_ptr(*item))->hash;
+    }
+
+    template<class Key>
+    struct MemberHookHash
+    {
+      size_t operator () (const Key &item) const
+      {
+        return get_hash (&item);
+      }
+    };
+
+    typedef typename boost::intrusive::unordered_multiset< Container,
+                                                           boost::intrusive::hash< MemberHookHash< Container > >,
+                                                           boost::intrusive::power_2_buckets<true>,
+                                                           Hook > policy_container;
+
+    typedef typename policy_container::bucket_type   bucket_type;
+    typedef typename policy_container::bucket_traits bucket_traits;
+
+    /// @brief Storage for hash table buckets (has to outlive policy_container)
+    struct buckets_holder
+    {
+      buckets_holder () : buckets_ (initialBucketSize) { }
+
+      static const size_t initialBucketSize = 64;
+      std::vector<bucket_type> buckets_;
+    };
+
+    /// @brief Lookup key: prefix of the given length of the name
+    struct Prefix
+    {
+      Prefix (const Name &name, size_t len) : name_ (name), len_ (len) { }
+
+      const Name &name_;
+      size_t len_;
+    };
+
+    struct PrefixHash
+    {
+      size_t operator () (const Prefix &prefix) const
+      {
+        return prefix.name_.getPrefixHash (prefix.len_);
+      }
+    };
+
+    struct PrefixEqual
+    {
+      bool operator () (const Prefix &prefix, const Container &item) const
+      {
+        const Name &name = item.payload ()->GetPrefix ();
+        return name.size () == prefix.len_ &&
+          std::equal (name.begin (), name.end (), prefix.name_.begin ());
+      }
+    };
+
+    class type : private buckets_holder, public policy_container
+    {
+    public:
+      typedef Container parent_trie;
+
+      type (Base &base)
+        : policy_container (bucket_traits (&buckets_holder::buckets_ [0], buckets_holder::buckets_.size ()))
+        , base_ (base)
+        , max_size_ (0)
+      {
+      }
+
+      inline void
+      update (typename parent_trie::iterator item)
+      {
+        // do nothing
+      }
+
+      inline bool
+      insert (typename parent_trie::iterator item)
+      {
+        get_hash (item) = item->payload ()->GetPrefix ().getHash ();
+
+        policy_container::insert (*item);
+        rehash_if_necessary ();
+        return true;
+      }
+
+      inline void
+      lookup (typename parent_trie::iterator item)
+      {
+        // do nothing
+      }
+
+      inline void
+      erase (typename parent_trie::iterator item)
+      {
+        policy_container::erase (policy_container::iterator_to (*item));
+      }
+
+      inline void
+      clear ()
+      {
+        policy_container::clear ();
+      }
+
+      inline void
+      set_max_size (size_t max_size)
+      {
+        max_size_ = max_size;
+      }
+
+      inline size_t
+      get_max_size () const
+      {
+        return max_size_;
+      }
+
+      /**
+       * @brief Find an element that exactly matches the name (one hash probe)
+       */
+      inline typename parent_trie::iterator
+      find_exact (const Name &name)
+      {
+        typename policy_container::iterator item =
+          policy_container::find (Prefix (name, name.size ()), PrefixHash (), PrefixEqual ());
+        if (item == policy_container::end ())
+          return 0;
+
+        return &(*item);
+      }
+
+      /**
+       * @brief Find an element with the longest prefix of the name that satisfies the predicate
+       *
+       * Prefixes are checked starting from the longest one, one hash probe per prefix length
+       */
+      template<class Predicate>
+      inline typename parent_trie::iterator
+      longest_prefix_match_if (const Name &name, Predicate pred)
+      {
+        for (size_t len = name.size () + 1; len > 0; len--)
+          {
+            Prefix prefix (name, len - 1);
+
+            std::pair<typename policy_container::iterator, typename policy_container::iterator> range =
+              policy_container::equal_range (prefix, PrefixHash (), PrefixEqual ());
+
+            for (typename policy_container::iterator item = range.first; item != range.second; item++)
+              {
+                if (pred (item->payload ()))
+                  return &(*item);
+              }
+          }
+
+        return 0;
+      }
+
+    private:
+      inline void
+      rehash_if_necessary ()
+      {
+        if (policy_container::size () <= policy_container::bucket_count ())
+          return;
+
+        std::vector<bucket_type> newBuckets (policy_container::bucket_count () * 2);
+        policy_container::rehash (bucket_traits (&newBuckets [0], newBuckets.size ()));
+        buckets_holder::buckets_.swap (newBuckets);
+      }
+
+      type () : base_(*((Base*)0)) { };
+
+    private:
+      Base &base_;
+      size_t max_size_;
+    };
+  };
+};
+
+} // ndnSIM
+} // ndn
+} // ns3
+
+#endif // NAME_HASH_INDEX_POLICY_H_
@@ -0,0 +1,162 @@
+/* -*- Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef _NDN_PIT_ENTRY_IMPL_H_
+#define	_NDN_PIT_ENTRY_IMPL_H_
+
+namespace ns3 {
+namespace ndn {
+
+class Pit;
+
+namespace pit {
+
+/**
+ * @ingroup ndn-pit
+ * @brief PIT entry implementation with additional pointers to the underlying container
+ */
+template<class Pit>
+class EntryImpl : public Entry
+{
+public:
+  typedef Entry base_type;
+
+  typedef Entry super;
+  #define CONTAINER static_cast<Pit&> (m_container)
+  
+public:
+  EntryImpl (Pit &pit,
+                Ptr<const Interest> header,
+                Ptr<fib::Entry> fibEntry)
+  : Entry (pit, header, fibEntry)
+  , item_ (0)
+  {
+    CONTAINER.ScheduleExpiration (*this);
+    CONTAINER.AddToFibIndex (*this);
+  }
+  
+  virtual ~EntryImpl ()
+  {
+    CONTAINER.i_time.erase (*this);
+    CONTAINER.RemoveFromFibIndex (*this);
+
+    for (in_iterator face = m_incoming.begin (); face != m_incoming.end (); face++)
+      CONTAINER.RemoveFromFaceIndex (face->m_face, *this);
+    for (out_iterator face = m_outgoing.begin (); face != m_outgoing.end (); face++)
+      if (m_incoming.find (face->m_face) == m_incoming.end ())
+        CONTAINER.RemoveFromFaceIndex (face->m_face, *this);
+  }
+
+  virtual void
+  UpdateLifetime (const Time &offsetTime)
+  {
+    CONTAINER.i_time.erase (*this);
+    super::UpdateLifetime (offsetTime);
+    CONTAINER.ScheduleExpiration (*this);
+  }
+
+  virtual void
+  OffsetLifetime (const Time &offsetTime)
+  {
+    CONTAINER.i_time.erase (*this);
+    super::OffsetLifetime (offsetTime);
+    CONTAINER.ScheduleExpiration (*this);
+  }
+
+  virtual in_iterator
+  AddIncoming (Ptr<Face> face)
+  {
+    bool newFace = !IsFaceReferenced (face);
+    in_iterator ret = super::AddIncoming (face);
+    if (newFace)
+      CONTAINER.AddToFaceIndex (face, *this);
+    return ret;
+  }
+
+  virtual void
+  RemoveIncoming (Ptr<Face> face)
+  {
+    super::RemoveIncoming (face);
+    if (!IsFaceReferenced (face))
+      CONTAINER.RemoveFromFaceIndex (face, *this);
+  }
+
+  virtual void
+  ClearIncoming ()
+  {
+    for (in_iterator face = m_incoming.begin (); face != m_incoming.end (); face++)
+      if (m_outgoing.find (face->m_face) == m_outgoing.end ())
+        CONTAINER.RemoveFromFaceIndex (face->m_face, *this);
+    super::ClearIncoming ();
+  }
+
+  virtual out_iterator
+  AddOutgoing (Ptr<Face> face)
+  {
+    bool newFace = !IsFaceReferenced (face);
+    out_iterator ret = super::AddOutgoing (face);
+    if (newFace)
+      CONTAINER.AddToFaceIndex (face, *this);
+    return ret;
+  }
+
+  virtual void
+  ClearOutgoing ()
+  {
+    for (out_iterator face = m_outgoing.begin (); face != m_outgoing.end (); face++)
+      if (m_incoming.find (face->m_face) == m_incoming.end ())
+        CONTAINER.RemoveFromFaceIndex (face->m_face, *this);
+    super::ClearOutgoing ();
+  }
+
+  virtual void
+  RemoveAllReferencesToFace (Ptr<Face> face)
+  {
+    super::RemoveAllReferencesToFace (face);
+    CONTAINER.RemoveFromFaceIndex (face, *this);
+  }
+  
+  // to make sure policies work
+  void
+  SetTrie (typename Pit::super::iterator item) { item_ = item; }
+
+  typename Pit::super::iterator to_iterator () { return item_; }
+  typename Pit::super::const_iterator to_iterator () const { return item_; }
+
+private:
+  bool
+  IsFaceReferenced (const Ptr<Face> &face) const
+  {
+    return m_incoming.find (face) != m_incoming.end () || m_outgoing.find (face) != m_outgoing.end ();
+  }
+
+public:
+  TimerWheelHook time_hook_;
+  boost::intrusive::list_member_hook<> fib_hook_;
+  
+private:
+  typename Pit::super::iterator item_;
+};
+
+} // namespace pit
+} // namespace ndn
+} // namespace ns3
+
+#endif 
@@ -0,0 +1,625 @@
+/* -*- Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef _NDN_PIT_IMPL_H_
+#define	_NDN_PIT_IMPL_H_
+
+#include "ndn-pit.h"
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+#include "../../utils/trie/trie-with-policy.h"
+#include "../../utils/timer-wheel.h"
+#include "ndn-pit-entry-impl.h"
+
+#include <boost/intrusive/list.hpp>
+#include <boost/unordered_map.hpp>
+#include <boost/unordered_set.hpp>
+
+#include "ns3/ndn-interest.h"
+#include "ns3/ndn-data.h"
+#include "ns3/ndn-forwarding-strategy.h"
+#include "ns3/ndn-name.h"
+
+
+namespace ns3 {
+namespace ndn {
+
+class ForwardingStrategy;
+
+namespace pit {
+
+/**
+ * @ingroup ndn-pit
+ * @brief Class implementing Pending Interests Table
+ */
+template<class Policy, class TrieTraits = ndnSIM::node_trie_traits>
+class PitImpl : public Pit
+              , protected ndnSIM::trie_with_policy<Name,
+                                                   ndnSIM::smart_pointer_payload_traits< EntryImpl< PitImpl< Policy, TrieTraits > > >,
+                                                   // ndnSIM::persistent_policy_traits
+                                                   Policy,
+                                                   TrieTraits
+                                                   >
+{
+public:
+  typedef ndnSIM::trie_with_policy<Name,
+                                   ndnSIM::smart_pointer_payload_traits< EntryImpl< PitImpl< Policy, TrieTraits > > >,
+                                   // ndnSIM::persistent_policy_traits
+                                   Policy,
+                                   TrieTraits
+                                   > super;
+  typedef EntryImpl< PitImpl< Policy, TrieTraits > > entry;
+
+  /**
+   * \brief Interface ID
+   *
+   * \return interface ID
+   */
+  static TypeId GetTypeId ();
+
+  /**
+   * \brief PIT constructor
+   */
+  PitImpl ();
+
+  /**
+   * \brief Destructor
+   */
+  virtual ~PitImpl ();
+
+  // inherited from Pit
+  virtual Ptr<Entry>
+  Lookup (const Data &header);
+
+  virtual Ptr<Entry>
+  Lookup (const Interest &header);
+
+  virtual Ptr<Entry>
+  Find (const Name &prefix);
+
+  virtual Ptr<Entry>
+  Create (Ptr<const Interest> header);
+
+  virtual void
+  MarkErased (Ptr<Entry> entry);
+
+  virtual void
+  RemoveFromAll (Ptr<Face> face);
+
+  virtual void
+  Print (std::ostream &os) const;
+
+  virtual uint32_t
+  GetSize () const;
+
+  virtual Ptr<Entry>
+  Begin ();
+
+  virtual Ptr<Entry>
+  End ();
+
+  virtual Ptr<Entry>
+  Next (Ptr<Entry>);
+
+  const typename super::policy_container &
+  GetPolicy () const { return super::getPolicy (); }
+
+  typename super::policy_container &
+  GetPolicy () { return super::getPolicy (); }
+
+protected:
+  void ScheduleExpiration (entry &item);
+  void AddToFaceIndex (const Ptr<Face> &face, entry &item);
+  void RemoveFromFaceIndex (const Ptr<Face> &face, entry &item);
+  void AddToFibIndex (entry &item);
+  void RemoveFromFibIndex (entry &item);
+  void RescheduleCleaning ();
+  void CleanExpired ();
+
+  // inherited from Object class
+  virtual void NotifyNewAggregate (); ///< @brief Even when object is aggregated to another Object
+  virtual void DoDispose (); ///< @brief Do cleanup
+
+private:
+  uint32_t
+  GetMaxSize () const;
+
+  void
+  SetMaxSize (uint32_t maxSize);
+
+  uint32_t
+  GetCurrentSize () const;
+
+  uint64_t
+  ToTick (const Time &time) const;
+
+private:
+  Time m_tick; ///< @brief Granularity of the timing wheel
+  EventId m_cleanEvent;
+  uint64_t m_cleanTick; ///< @brief Wheel tick for which m_cleanEvent is scheduled
+  Ptr<Fib> m_fib; ///< \brief Link to FIB table
+  Ptr<ForwardingStrategy> m_forwardingStrategy;
+
+  static LogComponent g_log; ///< @brief Logging variable
+
+  // indexes
+  typedef TimerWheel<entry, &entry::time_hook_> time_index;
+  time_index i_time;
+
+  // face -> entries that have the face in incoming or outgoing lists
+  typedef boost::unordered_map< const Face*, boost::unordered_set<entry*> > face_index;
+  face_index i_face;
+
+  // FIB entry -> entries created using this FIB entry
+  typedef boost::intrusive::list< entry,
+                                  boost::intrusive::member_hook< entry,
+                                                                 boost::intrusive::list_member_hook<>,
+                                                                 &entry::fib_hook_ > > fib_entries;
+  typedef boost::unordered_map< const fib::Entry*, fib_entries > fib_index;
+  fib_index i_fib;
+
+  friend class EntryImpl< PitImpl >;
+};
+
+//////////////////////////////////////////
+////////// Implementation ////////////////
+//////////////////////////////////////////
+
+template<class Policy, class TrieTraits>
+LogComponent PitImpl<Policy, TrieTraits>::g_log = LogComponent (("ndn.pit." + TrieTraits::GetLogPrefix () + Policy::GetName ()).c_str ());
+
+
+template<class Policy, class TrieTraits>
+TypeId
+PitImpl<Policy, TrieTraits>::GetTypeId ()
+{
+  static TypeId tid = TypeId (("ns3::ndn::pit::" + TrieTraits::GetTypeIdPrefix () + Policy::GetName ()).c_str ())
+    .SetGroupName ("Ndn")
+    .SetParent<Pit> ()
+    .AddConstructor< PitImpl<Policy, TrieTraits> > ()
+    .AddAttribute ("MaxSize",
+                   "Set maximum size of PIT in bytes. If 0, limit is not enforced",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&PitImpl<Policy, TrieTraits>::GetMaxSize,
+                                         &PitImpl<Policy, TrieTraits>::SetMaxSize),
+                   MakeUintegerChecker<uint32_t> ())
+
+    .AddAttribute ("CurrentSize", "Get current size of PIT in bytes",
+                   TypeId::ATTR_GET,
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&PitImpl<Policy, TrieTraits>::GetCurrentSize),
+                   MakeUintegerChecker<uint32_t> ())
+
+    .AddAttribute ("TimerWheelTick",
+                   "Granularity of the timing wheel used to expire PIT entries (entries are removed "
+                   "at most one tick later than their expiration time). Should be set before PIT is used",
+                   TimeValue (MilliSeconds (1)),
+                   MakeTimeAccessor (&PitImpl<Policy, TrieTraits>::m_tick),
+                   MakeTimeChecker (TimeStep (1)))
+    ;
+
+  return tid;
+}
+
+template<class Policy, class TrieTraits>
+uint32_t
+PitImpl<Policy, TrieTraits>::GetCurrentSize () const
+{
+  return super::getPolicy ().size ();
+}
+
+template<class Policy, class TrieTraits>
+PitImpl<Policy, TrieTraits>::PitImpl ()
+  : m_cleanTick (0)
+{
+}
+
+template<class Policy, class TrieTraits>
+PitImpl<Policy, TrieTraits>::~PitImpl ()
+{
+}
+
+template<class Policy, class TrieTraits>
+uint32_t
+PitImpl<Policy, TrieTraits>::GetMaxSize () const
+{
+  return super::getPolicy ().get_max_size ();
+}
+
+template<class Policy, class TrieTraits>
+void
+PitImpl<Policy, TrieTraits>::SetMaxSize (uint32_t maxSize)
+{
+  super::getPolicy ().set_max_size (maxSize);
+}
+
+template<class Policy, class TrieTraits>
+void
+PitImpl<Policy, TrieTraits>::NotifyNewAggregate ()
+{
+  if (m_fib == 0)
+    {
+      m_fib = GetObject<Fib> ();
+    }
+  if (m_forwardingStrategy == 0)
+    {
+      m_forwardingStrategy = GetObject<ForwardingStrategy> ();
+    }
+
+  Pit::NotifyNewAggregate ();
+}
+
+template<class Policy, class TrieTraits>
+void
+PitImpl<Policy, TrieTraits>::DoDispose ()
+{
+  super::clear ();
+  i_face.clear ();
+  i_fib.clear ();
+
+  m_forwardingStrategy = 0;
+  m_fib = 0;
+
+  Pit::DoDispose ();
+}
+
+template<class Policy, class TrieTraits>
+uint64_t
+PitImpl<Policy, TrieTraits>::ToTick (const Time &time) const
+{
+  // round up, so entries never expire earlier than requested
+  return (time.GetTimeStep () + m_tick.GetTimeStep () - 1) / m_tick.GetTimeStep ();
+}
+
+template<class Policy, class TrieTraits>
+void
+PitImpl<Policy, TrieTraits>::ScheduleExpiration (entry &item)
+{
+  if (i_time.empty ())
+    {
+      i_time.reset (Simulator::Now ().GetTimeStep () / m_tick.GetTimeStep ());
+    }
+
+  i_time.insert (item, ToTick (item.GetExpireTime ()));
+  RescheduleCleaning ();
+}
+
+template<class Policy, class TrieTraits>
+void
+PitImpl<Policy, TrieTraits>::AddToFaceIndex (const Ptr<Face> &face, entry &item)
+{
+  i_face [PeekPointer (face)].insert (&item);
+}
+
+template<class Policy, class TrieTraits>
+void
+PitImpl<Policy, TrieTraits>::RemoveFromFaceIndex (const Ptr<Face> &face, entry &item)
+{
+  typename face_index::iterator record = i_face.find (PeekPointer (face));
+  if (record == i_face.end ())
+    return;
+
+  record->second.erase (&item);
+  if (record->second.empty ())
+    i_face.erase (record);
+}
+
+template<class Policy, class TrieTraits>
+void
+PitImpl<Policy, TrieTraits>::AddToFibIndex (entry &item)
+{
+  i_fib [PeekPointer (item.GetFibEntry ())].push_back (item);
+}
+
+template<class Policy, class TrieTraits>
+void
+PitImpl<Policy, TrieTraits>::RemoveFromFibIndex (entry &item)
+{
+  if (!item.fib_hook_.is_linked ())
+    return;
+
+  typename fib_index::iterator record = i_fib.find (PeekPointer (item.GetFibEntry ()));
+  record->second.erase (record->second.iterator_to (item));
+  if (record->second.empty ())
+    i_fib.erase (record);
+}
+
+template<class Policy, class TrieTraits>
+void
+PitImpl<Policy, TrieTraits>::RescheduleCleaning ()
+{
+  uint64_t nextTick = i_time.next ();
+  if (nextTick == time_index::npos)
+    {
+      // NS_LOG_DEBUG ("No items in PIT");
+      return; // if event is still scheduled, it will just find nothing to clean
+    }
+
+  if (m_cleanEvent.IsRunning ())
+    {
+      if (m_cleanTick <= nextTick)
+        return; // wheel tick is already scheduled early enough
+
+      Simulator::Remove (m_cleanEvent);
+    }
+
+  Time nextEvent = TimeStep (m_tick.GetTimeStep () * nextTick) - Simulator::Now ();
+  if (nextEvent <= 0) nextEvent = Seconds (0);
+
+  NS_LOG_DEBUG ("Schedule next cleaning in " <<
+                nextEvent.ToDouble (Time::S) << "s (tick " << nextTick << ")");
+
+  m_cleanTick = nextTick;
+  m_cleanEvent = Simulator::Schedule (nextEvent,
+                                      &PitImpl<Policy, TrieTraits>::CleanExpired, this);
+}
+
+template<class Policy, class TrieTraits>
+void
+PitImpl<Policy, TrieTraits>::CleanExpired ()
+{
+  NS_LOG_LOGIC ("Cleaning PIT. Total: " << i_time.size ());
+  Time now = Simulator::Now ();
+
+  i_time.expire (now.GetTimeStep () / m_tick.GetTimeStep ());
+
+  entry *item;
+  while ((item = i_time.pop ()) != 0)
+    {
+      if (item->GetExpireTime () <= now) // is the record stale?
+        {
+          m_forwardingStrategy->WillEraseTimedOutPendingInterest (item->to_iterator ()->payload ());
+          super::erase (item->to_iterator ());
+        }
+      else
+        {
+          // should not really happen, as expiration time is rounded up to wheel ticks
+          i_time.insert (*item, ToTick (item->GetExpireTime ()));
+        }
+    }
+
+  if (super::getPolicy ().size ())
+    {
+      NS_LOG_DEBUG ("Size: " << super::getPolicy ().size ());
+      NS_LOG_DEBUG ("i_time size: " << i_time.size ());
+    }
+  RescheduleCleaning ();
+}
+
+template<class Policy, class TrieTraits>
+Ptr<Entry>
+PitImpl<Policy, TrieTraits>::Lookup (const Data &header)
+{
+  /// @todo use predicate to search with exclude filters
+  typename super::iterator item = super::longest_prefix_match_if (header.GetName (), EntryIsNotEmpty ());
+
+  if (item == super::end ())
+    return 0;
+  else
+    return item->payload (); // which could also be 0
+}
+
+template<class Policy, class TrieTraits>
+Ptr<Entry>
+PitImpl<Policy, TrieTraits>::Lookup (const Interest &header)
+{
+  // NS_LOG_FUNCTION (header.GetName ());
+  NS_ASSERT_MSG (m_fib != 0, "FIB should be set");
+  NS_ASSERT_MSG (m_forwardingStrategy != 0, "Forwarding strategy  should be set");
+
+  typename super::iterator foundItem, lastItem;
+  bool reachLast;
+  boost::tie (foundItem, reachLast, lastItem) = super::getTrie ().find (header.GetName ());
+
+  if (!reachLast || lastItem == super::end ())
+    return 0;
+  else
+    return lastItem->payload (); // which could also be 0
+}
+
+template<class Policy, class TrieTraits>
+Ptr<Entry>
+PitImpl<Policy, TrieTraits>::Find (const Name &prefix)
+{
+  typename super::iterator item = super::find_exact (prefix);
+
+  if (item == super::end ())
+    return 0;
+  else
+    return item->payload ();
+}
+
+
+template<class Policy, class TrieTraits>
+Ptr<Entry>
+PitImpl<Policy, TrieTraits>::Create (Ptr<const Interest> header)
+{
+  NS_LOG_DEBUG (header->GetName ());
+  Ptr<fib::Entry> fibEntry = m_fib->LongestPrefixMatch (*header);
+  if (fibEntry == 0)
+    return 0;
+
+  // NS_ASSERT_MSG (fibEntry != 0,
+  //                "There should be at least default route set" <<
+  //                " Prefix = "<< header->GetName() << ", NodeID == " << m_fib->GetObject<Node>()->GetId() << "\n" << *m_fib);
+
+  Ptr< entry > newEntry = ns3::Create< entry > (boost::ref (*this), header, fibEntry);
+  std::pair< typename super::iterator, bool > result = super::insert (header->GetName (), newEntry);
+  if (result.first != super::end ())
+    {
+      if (result.second)
+        {
+          newEntry->SetTrie (result.first);
+          return newEntry;
+        }
+      else
+        {
+          // should we do anything?
+          // update payload? add new payload?
+          return result.first->payload ();
+        }
+    }
+  else
+    return 0;
+}
+
+
+template<class Policy, class TrieTraits>
+void
+PitImpl<Policy, TrieTraits>::MarkErased (Ptr<Entry> item)
+{
+  if (this->m_PitEntryPruningTimout.IsZero ())
+    {
+      super::erase (StaticCast< entry > (item)->to_iterator ());
+    }
+  else
+    {
+      item->OffsetLifetime (this->m_PitEntryPruningTimout - item->GetExpireTime () + Simulator::Now ());
+    }
+}
+
+
+template<class Policy, class TrieTraits>
+void
+PitImpl<Policy, TrieTraits>::RemoveFromAll (Ptr<Face> face)
+{
+  NS_LOG_FUNCTION (this);
+
+  // If this face is the only for the associated FIB entry, then FIB entry will be removed soon.
+  // Thus, we have to remove the whole PIT entry
+  std::vector< Ptr<entry> > entriesToRemove;
+  std::vector< Ptr<fib::Entry> > fibEntries = m_fib->GetEntriesWithFace (face);
+  for (std::vector< Ptr<fib::Entry> >::iterator fibEntry = fibEntries.begin ();
+       fibEntry != fibEntries.end ();
+       fibEntry++)
+    {
+      if ((*fibEntry)->m_faces.size () != 1)
+        continue;
+
+      typename fib_index::iterator record = i_fib.find (PeekPointer (*fibEntry));
+      if (record == i_fib.end ())
+        continue;
+
+      for (typename fib_entries::iterator item = record->second.begin ();
+           item != record->second.end ();
+           item++)
+        {
+          entriesToRemove.push_back (&(*item));
+        }
+    }
+
+  typename face_index::iterator record = i_face.find (PeekPointer (face));
+  if (record != i_face.end ())
+    {
+      // just to be on a safe side. Do the process in two steps
+      std::vector< Ptr<entry> > entries (record->second.begin (), record->second.end ());
+      i_face.erase (record);
+
+      for (typename std::vector< Ptr<entry> >::iterator item = entries.begin ();
+           item != entries.end ();
+           item++)
+        {
+          (*item)->RemoveAllReferencesToFace (face);
+        }
+    }
+
+  for (typename std::vector< Ptr<entry> >::iterator item = entriesToRemove.begin ();
+       item != entriesToRemove.end ();
+       item++)
+    {
+      MarkErased (*item);
+    }
+}
+
+template<class Policy, class TrieTraits>
+void
+PitImpl<Policy, TrieTraits>::Print (std::ostream& os) const
+{
+  // !!! unordered_set imposes "random" order of item in the same level !!!
+  typename super::parent_trie::const_recursive_iterator item (super::getTrie ()), end (0);
+  for (; item != end; item++)
+    {
+      if (item->payload () == 0) continue;
+
+      os << item->payload ()->GetPrefix () << "\t" << *item->payload () << "\n";
+    }
+}
+
+template<class Policy, class TrieTraits>
+uint32_t
+PitImpl<Policy, TrieTraits>::GetSize () const
+{
+  return super::getPolicy ().size ();
+}
+
+template<class Policy, class TrieTraits>
+Ptr<Entry>
+PitImpl<Policy, TrieTraits>::Begin ()
+{
+  typename super::parent_trie::recursive_iterator item (super::getTrie ()), end (0);
+  for (; item != end; item++)
+    {
+      if (item->payload () == 0) continue;
+      break;
+    }
+
+  if (item == end)
+    return End ();
+  else
+    return item->payload ();
+}
+
+template<class Policy, class TrieTraits>
+Ptr<Entry>
+PitImpl<Policy, TrieTraits>::End ()
+{
+  return 0;
+}
+
+template<class Policy, class TrieTraits>
+Ptr<Entry>
+PitImpl<Policy, TrieTraits>::Next (Ptr<Entry> from)
+{
+  if (from == 0) return 0;
+
+  typename super::parent_trie::recursive_iterator
+    item (*StaticCast< entry > (from)->to_iterator ()),
+    end (0);
+
+  for (item++; item != end; item++)
+    {
+      if (item->payload () == 0) continue;
+      break;
+    }
+
+  if (item == end)
+    return End ();
+  else
+    return item->payload ();
+}
+
+
+} // namespace pit
+} // namespace ndn
+} // namespace ns3
+
+#endif	/* NDN_PIT_IMPL_H */
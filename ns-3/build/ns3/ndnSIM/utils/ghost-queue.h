@@ -0,0 +1,243 @@
+/* -*- Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef GHOST_QUEUE_H_
+#define GHOST_QUEUE_H_
+
+#include <cstddef>
+#include <stdint.h>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+/**
+ * @brief Bounded FIFO of hashes of recently evicted items ("ghost" entries of ARC and S3-FIFO)
+ *
+ * Only 32-bit fingerprints of hashes are remembered.  Fingerprints are kept in a ring buffer of
+ * the fixed capacity, and an open-addressed (linear probing) table of ring positions supports
+ * constant time membership check and removal.  The table is at least twice as large as the ring,
+ * so one remembered hash costs 12 to 20 bytes (4 bytes in the ring, 8 to 16 bytes in the table).
+ * Different hashes with the same fingerprint are indistinguishable, which for a ghost queue of
+ * n hashes happens with probability of about n / 2^32 per lookup.
+ *
+ * Removed hashes keep occupying their ring slots until they reach the head of the queue, so the
+ * number of live hashes can be below the capacity.
+ */
+class ghost_queue
+{
+public:
+  ghost_queue ()
+    : m_head (0)
+    , m_used (0)
+    , m_live (0)
+  {
+  }
+
+  /**
+   * @brief Clear the queue and set its capacity
+   */
+  void
+  set_capacity (size_t capacity)
+  {
+    m_ring.assign (capacity, Empty);
+
+    size_t tableSize = 2;
+    while (tableSize < 2 * capacity)
+      tableSize *= 2;
+    m_table.assign (capacity > 0 ? tableSize : 0, Empty);
+
+    m_head = 0;
+    m_used = 0;
+    m_live = 0;
+  }
+
+  /**
+   * @brief Add hash to the tail of the queue, the oldest hash is dropped if the queue is full
+   */
+  void
+  push (size_t hash)
+  {
+    if (m_ring.empty ())
+      return;
+
+    uint32_t print = fingerprint (hash);
+    remove (print); // only the latest copy of the hash is live
+
+    if (m_used == m_ring.size ())
+      pop ();
+
+    uint32_t position = (m_head + m_used) % m_ring.size ();
+    m_ring[position] = print;
+    m_used++;
+    m_live++;
+
+    size_t slot = home (print);
+    while (m_table[slot] != Empty)
+      slot = (slot + 1) & (m_table.size () - 1);
+    m_table[slot] = position + 1;
+  }
+
+  /**
+   * @brief Drop the oldest slot of the queue (no-op if the queue is empty)
+   */
+  void
+  pop ()
+  {
+    if (m_used == 0)
+      return;
+
+    if (m_ring[m_head] != Empty)
+      remove (m_ring[m_head]);
+
+    m_head = (m_head + 1) % m_ring.size ();
+    m_used--;
+  }
+
+  /**
+   * @brief Drop the oldest live hash of the queue
+   */
+  void
+  pop_live ()
+  {
+    while (m_used > 0)
+      {
+        bool live = m_ring[m_head] != Empty;
+        pop ();
+        if (live)
+          break;
+      }
+  }
+
+  bool
+  contains (size_t hash) const
+  {
+    return find (fingerprint (hash)) != npos;
+  }
+
+  /**
+   * @brief Remove hash from the queue (if present)
+   */
+  bool
+  erase (size_t hash)
+  {
+    return remove (fingerprint (hash));
+  }
+
+  /**
+   * @brief Number of live hashes in the queue
+   */
+  size_t
+  size () const
+  {
+    return m_live;
+  }
+
+  void
+  clear ()
+  {
+    set_capacity (m_ring.size ());
+  }
+
+private:
+  enum
+    {
+      Empty = 0 ///< @brief marks empty table slots and removed ring slots
+    };
+  static const size_t npos = static_cast<size_t> (-1);
+
+  static uint32_t
+  fingerprint (size_t hash)
+  {
+    uint64_t value = hash;
+    uint32_t print = static_cast<uint32_t> (value ^ (value >> 32));
+    return print != Empty ? print : 1;
+  }
+
+  size_t
+  home (uint32_t print) const
+  {
+    // fingerprints are mixed, as low bits of some hashes are poorly distributed
+    print ^= print >> 16;
+    print *= 0x85ebca6b;
+    print ^= print >> 13;
+    return print & (m_table.size () - 1);
+  }
+
+  /**
+   * @brief Table slot that refers to the fingerprint, or npos
+   */
+  size_t
+  find (uint32_t print) const
+  {
+    if (m_table.empty ())
+      return npos;
+
+    for (size_t slot = home (print); m_table[slot] != Empty; slot = (slot + 1) & (m_table.size () - 1))
+      {
+        if (m_ring[m_table[slot] - 1] == print)
+          return slot;
+      }
+    return npos;
+  }
+
+  /**
+   * @brief Remove fingerprint from the table and mark its ring slot as removed
+   */
+  bool
+  remove (uint32_t print)
+  {
+    size_t slot = find (print);
+    if (slot == npos)
+      return false;
+
+    uint32_t position = m_table[slot] - 1;
+
+    // backward shift deletion: move following entries of the probe sequence into the hole,
+    // unless they are already at or before their home slot
+    size_t mask = m_table.size () - 1;
+    size_t hole = slot;
+    for (size_t next = (hole + 1) & mask; m_table[next] != Empty; next = (next + 1) & mask)
+      {
+        size_t nextHome = home (m_ring[m_table[next] - 1]);
+        if (((next - nextHome) & mask) >= ((next - hole) & mask))
+          {
+            m_table[hole] = m_table[next];
+            hole = next;
+          }
+      }
+    m_table[hole] = Empty;
+
+    m_ring[position] = Empty;
+    m_live--;
+    return true;
+  }
+
+private:
+  std::vector<uint32_t> m_ring;  ///< @brief fingerprints in FIFO order (Empty for removed hashes)
+  std::vector<uint32_t> m_table; ///< @brief open-addressed index: ring position + 1, or Empty
+  size_t m_head;
+  size_t m_used;
+  size_t m_live;
+};
+
+} // ndnSIM
+} // ndn
+} // ns3
+
+#endif // GHOST_QUEUE_H_
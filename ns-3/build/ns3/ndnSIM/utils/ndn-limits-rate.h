@@ -0,0 +1,165 @@
+/* -*- Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef _NDN_LIMITS_RATE_H_
+#define	_NDN_LIMITS_RATE_H_
+
+#include "ndn-limits.h"
+#include <ns3/nstime.h>
+#include <ns3/event-id.h>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * \ingroup ndn-fw
+ * \brief Structure to manage limits for outstanding interests
+ *
+ * By default, token bucket is leaked by a periodic event (every 1.001/rate seconds).  If
+ * LazyLeak attribute is set, the bucket level is instead calculated from the time of the last
+ * update whenever the limit is checked or borrowed, and the only scheduled event is the one
+ * that fires the available slot callback after the limit was found exhausted.
+ */
+class LimitsRate :
+    public Limits
+{
+public:
+  typedef Limits super;
+
+  static TypeId
+  GetTypeId ();
+
+  /**
+   * \brief Constructor
+   * \param prefix smart pointer to the prefix for the FIB entry
+   */
+  LimitsRate ()
+    : m_isLeakScheduled (false)
+    , m_lazyLeak (false)
+    , m_bucketMax (0)
+    , m_bucketLeak (1)
+    , m_bucket (0)
+  { }
+
+  virtual
+  ~LimitsRate () { }
+
+  virtual void
+  SetLimits (double rate, double delay);
+
+  virtual
+  double
+  GetMaxLimit () const
+  {
+    return GetMaxRate ();
+  }
+
+  /**
+   * @brief Check if Interest limit is reached (token bucket is not empty)
+   */
+  virtual bool
+  IsBelowLimit ();
+
+  /**
+   * @brief Get token from the bucket
+   */
+  virtual void
+  BorrowLimit ();
+
+  /**
+   * @brief Does nothing (token bucket leakage is time-dependent only)
+   */
+  virtual void
+  ReturnLimit ();
+
+  /**
+   * @brief Update normalized amount that should be leaked every second (token bucket leak rate) and leak rate
+   */
+  virtual void
+  UpdateCurrentLimit (double limit);
+
+  /**
+   * @brief Get normalized amount that should be leaked every second (token bucket leak rate)
+   */
+  virtual double
+  GetCurrentLimit () const
+  {
+    return m_bucketLeak;
+  }
+
+  virtual double
+  GetCurrentLimitRate () const
+  {
+    return m_bucketLeak;
+  }
+
+protected:
+  // from Node
+  void
+  NotifyNewAggregate ();
+
+  virtual void
+  DoDispose ();
+
+private:
+  /**
+   * @brief Leak bucket, assuming `interval' seconds between leakages
+   *
+   * @param interval Time interval for leakage. Used to calculate size of the leak
+   */
+  void
+  LeakBucket (double interval);
+
+  /**
+   * @brief Leak bucket by the amount accumulated since the last update (LazyLeak mode)
+   */
+  void
+  UpdateBucket ();
+
+  /**
+   * @brief Schedule FireAvailableSlotCallback for the time when a token will become available (LazyLeak mode)
+   */
+  void
+  ScheduleAvailableSlot ();
+
+  /**
+   * @brief Fire available slot callback, if token is available (LazyLeak mode)
+   */
+  void
+  AvailableSlot ();
+
+private:
+  bool m_isLeakScheduled;
+  bool m_lazyLeak;      ///< \brief Calculate bucket level on demand instead of leaking it periodically
+  Time m_lastLeak;      ///< \brief Time of the last bucket update (LazyLeak mode)
+  EventId m_slotEvent;  ///< \brief Scheduled notification about available slot (LazyLeak mode)
+
+  double m_bucketMax;   ///< \brief Maximum Interest allowance for this face (maximum tokens that can be issued at the same time)
+  double m_bucketLeak;  ///< \brief Normalized amount that should be leaked every second (token bucket leak rate)
+  double m_bucket;      ///< \brief Value representing current size of the Interest allowance for this face (current size of token bucket)
+
+  Time m_leakRandomizationInteral;
+};
+
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // _NDN_LIMITS_RATE_H_
@@ -0,0 +1,254 @@
+/* -*- Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef SMALL_SORTED_SET_H_
+#define SMALL_SORTED_SET_H_
+
+#include <boost/type_traits/aligned_storage.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <stdint.h>
+#include <utility>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+/**
+ * @brief Set container, optimized for a small number of elements
+ *
+ * Elements are kept sorted in a contiguous array.  First InlineCapacity elements are stored
+ * inside the object itself (no heap allocation at all), larger sets are moved to a heap array.
+ * Supports the subset of std::set interface (insert, find, erase, iteration in sorted order),
+ * but unlike std::set, insert and erase invalidate iterators.
+ *
+ * As in std::set, elements are not supposed to be modified through iterators (at least not
+ * the part that is used by Compare).
+ */
+template<class T, size_t InlineCapacity = 1, class Compare = std::less<T> >
+class small_sorted_set
+{
+public:
+  typedef T         key_type;
+  typedef T         value_type;
+  typedef const T&  reference;
+  typedef const T&  const_reference;
+  typedef const T*  iterator;
+  typedef const T*  const_iterator;
+  typedef size_t    size_type;
+  typedef ptrdiff_t difference_type;
+
+  small_sorted_set ()
+    : m_data (inlineData ())
+    , m_size (0)
+    , m_capacity (InlineCapacity)
+  {
+  }
+
+  small_sorted_set (const small_sorted_set &other)
+    : m_data (inlineData ())
+    , m_size (0)
+    , m_capacity (InlineCapacity)
+  {
+    assign (other);
+  }
+
+  ~small_sorted_set ()
+  {
+    clear ();
+  }
+
+  small_sorted_set &
+  operator = (const small_sorted_set &other)
+  {
+    if (this != &other)
+      {
+        clear ();
+        assign (other);
+      }
+    return *this;
+  }
+
+  iterator begin () const { return m_data; }
+  iterator end () const { return m_data + m_size; }
+  size_type size () const { return m_size; }
+  bool empty () const { return m_size == 0; }
+
+  /**
+   * @brief Find element equivalent to key
+   * @returns iterator to the element or end ()
+   */
+  iterator
+  find (const key_type &key) const
+  {
+    iterator item = std::lower_bound (begin (), end (), key, Compare ());
+    if (item != end () && !Compare () (key, *item))
+      return item;
+    else
+      return end ();
+  }
+
+  size_type
+  count (const key_type &key) const
+  {
+    return find (key) != end () ? 1 : 0;
+  }
+
+  /**
+   * @brief Insert element, if equivalent element does not exist yet
+   * @returns the same as std::set::insert: iterator to the new or existing element and
+   *          flag whether element was inserted
+   */
+  std::pair<iterator, bool>
+  insert (const value_type &value)
+  {
+    iterator item = std::lower_bound (begin (), end (), value, Compare ());
+    if (item != end () && !Compare () (value, *item))
+      return std::make_pair (item, false);
+
+    size_type pos = item - begin ();
+    T copy (value); // value may reference an element of this container
+    if (m_size == m_capacity)
+      grow ();
+    return std::make_pair (insertAt (pos, copy), true);
+  }
+
+  /**
+   * @brief Erase element pointed by the iterator
+   * @returns iterator to the element following the erased one
+   */
+  iterator
+  erase (iterator item)
+  {
+    size_type pos = item - begin ();
+    for (size_type i = pos; i + 1 < m_size; i++)
+      m_data [i] = m_data [i + 1];
+
+    m_data [m_size - 1].~T ();
+    m_size --;
+    return begin () + pos;
+  }
+
+  /**
+   * @brief Erase element equivalent to key
+   * @returns number of erased elements (0 or 1)
+   */
+  size_type
+  erase (const key_type &key)
+  {
+    iterator item = find (key);
+    if (item == end ())
+      return 0;
+
+    erase (item);
+    return 1;
+  }
+
+  /**
+   * @brief Remove all elements and release heap storage (if any)
+   */
+  void
+  clear ()
+  {
+    for (size_type i = 0; i < m_size; i++)
+      m_data [i].~T ();
+    m_size = 0;
+
+    if (m_data != inlineData ())
+      {
+        ::operator delete (m_data);
+        m_data = inlineData ();
+        m_capacity = InlineCapacity;
+      }
+  }
+
+private:
+  T *
+  inlineData ()
+  {
+    return reinterpret_cast<T*> (&m_inline);
+  }
+
+  void
+  assign (const small_sorted_set &other)
+  {
+    reserve (other.m_size);
+    std::uninitialized_copy (other.begin (), other.end (), m_data);
+    m_size = other.m_size;
+  }
+
+  void
+  grow ()
+  {
+    reserve (m_capacity * 2);
+  }
+
+  void
+  reserve (size_type capacity)
+  {
+    if (capacity <= m_capacity)
+      return;
+
+    T *data = static_cast<T*> (::operator new (capacity * sizeof (T)));
+    std::uninitialized_copy (begin (), end (), data);
+    for (size_type i = 0; i < m_size; i++)
+      m_data [i].~T ();
+
+    if (m_data != inlineData ())
+      ::operator delete (m_data);
+
+    m_data = data;
+    m_capacity = capacity;
+  }
+
+  iterator
+  insertAt (size_type pos, const value_type &value)
+  {
+    if (pos == m_size)
+      {
+        new (m_data + m_size) T (value);
+      }
+    else
+      {
+        new (m_data + m_size) T (m_data [m_size - 1]);
+        for (size_type i = m_size - 1; i > pos; i--)
+          m_data [i] = m_data [i - 1];
+        m_data [pos] = value;
+      }
+    m_size ++;
+    return begin () + pos;
+  }
+
+private:
+  typename boost::aligned_storage<sizeof (T) * InlineCapacity, boost::alignment_of<T>::value>::type m_inline;
+
+  T *m_data;
+  uint32_t m_size;
+  uint32_t m_capacity;
+};
+
+} // namespace ndnSIM
+} // namespace ndn
+} // namespace ns3
+
+#endif // SMALL_SORTED_SET_H_
@@ -0,0 +1,301 @@
+/* -*- Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _TIMER_WHEEL_H_
+#define _TIMER_WHEEL_H_
+
+#include <boost/intrusive/list.hpp>
+#include <boost/scoped_array.hpp>
+#include <algorithm>
+#include <limits>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @brief Hook that needs to be a member of every item stored in TimerWheel
+ */
+struct TimerWheelHook : public boost::intrusive::list_member_hook< boost::intrusive::link_mode<boost::intrusive::auto_unlink> >
+{
+  uint64_t tick; ///< @brief absolute tick at which item is due
+};
+
+/**
+ * @brief Hierarchical timing wheel for intrusively hooked items
+ *
+ * Time is measured in abstract integer ticks (conversion to simulation time is done by the user).
+ * Items are kept in Levels levels of 256 slots each: level 0 covers next 256 ticks with one slot per tick,
+ * level 1 covers next 256*256 ticks with one slot per 256 ticks, etc.  Items from higher levels are
+ * cascaded to the lower levels when the lower level wraps around.  Insertion and removal are O(1),
+ * and processing of one tick costs O(1) plus the number of items that are due or cascaded.
+ *
+ * Items are never reported before their due tick, but ticks before the current position
+ * of the wheel are rounded up to the current position.
+ *
+ * Slots are allocated on the first insertion, so wheels that are never used (e.g., PITs of
+ * nodes that do not see any Interests) cost only a few words of memory.
+ */
+template<class Item, TimerWheelHook Item::*Hook, int Levels = 4>
+class TimerWheel
+{
+public:
+  typedef boost::intrusive::list< Item,
+                                  boost::intrusive::member_hook< Item, TimerWheelHook, Hook >,
+                                  boost::intrusive::constant_time_size<false> > list_type;
+
+  /// @brief Value returned by Next () when the wheel is empty
+  static const uint64_t npos = static_cast<uint64_t> (-1);
+
+  TimerWheel ()
+    : m_next (0)
+    , m_size (0)
+  {
+    std::fill (m_occupied, m_occupied + Words, 0);
+  }
+
+  ~TimerWheel ()
+  {
+    clear ();
+  }
+
+  /**
+   * @brief Number of items in the wheel (including items that are due, but not yet popped out)
+   */
+  size_t
+  size () const
+  {
+    return m_size;
+  }
+
+  bool
+  empty () const
+  {
+    return m_size == 0;
+  }
+
+  /**
+   * @brief Reset current position of the empty wheel
+   *
+   * Should be called before inserting items to the empty wheel, otherwise wheel will have to
+   * process all ticks between the old and new position
+   */
+  void
+  reset (uint64_t tick)
+  {
+    if (empty ())
+      m_next = tick;
+  }
+
+  /**
+   * @brief Add item to the wheel
+   * @param item item to add (should not be already in the wheel)
+   * @param tick absolute tick at which item is due
+   */
+  void
+  insert (Item &item, uint64_t tick)
+  {
+    if (!m_slots)
+      m_slots.reset (new list_type [Levels * Slots]);
+
+    m_size ++;
+    place (item, tick);
+  }
+
+  /**
+   * @brief Remove item from the wheel (no-op if item is not in the wheel)
+   */
+  void
+  erase (Item &item)
+  {
+    if (!(item.*Hook).is_linked ())
+      return;
+
+    (item.*Hook).unlink ();
+    m_size --;
+  }
+
+  /**
+   * @brief Remove all items from the wheel
+   */
+  void
+  clear ()
+  {
+    if (m_slots)
+      {
+        for (int i = 0; i < Levels * Slots; i++)
+          m_slots [i].clear ();
+      }
+    std::fill (m_occupied, m_occupied + Words, 0);
+    m_due.clear ();
+    m_size = 0;
+  }
+
+  /**
+   * @brief Get the next tick that needs to be processed by Expire
+   *
+   * This is either the first non-empty slot of the level 0 before level 0 wraps around,
+   * or the position when level 0 wraps around (cascade from the higher levels is necessary).
+   * Non-empty slots of level 0 are found using the occupancy bitmap, one 64-bit word at a time.
+   *
+   * @returns next tick or npos if wheel is empty
+   */
+  uint64_t
+  next () const
+  {
+    if (empty ())
+      return npos;
+
+    // level 0 wraps around at m_next: items cascaded from the higher levels can be due earlier
+    // than the items already in level 0
+    if (!m_due.empty () || (m_next & Mask) == 0)
+      return m_next;
+
+    uint64_t index = m_next & Mask;
+    while (index < static_cast<uint64_t> (Slots))
+      {
+        uint64_t word = m_occupied[index / 64] & (~static_cast<uint64_t> (0) << (index % 64));
+        if (word == 0)
+          {
+            index = (index | 63) + 1;
+            continue;
+          }
+
+        index = (index & ~static_cast<uint64_t> (63)) + __builtin_ctzll (word);
+        if (!slot (0, index).empty ())
+          return (m_next & ~Mask) + index;
+
+        // all items of the slot have been erased
+        m_occupied[index / 64] &= ~(static_cast<uint64_t> (1) << (index % 64));
+        index++;
+      }
+    return (m_next | Mask) + 1;
+  }
+
+  /**
+   * @brief Advance wheel position up to and including tick and make all items with due ticks available via Pop
+   */
+  void
+  expire (uint64_t tick)
+  {
+    if (empty ())
+      {
+        if (m_next <= tick)
+          m_next = tick + 1;
+        return;
+      }
+
+    for (; m_next <= tick; m_next++)
+      {
+        if ((m_next & Mask) == 0)
+          cascade ();
+
+        m_due.splice (m_due.end (), slot (0, m_next & Mask));
+        m_occupied[(m_next & Mask) / 64] &= ~(static_cast<uint64_t> (1) << (m_next % 64));
+      }
+  }
+
+  /**
+   * @brief Remove and return the next item that is due (after Expire call)
+   * @returns pointer to item or 0 if there are no more items that are due
+   */
+  Item *
+  pop ()
+  {
+    if (m_due.empty ())
+      return 0;
+
+    Item &item = m_due.front ();
+    m_due.pop_front ();
+    m_size --;
+    return &item;
+  }
+
+private:
+  list_type &
+  slot (int level, uint64_t index) const
+  {
+    return m_slots [level * Slots + index];
+  }
+
+  void
+  place (Item &item, uint64_t tick)
+  {
+    if (tick < m_next)
+      tick = m_next;
+
+    (item.*Hook).tick = tick;
+
+    uint64_t delta = tick - m_next;
+    for (int level = 0; level < Levels; level++)
+      {
+        uint64_t range = static_cast<uint64_t> (1) << (Bits * (level + 1));
+        if (delta < range)
+          {
+            uint64_t index = (tick >> (Bits * level)) & Mask;
+            slot (level, index).push_back (item);
+            if (level == 0)
+              m_occupied[index / 64] |= static_cast<uint64_t> (1) << (index % 64);
+            return;
+          }
+      }
+
+    // too far in the future, park in the last slot of the top level (will be re-placed during cascade)
+    uint64_t parked = m_next + (static_cast<uint64_t> (1) << (Bits * Levels)) - 1;
+    slot (Levels-1, (parked >> (Bits * (Levels-1))) & Mask).push_back (item);
+  }
+
+  void
+  cascade ()
+  {
+    for (int level = 1; level < Levels; level++)
+      {
+        list_type items;
+        items.splice (items.end (), slot (level, (m_next >> (Bits * level)) & Mask));
+        while (!items.empty ())
+          {
+            Item &item = items.front ();
+            items.pop_front ();
+            place (item, (item.*Hook).tick);
+          }
+
+        if (((m_next >> (Bits * level)) & Mask) != 0)
+          break; // higher levels do not wrap around yet
+      }
+  }
+
+private:
+  static const int Bits = 8;
+  static const int Slots = 1 << Bits;
+  static const uint64_t Mask = Slots - 1;
+  static const int Words = Slots / 64;
+
+  boost::scoped_array<list_type> m_slots; ///< @brief Levels x Slots lists (allocated on the first insertion)
+  list_type m_due;
+
+  // bit is set when an item is placed into the level 0 slot and cleared when the slot is expired
+  // or found empty (items can be erased without the wheel knowing their slot)
+  mutable uint64_t m_occupied[Words];
+
+  uint64_t m_next; ///< @brief next tick to be processed
+  size_t m_size;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // _TIMER_WHEEL_H_
@@ -0,0 +1,233 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef BINARY_TRACE_WRITER_H
+#define BINARY_TRACE_WRITER_H
+
+#include "ns3/assert.h"
+
+#include <boost/shared_ptr.hpp>
+#include <boost/unordered_map.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Buffered writer of binary columnar trace files
+ *
+ * File starts with the schema (list of column names and types), followed by fixed-width
+ * records and string dictionary entries.  Strings (node names, record types, face descriptions)
+ * are written only once and records refer to them by numeric ID, so writing a record is just
+ * copying a few values into the write buffer.  All values are in the host byte order.
+ *
+ * Files can be converted to the same tab-separated format that is produced by the text tracers
+ * using ConvertToTsv or ``ndn-trace-to-tsv`` tool.
+ *
+ * Tracers switch to binary output when trace file name ends with ".bin"
+ */
+class BinaryTraceWriter
+{
+public:
+  /**
+   * @brief Type of the column
+   */
+  enum ColumnType
+    {
+      DOUBLE = 0, ///< 8-byte double
+      INT32  = 1, ///< 4-byte signed integer
+      UINT32 = 2, ///< 4-byte unsigned integer
+      STRING = 3, ///< 4-byte ID of the string (see Intern)
+      UINT64 = 4  ///< 8-byte unsigned integer
+    };
+
+  /**
+   * @brief Open trace file for writing
+   * @param file name of the file
+   * @param bufferSize size of the write buffer
+   * @returns writer or empty pointer, if file cannot be opened
+   */
+  static boost::shared_ptr<BinaryTraceWriter>
+  Open (const std::string &file, size_t bufferSize = 1024 * 1024);
+
+  /**
+   * @brief Open output of a tracer: binary trace if file name ends with ".bin", standard output
+   * if file is "-", or text file otherwise
+   *
+   * @param file name of the file
+   * @param os [out] text output stream (empty pointer for binary traces)
+   * @param writer [out] binary trace writer (empty pointer for text traces)
+   * @returns false if file cannot be opened
+   */
+  static bool
+  OpenTrace (const std::string &file,
+             boost::shared_ptr<std::ostream> &os, boost::shared_ptr<BinaryTraceWriter> &writer);
+
+  /**
+   * @brief Check if tracers should use binary format for the file (i.e., file name ends with ".bin")
+   */
+  static bool
+  IsBinaryFile (const std::string &file);
+
+  /**
+   * @brief Convert binary trace to tab-separated text
+   * @returns false if input is not a valid binary trace
+   */
+  static bool
+  ConvertToTsv (std::istream &is, std::ostream &os);
+
+  /**
+   * @brief Flush the buffer and close the file
+   */
+  ~BinaryTraceWriter ();
+
+  /**
+   * @brief Add column to the schema (all columns should be added before anything is written)
+   */
+  void
+  AddColumn (const std::string &name, ColumnType type);
+
+  /**
+   * @brief Get ID of the string, writing the string into the file if it has not been seen before
+   */
+  uint32_t
+  Intern (const std::string &value);
+
+  /**
+   * @brief Start new record
+   *
+   * After this call, exactly one Put* call should be made for each column of the schema, in order
+   */
+  inline void
+  BeginRecord ();
+
+  inline void
+  PutDouble (double value);
+
+  inline void
+  PutInt32 (int32_t value);
+
+  inline void
+  PutUint32 (uint32_t value);
+
+  inline void
+  PutUint64 (uint64_t value);
+
+  /**
+   * @brief Put ID of the string, returned by Intern
+   */
+  inline void
+  PutString (uint32_t id);
+
+  /**
+   * @brief Write buffered data to the file
+   */
+  void
+  Flush ();
+
+private:
+  BinaryTraceWriter (size_t bufferSize);
+
+  void
+  WriteSchema ();
+
+  inline void
+  Reserve (size_t size);
+
+  inline void
+  Put (const void *value, size_t size);
+
+private:
+  std::ofstream m_os;
+
+  std::vector<char> m_buffer;
+  size_t m_size;
+
+  std::vector<std::pair<std::string, ColumnType> > m_columns;
+  size_t m_recordSize;
+  size_t m_recordEnd; ///< @brief expected value of m_size at the end of the current record
+  bool m_schemaWritten;
+
+  boost::unordered_map<std::string, uint32_t> m_strings;
+};
+
+inline void
+BinaryTraceWriter::Reserve (size_t size)
+{
+  if (m_size + size > m_buffer.size ())
+    Flush ();
+}
+
+inline void
+BinaryTraceWriter::Put (const void *value, size_t size)
+{
+  NS_ASSERT_MSG (m_size + size <= m_recordEnd, "Record does not match the schema");
+  std::memcpy (&m_buffer[m_size], value, size);
+  m_size += size;
+}
+
+inline void
+BinaryTraceWriter::BeginRecord ()
+{
+  NS_ASSERT_MSG (m_size == m_recordEnd, "Previous record does not match the schema");
+  if (!m_schemaWritten)
+    WriteSchema ();
+
+  Reserve (1 + m_recordSize);
+  m_buffer[m_size ++] = 'R';
+  m_recordEnd = m_size + m_recordSize;
+}
+
+inline void
+BinaryTraceWriter::PutDouble (double value)
+{
+  Put (&value, sizeof (value));
+}
+
+inline void
+BinaryTraceWriter::PutInt32 (int32_t value)
+{
+  Put (&value, sizeof (value));
+}
+
+inline void
+BinaryTraceWriter::PutUint32 (uint32_t value)
+{
+  Put (&value, sizeof (value));
+}
+
+inline void
+BinaryTraceWriter::PutUint64 (uint64_t value)
+{
+  Put (&value, sizeof (value));
+}
+
+inline void
+BinaryTraceWriter::PutString (uint32_t id)
+{
+  Put (&id, sizeof (id));
+}
+
+} // namespace ns3
+
+#endif // BINARY_TRACE_WRITER_H
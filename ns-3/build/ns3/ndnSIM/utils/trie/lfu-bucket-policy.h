@@ -0,0 +1,269 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ */
+
+#ifndef LFU_BUCKET_POLICY_H_
+#define LFU_BUCKET_POLICY_H_
+
+#include <boost/intrusive/options.hpp>
+#include <boost/intrusive/list.hpp>
+#include <boost/unordered_map.hpp>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+/**
+ * @brief Traits for LFU replacement policy with constant time updates
+ *
+ * All entries are kept in a single list ordered by access frequency (entries with the same
+ * frequency are ordered by the time they reached this frequency), which is exactly the order
+ * of lfu_policy_traits.  Additionally, the last entry of every frequency bucket is remembered,
+ * so an entry moves to the next bucket with a single splice instead of O(log n) erase and
+ * reinsert into the multiset.
+ *
+ * To let the cache adapt to changes of popularity, frequencies age: after every aging period
+ * (by default, AgingFactor times the maximum size of the cache) insertions and hits, all
+ * frequencies are halved.  Halving keeps the order of the list, so only the bucket tails are
+ * recalculated, which costs O(n) once per period, i.e., O(1) amortized per operation.  With
+ * aging disabled (set_aging_period (0)), the order is exactly the order of lfu_policy_traits.
+ */
+struct lfu_bucket_policy_traits
+{
+  /// @brief Name that can be used to identify the policy (for NS-3 object model and logging)
+  static std::string GetName () { return "BucketLfu"; }
+
+  struct policy_hook_type : public boost::intrusive::list_member_hook<> { uint32_t frequency; };
+
+  template<class Container>
+  struct container_hook
+  {
+    typedef boost::intrusive::member_hook< Container,
+                                           policy_hook_type,
+                                           &Container::policy_hook_ > type;
+  };
+
+  template<class Base,
+           class Container,
+           class Hook>
+  struct policy
+  {
+    static uint32_t& get_order (typename Container::iterator item)
+    {
+      return static_cast<policy_hook_type*>
+        (policy_container::value_traits::to_node_ptr(*item))->frequency;
+    }
+
+    static const uint32_t& get_order (typename Container::const_iterator item)
+    {
+      return static_cast<const policy_hook_type*>
+        (policy_container::value_traits::to_node_ptr(*item))->frequency;
+    }
+
+    typedef boost::intrusive::list< Container, Hook > policy_container;
+
+    // could be just typedef
+    class type : public policy_container
+    {
+    public:
+      typedef policy policy_base; // to get access to get_order methods from outside
+      typedef Container parent_trie;
+
+      /// @brief Default aging period, relative to the maximum size of the cache
+      static const size_t AgingFactor = 8;
+
+      type (Base &base)
+        : base_ (base)
+        , max_size_ (100)
+        , aging_period_ (AgingFactor * 100)
+        , aging_period_set_ (false)
+        , operations_ (0)
+      {
+      }
+
+      inline void
+      update (typename parent_trie::iterator item)
+      {
+        increment (item);
+      }
+
+      inline bool
+      insert (typename parent_trie::iterator item)
+      {
+        count_operation ();
+        get_order (item) = 0;
+
+        if (max_size_ != 0 && policy_container::size () >= max_size_)
+          {
+            // this erases the "least frequently used item" from cache
+            base_.erase (&(*policy_container::begin ()));
+          }
+
+        // zero-frequency bucket is always at the beginning of the list
+        typename tails::iterator tail = tails_.find (0);
+        if (tail != tails_.end ())
+          policy_container::insert (++policy_container::s_iterator_to (*tail->second), *item);
+        else
+          policy_container::push_front (*item);
+
+        tails_[0] = &(*item);
+        return true;
+      }
+
+      inline void
+      lookup (typename parent_trie::iterator item)
+      {
+        increment (item);
+      }
+
+      inline void
+      erase (typename parent_trie::iterator item)
+      {
+        unlink_from_bucket (item);
+        policy_container::erase (policy_container::s_iterator_to (*item));
+      }
+
+      inline void
+      clear ()
+      {
+        policy_container::clear ();
+        tails_.clear ();
+        operations_ = 0;
+      }
+
+      inline void
+      set_max_size (size_t max_size)
+      {
+        max_size_ = max_size;
+        if (!aging_period_set_)
+          aging_period_ = AgingFactor * max_size;
+      }
+
+      inline size_t
+      get_max_size () const
+      {
+        return max_size_;
+      }
+
+      /**
+       * @brief Set number of insertions and hits after which all frequencies are halved (0 disables aging)
+       */
+      inline void
+      set_aging_period (size_t period)
+      {
+        aging_period_ = period;
+        aging_period_set_ = true;
+      }
+
+      inline size_t
+      get_aging_period () const
+      {
+        return aging_period_;
+      }
+
+    private:
+      type () : base_(*((Base*)0)) { };
+
+      /**
+       * @brief Move entry to the end of the next frequency bucket
+       */
+      inline void
+      increment (typename parent_trie::iterator item)
+      {
+        count_operation ();
+        uint32_t frequency = get_order (item);
+
+        // entry is placed after the last entry of the next bucket or, if there is no such bucket
+        // yet, after the last entry of the current one
+        typename tails::iterator next = tails_.find (frequency + 1);
+        parent_trie *position = (next != tails_.end ()) ? next->second : tails_[frequency];
+
+        unlink_from_bucket (item);
+        if (position != &(*item))
+          {
+            typename policy_container::iterator where = policy_container::s_iterator_to (*position);
+            policy_container::splice (++where, *this, policy_container::s_iterator_to (*item));
+          }
+
+        get_order (item) = frequency + 1;
+        tails_[frequency + 1] = &(*item);
+      }
+
+      /**
+       * @brief Update the bucket tail if entry is the last one in its bucket
+       */
+      inline void
+      unlink_from_bucket (typename parent_trie::iterator item)
+      {
+        uint32_t frequency = get_order (item);
+        typename tails::iterator tail = tails_.find (frequency);
+        if (tail->second != &(*item))
+          return;
+
+        typename policy_container::iterator prev = policy_container::s_iterator_to (*item);
+        if (prev != policy_container::begin () && get_order (&(*--prev)) == frequency)
+          tail->second = &(*prev);
+        else
+          tails_.erase (tail);
+      }
+
+      inline void
+      count_operation ()
+      {
+        if (aging_period_ == 0 || ++operations_ < aging_period_)
+          return;
+
+        operations_ = 0;
+        age ();
+      }
+
+      /**
+       * @brief Halve all frequencies (the list stays ordered, tail of every bucket is recalculated)
+       */
+      void
+      age ()
+      {
+        tails_.clear ();
+        for (typename policy_container::iterator entry = policy_container::begin ();
+             entry != policy_container::end ();
+             entry++)
+          {
+            uint32_t &frequency = get_order (&(*entry));
+            frequency /= 2;
+            tails_[frequency] = &(*entry);
+          }
+      }
+
+    private:
+      Base &base_;
+      size_t max_size_;
+      size_t aging_period_;
+      bool aging_period_set_;
+      size_t operations_; ///< @brief insertions and hits since the last aging
+
+      typedef boost::unordered_map<uint32_t, parent_trie*> tails;
+      tails tails_; ///< @brief frequency -> last entry with this frequency
+    };
+  };
+};
+
+} // ndnSIM
+} // ndn
+} // ns3
+
+#endif // LFU_BUCKET_POLICY_H
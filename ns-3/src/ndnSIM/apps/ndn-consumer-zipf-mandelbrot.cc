@@ -28,6 +28,8 @@
 
 #include <math.h>
 
+#include <algorithm>
+
 
 NS_LOG_COMPONENT_DEFINE ("ndn.ConsumerZipfMandelbrot");
 
@@ -44,6 +46,12 @@ ConsumerZipfMandelbrot::GetTypeId (void)
     .SetParent<ConsumerCbr> ()
     .AddConstructor<ConsumerZipfMandelbrot> ()
 
+    // should be before NumberOfContents, so no table is built for rejection sampling
+    .AddAttribute ("Sampling", "Content index sampling method: cdf (default), alias, rejection",
+                   StringValue ("cdf"),
+                   MakeStringAccessor (&ConsumerZipfMandelbrot::SetSampling, &ConsumerZipfMandelbrot::GetSampling),
+                   MakeStringChecker ())
+
     .AddAttribute ("NumberOfContents", "Number of the Contents in total",
                    StringValue ("100"),
                    MakeUintegerAccessor (&ConsumerZipfMandelbrot::SetNumberOfContents, &ConsumerZipfMandelbrot::GetNumberOfContents),
@@ -68,6 +76,8 @@ ConsumerZipfMandelbrot::ConsumerZipfMandelbrot()
   : m_N (100) // needed here to make sure when SetQ/SetS are called, there is a valid value of N
   , m_q (0.7)
   , m_s (0.7)
+  , m_sampling (SAMPLING_CDF)
+  , m_samplerReady (false)
   , m_SeqRng (0.0, 1.0)
 {
   // SetNumberOfContents is called by NS-3 object system during the initialization
@@ -81,9 +91,27 @@ void
 ConsumerZipfMandelbrot::SetNumberOfContents (uint32_t numOfContents)
 {
   m_N = numOfContents;
+  m_samplerReady = false;
+}
 
+void
+ConsumerZipfMandelbrot::PrepareSampler ()
+{
   NS_LOG_DEBUG (m_q << " and " << m_s << " and " << m_N);
 
+  m_Pcum.clear ();
+  m_aliasProb.clear ();
+  m_alias.clear ();
+
+  if (m_sampling == SAMPLING_REJECTION)
+    {
+      m_hIntegralX1 = HIntegral (1.5) - H (1.0);
+      m_hIntegralN = HIntegral (m_N + 0.5);
+      m_squeeze = 2.0 - HIntegralInverse (HIntegral (2.5) - H (2.0));
+      m_samplerReady = true;
+      return;
+    }
+
   m_Pcum = std::vector<double> (m_N + 1);
 
   m_Pcum[0] = 0.0;
@@ -97,6 +125,50 @@ ConsumerZipfMandelbrot::SetNumberOfContents (uint32_t numOfContents)
       m_Pcum[i] = m_Pcum[i] / m_Pcum[m_N];
       NS_LOG_LOGIC ("Cumulative probability [" << i << "]=" << m_Pcum[i]);
   }
+
+  if (m_sampling == SAMPLING_ALIAS && m_N > 0)
+    {
+      // Vose's method: columns with probability below the average get the excess of larger ones
+      m_aliasProb.resize (m_N);
+      m_alias.resize (m_N);
+
+      std::vector<uint32_t> small, large;
+      for (uint32_t i = 0; i < m_N; i++)
+        {
+          m_aliasProb[i] = (m_Pcum[i+1] - m_Pcum[i]) * m_N;
+          m_alias[i] = i;
+          if (m_aliasProb[i] < 1.0)
+            small.push_back (i);
+          else
+            large.push_back (i);
+        }
+
+      while (!small.empty () && !large.empty ())
+        {
+          uint32_t less = small.back ();
+          small.pop_back ();
+          uint32_t more = large.back ();
+
+          m_alias[less] = more;
+          m_aliasProb[more] -= 1.0 - m_aliasProb[less];
+          if (m_aliasProb[more] < 1.0)
+            {
+              large.pop_back ();
+              small.push_back (more);
+            }
+        }
+
+      // leftovers are due to rounding errors
+      for (std::vector<uint32_t>::iterator i = small.begin (); i != small.end (); i++)
+        m_aliasProb[*i] = 1.0;
+      for (std::vector<uint32_t>::iterator i = large.begin (); i != large.end (); i++)
+        m_aliasProb[*i] = 1.0;
+
+      // cumulative probabilities are not needed anymore
+      std::vector<double> ().swap (m_Pcum);
+    }
+
+  m_samplerReady = true;
 }
 
 uint32_t
@@ -109,7 +181,7 @@ void
 ConsumerZipfMandelbrot::SetQ (double q)
 {
   m_q = q;
-  SetNumberOfContents (m_N);
+  m_samplerReady = false;
 }
 
 double
@@ -122,7 +194,7 @@ void
 ConsumerZipfMandelbrot::SetS (double s)
 {
   m_s = s;
-  SetNumberOfContents (m_N);
+  m_samplerReady = false;
 }
 
 double
@@ -131,6 +203,35 @@ ConsumerZipfMandelbrot::GetS () const
   return m_s;
 }
 
+void
+ConsumerZipfMandelbrot::SetSampling (const std::string &sampling)
+{
+  if (sampling == "alias")
+    m_sampling = SAMPLING_ALIAS;
+  else if (sampling == "rejection")
+    m_sampling = SAMPLING_REJECTION;
+  else if (sampling == "cdf")
+    m_sampling = SAMPLING_CDF;
+  else
+    NS_FATAL_ERROR ("Unknown sampling method [" << sampling << "]. Should be one of cdf, alias, or rejection");
+
+  m_samplerReady = false;
+}
+
+std::string
+ConsumerZipfMandelbrot::GetSampling () const
+{
+  switch (m_sampling)
+    {
+    case SAMPLING_ALIAS:
+      return "alias";
+    case SAMPLING_REJECTION:
+      return "rejection";
+    default:
+      return "cdf";
+    }
+}
+
 void
 ConsumerZipfMandelbrot::SendPacket() {
   if (!m_active) return;
@@ -185,17 +286,7 @@ ConsumerZipfMandelbrot::SendPacket() {
 
   // NS_LOG_INFO ("Requesting Interest: \n" << *interest);
   NS_LOG_INFO ("> Interest for " << seq<<", Total: "<<m_seq<<", face: "<<m_face->GetId());
-  NS_LOG_DEBUG ("Trying to add " << seq << " with " << Simulator::Now () << ". already " << m_seqTimeouts.size () << " items");
-
-  m_seqTimeouts.insert (SeqTimeout (seq, Simulator::Now ()));
-  m_seqFullDelay.insert (SeqTimeout (seq, Simulator::Now ()));
-
-  m_seqLastDelay.erase (seq);
-  m_seqLastDelay.insert (SeqTimeout (seq, Simulator::Now ()));
-
-  m_seqRetxCounts[seq] ++;
-
-  m_rtt->SentSeq (SequenceNumber32 (seq), 1);
+  WillSendOutInterest (seq);
 
   FwHopCountTag hopCountTag;
   interest->GetPayload ()->AddPacketTag (hopCountTag);
@@ -210,8 +301,15 @@ ConsumerZipfMandelbrot::SendPacket() {
 uint32_t
 ConsumerZipfMandelbrot::GetNextSeq()
 {
+  if (!m_samplerReady)
+    PrepareSampler ();
+
+  if (m_sampling == SAMPLING_ALIAS)
+    return GetNextSeqAlias ();
+  else if (m_sampling == SAMPLING_REJECTION)
+    return GetNextSeqRejection ();
+
   uint32_t content_index = 1; //[1, m_N]
-  double p_sum = 0;
 
   double p_random = m_SeqRng.GetValue();
   while (p_random == 0)
@@ -220,20 +318,89 @@ ConsumerZipfMandelbrot::GetNextSeq()
     }
   //if (p_random == 0)
   NS_LOG_LOGIC("p_random="<<p_random);
-  for (uint32_t i=1; i<=m_N; i++)
-    {
-      p_sum = m_Pcum[i];   //m_Pcum[i] = m_Pcum[i-1] + p[i], p[0] = 0;   e.g.: p_cum[1] = p[1], p_cum[2] = p[1] + p[2]
-      if (p_random <= p_sum)
-        {
-          content_index = i;
-          break;
-        } //if
-    } //for
-  //content_index = 1;
+
+  // first i such that p_random <= m_Pcum[i], m_Pcum[i] = m_Pcum[i-1] + p[i], p[0] = 0
+  std::vector<double>::const_iterator item = std::lower_bound (m_Pcum.begin () + 1, m_Pcum.end (), p_random);
+  if (item != m_Pcum.end ())
+    content_index = item - m_Pcum.begin ();
+
+  NS_LOG_DEBUG("RandomNumber="<<content_index);
+  return content_index;
+}
+
+uint32_t
+ConsumerZipfMandelbrot::GetNextSeqAlias ()
+{
+  if (m_N == 0)
+    return 1;
+
+  double p_random = m_SeqRng.GetValue () * m_N;
+  uint32_t column = std::min (static_cast<uint32_t> (p_random), m_N - 1);
+
+  uint32_t content_index = 1 + ((p_random - column < m_aliasProb[column]) ? column : m_alias[column]);
   NS_LOG_DEBUG("RandomNumber="<<content_index);
   return content_index;
 }
 
+uint32_t
+ConsumerZipfMandelbrot::GetNextSeqRejection ()
+{
+  // Rejection-inversion sampling of discrete distributions with decreasing probabilities,
+  // W. Hormann and G. Derflinger, ACM TOMACS, 1996
+  while (true)
+    {
+      double u = m_hIntegralN + m_SeqRng.GetValue () * (m_hIntegralX1 - m_hIntegralN);
+      double x = HIntegralInverse (u);
+
+      double k = std::floor (x + 0.5);
+      if (k < 1)
+        k = 1;
+      else if (k > m_N)
+        k = m_N;
+
+      if (k - x <= m_squeeze || u >= HIntegral (k + 0.5) - H (k))
+        {
+          NS_LOG_DEBUG("RandomNumber="<<k);
+          return static_cast<uint32_t> (k);
+        }
+    }
+}
+
+// log (1 + x) / x, precise for small x
+static double
+Helper1 (double x)
+{
+  return (std::abs (x) > 1e-8) ? log1p (x) / x : 1.0 - x * (0.5 - x * (1.0 / 3.0 - 0.25 * x));
+}
+
+// (exp (x) - 1) / x, precise for small x
+static double
+Helper2 (double x)
+{
+  return (std::abs (x) > 1e-8) ? expm1 (x) / x : 1.0 + x * 0.5 * (1.0 + x * 1.0 / 3.0 * (1.0 + 0.25 * x));
+}
+
+double
+ConsumerZipfMandelbrot::H (double x) const
+{
+  return std::exp (-m_s * std::log (x + m_q));
+}
+
+double
+ConsumerZipfMandelbrot::HIntegral (double x) const
+{
+  // integral of (x + q)^-s, ((x + q)^(1-s) - 1) / (1-s), or log (x + q) if s = 1
+  double logX = std::log (x + m_q);
+  return Helper2 ((1.0 - m_s) * logX) * logX;
+}
+
+double
+ConsumerZipfMandelbrot::HIntegralInverse (double x) const
+{
+  double t = std::max (-1.0, x * (1.0 - m_s));
+  return std::exp (Helper1 (t) * x) - m_q;
+}
+
 void
 ConsumerZipfMandelbrot::ScheduleNextPacket() {
 
@@ -43,6 +43,14 @@ namespace ndn {
  *
  * The class implements an app which requests contents following Zipf-Mandelbrot Distribution
  * Here is the explaination of Zipf-Mandelbrot Distribution: http://en.wikipedia.org/wiki/Zipf%E2%80%93Mandelbrot_law
+ *
+ * Content index can be sampled in one of the following ways (Sampling attribute):
+ * - cdf (default): binary search over the cumulative distribution, O(log N) per Interest, 8 bytes per content
+ * - alias: Walker's alias table, O(1) per Interest, 12 bytes per content
+ * - rejection: rejection-inversion sampling (Hormann and Derflinger), O(1) expected time per
+ *   Interest and no per-content memory, suitable for very large catalogues
+ *
+ * Tables are (re)built on the first request after any of the parameters changes.
  */
 class ConsumerZipfMandelbrot: public ConsumerCbr
 {
@@ -83,12 +91,56 @@ private:
   double
   GetS () const;
 
+  void
+  SetSampling (const std::string &sampling);
+
+  std::string
+  GetSampling () const;
+
+  /**
+   * @brief Build tables for the selected sampling method
+   */
+  void
+  PrepareSampler ();
+
+  uint32_t
+  GetNextSeqAlias ();
+
+  uint32_t
+  GetNextSeqRejection ();
+
+  // helpers for rejection-inversion sampling
+  double
+  H (double x) const;
+
+  double
+  HIntegral (double x) const;
+
+  double
+  HIntegralInverse (double x) const;
+
 private:
+  enum Sampling
+    {
+      SAMPLING_CDF,
+      SAMPLING_ALIAS,
+      SAMPLING_REJECTION
+    };
+
   uint32_t m_N;  //number of the contents
   double m_q;  //q in (k+q)^s
   double m_s;  //s in (k+q)^s
+  Sampling m_sampling;
+  bool m_samplerReady; // false if tables need to be rebuilt
   std::vector<double> m_Pcum;  //cumulative probability
 
+  std::vector<double> m_aliasProb;    // alias table: probability to stay in the column
+  std::vector<uint32_t> m_alias;      // alias table: alternative index for the column
+
+  double m_hIntegralX1;   // rejection-inversion: HIntegral (1.5) - H (1)
+  double m_hIntegralN;    // rejection-inversion: HIntegral (N + 0.5)
+  double m_squeeze;       // rejection-inversion: threshold for the quick acceptance
+
   UniformVariable m_SeqRng; //RNG
 };
 
@@ -87,6 +87,8 @@ Consumer::Consumer ()
   : m_rand (0, std::numeric_limits<uint32_t>::max ())
   , m_seq (0)
   , m_seqMax (0) // don't request anything
+  , m_timeoutStamp (0)
+  , m_pendingTimeouts (0)
 {
   NS_LOG_FUNCTION_NOARGS ();
 
@@ -122,15 +124,28 @@ Consumer::CheckRetxTimeout ()
   Time rto = m_rtt->RetransmitTimeout ();
   // NS_LOG_DEBUG ("Current RTO: " << rto.ToDouble (Time::S) << "s");
 
-  while (!m_seqTimeouts.empty ())
+  // no valid entries: all queued entries are for already satisfied Interests
+  if (m_pendingTimeouts == 0)
+    m_timeoutQueue.clear ();
+
+  // entries are queued in order of send time, so only expired entries (and entries that are no
+  // longer valid) need to be visited
+  while (!m_timeoutQueue.empty ())
     {
-      SeqTimeoutsContainer::index<i_timestamp>::type::iterator entry =
-        m_seqTimeouts.get<i_timestamp> ().begin ();
-      if (entry->time + rto <= now) // timeout expired?
+      SeqTimeout entry = m_timeoutQueue.front ();
+      SeqState *state = m_seqStates.find (entry.seq);
+      if (state == 0 || !state->timeoutPending || state->timeoutStamp != entry.stamp)
         {
-          uint32_t seqNo = entry->seq;
-          m_seqTimeouts.get<i_timestamp> ().erase (entry);
-          OnTimeout (seqNo);
+          m_timeoutQueue.pop_front (); // stale entry
+          continue;
+        }
+
+      if (entry.time + rto <= now) // timeout expired?
+        {
+          m_timeoutQueue.pop_front ();
+          state->timeoutPending = false;
+          m_pendingTimeouts --;
+          OnTimeout (entry.seq);
         }
       else
         break; // nothing else to do. All later packets need not be retransmitted
@@ -243,23 +258,16 @@ Consumer::OnData (Ptr<const Data> data)
       hopCount = hopCountTag.Get ();
     }
 
-  SeqTimeoutsContainer::iterator entry = m_seqLastDelay.find (seq);
-  if (entry != m_seqLastDelay.end ())
+  SeqState *state = m_seqStates.find (seq);
+  if (state != 0)
     {
-      m_lastRetransmittedInterestDataDelay (this, seq, Simulator::Now () - entry->time, hopCount);
-    }
+      m_lastRetransmittedInterestDataDelay (this, seq, Simulator::Now () - state->lastSent, hopCount);
+      m_firstInterestDataDelay (this, seq, Simulator::Now () - state->firstSent, state->retxCount, hopCount);
 
-  entry = m_seqFullDelay.find (seq);
-  if (entry != m_seqFullDelay.end ())
-    {
-      m_firstInterestDataDelay (this, seq, Simulator::Now () - entry->time, m_seqRetxCounts[seq], hopCount);
+      CancelSeqTimeout (seq);
+      m_seqStates.erase (seq);
     }
 
-  m_seqRetxCounts.erase (seq);
-  m_seqFullDelay.erase (seq);
-  m_seqLastDelay.erase (seq);
-
-  m_seqTimeouts.erase (seq);
   m_retxSeqs.erase (seq);
 
   m_rtt->AckSeq (SequenceNumber32 (seq));
@@ -286,7 +294,7 @@ Consumer::OnNack (Ptr<const Interest> interest)
   m_retxSeqs.insert (seq);
   // NS_LOG_INFO ("After: " << m_retxSeqs.size ());
 
-  m_seqTimeouts.erase (seq);
+  CancelSeqTimeout (seq);
 
   m_rtt->IncreaseMultiplier ();             // Double the next RTO ??
   ScheduleNextPacket ();
@@ -305,17 +313,37 @@ Consumer::OnTimeout (uint32_t sequenceNumber)
 }
 
 void
-Consumer::WillSendOutInterest (uint32_t sequenceNumber)
+Consumer::CancelSeqTimeout (uint32_t seq)
 {
-  NS_LOG_DEBUG ("Trying to add " << sequenceNumber << " with " << Simulator::Now () << ". already " << m_seqTimeouts.size () << " items");
-
-  m_seqTimeouts.insert (SeqTimeout (sequenceNumber, Simulator::Now ()));
-  m_seqFullDelay.insert (SeqTimeout (sequenceNumber, Simulator::Now ()));
+  SeqState *state = m_seqStates.find (seq);
+  if (state != 0 && state->timeoutPending)
+    {
+      // entry stays in m_timeoutQueue and will be skipped by CheckRetxTimeout
+      state->timeoutPending = false;
+      m_pendingTimeouts --;
+    }
+}
 
-  m_seqLastDelay.erase (sequenceNumber);
-  m_seqLastDelay.insert (SeqTimeout (sequenceNumber, Simulator::Now ()));
+void
+Consumer::WillSendOutInterest (uint32_t sequenceNumber)
+{
+  NS_LOG_DEBUG ("Trying to add " << sequenceNumber << " with " << Simulator::Now () << ". already " << m_pendingTimeouts << " items");
 
-  m_seqRetxCounts[sequenceNumber] ++;
+  Time now = Simulator::Now ();
+  bool isNew = m_seqStates.find (sequenceNumber) == 0;
+  SeqState &state = m_seqStates.insert (sequenceNumber);
+  if (isNew)
+    state.firstSent = now;
+  state.lastSent = now;
+  state.retxCount ++;
+
+  if (!state.timeoutPending)
+    {
+      state.timeoutPending = true;
+      state.timeoutStamp = ++m_timeoutStamp;
+      m_pendingTimeouts ++;
+      m_timeoutQueue.push_back (SeqTimeout (sequenceNumber, now, state.timeoutStamp));
+    }
 
   m_rtt->SentSeq (SequenceNumber32 (sequenceNumber), 1);
 }
@@ -29,13 +29,10 @@
 #include "ns3/data-rate.h"
 #include "ns3/ndn-rtt-estimator.h"
 
-#include <set>
-#include <map>
+#include "ns3/ndnSIM/utils/seq-ring-map.h"
 
-#include <boost/multi_index_container.hpp>
-#include <boost/multi_index/tag.hpp>
-#include <boost/multi_index/ordered_index.hpp>
-#include <boost/multi_index/member.hpp>
+#include <set>
+#include <deque>
 
 namespace ns3 {
 namespace ndn {
@@ -148,46 +145,43 @@ protected:
   RetxSeqsContainer m_retxSeqs;             ///< \brief ordered set of sequence numbers to be retransmitted
 
   /**
-   * \struct This struct contains a pair of packet sequence number and its timeout
+   * \struct This struct contains bookkeeping for a sequence number that was sent out, but not yet satisfied
+   */
+  struct SeqState
+  {
+    SeqState () : retxCount (0), timeoutStamp (0), timeoutPending (false) { }
+
+    Time firstSent;          ///< \brief time when Interest was sent out for the first time
+    Time lastSent;           ///< \brief time when Interest was sent out for the last time
+    uint32_t retxCount;      ///< \brief number of times Interest was sent out
+    uint32_t timeoutStamp;   ///< \brief stamp of the valid entry in m_timeoutQueue
+    bool timeoutPending;     ///< \brief whether retransmission timeout is being tracked
+  };
+
+  /**
+   * \struct This struct contains an entry of the retransmission timeout queue
    */
   struct SeqTimeout
   {
-    SeqTimeout (uint32_t _seq, Time _time) : seq (_seq), time (_time) { }
+    SeqTimeout (uint32_t _seq, Time _time, uint32_t _stamp) : seq (_seq), time (_time), stamp (_stamp) { }
 
     uint32_t seq;
     Time time;
+    uint32_t stamp;
   };
 /// @endcond
 
-/// @cond include_hidden
-  class i_seq { };
-  class i_timestamp { };
-/// @endcond
-
-/// @cond include_hidden
   /**
-   * \struct This struct contains a multi-index for the set of SeqTimeout structs
+   * @brief Stop tracking the retransmission timeout of the sequence number
    */
-  struct SeqTimeoutsContainer :
-    public boost::multi_index::multi_index_container<
-    SeqTimeout,
-    boost::multi_index::indexed_by<
-      boost::multi_index::ordered_unique<
-        boost::multi_index::tag<i_seq>,
-        boost::multi_index::member<SeqTimeout, uint32_t, &SeqTimeout::seq>
-        >,
-      boost::multi_index::ordered_non_unique<
-        boost::multi_index::tag<i_timestamp>,
-        boost::multi_index::member<SeqTimeout, Time, &SeqTimeout::time>
-        >
-      >
-    > { } ;
-
-  SeqTimeoutsContainer m_seqTimeouts;       ///< \brief multi-index for the set of SeqTimeout structs
-
-  SeqTimeoutsContainer m_seqLastDelay;
-  SeqTimeoutsContainer m_seqFullDelay;
-  std::map<uint32_t, uint32_t> m_seqRetxCounts;
+  void
+  CancelSeqTimeout (uint32_t seq);
+
+/// @cond include_hidden
+  ndnSIM::seq_ring_map<SeqState> m_seqStates; ///< \brief state of pending sequence numbers
+  std::deque<SeqTimeout> m_timeoutQueue;      ///< \brief FIFO of timeout entries (in order of send time)
+  uint32_t m_timeoutStamp;                    ///< \brief last stamp given to timeout entry
+  uint32_t m_pendingTimeouts;                 ///< \brief number of valid entries in m_timeoutQueue (if 0, the queue is cleared without lookups)
 
   TracedCallback<Ptr<App> /* app */, uint32_t /* seqno */,
                  Time /* delay */, int32_t /*hop count*/> m_lastRetransmittedInterestDataDelay;
@@ -0,0 +1,361 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+// ndn-cs-policy-benchmark.cc
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/ndnSIM/utils/trie/trie-with-policy.h"
+#include "ns3/ndnSIM/utils/trie/lru-policy.h"
+#include "ns3/ndnSIM/utils/trie/fifo-policy.h"
+#include "ns3/ndnSIM/utils/trie/lfu-policy.h"
+#include "ns3/ndnSIM/utils/trie/lfu-bucket-policy.h"
+
+#include <boost/lexical_cast.hpp>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * Benchmark of content store replacement policies under ConsumerZipfMandelbrot load:
+ *
+ *   (consumer 0) --+
+ *   (consumer 1) --+-- (cache) ------ (producer)
+ *        ...       |
+ *   (consumer N) --+
+ *
+ * Only the cache node has the content store under test (--cs, --size), other nodes do not cache.
+ * Consumers request --contents (by default 10 * size) different contents with Zipf-Mandelbrot
+ * popularity.  With --scan, the given fraction of Interests of every consumer requests one-time
+ * contents (ConsumerCbr with /scan prefix).  Links are fast enough that Interests are never dropped.
+ *
+ * The first --requests Interests warm up the cache.  For the next --requests Interests, the scenario
+ * reports hit ratio of the cache node and wall-clock time of the simulation, which includes the time
+ * spent in the content store.  To estimate cost of the policy itself, compare with the same run using
+ * ns3::ndn::cs::Nocache.
+ *
+ * With --store-only=1, no network is simulated.  The same Zipf-Mandelbrot requests (without scan
+ * traffic) are replayed directly against one content store: every request is looked up and, on a
+ * miss, its Data is added.  Packets are prepared in advance, so only the content store calls are
+ * timed (trie, replacement policy, and creation and destruction of cache entries).  With
+ * --policy-only=1, the requests are replayed against the trie with the replacement policy of the
+ * content store (Lru, Fifo, Lfu, or BucketLfu) and without any packets, which times the policy
+ * itself plus the name lookups.
+ *
+ * To run:
+ *
+ *     ./waf --run="ndn-cs-policy-benchmark --cs=ns3::ndn::cs::BucketLfu --size=100000"
+ *     ./waf --run="ndn-cs-policy-benchmark --cs=ns3::ndn::cs::BucketLfu --size=100000 --store-only=1"
+ *     ./waf --run="ndn-cs-policy-benchmark --cs=ns3::ndn::cs::BucketLfu --size=100000 --policy-only=1"
+ */
+
+static uint64_t g_hits = 0;
+static uint64_t g_misses = 0;
+static SystemWallClockMs g_clock;
+
+static void
+CacheHit (Ptr<const ndn::Interest>, Ptr<const ndn::Data>)
+{
+  g_hits++;
+}
+
+static void
+CacheMiss (Ptr<const ndn::Interest>)
+{
+  g_misses++;
+}
+
+static void
+ResetCounters ()
+{
+  g_hits = 0;
+  g_misses = 0;
+  g_clock.Start ();
+}
+
+/**
+ * Names requested with Zipf-Mandelbrot popularity (the same distribution as of ConsumerZipfMandelbrot)
+ */
+class ZipfMandelbrotNames
+{
+public:
+  ZipfMandelbrotNames (uint32_t contents, double q, double s)
+    : m_pcum (contents + 1, 0.0)
+  {
+    // cumulative distribution, ranks start from 1
+    for (uint32_t i = 1; i <= contents; i++)
+      m_pcum[i] = m_pcum[i-1] + 1.0 / std::pow (i + q, s);
+
+    m_rand = UniformVariable (0, m_pcum[contents]);
+  }
+
+  Ptr<ndn::Name>
+  Next ()
+  {
+    uint32_t rank = std::lower_bound (m_pcum.begin () + 1, m_pcum.end (), m_rand.GetValue ()) - m_pcum.begin ();
+
+    Ptr<ndn::Name> name = Create<ndn::Name> ("/prefix");
+    name->appendSeqNum (std::min<uint32_t> (rank, m_pcum.size () - 1));
+    return name;
+  }
+
+private:
+  std::vector<double> m_pcum;
+  UniformVariable m_rand;
+};
+
+// ns3::ndn::cs::Nocache has no MaxSize attribute
+static bool
+HasMaxSize (const std::string &cs)
+{
+  TypeId::AttributeInformation info;
+  return TypeId::LookupByName (cs).LookupAttributeByName ("MaxSize", &info);
+}
+
+// requests are prepared in batches, so only content store (or policy) calls are timed
+static const uint32_t batchSize = 10000;
+
+static void
+Report (const std::string &cs, uint32_t size, uint32_t requests, int64_t ms, uint64_t hits, const std::string &what)
+{
+  std::cout << cs << " size " << size << ", " << requests << " requests in " << ms << " ms (" << what << ")";
+  if (requests > 0)
+    std::cout << ", hit ratio " << 1.0 * hits / requests;
+  std::cout << std::endl;
+}
+
+static void
+RunStoreOnly (const std::string &cs, uint32_t size, uint32_t requests, ZipfMandelbrotNames &names)
+{
+  ObjectFactory factory (cs);
+  if (HasMaxSize (cs))
+    factory.Set ("MaxSize", UintegerValue (size));
+  Ptr<ndn::ContentStore> store = factory.Create<ndn::ContentStore> ();
+
+  std::vector< Ptr<ndn::Interest> > interests (batchSize);
+  std::vector< Ptr<ndn::Data> > datas (batchSize);
+
+  SystemWallClockMs clock;
+  for (uint32_t round = 0; round < 2; round++) // warm-up and measurement
+    {
+      uint64_t hits = 0;
+      int64_t ms = 0;
+      for (uint32_t batch = 0; batch < requests; batch += batchSize)
+        {
+          uint32_t count = std::min (batchSize, requests - batch);
+          for (uint32_t i = 0; i < count; i++)
+            {
+              Ptr<ndn::Name> name = names.Next ();
+
+              interests[i] = Create<ndn::Interest> ();
+              interests[i]->SetName (name);
+
+              datas[i] = Create<ndn::Data> (Create<Packet> (1024));
+              datas[i]->SetName (name);
+            }
+
+          clock.Start ();
+          for (uint32_t i = 0; i < count; i++)
+            {
+              if (store->Lookup (interests[i]) != 0)
+                hits++;
+              else
+                store->Add (datas[i]);
+            }
+          ms += clock.End ();
+        }
+
+      if (round > 0)
+        Report (cs, size, requests, ms, hits, "content store only");
+    }
+}
+
+template<class Policy>
+static void
+RunPolicyOnly (const std::string &cs, uint32_t size, uint32_t requests, ZipfMandelbrotNames &names)
+{
+  typedef ndn::ndnSIM::trie_with_policy<ndn::Name,
+                                        ndn::ndnSIM::pointer_payload_traits<uint32_t>,
+                                        Policy> trie;
+  trie cache;
+  cache.getPolicy ().set_max_size (size);
+
+  uint32_t payload = 0;
+  std::vector< Ptr<ndn::Name> > batchNames (batchSize);
+
+  SystemWallClockMs clock;
+  for (uint32_t round = 0; round < 2; round++) // warm-up and measurement
+    {
+      uint64_t hits = 0;
+      int64_t ms = 0;
+      for (uint32_t batch = 0; batch < requests; batch += batchSize)
+        {
+          uint32_t count = std::min (batchSize, requests - batch);
+          for (uint32_t i = 0; i < count; i++)
+            batchNames[i] = names.Next ();
+
+          clock.Start ();
+          for (uint32_t i = 0; i < count; i++)
+            {
+              if (cache.deepest_prefix_match (*batchNames[i]) != cache.end ())
+                hits++;
+              else
+                cache.insert (*batchNames[i], &payload);
+            }
+          ms += clock.End ();
+        }
+
+      if (round > 0)
+        Report (cs, size, requests, ms, hits, "policy and trie only");
+    }
+}
+
+int
+main (int argc, char *argv[])
+{
+  std::string cs = "ns3::ndn::cs::Lfu";
+  uint32_t size = 10000;
+  uint32_t contents = 0;
+  uint32_t requests = 1000000;
+  uint32_t consumers = 4;
+  double frequency = 10000.0;
+  std::string q = "0.7";
+  std::string s = "0.7";
+  double scan = 0.0;
+  bool storeOnly = false;
+  bool policyOnly = false;
+
+  CommandLine cmd;
+  cmd.AddValue ("cs", "Content store implementation", cs);
+  cmd.AddValue ("size", "Maximum number of entries in the content store", size);
+  cmd.AddValue ("contents", "Number of distinct contents (default 10 * size)", contents);
+  cmd.AddValue ("requests", "Number of Interests to measure (the same number is used to warm up the cache)", requests);
+  cmd.AddValue ("consumers", "Number of consumers", consumers);
+  cmd.AddValue ("frequency", "Interests per second of each consumer", frequency);
+  cmd.AddValue ("q", "Zipf-Mandelbrot q parameter", q);
+  cmd.AddValue ("s", "Zipf-Mandelbrot s parameter", s);
+  cmd.AddValue ("scan", "Fraction of Interests for one-time contents (scan traffic)", scan);
+  cmd.AddValue ("store-only", "Replay requests directly against the content store, without network", storeOnly);
+  cmd.AddValue ("policy-only", "Replay requests directly against the trie with replacement policy of the content store", policyOnly);
+  cmd.Parse (argc, argv);
+
+  if (contents == 0)
+    contents = 10 * size;
+
+  if (storeOnly || policyOnly)
+    {
+      ZipfMandelbrotNames names (contents, boost::lexical_cast<double> (q), boost::lexical_cast<double> (s));
+      if (storeOnly)
+        RunStoreOnly (cs, size, requests, names);
+      else if (cs == "ns3::ndn::cs::Lru")
+        RunPolicyOnly<ndn::ndnSIM::lru_policy_traits> (cs, size, requests, names);
+      else if (cs == "ns3::ndn::cs::Fifo")
+        RunPolicyOnly<ndn::ndnSIM::fifo_policy_traits> (cs, size, requests, names);
+      else if (cs == "ns3::ndn::cs::Lfu")
+        RunPolicyOnly<ndn::ndnSIM::lfu_policy_traits> (cs, size, requests, names);
+      else if (cs == "ns3::ndn::cs::BucketLfu")
+        RunPolicyOnly<ndn::ndnSIM::lfu_bucket_policy_traits> (cs, size, requests, names);
+      else
+        std::cerr << "--policy-only supports only Lru, Fifo, Lfu, and BucketLfu content stores" << std::endl;
+
+      Simulator::Destroy ();
+      return 0;
+    }
+
+  Config::SetDefault ("ns3::PointToPointNetDevice::DataRate", StringValue ("100Gbps"));
+  Config::SetDefault ("ns3::PointToPointChannel::Delay", StringValue ("1ms"));
+  Config::SetDefault ("ns3::DropTailQueue::MaxPackets", StringValue ("100000"));
+
+  NodeContainer consumerNodes;
+  consumerNodes.Create (consumers);
+  Ptr<Node> cache = CreateObject<Node> ();
+  Ptr<Node> producer = CreateObject<Node> ();
+
+  PointToPointHelper p2p;
+  for (uint32_t i = 0; i < consumers; i++)
+    p2p.Install (consumerNodes.Get (i), cache);
+  p2p.Install (cache, producer);
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.SetContentStore ("ns3::ndn::cs::Nocache");
+  ndnHelper.Install (consumerNodes);
+  ndnHelper.Install (producer);
+
+  if (HasMaxSize (cs))
+    ndnHelper.SetContentStore (cs, "MaxSize", boost::lexical_cast<std::string> (size));
+  else
+    ndnHelper.SetContentStore (cs);
+  ndnHelper.Install (cache);
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll ();
+
+  std::string prefix = "/prefix";
+
+  ndn::AppHelper consumerHelper ("ns3::ndn::ConsumerZipfMandelbrot");
+  consumerHelper.SetPrefix (prefix);
+  consumerHelper.SetAttribute ("Frequency", DoubleValue (frequency * (1 - scan)));
+  consumerHelper.SetAttribute ("NumberOfContents", UintegerValue (contents));
+  consumerHelper.SetAttribute ("q", StringValue (q));
+  consumerHelper.SetAttribute ("s", StringValue (s));
+  consumerHelper.SetAttribute ("Sampling", StringValue ("alias"));
+  consumerHelper.Install (consumerNodes);
+
+  if (scan > 0)
+    {
+      ndn::AppHelper scanHelper ("ns3::ndn::ConsumerCbr");
+      scanHelper.SetPrefix ("/scan");
+      scanHelper.SetAttribute ("Frequency", DoubleValue (frequency * scan));
+      scanHelper.Install (consumerNodes);
+    }
+
+  ndn::AppHelper producerHelper ("ns3::ndn::Producer");
+  producerHelper.SetPrefix (prefix);
+  producerHelper.SetAttribute ("PayloadSize", StringValue ("1024"));
+  producerHelper.Install (producer);
+  producerHelper.SetPrefix ("/scan");
+  producerHelper.Install (producer);
+
+  ndnGlobalRoutingHelper.AddOrigins (prefix, producer);
+  ndnGlobalRoutingHelper.AddOrigins ("/scan", producer);
+  ndn::GlobalRoutingHelper::CalculateRoutes ();
+
+  Ptr<ndn::ContentStore> store = cache->GetObject<ndn::ContentStore> ();
+  store->TraceConnectWithoutContext ("CacheHits", MakeCallback (CacheHit));
+  store->TraceConnectWithoutContext ("CacheMisses", MakeCallback (CacheMiss));
+
+  Time half = Seconds (requests / (consumers * frequency));
+  Simulator::Schedule (half, ResetCounters);
+  Simulator::Stop (half + half);
+
+  Simulator::Run ();
+  int64_t ms = g_clock.End ();
+
+  uint64_t total = g_hits + g_misses;
+  std::cout << cs << " size " << size << ", " << contents << " contents, "
+            << total << " Interests in " << ms << " ms";
+  if (total > 0)
+    std::cout << ", hit ratio " << 1.0 * g_hits / total;
+  std::cout << std::endl;
+
+  Simulator::Destroy ();
+  return 0;
+}
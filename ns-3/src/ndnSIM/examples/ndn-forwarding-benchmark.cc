@@ -0,0 +1,179 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// ndn-forwarding-benchmark.cc
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include <iostream>
+
+using namespace ns3;
+
+/**
+ * Micro-benchmark that measures how many Interests per second can be processed by the
+ * forwarding strategy of a node with one route (/prefix) that has a single next hop.
+ *
+ * Packets are passed directly to the forwarding strategy and faces discard all outgoing
+ * packets, so only time spent in the forwarding strategy, PIT, FIB, and content store
+ * (ns3::ndn::cs::Nocache by default) is reported.  Every Interest for /prefix/<seq>, where <seq>
+ * cycles through --names distinct values, is followed by the Data packet after --names other
+ * Interests.  The same workload is processed with SingleNextHopFastPath disabled and enabled.
+ *
+ * To run:
+ *
+ *     ./waf --run="ndn-forwarding-benchmark --strategy=ns3::ndn::fw::BestRoute --packets=1000000"
+ */
+
+namespace ns3 {
+
+/**
+ * @brief Face that discards all outgoing packets
+ */
+class BenchmarkFace : public ndn::Face
+{
+public:
+  BenchmarkFace (Ptr<Node> node)
+    : Face (node)
+  {
+  }
+
+  virtual bool
+  SendInterest (Ptr<const ndn::Interest> interest)
+  {
+    return true;
+  }
+
+  virtual bool
+  SendData (Ptr<const ndn::Data> data)
+  {
+    return true;
+  }
+};
+
+}
+
+struct Workload
+{
+  Ptr<ndn::ForwardingStrategy> fw;
+  Ptr<ndn::Face> consumer;
+  Ptr<ndn::Face> producer;
+  std::vector< Ptr<ndn::Interest> > interests;
+  std::vector< Ptr<ndn::Data> > datas;
+  uint32_t packets;
+  int64_t ms;
+};
+
+static void
+Forward (Workload *workload)
+{
+  uint32_t names = workload->interests.size ();
+
+  SystemWallClockMs clock;
+  clock.Start ();
+  for (uint32_t i = 0; i < workload->packets; i++)
+    {
+      if (i >= names)
+        {
+          workload->fw->OnData (workload->producer, workload->datas [i % names]);
+        }
+      workload->interests [i % names]->SetNonce (i);
+      workload->fw->OnInterest (workload->consumer, workload->interests [i % names]);
+    }
+  workload->ms = clock.End ();
+}
+
+static int64_t
+Run (const std::string &strategy, const std::string &cs, bool fastPath, Workload &workload)
+{
+  Ptr<Node> node = CreateObject<Node> ();
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.SetForwardingStrategy (strategy, "SingleNextHopFastPath", fastPath ? "true" : "false");
+  ndnHelper.SetContentStore (cs);
+  ndnHelper.Install (node);
+
+  Ptr<ndn::L3Protocol> ndn = node->GetObject<ndn::L3Protocol> ();
+  workload.consumer = CreateObject<BenchmarkFace> (node);
+  workload.producer = CreateObject<BenchmarkFace> (node);
+  ndn->AddFace (workload.consumer);
+  ndn->AddFace (workload.producer);
+  workload.consumer->SetUp (true);
+  workload.producer->SetUp (true);
+
+  ndnHelper.AddRoute (node, "/prefix", workload.producer, 0);
+
+  workload.fw = node->GetObject<ndn::ForwardingStrategy> ();
+
+  // packets are processed inside the simulation, the same way as in a real scenario
+  Simulator::ScheduleNow (&Forward, &workload);
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  workload.fw = 0;
+  workload.consumer = 0;
+  workload.producer = 0;
+  return workload.ms;
+}
+
+static void
+Report (const std::string &what, uint32_t packets, int64_t ms)
+{
+  std::cout << what << ": " << packets << " Interests in " << ms << " ms";
+  if (ms > 0)
+    std::cout << " (" << static_cast<uint64_t> (packets * 1000.0 / ms) << " Interests/s)";
+  std::cout << std::endl;
+}
+
+int
+main (int argc, char *argv[])
+{
+  std::string strategy = "ns3::ndn::fw::BestRoute";
+  std::string cs = "ns3::ndn::cs::Nocache";
+  uint32_t packets = 1000000;
+  uint32_t names = 1000;
+
+  CommandLine cmd;
+  cmd.AddValue ("strategy", "Forwarding strategy", strategy);
+  cmd.AddValue ("cs", "Content store implementation", cs);
+  cmd.AddValue ("packets", "Number of Interests to forward", packets);
+  cmd.AddValue ("names", "Number of distinct names (i.e., number of pending Interests)", names);
+  cmd.Parse (argc, argv);
+
+  Workload workload;
+  workload.packets = packets;
+  for (uint32_t seq = 0; seq < names; seq++)
+    {
+      Ptr<ndn::Name> name = Create<ndn::Name> ("/prefix");
+      name->appendSeqNum (seq);
+
+      Ptr<ndn::Interest> interest = Create<ndn::Interest> ();
+      interest->SetName (name);
+      interest->SetInterestLifetime (Seconds (2));
+      workload.interests.push_back (interest);
+
+      Ptr<ndn::Data> data = Create<ndn::Data> (Create<Packet> (1024));
+      data->SetName (name);
+      workload.datas.push_back (data);
+    }
+
+  Report ("Default path", packets, Run (strategy, cs, false, workload));
+  Report ("Fast path   ", packets, Run (strategy, cs, true, workload));
+
+  return 0;
+}
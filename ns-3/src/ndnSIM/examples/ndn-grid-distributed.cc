@@ -0,0 +1,124 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+// ndn-grid-distributed.cc
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include <iostream>
+
+#ifdef NS3_MPI
+#include "ns3/mpi-interface.h"
+#endif
+
+using namespace ns3;
+
+/**
+ * This scenario simulates the same grid topology as ndn-grid-topo-plugin, but the simulation
+ * can be distributed between several processes (ns-3 should be configured with --enable-mpi):
+ *
+ *     mpirun -np 2 ./build/src/ndnSIM/examples/ns3-dev-ndn-grid-distributed-debug --distributed=1
+ *
+ * Nodes are assigned to processes (ranks) using ndn::PartitionHelper, so that the number of links
+ * between ranks is minimal.  Every rank installs applications, FIBs, and tracers only on its own
+ * nodes, and writes its own trace file (rate-trace-rank0.txt, rate-trace-rank1.txt, ...).  The
+ * files can be merged into one using ndn-trace-merge tool:
+ *
+ *     ./waf --run="ndn-trace-merge --input=rate-trace.txt --ranks=2 --output=rate-trace-merged.txt"
+ *
+ * Without --distributed, the scenario runs in a single process.
+ */
+
+int
+main (int argc, char *argv[])
+{
+  bool distributed = false;
+  bool nullmsg = false;
+
+  CommandLine cmd;
+  cmd.AddValue ("distributed", "Distribute simulation between MPI processes", distributed);
+  cmd.AddValue ("nullmsg", "Enable the use of null-message synchronization", nullmsg);
+  cmd.Parse (argc, argv);
+
+  if (distributed)
+    {
+#ifdef NS3_MPI
+      GlobalValue::Bind ("SimulatorImplementationType",
+                         StringValue (nullmsg ? "ns3::NullMessageSimulatorImpl" : "ns3::DistributedSimulatorImpl"));
+      MpiInterface::Enable (&argc, &argv);
+#else
+      std::cerr << "Distributed simulation requires ns-3 configured with --enable-mpi" << std::endl;
+      return 1;
+#endif
+    }
+
+  // Nodes are partitioned before links are installed, so links between ranks become remote channels
+  AnnotatedTopologyReader topologyReader ("", 25);
+  topologyReader.SetFileName ("src/ndnSIM/examples/topologies/topo-grid-3x3.txt");
+  topologyReader.SetPartitions (ndn::PartitionHelper::GetSize ());
+  topologyReader.Read ();
+
+  // Install NDN stack on all nodes (global routing needs faces of remote nodes as well)
+  ndn::StackHelper ndnHelper;
+  ndnHelper.SetForwardingStrategy ("ns3::ndn::fw::BestRoute");
+  ndnHelper.InstallAll ();
+
+  // Installing global routing interface on all nodes
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll ();
+
+  // Getting containers for the consumer/producer
+  Ptr<Node> producer = Names::Find<Node> ("Node8");
+  NodeContainer consumerNodes;
+  consumerNodes.Add (Names::Find<Node> ("Node0"));
+
+  // Install NDN applications (only on nodes of the current rank)
+  std::string prefix = "/prefix";
+
+  ndn::AppHelper consumerHelper ("ns3::ndn::ConsumerCbr");
+  consumerHelper.SetPrefix (prefix);
+  consumerHelper.SetAttribute ("Frequency", StringValue ("100")); // 100 interests a second
+  consumerHelper.Install (consumerNodes);
+
+  ndn::AppHelper producerHelper ("ns3::ndn::Producer");
+  producerHelper.SetPrefix (prefix);
+  producerHelper.SetAttribute ("PayloadSize", StringValue("1024"));
+  producerHelper.Install (producer);
+
+  // Add /prefix origins to ndn::GlobalRouter
+  ndnGlobalRoutingHelper.AddOrigins (prefix, producer);
+
+  // Calculate and install FIBs of the current rank's nodes
+  ndn::GlobalRoutingHelper::CalculateRoutes ();
+
+  ndn::L3RateTracer::InstallAll ("rate-trace.txt", Seconds (1.0));
+
+  Simulator::Stop (Seconds (20.0));
+
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+#ifdef NS3_MPI
+  if (distributed)
+    {
+      MpiInterface::Disable ();
+    }
+#endif
+
+  return 0;
+}
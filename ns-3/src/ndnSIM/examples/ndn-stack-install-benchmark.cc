@@ -0,0 +1,144 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// ndn-stack-install-benchmark.cc
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include <fstream>
+#include <iostream>
+#include <unistd.h>
+
+using namespace ns3;
+
+/**
+ * Micro-benchmark that measures time and memory needed to install NDN stack (with default
+ * routes) on a large topology.
+ *
+ * --nodes nodes are connected in a ring, and every node is also connected to --degree/2 next
+ * nodes, so every node has --degree faces.  The stack is installed either on the whole
+ * container at once (state that is the same for all nodes is resolved only once), or node by node
+ * (--per-node=1).  With --pit=1, one PIT entry is created on every node afterwards, which
+ * allocates timing wheels of all PITs (without it, wheels of the nodes that never see
+ * Interests are not allocated).
+ *
+ * Memory is reported as the increase of the resident set size (read from /proc/self/statm, so
+ * it is reported only on Linux).
+ *
+ * To run:
+ *
+ *     ./waf --run="ndn-stack-install-benchmark --nodes=10000 --degree=10"
+ *     ./waf --run="ndn-stack-install-benchmark --nodes=10000 --degree=10 --per-node=1 --pit=1"
+ */
+
+// resident set size of the process, in bytes (0 if unknown)
+static uint64_t
+ResidentMemory ()
+{
+  std::ifstream statm ("/proc/self/statm");
+  uint64_t size = 0, resident = 0;
+  if (!(statm >> size >> resident))
+    return 0;
+
+  return resident * sysconf (_SC_PAGESIZE);
+}
+
+static void
+Report (const std::string &what, int64_t ms, uint64_t before, uint64_t after)
+{
+  std::cout << what << ": " << ms << " ms";
+  if (before != 0 && after != 0)
+    std::cout << ", " << (after > before ? after - before : 0) / (1024 * 1024) << " MB";
+  std::cout << std::endl;
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t nodeCount = 10000;
+  uint32_t degree = 10;
+  bool perNode = false;
+  bool pit = false;
+
+  CommandLine cmd;
+  cmd.AddValue ("nodes", "Number of nodes", nodeCount);
+  cmd.AddValue ("degree", "Number of faces of every node (even number)", degree);
+  cmd.AddValue ("per-node", "Install stack node by node instead of on the whole container", perNode);
+  cmd.AddValue ("pit", "Create one PIT entry on every node after the stack is installed", pit);
+  cmd.Parse (argc, argv);
+
+  NodeContainer nodes;
+  nodes.Create (nodeCount);
+
+  PointToPointHelper p2p;
+  for (uint32_t i = 0; i < nodeCount; i++)
+    {
+      for (uint32_t hop = 1; hop <= degree / 2 && hop < nodeCount; hop++)
+        {
+          p2p.Install (nodes.Get (i), nodes.Get ((i + hop) % nodeCount));
+        }
+    }
+
+  std::cout << nodeCount << " nodes, " << nodeCount * (degree / 2) * 2 << " faces" << std::endl;
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.SetDefaultRoutes (true);
+
+  uint64_t before = ResidentMemory ();
+  SystemWallClockMs clock;
+  clock.Start ();
+  if (perNode)
+    {
+      for (NodeContainer::Iterator node = nodes.Begin (); node != nodes.End (); node++)
+        {
+          ndnHelper.Install (*node);
+        }
+    }
+  else
+    {
+      ndnHelper.Install (nodes);
+    }
+  int64_t ms = clock.End ();
+  uint64_t after = ResidentMemory ();
+  Report (perNode ? "Install node by node" : "Install container   ", ms, before, after);
+
+  if (pit)
+    {
+      Ptr<ndn::Interest> interest = Create<ndn::Interest> ();
+      interest->SetName (Create<ndn::Name> ("/prefix"));
+      interest->SetInterestLifetime (Seconds (1));
+
+      before = after;
+      clock.Start ();
+      for (NodeContainer::Iterator node = nodes.Begin (); node != nodes.End (); node++)
+        {
+          Ptr<ndn::pit::Entry> entry = (*node)->GetObject<ndn::Pit> ()->Create (interest);
+          // the same as forwarding strategy does for new entries, schedules the entry in the timing wheel
+          entry->UpdateLifetime (interest->GetInterestLifetime ());
+        }
+      ms = clock.End ();
+      after = ResidentMemory ();
+      Report ("One PIT entry a node", ms, before, after);
+    }
+
+  Simulator::Destroy ();
+
+  return 0;
+}
@@ -0,0 +1,102 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+// ndn-wire-decode-benchmark.cc
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include <iostream>
+
+using namespace ns3;
+
+/**
+ * Micro-benchmark that measures how many Interest and Data packets per second
+ * can be decoded from the wire format (the same operation that is performed by
+ * ndn::Face for every received packet).
+ *
+ * Packets are pre-encoded with names /prefix/<seq> (plus optional extra components),
+ * where <seq> cycles through --names distinct values.
+ *
+ * To run:
+ *
+ *     ./waf --run="ndn-wire-decode-benchmark --packets=1000000 --names=1000"
+ */
+
+static void
+Report (const std::string &what, uint32_t packets, int64_t ms)
+{
+  std::cout << what << ": " << packets << " packets in " << ms << " ms";
+  if (ms > 0)
+    std::cout << " (" << static_cast<uint64_t> (packets * 1000.0 / ms) << " packets/s)";
+  std::cout << std::endl;
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t packets = 1000000;
+  uint32_t names = 1000;
+  uint32_t components = 3;
+  int32_t format = ndn::Wire::WIRE_FORMAT_NDNSIM;
+
+  CommandLine cmd;
+  cmd.AddValue ("packets", "Number of packets of each type to decode", packets);
+  cmd.AddValue ("names", "Number of distinct names", names);
+  cmd.AddValue ("components", "Number of name components before the sequence number", components);
+  cmd.AddValue ("format", "Wire format (0 for ndnSIM, 1 for CCNb)", format);
+  cmd.Parse (argc, argv);
+
+  std::vector< Ptr<const Packet> > interests;
+  std::vector< Ptr<const Packet> > datas;
+  for (uint32_t seq = 0; seq < names; seq++)
+    {
+      Ptr<ndn::Name> name = Create<ndn::Name> ("/prefix");
+      for (uint32_t i = 1; i < components; i++)
+        name->append ("component");
+      name->appendSeqNum (seq);
+
+      Ptr<ndn::Interest> interest = Create<ndn::Interest> ();
+      interest->SetName (name);
+      interest->SetNonce (seq);
+      interest->SetInterestLifetime (Seconds (2));
+      interests.push_back (ndn::Wire::FromInterest (interest, format));
+
+      Ptr<ndn::Data> data = Create<ndn::Data> (Create<Packet> (1024));
+      data->SetName (name);
+      datas.push_back (ndn::Wire::FromData (data, format));
+    }
+
+  SystemWallClockMs clock;
+
+  clock.Start ();
+  for (uint32_t i = 0; i < packets; i++)
+    {
+      ndn::Wire::ToInterest (interests [i % names]->Copy (), format);
+    }
+  Report ("Interest", packets, clock.End ());
+
+  clock.Start ();
+  for (uint32_t i = 0; i < packets; i++)
+    {
+      ndn::Wire::ToData (datas [i % names]->Copy (), format);
+    }
+  Report ("Data", packets, clock.End ());
+
+  Simulator::Destroy ();
+  return 0;
+}
@@ -25,6 +25,7 @@
 #endif
 
 #include "ndn-global-routing-helper.h"
+#include "ndn-partition-helper.h"
 
 #include "ns3/ndn-l3-protocol.h"
 #include "../model/ndn-net-device-face.h"
@@ -43,25 +44,52 @@
 #include "ns3/channel-list.h"
 #include "ns3/object-factory.h"
 
+#include "ns3/simulator.h"
+#include "ns3/global-value.h"
+#include "ns3/uinteger.h"
+#include "ns3/boolean.h"
+#include "ns3/core-config.h"
+#ifdef HAVE_PTHREAD_H
+#include "ns3/system-thread.h"
+#include <unistd.h>
+#endif
+
+#include "ns3/ndn-limits.h"
+
 #include <boost/lexical_cast.hpp>
 #include <boost/foreach.hpp>
-#include <boost/concept/assert.hpp>
-// #include <boost/graph/graph_concepts.hpp>
-// #include <boost/graph/adjacency_list.hpp>
-#include <boost/graph/dijkstra_shortest_paths.hpp>
-
-#include "boost-graph-ndn-global-routing-helper.h"
+#include <boost/shared_ptr.hpp>
 
 #include <math.h>
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <map>
+#include <set>
+#include <stdint.h>
+#include <queue>
+#include <vector>
 
 NS_LOG_COMPONENT_DEFINE ("ndn.GlobalRoutingHelper");
 
 using namespace std;
-using namespace boost;
 
 namespace ns3 {
 namespace ndn {
 
+static GlobalValue g_routingThreads ("NdnGlobalRoutingThreads",
+                                     "Number of threads used by ndn::GlobalRoutingHelper to calculate routes "
+                                     "(0 to use one thread per online processor)",
+                                     UintegerValue (0),
+                                     MakeUintegerChecker<uint32_t> ());
+
+static GlobalValue g_routingIncremental ("NdnGlobalRoutingIncremental",
+                                         "Keep shortest path trees calculated by ndn::GlobalRoutingHelper::CalculateRoutes "
+                                         "and update routes incrementally when face state or metric changes "
+                                         "(trees take 16 bytes per GlobalRouter for every origin node)",
+                                         BooleanValue (false),
+                                         MakeBooleanChecker ());
+
 void
 GlobalRoutingHelper::Install (Ptr<Node> node)
 {
@@ -233,228 +261,1041 @@ GlobalRoutingHelper::AddOriginsForAll ()
     }
 }
 
-void
-GlobalRoutingHelper::CalculateRoutes (bool invalidatedRoutes/* = true*/)
+/// @cond include_hidden
+namespace {
+
+static const uint32_t NO_EDGE = std::numeric_limits<uint32_t>::max ();
+
+// the same as boost::WeightInf used before: paths with larger metric are considered unreachable
+static const uint32_t METRIC_INF = std::numeric_limits<uint16_t>::max ();
+
+// metric of disabled faces in CalculateAllPossibleRoutes
+// (std::numeric_limits<uint16_t>::max () MUST NOT be used, it is reserved)
+static const uint32_t METRIC_DISABLED = std::numeric_limits<uint16_t>::max () - 1;
+
+// upper limit for the memory used by distances to origins in CalculateAllPossibleRoutes
+static const size_t MAX_ORIGIN_ROWS_SIZE = 64 * 1024 * 1024;
+
+/**
+ * @brief Metric of the graph edge: face metric, METRIC_INF if the face is down, 0 for edges of channels
+ */
+static uint32_t
+EdgeMetric (Ptr<Face> face)
+{
+  if (face == 0)
+    return 0;
+  else if (!face->IsUp ())
+    return METRIC_INF;
+  else
+    return face->GetMetric ();
+}
+
+/**
+ * @brief Snapshot of the global router graph in compressed sparse row form
+ *
+ * Vertices of nodes are numbered first (in NodeList order), followed by vertices of channels.
+ * Outgoing edges of vertex v are [m_offsets[v], m_offsets[v+1]), indexes of incoming edges are
+ * stored in m_inEdges[m_inOffsets[v]] ... m_inEdges[m_inOffsets[v+1]-1].  Threads calculating
+ * routes use only plain arrays, smart pointers are touched only by the main thread.
+ */
+struct RouterGraph
 {
+  RouterGraph ();
+
+  std::vector< Ptr<GlobalRouter> > m_vertices;
+  uint32_t m_nodes;                  ///< @brief number of node vertices
+  std::vector<uint32_t> m_localNodes; ///< @brief node vertices simulated by this process (sources of route calculation)
+  std::vector<uint8_t> m_isLocal;    ///< @brief whether the vertex is in m_localNodes
+  std::vector<uint32_t> m_origins;   ///< @brief vertices that have locally exported prefixes
+
+  std::vector<uint32_t> m_offsets;
+  std::vector<uint32_t> m_sources;   ///< @brief source vertex of the edge
+  std::vector<uint32_t> m_targets;   ///< @brief target vertex of the edge
+  std::vector<uint32_t> m_metrics;   ///< @brief routing metric of the edge (see EdgeMetric)
+  std::vector<double> m_delays;      ///< @brief link delay of the edge (taken from face's Limits, if any)
+  std::vector< Ptr<Face> > m_faces;  ///< @brief face of the edge (0 for edges of channels)
+
+  std::vector<uint32_t> m_inOffsets;
+  std::vector<uint32_t> m_inEdges;
+};
+
+RouterGraph::RouterGraph ()
+  : m_nodes (0)
+{
+  for (NodeList::Iterator node = NodeList::Begin (); node != NodeList::End (); node++)
+    {
+      Ptr<GlobalRouter> gr = (*node)->GetObject<GlobalRouter> ();
+      if (gr != 0)
+        m_vertices.push_back (gr);
+      else
+        NS_LOG_DEBUG ("Node " << (*node)->GetId () << " does not export GlobalRouter interface");
+    }
+  m_nodes = m_vertices.size ();
+
+  // in the distributed simulation, each process calculates routes only for its own nodes
+  m_isLocal.assign (m_nodes, 0);
+  for (uint32_t vertex = 0; vertex < m_nodes; vertex++)
+    {
+      if (PartitionHelper::IsLocal (m_vertices[vertex]->GetObject<Node> ()))
+        {
+          m_localNodes.push_back (vertex);
+          m_isLocal[vertex] = 1;
+        }
+    }
+
+  for (ChannelList::Iterator channel = ChannelList::Begin (); channel != ChannelList::End (); channel++)
+    {
+      Ptr<GlobalRouter> gr = (*channel)->GetObject<GlobalRouter> ();
+      if (gr != 0)
+        m_vertices.push_back (gr);
+    }
+
+  std::map< Ptr<GlobalRouter>, uint32_t > index;
+  for (uint32_t vertex = 0; vertex < m_vertices.size (); vertex++)
+    {
+      index[m_vertices[vertex]] = vertex;
+    }
+
+  m_offsets.reserve (m_vertices.size () + 1);
+  for (uint32_t vertex = 0; vertex < m_vertices.size (); vertex++)
+    {
+      m_offsets.push_back (m_targets.size ());
+      if (!m_vertices[vertex]->GetLocalPrefixes ().empty ())
+        m_origins.push_back (vertex);
+
+      BOOST_FOREACH (const GlobalRouter::Incidency &incidency, m_vertices[vertex]->GetIncidencies ())
+        {
+          std::map< Ptr<GlobalRouter>, uint32_t >::iterator target = index.find (incidency.get<2> ());
+          if (target == index.end ())
+            continue;
+
+          Ptr<Face> face = incidency.get<1> ();
+          double delay = 0.0;
+          if (face != 0)
+            {
+              Ptr<Limits> limits = face->GetObject<Limits> ();
+              if (limits != 0) // valid limits object
+                {
+                  delay = limits->GetLinkDelay ();
+                }
+            }
+
+          m_sources.push_back (vertex);
+          m_targets.push_back (target->second);
+          m_metrics.push_back (EdgeMetric (face));
+          m_delays.push_back (delay);
+          m_faces.push_back (face);
+        }
+    }
+  m_offsets.push_back (m_targets.size ());
+
+  // incoming edges (counting sort by target)
+  m_inOffsets.assign (m_vertices.size () + 1, 0);
+  for (uint32_t edge = 0; edge < m_targets.size (); edge++)
+    {
+      m_inOffsets[m_targets[edge] + 1] ++;
+    }
+  for (uint32_t vertex = 0; vertex < m_vertices.size (); vertex++)
+    {
+      m_inOffsets[vertex + 1] += m_inOffsets[vertex];
+    }
+  m_inEdges.resize (m_targets.size ());
+  std::vector<uint32_t> position (m_inOffsets.begin (), m_inOffsets.end () - 1);
+  for (uint32_t edge = 0; edge < m_targets.size (); edge++)
+    {
+      m_inEdges[position[m_targets[edge]] ++] = edge;
+    }
+}
+
+/**
+ * @brief Route from a source node to an origin vertex
+ */
+struct Route
+{
+  uint32_t m_origin; ///< @brief index in RouterGraph::m_origins
+  uint32_t m_edge;   ///< @brief first edge of the path (defines the outgoing face)
+  uint32_t m_metric; ///< @brief sum of routing metrics along the path
+  double m_delay;    ///< @brief sum of link delays along the path
+};
+
+/**
+ * @brief Shortest paths from all vertices towards one target vertex
+ */
+struct ShortestPathTree
+{
+  std::vector<uint32_t> m_distance; ///< @brief sum of routing metrics along the path (METRIC_INF, if unreachable)
+  std::vector<uint32_t> m_next;     ///< @brief next edge of the path (NO_EDGE, if unreachable)
+  std::vector<double> m_delay;      ///< @brief sum of link delays along the path
+};
+
+/**
+ * @brief Old state of the vertex, which path in ShortestPathTree has changed
+ */
+struct TreeChange
+{
+  uint32_t m_vertex;
+  uint32_t m_next;
+  uint32_t m_distance;
+  double m_delay;
+};
+
+/**
+ * @brief Dijkstra search on RouterGraph with dense per-vertex arrays (one instance per thread)
+ *
+ * Only routing metrics are compared and ties are resolved in favor of the path found first, the
+ * same way as it was done by boost::dijkstra_shortest_paths with boost::WeightCompare.  For every
+ * reached vertex the sum of link delays along the path is recorded, as well as the first edge of
+ * the path (for forward search) or the next edge of the path (for reverse search).
+ */
+class ShortestPaths
+{
+public:
+  ShortestPaths (const RouterGraph &graph)
+    : m_graph (graph)
+    , m_distance (graph.m_vertices.size ())
+    , m_firstEdge (graph.m_vertices.size ())
+    , m_delay (graph.m_vertices.size ())
+    , m_done (graph.m_vertices.size ())
+    , m_touched (graph.m_vertices.size ())
+  {
+  }
+
   /**
-   * Implementation of route calculation is heavily based on Boost Graph Library
-   * See http://www.boost.org/doc/libs/1_49_0/libs/graph/doc/table_of_contents.html for more details
+   * @brief Calculate paths from the source vertex to all other vertices
+   * @param source      source vertex
+   * @param enabledEdge if not NO_EDGE, all other edges of the source get METRIC_DISABLED metric
    */
+  void
+  Search (uint32_t source, uint32_t enabledEdge);
 
-  BOOST_CONCEPT_ASSERT(( VertexListGraphConcept< NdnGlobalRouterGraph > ));
-  BOOST_CONCEPT_ASSERT(( IncidenceGraphConcept< NdnGlobalRouterGraph > ));
+  /**
+   * @brief Calculate paths from all vertices to the target vertex
+   */
+  void
+  ReverseSearch (uint32_t target);
 
-  NdnGlobalRouterGraph graph;
-  // typedef graph_traits < NdnGlobalRouterGraph >::vertex_descriptor vertex_descriptor;
+  /**
+   * @brief Update tree calculated by ReverseSearch after metric of the edge has changed
+   *
+   * Dynamic version of Dijkstra algorithm: if the metric has increased and the edge is part of the
+   * tree, only paths of the vertices that went via the edge are recalculated; if the metric has
+   * decreased, improvements are propagated from the source of the edge.
+   *
+   * @param tree      tree to update
+   * @param edge      changed edge (RouterGraph::m_metrics should already contain the new metric)
+   * @param oldMetric metric of the edge before the change
+   * @param changes   old state of node vertices, which paths have changed, is appended to the list
+   */
+  void
+  UpdateTree (ShortestPathTree &tree, uint32_t edge, uint32_t oldMetric, std::vector<TreeChange> &changes);
 
-  // For now we doing Dijkstra for every node.  Can be replaced with Bellman-Ford or Floyd-Warshall.
-  // Other algorithms should be faster, but they need additional EdgeListGraph concept provided by the graph, which
-  // is not obviously how implement in an efficient manner
-  for (NodeList::Iterator node = NodeList::Begin (); node != NodeList::End (); node++)
+private:
+  void
+  Reset (uint32_t vertex);
+
+  void
+  Touch (const ShortestPathTree &tree, uint32_t vertex, std::vector<TreeChange> &touched);
+
+  void
+  Relax (ShortestPathTree &tree, bool affectedOnly, std::vector<TreeChange> &touched);
+
+public:
+  const RouterGraph &m_graph;
+  std::vector<uint32_t> m_distance;
+  std::vector<uint32_t> m_firstEdge;
+  std::vector<double> m_delay;
+
+private:
+  typedef std::pair<uint32_t, uint32_t> QueueItem; // distance, vertex
+  std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem> > m_queue;
+  std::vector<bool> m_done;
+  std::vector<bool> m_touched;
+};
+
+void
+ShortestPaths::Reset (uint32_t vertex)
+{
+  std::fill (m_distance.begin (), m_distance.end (), METRIC_INF);
+  std::fill (m_firstEdge.begin (), m_firstEdge.end (), NO_EDGE);
+  std::fill (m_done.begin (), m_done.end (), false);
+
+  m_distance[vertex] = 0;
+  m_delay[vertex] = 0.0;
+  m_queue.push (QueueItem (0, vertex));
+}
+
+void
+ShortestPaths::Search (uint32_t source, uint32_t enabledEdge)
+{
+  Reset (source);
+
+  while (!m_queue.empty ())
     {
-      Ptr<GlobalRouter> source = (*node)->GetObject<GlobalRouter> ();
-      if (source == 0)
-	{
-	  NS_LOG_DEBUG ("Node " << (*node)->GetId () << " does not export GlobalRouter interface");
-	  continue;
-	}
+      uint32_t vertex = m_queue.top ().second;
+      m_queue.pop ();
 
-      DistancesMap    distances;
-
-      dijkstra_shortest_paths (graph, source,
-			       // predecessor_map (boost::ref(predecessors))
-			       // .
-			       distance_map (boost::ref(distances))
-			       .
-			       distance_inf (WeightInf)
-			       .
-			       distance_zero (WeightZero)
-			       .
-			       distance_compare (boost::WeightCompare ())
-			       .
-			       distance_combine (boost::WeightCombine ())
-			       );
-
-      // NS_LOG_DEBUG (predecessors.size () << ", " << distances.size ());
-
-      Ptr<Fib>  fib  = source->GetObject<Fib> ();
-      if (invalidatedRoutes)
+      if (m_done[vertex])
+        continue;
+      m_done[vertex] = true;
+
+      for (uint32_t edge = m_graph.m_offsets[vertex]; edge < m_graph.m_offsets[vertex + 1]; edge++)
         {
-          fib->InvalidateAll ();
+          uint32_t metric = m_graph.m_metrics[edge];
+          if (vertex == source && enabledEdge != NO_EDGE && edge != enabledEdge && metric < METRIC_INF)
+            metric = METRIC_DISABLED;
+
+          uint32_t target = m_graph.m_targets[edge];
+          uint32_t distance = m_distance[vertex] + metric;
+          if (distance < m_distance[target])
+            {
+              m_distance[target] = distance;
+              m_firstEdge[target] = vertex == source ? edge : m_firstEdge[vertex];
+              m_delay[target] = m_delay[vertex] + m_graph.m_delays[edge];
+              m_queue.push (QueueItem (distance, target));
+            }
         }
-      NS_ASSERT (fib != 0);
+    }
+}
 
-      NS_LOG_DEBUG ("Reachability from Node: " << source->GetObject<Node> ()->GetId ());
-      for (DistancesMap::iterator i = distances.begin ();
-	   i != distances.end ();
-	   i++)
-	{
-	  if (i->first == source)
-	    continue;
-	  else
-	    {
-	      // cout << "  Node " << i->first->GetObject<Node> ()->GetId ();
-	      if (i->second.get<0> () == 0)
-		{
-		  // cout << " is unreachable" << endl;
-		}
-	      else
-		{
-                  BOOST_FOREACH (const Ptr<const Name> &prefix, i->first->GetLocalPrefixes ())
-                    {
-                      NS_LOG_DEBUG (" prefix " << prefix << " reachable via face " << *i->second.get<0> ()
-                                    << " with distance " << i->second.get<1> ()
-                                    << " with delay " << i->second.get<2> ());
-
-                      Ptr<fib::Entry> entry = fib->Add (prefix, i->second.get<0> (), i->second.get<1> ());
-                      entry->SetRealDelayToProducer (i->second.get<0> (), Seconds (i->second.get<2> ()));
-
-                      Ptr<Limits> faceLimits = i->second.get<0> ()->GetObject<Limits> ();
-
-                      Ptr<Limits> fibLimits = entry->GetObject<Limits> ();
-                      if (fibLimits != 0)
-                        {
-                          // if it was created by the forwarding strategy via DidAddFibEntry event
-                          fibLimits->SetLimits (faceLimits->GetMaxRate (), 2 * i->second.get<2> () /*exact RTT*/);
-                          NS_LOG_DEBUG ("Set limit for prefix " << *prefix << " " << faceLimits->GetMaxRate () << " / " <<
-                                        2*i->second.get<2> () << "s (" << faceLimits->GetMaxRate () * 2 * i->second.get<2> () << ")");
-                        }
-                    }
-		}
-	    }
-	}
+void
+ShortestPaths::ReverseSearch (uint32_t target)
+{
+  Reset (target);
+
+  while (!m_queue.empty ())
+    {
+      uint32_t vertex = m_queue.top ().second;
+      m_queue.pop ();
+
+      if (m_done[vertex])
+        continue;
+      m_done[vertex] = true;
+
+      for (uint32_t i = m_graph.m_inOffsets[vertex]; i < m_graph.m_inOffsets[vertex + 1]; i++)
+        {
+          uint32_t edge = m_graph.m_inEdges[i];
+          uint32_t source = m_graph.m_sources[edge];
+          uint32_t distance = m_distance[vertex] + m_graph.m_metrics[edge];
+          if (distance < m_distance[source])
+            {
+              m_distance[source] = distance;
+              m_firstEdge[source] = edge;
+              m_delay[source] = m_delay[vertex] + m_graph.m_delays[edge];
+              m_queue.push (QueueItem (distance, source));
+            }
+        }
     }
 }
 
 void
-GlobalRoutingHelper::CalculateAllPossibleRoutes (bool invalidatedRoutes/* = true*/)
+ShortestPaths::Touch (const ShortestPathTree &tree, uint32_t vertex, std::vector<TreeChange> &touched)
 {
-  /**
-   * Implementation of route calculation is heavily based on Boost Graph Library
-   * See http://www.boost.org/doc/libs/1_49_0/libs/graph/doc/table_of_contents.html for more details
-   */
+  if (m_touched[vertex])
+    return;
 
-  BOOST_CONCEPT_ASSERT(( VertexListGraphConcept< NdnGlobalRouterGraph > ));
-  BOOST_CONCEPT_ASSERT(( IncidenceGraphConcept< NdnGlobalRouterGraph > ));
+  m_touched[vertex] = true;
+  TreeChange change = { vertex, tree.m_next[vertex], tree.m_distance[vertex], tree.m_delay[vertex] };
+  touched.push_back (change);
+}
 
-  NdnGlobalRouterGraph graph;
-  // typedef graph_traits < NdnGlobalRouterGraph >::vertex_descriptor vertex_descriptor;
+void
+ShortestPaths::Relax (ShortestPathTree &tree, bool affectedOnly, std::vector<TreeChange> &touched)
+{
+  while (!m_queue.empty ())
+    {
+      uint32_t distance = m_queue.top ().first;
+      uint32_t vertex = m_queue.top ().second;
+      m_queue.pop ();
 
-  // For now we doing Dijkstra for every node.  Can be replaced with Bellman-Ford or Floyd-Warshall.
-  // Other algorithms should be faster, but they need additional EdgeListGraph concept provided by the graph, which
-  // is not obviously how implement in an efficient manner
-  for (NodeList::Iterator node = NodeList::Begin (); node != NodeList::End (); node++)
+      if (distance != tree.m_distance[vertex])
+        continue; // outdated queue item
+
+      for (uint32_t i = m_graph.m_inOffsets[vertex]; i < m_graph.m_inOffsets[vertex + 1]; i++)
+        {
+          uint32_t edge = m_graph.m_inEdges[i];
+          uint32_t source = m_graph.m_sources[edge];
+          if (affectedOnly && !m_done[source])
+            continue;
+
+          distance = tree.m_distance[vertex] + m_graph.m_metrics[edge];
+          if (distance < tree.m_distance[source])
+            {
+              Touch (tree, source, touched);
+              tree.m_distance[source] = distance;
+              tree.m_next[source] = edge;
+              tree.m_delay[source] = tree.m_delay[vertex] + m_graph.m_delays[edge];
+              m_queue.push (QueueItem (distance, source));
+            }
+        }
+    }
+}
+
+void
+ShortestPaths::UpdateTree (ShortestPathTree &tree, uint32_t edge, uint32_t oldMetric, std::vector<TreeChange> &changes)
+{
+  uint32_t metric = m_graph.m_metrics[edge];
+  uint32_t source = m_graph.m_sources[edge];
+  uint32_t target = m_graph.m_targets[edge];
+
+  std::vector<TreeChange> touched;
+  if (metric > oldMetric)
     {
-      Ptr<GlobalRouter> source = (*node)->GetObject<GlobalRouter> ();
-      if (source == 0)
-	{
-	  NS_LOG_DEBUG ("Node " << (*node)->GetId () << " does not export GlobalRouter interface");
-	  continue;
-	}
+      if (tree.m_next[source] != edge)
+        return; // paths that do not use the edge are not affected
 
-      Ptr<Fib>  fib  = source->GetObject<Fib> ();
+      // vertices, paths of which go via the edge (marked in m_done)
+      std::vector<uint32_t> affected (1, source);
+      m_done[source] = true;
+      for (size_t i = 0; i < affected.size (); i++)
+        {
+          for (uint32_t j = m_graph.m_inOffsets[affected[i]]; j < m_graph.m_inOffsets[affected[i] + 1]; j++)
+            {
+              uint32_t inEdge = m_graph.m_inEdges[j];
+              uint32_t vertex = m_graph.m_sources[inEdge];
+              if (!m_done[vertex] && tree.m_next[vertex] == inEdge)
+                {
+                  m_done[vertex] = true;
+                  affected.push_back (vertex);
+                }
+            }
+        }
+
+      BOOST_FOREACH (uint32_t vertex, affected)
+        {
+          Touch (tree, vertex, touched);
+          tree.m_distance[vertex] = METRIC_INF;
+          tree.m_next[vertex] = NO_EDGE;
+        }
+
+      // best paths via not affected neighbors
+      BOOST_FOREACH (uint32_t vertex, affected)
+        {
+          for (uint32_t outEdge = m_graph.m_offsets[vertex]; outEdge < m_graph.m_offsets[vertex + 1]; outEdge++)
+            {
+              uint32_t neighbor = m_graph.m_targets[outEdge];
+              uint32_t distance = m_graph.m_metrics[outEdge] + tree.m_distance[neighbor];
+              if (!m_done[neighbor] && distance < tree.m_distance[vertex])
+                {
+                  tree.m_distance[vertex] = distance;
+                  tree.m_next[vertex] = outEdge;
+                  tree.m_delay[vertex] = m_graph.m_delays[outEdge] + tree.m_delay[neighbor];
+                }
+            }
+
+          if (tree.m_distance[vertex] < METRIC_INF)
+            m_queue.push (QueueItem (tree.m_distance[vertex], vertex));
+        }
+
+      Relax (tree, true, touched);
+
+      BOOST_FOREACH (uint32_t vertex, affected)
+        {
+          m_done[vertex] = false;
+        }
+    }
+  else
+    {
+      uint32_t distance = metric + tree.m_distance[target];
+      if (distance >= tree.m_distance[source])
+        return; // no improvements
+
+      Touch (tree, source, touched);
+      tree.m_distance[source] = distance;
+      tree.m_next[source] = edge;
+      tree.m_delay[source] = m_graph.m_delays[edge] + tree.m_delay[target];
+      m_queue.push (QueueItem (distance, source));
+
+      Relax (tree, false, touched);
+    }
+
+  BOOST_FOREACH (const TreeChange &change, touched)
+    {
+      m_touched[change.m_vertex] = false;
+
+      if (change.m_vertex < m_graph.m_nodes &&
+          (change.m_next != tree.m_next[change.m_vertex] ||
+           change.m_distance != tree.m_distance[change.m_vertex] ||
+           change.m_delay != tree.m_delay[change.m_vertex]))
+        {
+          changes.push_back (change);
+        }
+    }
+}
+
+static uint32_t
+GetNumberOfThreads (uint32_t jobs)
+{
+  UintegerValue value;
+  g_routingThreads.GetValue (value);
+  uint32_t threads = value.Get ();
+
+#ifdef HAVE_PTHREAD_H
+  if (threads == 0)
+    {
+      long processors = sysconf (_SC_NPROCESSORS_ONLN);
+      threads = processors > 0 ? processors : 1;
+    }
+#else
+  threads = 1;
+#endif
+
+  return std::max<uint32_t> (1, std::min (threads, jobs));
+}
+
+/**
+ * @brief Thread processing every step-th job starting from first
+ */
+template<class Job>
+struct Worker
+{
+  void
+  Run ()
+  {
+    ShortestPaths paths (*m_job->m_graph);
+    for (uint32_t i = m_first; i < m_count; i += m_step)
+      {
+        m_job->Process (i, paths);
+      }
+  }
+
+  Job *m_job;
+  uint32_t m_first;
+  uint32_t m_step;
+  uint32_t m_count;
+};
+
+/**
+ * @brief Call job.Process (i, paths) for every i in [0, count) using a pool of threads
+ *
+ * Calls with different i can be made in parallel, so they should not modify any shared state
+ */
+template<class Job>
+static void
+RunInParallel (Job &job, uint32_t count)
+{
+  uint32_t threads = GetNumberOfThreads (count);
+
+  std::vector< Worker<Job> > workers (threads);
+  for (uint32_t i = 0; i < threads; i++)
+    {
+      workers[i].m_job = &job;
+      workers[i].m_first = i;
+      workers[i].m_step = threads;
+      workers[i].m_count = count;
+    }
+
+#ifdef HAVE_PTHREAD_H
+  std::vector< Ptr<SystemThread> > systemThreads;
+  for (uint32_t i = 1; i < threads; i++)
+    {
+      systemThreads.push_back (Create<SystemThread> (MakeCallback (&Worker<Job>::Run, &workers[i])));
+      systemThreads.back ()->Start ();
+    }
+#endif
+
+  workers[0].Run (); // the calling thread is also doing its share
+
+#ifdef HAVE_PTHREAD_H
+  for (uint32_t i = 0; i < systemThreads.size (); i++)
+    {
+      systemThreads[i]->Join ();
+    }
+#endif
+}
+
+/**
+ * @brief Shortest path from every local node to every origin
+ */
+struct BestRoutes
+{
+  void
+  Process (uint32_t i, ShortestPaths &paths)
+  {
+    uint32_t source = m_graph->m_localNodes[i];
+    paths.Search (source, NO_EDGE);
+
+    for (uint32_t origin = 0; origin < m_graph->m_origins.size (); origin++)
+      {
+        uint32_t vertex = m_graph->m_origins[origin];
+        if (vertex == source || paths.m_firstEdge[vertex] == NO_EDGE)
+          continue;
+
+        Route route = { origin, paths.m_firstEdge[vertex], paths.m_distance[vertex], paths.m_delay[vertex] };
+        (*m_routes)[source].push_back (route);
+      }
+  }
+
+  const RouterGraph *m_graph;
+  std::vector< std::vector<Route> > *m_routes;
+};
+
+/**
+ * @brief Best path from every node to every origin via each of the node's faces
+ *
+ * The result is the same as calculating shortest paths separately for each face with all other
+ * faces of the node having METRIC_DISABLED metric.  However, instead of running such a search
+ * for each face, the routes are derived in one pass from distances of all vertices to origins
+ * (dist (v, o)): if dist (n, o) < dist (n, s) + dist (s, o), the shortest path from neighbor n to
+ * origin o does not go back via source s, and so the best path via the face towards n has metric
+ * metric (s, n) + dist (n, o).  Only faces, for which this does not hold for some origin, are
+ * processed using the per-face search.
+ */
+struct AllPossibleRoutes
+{
+  // dist (n, s) for every edge (s, n) of every local node
+  void
+  ProcessSource (uint32_t i, ShortestPaths &paths)
+  {
+    uint32_t source = m_graph->m_localNodes[i];
+    paths.ReverseSearch (source);
+    for (uint32_t edge = m_graph->m_offsets[source]; edge < m_graph->m_offsets[source + 1]; edge++)
+      {
+        m_neighborToSource[edge] = paths.m_distance[m_graph->m_targets[edge]];
+      }
+  }
+
+  // dist (v, o) for every vertex and every origin of the current batch
+  void
+  ProcessOrigin (uint32_t i, ShortestPaths &paths)
+  {
+    paths.ReverseSearch (m_graph->m_origins[m_batchBegin + i]);
+    std::copy (paths.m_distance.begin (), paths.m_distance.end (), m_distance.begin () + i * m_graph->m_vertices.size ());
+    std::copy (paths.m_delay.begin (), paths.m_delay.end (), m_delay.begin () + i * m_graph->m_vertices.size ());
+  }
+
+  // routes to origins of the current batch, derived from distances
+  void
+  ProcessRoutes (uint32_t i, ShortestPaths &paths)
+  {
+    uint32_t source = m_graph->m_localNodes[i];
+    for (uint32_t row = 0; row < m_batchEnd - m_batchBegin; row++)
+      {
+        uint32_t origin = m_batchBegin + row;
+        if (m_graph->m_origins[origin] == source)
+          continue;
+
+        const uint32_t *distance = &m_distance[row * m_graph->m_vertices.size ()];
+        const double *delay = &m_delay[row * m_graph->m_vertices.size ()];
+
+        uint32_t sourceDistance = METRIC_INF;
+        for (uint32_t edge = m_graph->m_offsets[source]; edge < m_graph->m_offsets[source + 1]; edge++)
+          {
+            sourceDistance = std::min (sourceDistance, m_graph->m_metrics[edge] + distance[m_graph->m_targets[edge]]);
+          }
+
+        for (uint32_t edge = m_graph->m_offsets[source]; edge < m_graph->m_offsets[source + 1]; edge++)
+          {
+            if (m_fallback[edge] || m_graph->m_metrics[edge] == METRIC_DISABLED)
+              continue;
+
+            uint32_t neighbor = m_graph->m_targets[edge];
+            uint32_t metric = m_graph->m_metrics[edge] + distance[neighbor];
+            if (distance[neighbor] >= METRIC_INF || metric >= METRIC_INF)
+              continue; // unreachable via this face
+
+            if (distance[neighbor] >= m_neighborToSource[edge] + sourceDistance || metric == METRIC_DISABLED)
+              {
+                m_fallback[edge] = true;
+                continue;
+              }
+
+            Route route = { origin, edge, metric, m_graph->m_delays[edge] + delay[neighbor] };
+            (*m_routes)[source].push_back (route);
+          }
+      }
+  }
+
+  // per-face search for faces, for which routes cannot be derived from distances
+  void
+  ProcessFallback (uint32_t i, ShortestPaths &paths)
+  {
+    uint32_t source = m_graph->m_localNodes[i];
+    std::vector<Route> &routes = (*m_routes)[source];
+    for (uint32_t edge = m_graph->m_offsets[source]; edge < m_graph->m_offsets[source + 1]; edge++)
+      {
+        if (!m_fallback[edge])
+          continue;
+
+        paths.Search (source, edge);
+
+        for (uint32_t origin = 0; origin < m_graph->m_origins.size (); origin++)
+          {
+            uint32_t vertex = m_graph->m_origins[origin];
+            if (vertex == source || paths.m_firstEdge[vertex] != edge)
+              continue;
+
+            Route route = { origin, edge, paths.m_distance[vertex], paths.m_delay[vertex] };
+            routes.push_back (route);
+          }
+      }
+  }
+
+  template<void (AllPossibleRoutes::*Method) (uint32_t, ShortestPaths &)>
+  struct Stage
+  {
+    void
+    Process (uint32_t i, ShortestPaths &paths)
+    {
+      (m_job->*Method) (i, paths);
+    }
+
+    AllPossibleRoutes *m_job;
+    const RouterGraph *m_graph;
+  };
+
+  template<void (AllPossibleRoutes::*Method) (uint32_t, ShortestPaths &)>
+  void
+  RunStage (uint32_t count)
+  {
+    Stage<Method> stage = { this, m_graph };
+    RunInParallel (stage, count);
+  }
+
+  void
+  Run ()
+  {
+    uint32_t vertices = m_graph->m_vertices.size ();
+    uint32_t origins = m_graph->m_origins.size ();
+
+    m_neighborToSource.resize (m_graph->m_targets.size ());
+    m_fallback.assign (m_graph->m_targets.size (), 0);
+
+    RunStage<&AllPossibleRoutes::ProcessSource> (m_graph->m_localNodes.size ());
+
+    uint32_t batch = std::max<size_t> (1, MAX_ORIGIN_ROWS_SIZE / ((sizeof (uint32_t) + sizeof (double)) * std::max<uint32_t> (1, vertices)));
+    for (m_batchBegin = 0; m_batchBegin < origins; m_batchBegin = m_batchEnd)
+      {
+        m_batchEnd = std::min (m_batchBegin + batch, origins);
+        m_distance.resize ((m_batchEnd - m_batchBegin) * vertices);
+        m_delay.resize ((m_batchEnd - m_batchBegin) * vertices);
+
+        RunStage<&AllPossibleRoutes::ProcessOrigin> (m_batchEnd - m_batchBegin);
+        RunStage<&AllPossibleRoutes::ProcessRoutes> (m_graph->m_localNodes.size ());
+      }
+
+    // routes of faces that need per-face search are calculated again for all origins
+    BOOST_FOREACH (uint32_t source, m_graph->m_localNodes)
+      {
+        std::vector<Route> &routes = (*m_routes)[source];
+        std::vector<Route> kept;
+        BOOST_FOREACH (const Route &route, routes)
+          {
+            if (!m_fallback[route.m_edge])
+              kept.push_back (route);
+          }
+        routes.swap (kept);
+      }
+    RunStage<&AllPossibleRoutes::ProcessFallback> (m_graph->m_localNodes.size ());
+  }
+
+  const RouterGraph *m_graph;
+  std::vector< std::vector<Route> > *m_routes;
+
+  std::vector<uint32_t> m_neighborToSource;
+  std::vector<uint8_t> m_fallback; // not std::vector<bool>, elements are modified from different threads
+
+  uint32_t m_batchBegin;
+  uint32_t m_batchEnd;
+  std::vector<uint32_t> m_distance;
+  std::vector<double> m_delay;
+};
+
+static void
+AddRoute (Ptr<Fib> fib, Ptr<const Name> prefix, Ptr<Face> face, uint32_t metric, double delay)
+{
+  NS_LOG_DEBUG (" prefix " << *prefix << " reachable via face " << *face
+                << " with distance " << metric
+                << " with delay " << delay);
+
+  Ptr<fib::Entry> entry = fib->Add (prefix, face, metric);
+  entry->SetRealDelayToProducer (face, Seconds (delay));
+
+  Ptr<Limits> faceLimits = face->GetObject<Limits> ();
+
+  Ptr<Limits> fibLimits = entry->GetObject<Limits> ();
+  if (fibLimits != 0)
+    {
+      // if it was created by the forwarding strategy via DidAddFibEntry event
+      fibLimits->SetLimits (faceLimits->GetMaxRate (), 2 * delay /*exact RTT*/);
+      NS_LOG_DEBUG ("Set limit for prefix " << *prefix << " " << faceLimits->GetMaxRate () << " / " <<
+                    2*delay << "s (" << faceLimits->GetMaxRate () * 2 * delay << ")");
+    }
+}
+
+static void
+InstallRoutes (const RouterGraph &graph, const std::vector< std::vector<Route> > &routes, bool invalidatedRoutes)
+{
+  BOOST_FOREACH (uint32_t source, graph.m_localNodes)
+    {
+      Ptr<Fib>  fib  = graph.m_vertices[source]->GetObject<Fib> ();
+      NS_ASSERT (fib != 0);
       if (invalidatedRoutes)
         {
           fib->InvalidateAll ();
         }
-      NS_ASSERT (fib != 0);
 
-      NS_LOG_DEBUG ("===========");
-      NS_LOG_DEBUG ("Reachability from Node: " << source->GetObject<Node> ()->GetId () << " (" << Names::FindName (source->GetObject<Node> ()) << ")");
+      NS_LOG_DEBUG ("Reachability from Node: " << graph.m_vertices[source]->GetObject<Node> ()->GetId ());
+      BOOST_FOREACH (const Route &route, routes[source])
+        {
+          BOOST_FOREACH (const Ptr<const Name> &prefix, graph.m_vertices[graph.m_origins[route.m_origin]]->GetLocalPrefixes ())
+            {
+              AddRoute (fib, prefix, graph.m_faces[route.m_edge], route.m_metric, route.m_delay);
+            }
+        }
+    }
+}
 
-      Ptr<L3Protocol> l3 = source->GetObject<L3Protocol> ();
-      NS_ASSERT (l3 != 0);
+/**
+ * @brief Shortest path tree towards every origin
+ */
+struct BuildTrees
+{
+  void
+  Process (uint32_t origin, ShortestPaths &paths)
+  {
+    paths.ReverseSearch (m_graph->m_origins[origin]);
+
+    ShortestPathTree &tree = (*m_trees)[origin];
+    tree.m_distance = paths.m_distance;
+    tree.m_next = paths.m_firstEdge;
+    tree.m_delay = paths.m_delay;
+  }
+
+  const RouterGraph *m_graph;
+  std::vector<ShortestPathTree> *m_trees;
+};
+
+/**
+ * @brief Update of shortest path trees towards every origin after metric of one edge has changed
+ */
+struct UpdateTrees
+{
+  void
+  Process (uint32_t origin, ShortestPaths &paths)
+  {
+    paths.UpdateTree ((*m_trees)[origin], m_edge, m_oldMetric, (*m_changes)[origin]);
+  }
+
+  const RouterGraph *m_graph;
+  std::vector<ShortestPathTree> *m_trees;
+  uint32_t m_edge;
+  uint32_t m_oldMetric;
+  std::vector< std::vector<TreeChange> > *m_changes;
+};
+
+/**
+ * @brief State of incremental routing (see NdnGlobalRoutingIncremental global value)
+ */
+struct IncrementalRouting
+{
+  IncrementalRouting ();
+
+  RouterGraph m_graph;
+  std::map<const Face *, uint32_t> m_edges;              ///< @brief edge of every face
+  std::vector<ShortestPathTree> m_trees;                 ///< @brief tree towards every origin
+  std::vector< Ptr<const Name> > m_prefixes;             ///< @brief distinct prefixes of all origins
+  std::vector< std::vector<uint32_t> > m_prefixOrigins;  ///< @brief origins of every prefix
+  std::vector< std::vector<uint32_t> > m_originPrefixes; ///< @brief prefixes of every origin
+};
+
+IncrementalRouting::IncrementalRouting ()
+  : m_trees (m_graph.m_origins.size ())
+  , m_originPrefixes (m_graph.m_origins.size ())
+{
+  for (uint32_t edge = 0; edge < m_graph.m_faces.size (); edge++)
+    {
+      if (m_graph.m_faces[edge] != 0)
+        m_edges[PeekPointer (m_graph.m_faces[edge])] = edge;
+    }
 
-      // remember interface statuses
-      std::vector<uint16_t> originalMetric (l3->GetNFaces ());
-      for (uint32_t faceId = 0; faceId < l3->GetNFaces (); faceId++)
+  std::map<Name, uint32_t> prefixes;
+  for (uint32_t origin = 0; origin < m_graph.m_origins.size (); origin++)
+    {
+      BOOST_FOREACH (const Ptr<const Name> &prefix, m_graph.m_vertices[m_graph.m_origins[origin]]->GetLocalPrefixes ())
         {
-          originalMetric[faceId] = l3->GetFace (faceId)->GetMetric ();
-          l3->GetFace (faceId)->SetMetric (std::numeric_limits<uint16_t>::max ()-1); // value std::numeric_limits<uint16_t>::max () MUST NOT be used (reserved)
+          std::map<Name, uint32_t>::iterator item = prefixes.find (*prefix);
+          if (item == prefixes.end ())
+            {
+              item = prefixes.insert (std::make_pair (*prefix, m_prefixes.size ())).first;
+              m_prefixes.push_back (prefix);
+              m_prefixOrigins.push_back (std::vector<uint32_t> ());
+            }
+
+          m_prefixOrigins[item->second].push_back (origin);
+          m_originPrefixes[origin].push_back (item->second);
         }
+    }
 
-      for (uint32_t enabledFaceId = 0; enabledFaceId < l3->GetNFaces (); enabledFaceId++)
+  BuildTrees job = { &m_graph, &m_trees };
+  RunInParallel (job, m_graph.m_origins.size ());
+}
+
+static boost::shared_ptr<IncrementalRouting> g_incrementalRouting;
+
+static void
+ResetIncrementalRouting ()
+{
+  g_incrementalRouting.reset ();
+}
+
+} // namespace
+/// @endcond
+
+void
+GlobalRoutingHelper::CalculateRoutes (bool invalidatedRoutes/* = true*/)
+{
+  // Shortest paths from every node are calculated in parallel (see NdnGlobalRoutingThreads global
+  // value) on a snapshot of the graph formed by GlobalRouter objects.  FIBs are updated only after
+  // all calculations are finished.
+  BooleanValue incremental;
+  g_routingIncremental.GetValue (incremental);
+  if (!incremental.Get ())
+    {
+      g_incrementalRouting.reset ();
+
+      RouterGraph graph;
+      std::vector< std::vector<Route> > routes (graph.m_nodes);
+
+      BestRoutes job = { &graph, &routes };
+      RunInParallel (job, graph.m_localNodes.size ());
+
+      InstallRoutes (graph, routes, invalidatedRoutes);
+      return;
+    }
+
+  // In incremental mode, shortest path trees towards every origin are calculated instead and
+  // kept until the simulator is destroyed, so UpdateRoutes can patch them
+  boost::shared_ptr<IncrementalRouting> state (new IncrementalRouting ());
+  const RouterGraph &graph = state->m_graph;
+  std::vector< std::vector<Route> > routes (graph.m_nodes);
+
+  BOOST_FOREACH (uint32_t source, graph.m_localNodes)
+    {
+      for (uint32_t origin = 0; origin < graph.m_origins.size (); origin++)
         {
-          if (DynamicCast<ndn::NetDeviceFace> (l3->GetFace (enabledFaceId)) == 0)
+          const ShortestPathTree &tree = state->m_trees[origin];
+          if (graph.m_origins[origin] == source || tree.m_next[source] == NO_EDGE)
             continue;
 
-          // enabling only faceId
-          l3->GetFace (enabledFaceId)->SetMetric (originalMetric[enabledFaceId]);
+          Route route = { origin, tree.m_next[source], tree.m_distance[source], tree.m_delay[source] };
+          routes[source].push_back (route);
+        }
+    }
 
-          DistancesMap    distances;
+  InstallRoutes (graph, routes, invalidatedRoutes);
 
-          NS_LOG_DEBUG ("-----------");
+  if (g_incrementalRouting == 0)
+    {
+      Simulator::ScheduleDestroy (&ResetIncrementalRouting);
+    }
+  g_incrementalRouting = state;
+}
 
-          dijkstra_shortest_paths (graph, source,
-                                   // predecessor_map (boost::ref(predecessors))
-                                   // .
-                                   distance_map (boost::ref(distances))
-                                   .
-                                   distance_inf (WeightInf)
-                                   .
-                                   distance_zero (WeightZero)
-                                   .
-                                   distance_compare (boost::WeightCompare ())
-                                   .
-                                   distance_combine (boost::WeightCombine ())
-                                   );
+void
+GlobalRoutingHelper::UpdateRoutes (Ptr<Face> face)
+{
+  if (g_incrementalRouting == 0)
+    return; // incremental routing is disabled or CalculateRoutes has not been called yet
 
-          // NS_LOG_DEBUG (predecessors.size () << ", " << distances.size ());
+  IncrementalRouting &state = *g_incrementalRouting;
+  std::map<const Face *, uint32_t>::iterator item = state.m_edges.find (PeekPointer (face));
+  if (item == state.m_edges.end ())
+    {
+      NS_LOG_DEBUG ("Face " << *face << " is not known to global routing");
+      return;
+    }
 
-          for (DistancesMap::iterator i = distances.begin ();
-               i != distances.end ();
-               i++)
+  uint32_t edge = item->second;
+  uint32_t oldMetric = state.m_graph.m_metrics[edge];
+  state.m_graph.m_metrics[edge] = EdgeMetric (face);
+  if (state.m_graph.m_metrics[edge] == oldMetric)
+    return;
+
+  NS_LOG_DEBUG ("Metric of face " << *face << " changed from " << oldMetric << " to " << state.m_graph.m_metrics[edge]);
+
+  uint32_t origins = state.m_graph.m_origins.size ();
+  std::vector< std::vector<TreeChange> > changes (origins);
+  UpdateTrees job = { &state.m_graph, &state.m_trees, edge, oldMetric, &changes };
+  RunInParallel (job, origins);
+
+  // Old next hops of changed paths are invalidated, then routes to all origins of affected
+  // prefixes are added again (the same as the full recalculation does for these FIB entries)
+  std::set< std::pair<uint32_t, uint32_t> > affected; // (node, prefix)
+  for (uint32_t origin = 0; origin < origins; origin++)
+    {
+      BOOST_FOREACH (const TreeChange &change, changes[origin])
+        {
+          if (!state.m_graph.m_isLocal[change.m_vertex])
+            continue; // FIB of the node is updated by the process that simulates it
+
+          Ptr<Fib> fib = state.m_graph.m_vertices[change.m_vertex]->GetObject<Fib> ();
+          BOOST_FOREACH (uint32_t prefix, state.m_originPrefixes[origin])
             {
-              if (i->first == source)
-                continue;
-              else
+              Ptr<fib::Entry> entry = fib->Find (*state.m_prefixes[prefix]);
+              if (entry != 0 && change.m_next != NO_EDGE)
                 {
-                  // cout << "  Node " << i->first->GetObject<Node> ()->GetId ();
-                  if (i->second.get<0> () == 0)
-                    {
-                      // cout << " is unreachable" << endl;
-                    }
-                  else
-                    {
-                      BOOST_FOREACH (const Ptr<const Name> &prefix, i->first->GetLocalPrefixes ())
-                        {
-                          NS_LOG_DEBUG (" prefix " << *prefix << " reachable via face " << *i->second.get<0> ()
-                                        << " with distance " << i->second.get<1> ()
-                                        << " with delay " << i->second.get<2> ());
-
-                          if (i->second.get<0> ()->GetMetric () == std::numeric_limits<uint16_t>::max ()-1)
-                            continue;
-
-                          Ptr<fib::Entry> entry = fib->Add (prefix, i->second.get<0> (), i->second.get<1> ());
-                          entry->SetRealDelayToProducer (i->second.get<0> (), Seconds (i->second.get<2> ()));
-
-                          Ptr<Limits> faceLimits = i->second.get<0> ()->GetObject<Limits> ();
-
-                          Ptr<Limits> fibLimits = entry->GetObject<Limits> ();
-                          if (fibLimits != 0)
-                            {
-                              // if it was created by the forwarding strategy via DidAddFibEntry event
-                              fibLimits->SetLimits (faceLimits->GetMaxRate (), 2 * i->second.get<2> () /*exact RTT*/);
-                              NS_LOG_DEBUG ("Set limit for prefix " << *prefix << " " << faceLimits->GetMaxRate () << " / " <<
-                                            2*i->second.get<2> () << "s (" << faceLimits->GetMaxRate () * 2 * i->second.get<2> () << ")");
-                            }
-                        }
-                    }
+                  entry->InvalidateFace (state.m_graph.m_faces[change.m_next]);
                 }
+              affected.insert (std::make_pair (change.m_vertex, prefix));
             }
+        }
+    }
 
-          // disabling the face again
-          l3->GetFace (enabledFaceId)->SetMetric (std::numeric_limits<uint16_t>::max ()-1);
+  for (std::set< std::pair<uint32_t, uint32_t> >::iterator i = affected.begin (); i != affected.end (); i++)
+    {
+      uint32_t source = i->first;
+
+      // one route per face: the smallest metric and, as in InstallRoutes, the delay of the last origin
+      std::vector<Route> routes;
+      BOOST_FOREACH (uint32_t origin, state.m_prefixOrigins[i->second])
+        {
+          const ShortestPathTree &tree = state.m_trees[origin];
+          if (state.m_graph.m_origins[origin] == source || tree.m_next[source] == NO_EDGE)
+            continue;
+
+          std::vector<Route>::iterator route = routes.begin ();
+          while (route != routes.end () && route->m_edge != tree.m_next[source])
+            route++;
+
+          if (route == routes.end ())
+            {
+              Route newRoute = { origin, tree.m_next[source], tree.m_distance[source], tree.m_delay[source] };
+              routes.push_back (newRoute);
+            }
+          else
+            {
+              route->m_metric = std::min (route->m_metric, tree.m_distance[source]);
+              route->m_delay = tree.m_delay[source];
+            }
         }
 
-      // recover original interface statuses
-      for (uint32_t faceId = 0; faceId < l3->GetNFaces (); faceId++)
+      Ptr<Fib> fib = state.m_graph.m_vertices[source]->GetObject<Fib> ();
+      BOOST_FOREACH (const Route &route, routes)
         {
-          l3->GetFace (faceId)->SetMetric (originalMetric[faceId]);
+          AddRoute (fib, state.m_prefixes[i->second], state.m_graph.m_faces[route.m_edge], route.m_metric, route.m_delay);
         }
     }
 }
 
+void
+GlobalRoutingHelper::CalculateAllPossibleRoutes (bool invalidatedRoutes/* = true*/)
+{
+  // For every face of every node, the best path that starts with this face is calculated, as if
+  // all other faces of the node had very large metric (std::numeric_limits<uint16_t>::max ()-1).
+  // See AllPossibleRoutes for details.  These routes cannot be updated incrementally.
+  g_incrementalRouting.reset ();
+
+  RouterGraph graph;
+  std::vector< std::vector<Route> > routes (graph.m_nodes);
+
+  AllPossibleRoutes job;
+  job.m_graph = &graph;
+  job.m_routes = &routes;
+  job.Run ();
+
+  InstallRoutes (graph, routes, invalidatedRoutes);
+}
+
 
 } // namespace ndn
 } // namespace ns3
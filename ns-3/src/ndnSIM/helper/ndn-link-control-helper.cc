@@ -30,6 +30,7 @@
 
 #include "ns3/ndn-l3-protocol.h"
 #include "ns3/ndn-net-device-face.h"
+#include "ns3/ndn-global-routing-helper.h"
 
 NS_LOG_COMPONENT_DEFINE ("ndn.LinkControlHelper");
 
@@ -75,6 +76,9 @@ LinkControlHelper::FailLink (Ptr<Node> node1, Ptr<Node> node2)
 
           face1->SetUp (false);
           face2->SetUp (false);
+
+          GlobalRoutingHelper::UpdateRoutes (face1);
+          GlobalRoutingHelper::UpdateRoutes (face2);
           break;
         }
     }
@@ -124,6 +128,9 @@ LinkControlHelper::UpLink (Ptr<Node> node1, Ptr<Node> node2)
 
           face1->SetUp (true);
           face2->SetUp (true);
+
+          GlobalRoutingHelper::UpdateRoutes (face1);
+          GlobalRoutingHelper::UpdateRoutes (face2);
           break;
         }
     }
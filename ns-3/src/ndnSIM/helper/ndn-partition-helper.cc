@@ -0,0 +1,785 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ndn-partition-helper.h"
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include "ns3/uinteger.h"
+
+#ifdef NS3_MPI
+#include "ns3/mpi-interface.h"
+#endif
+
+#include <boost/lexical_cast.hpp>
+#include <boost/foreach.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <queue>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.PartitionHelper");
+
+namespace ns3 {
+namespace ndn {
+
+/// @cond include_hidden
+namespace {
+
+static const uint32_t NONE = std::numeric_limits<uint32_t>::max ();
+
+// maximum number of refinement passes on each level
+static const uint32_t MAX_REFINE_PASSES = 8;
+
+// number of moves without improvement after which a pass of RefineBisection stops
+static const uint32_t MAX_UNPRODUCTIVE_MOVES = 100;
+
+// number of different seeds tried by each bisection of the initial partitioning
+static const uint32_t BISECTION_ATTEMPTS = 4;
+
+/**
+ * @brief Undirected graph with vertex and edge weights in compressed sparse row form
+ *
+ * Every edge is stored twice (once for each of its ends), parallel edges are merged
+ */
+struct Graph
+{
+  uint32_t
+  GetN () const
+  {
+    return m_weights.size ();
+  }
+
+  uint32_t
+  GetTotalWeight () const
+  {
+    uint32_t total = 0;
+    for (uint32_t vertex = 0; vertex < GetN (); vertex++)
+      total += m_weights[vertex];
+    return total;
+  }
+
+  std::vector<uint32_t> m_weights;     ///< @brief vertex weights
+  std::vector<uint32_t> m_offsets;     ///< @brief edges of vertex v are [m_offsets[v], m_offsets[v+1])
+  std::vector<uint32_t> m_targets;     ///< @brief other end of the edge
+  std::vector<uint32_t> m_edgeWeights; ///< @brief edge weights
+};
+
+/**
+ * @brief Helper to build Graph from the adjacency of every vertex, merging parallel edges
+ */
+class GraphBuilder
+{
+public:
+  GraphBuilder (Graph &graph, uint32_t vertices)
+    : m_graph (graph)
+    , m_position (vertices, NONE)
+  {
+    m_graph.m_offsets.clear ();
+    m_graph.m_targets.clear ();
+    m_graph.m_edgeWeights.clear ();
+    m_graph.m_offsets.push_back (0);
+  }
+
+  void
+  AddEdge (uint32_t target, uint32_t weight)
+  {
+    if (m_position[target] == NONE)
+      {
+        m_position[target] = m_graph.m_targets.size ();
+        m_graph.m_targets.push_back (target);
+        m_graph.m_edgeWeights.push_back (weight);
+      }
+    else
+      m_graph.m_edgeWeights[m_position[target]] += weight;
+  }
+
+  void
+  EndVertex ()
+  {
+    for (uint32_t edge = m_graph.m_offsets.back (); edge < m_graph.m_targets.size (); edge++)
+      m_position[m_graph.m_targets[edge]] = NONE;
+    m_graph.m_offsets.push_back (m_graph.m_targets.size ());
+  }
+
+private:
+  Graph &m_graph;
+  std::vector<uint32_t> m_position; ///< @brief position of the edge to the vertex in the current adjacency
+};
+
+/**
+ * @brief Collapse heavy-edge matching of the graph
+ *
+ * Vertices are visited from the lowest degree, and every unmatched vertex is matched with its
+ * unmatched neighbor connected by the heaviest edge (unless the combined weight exceeds maxWeight)
+ *
+ * @param map coarse vertex of every vertex of the fine graph
+ */
+static void
+Coarsen (const Graph &fine, uint32_t maxWeight, Graph &coarse, std::vector<uint32_t> &map)
+{
+  uint32_t n = fine.GetN ();
+
+  std::vector< std::pair<uint32_t, uint32_t> > order (n); // (degree, vertex)
+  for (uint32_t vertex = 0; vertex < n; vertex++)
+    order[vertex] = std::make_pair (fine.m_offsets[vertex + 1] - fine.m_offsets[vertex], vertex);
+  std::sort (order.begin (), order.end ());
+
+  std::vector<uint32_t> match (n, NONE);
+  for (uint32_t i = 0; i < n; i++)
+    {
+      uint32_t vertex = order[i].second;
+      if (match[vertex] != NONE)
+        continue;
+
+      uint32_t best = vertex;
+      uint32_t bestWeight = 0;
+      for (uint32_t edge = fine.m_offsets[vertex]; edge < fine.m_offsets[vertex + 1]; edge++)
+        {
+          uint32_t neighbor = fine.m_targets[edge];
+          if (match[neighbor] != NONE ||
+              fine.m_weights[vertex] + fine.m_weights[neighbor] > maxWeight)
+            continue;
+
+          if (fine.m_edgeWeights[edge] > bestWeight ||
+              (fine.m_edgeWeights[edge] == bestWeight && fine.m_weights[neighbor] < fine.m_weights[best]))
+            {
+              best = neighbor;
+              bestWeight = fine.m_edgeWeights[edge];
+            }
+        }
+
+      match[vertex] = best;
+      match[best] = vertex;
+    }
+
+  map.assign (n, NONE);
+  std::vector<uint32_t> members; // fine vertices of every coarse vertex (one or two)
+  for (uint32_t vertex = 0; vertex < n; vertex++)
+    {
+      if (map[vertex] != NONE)
+        continue;
+
+      map[vertex] = map[match[vertex]] = coarse.m_weights.size ();
+      coarse.m_weights.push_back (fine.m_weights[vertex]);
+      members.push_back (vertex);
+      if (match[vertex] != vertex)
+        coarse.m_weights.back () += fine.m_weights[match[vertex]];
+    }
+
+  GraphBuilder builder (coarse, coarse.GetN ());
+  for (uint32_t coarseVertex = 0; coarseVertex < coarse.GetN (); coarseVertex++)
+    {
+      uint32_t vertex = members[coarseVertex];
+      for (int side = 0; side < 2; side++, vertex = match[vertex])
+        {
+          if (side == 1 && match[vertex] == vertex)
+            break;
+
+          for (uint32_t edge = fine.m_offsets[vertex]; edge < fine.m_offsets[vertex + 1]; edge++)
+            {
+              uint32_t target = map[fine.m_targets[edge]];
+              if (target != coarseVertex)
+                builder.AddEdge (target, fine.m_edgeWeights[edge]);
+            }
+        }
+      builder.EndVertex ();
+    }
+}
+
+/**
+ * @brief Vertices in breadth-first order, starting from the component of the start vertex
+ *
+ * If peripheral is true, the search in each component starts from a pseudo-peripheral vertex
+ * (the last vertex reached from the start).  Disconnected components are visited one after another.
+ */
+static std::vector<uint32_t>
+BreadthFirstOrder (const Graph &graph, uint32_t start, bool peripheral)
+{
+  uint32_t n = graph.GetN ();
+  std::vector<uint32_t> order;
+  std::vector<uint8_t> visited (n, 0);
+
+  for (uint32_t i = 0; i < n; i++)
+    {
+      uint32_t root = (start + i) % n;
+      if (visited[root])
+        continue;
+
+      for (int round = peripheral ? 0 : 1; round < 2; round++)
+        {
+          size_t begin = order.size ();
+          order.push_back (root);
+          visited[root] = 1;
+          for (size_t j = begin; j < order.size (); j++)
+            {
+              uint32_t vertex = order[j];
+              for (uint32_t edge = graph.m_offsets[vertex]; edge < graph.m_offsets[vertex + 1]; edge++)
+                {
+                  if (!visited[graph.m_targets[edge]])
+                    {
+                      visited[graph.m_targets[edge]] = 1;
+                      order.push_back (graph.m_targets[edge]);
+                    }
+                }
+            }
+
+          if (round == 0)
+            {
+              root = order.back ();
+              for (size_t j = begin; j < order.size (); j++)
+                visited[order[j]] = 0;
+              order.resize (begin);
+            }
+        }
+    }
+
+  return order;
+}
+
+/**
+ * @brief Grow partition 0 from a seed vertex until it reaches the target weight, every time
+ *        adding the vertex with the strongest connection to the partition.  The rest of vertices
+ *        are assigned to partition 1.
+ */
+static void
+GrowRegion (const Graph &graph, uint32_t target, const std::vector<uint32_t> &seeds, std::vector<uint32_t> &part)
+{
+  uint32_t n = graph.GetN ();
+  size_t nextSeed = 0;
+
+  part.assign (n, 1);
+  std::vector<uint32_t> connection (n, 0);
+  uint32_t weight = 0;
+
+  // (connection, n - vertex): the strongest connection first, then the lowest vertex
+  std::priority_queue< std::pair<uint32_t, uint32_t> > candidates;
+  while (weight < target)
+    {
+      uint32_t vertex = NONE;
+      while (!candidates.empty () && vertex == NONE)
+        {
+          uint32_t candidate = n - candidates.top ().second;
+          if (part[candidate] == 1 && connection[candidate] == candidates.top ().first)
+            vertex = candidate;
+          candidates.pop ();
+        }
+
+      if (vertex == NONE)
+        {
+          // start a new region (first vertex or disconnected graph)
+          while (nextSeed < seeds.size () && part[seeds[nextSeed]] == 0)
+            nextSeed++;
+          if (nextSeed == seeds.size ())
+            break;
+          vertex = seeds[nextSeed];
+        }
+
+      // do not overshoot the target more than undershoot it
+      if (weight > 0 && weight + graph.m_weights[vertex] - target > target - weight)
+        break;
+
+      part[vertex] = 0;
+      weight += graph.m_weights[vertex];
+
+      for (uint32_t edge = graph.m_offsets[vertex]; edge < graph.m_offsets[vertex + 1]; edge++)
+        {
+          uint32_t neighbor = graph.m_targets[edge];
+          if (part[neighbor] == 1)
+            {
+              connection[neighbor] += graph.m_edgeWeights[edge];
+              candidates.push (std::make_pair (connection[neighbor], n - neighbor));
+            }
+        }
+    }
+}
+
+/**
+ * @brief Total weight of edges between different partitions
+ */
+static uint64_t
+GetCut (const Graph &graph, const std::vector<uint32_t> &part)
+{
+  uint64_t cut = 0;
+  for (uint32_t vertex = 0; vertex < graph.GetN (); vertex++)
+    {
+      for (uint32_t edge = graph.m_offsets[vertex]; edge < graph.m_offsets[vertex + 1]; edge++)
+        {
+          if (part[vertex] != part[graph.m_targets[edge]])
+            cut += graph.m_edgeWeights[edge];
+        }
+    }
+  return cut / 2; // every edge is stored twice
+}
+
+/**
+ * @brief Greedy k-way refinement: boundary vertices are moved to the adjacent partition, if it
+ *        reduces the cut or improves balance without increasing the cut.  Vertices of partitions
+ *        that are heavier than their maximum weight are moved even if the cut increases.
+ */
+static void
+Refine (const Graph &graph, const std::vector<uint32_t> &maxWeight, std::vector<uint32_t> &part)
+{
+  uint32_t n = graph.GetN ();
+  uint32_t partitions = maxWeight.size ();
+
+  std::vector<uint32_t> partWeight (partitions, 0);
+  for (uint32_t vertex = 0; vertex < n; vertex++)
+    partWeight[part[vertex]] += graph.m_weights[vertex];
+
+  std::vector<uint32_t> connection (partitions, 0);
+  std::vector<uint32_t> adjacent;
+
+  for (uint32_t pass = 0; pass < MAX_REFINE_PASSES; pass++)
+    {
+      uint32_t moves = 0;
+      for (uint32_t vertex = 0; vertex < n; vertex++)
+        {
+          uint32_t own = part[vertex];
+          uint32_t weight = graph.m_weights[vertex];
+
+          for (uint32_t edge = graph.m_offsets[vertex]; edge < graph.m_offsets[vertex + 1]; edge++)
+            {
+              uint32_t other = part[graph.m_targets[edge]];
+              if (connection[other] == 0)
+                adjacent.push_back (other);
+              connection[other] += graph.m_edgeWeights[edge];
+            }
+
+          bool overweight = partWeight[own] > maxWeight[own];
+          uint32_t best = own;
+          int64_t bestGain = 0;
+          for (size_t i = 0; i < adjacent.size (); i++)
+            {
+              uint32_t other = adjacent[i];
+              if (other == own || partWeight[other] + weight > maxWeight[other])
+                continue;
+
+              int64_t gain = static_cast<int64_t> (connection[other]) - connection[own];
+              if (best == own || gain > bestGain ||
+                  (gain == bestGain && partWeight[other] < partWeight[best]))
+                {
+                  best = other;
+                  bestGain = gain;
+                }
+            }
+
+          if (best == own && overweight)
+            {
+              // no adjacent partition can take the vertex, move it to any partition that can
+              for (uint32_t other = 0; other < partitions && best == own; other++)
+                {
+                  if (other != own && partWeight[other] + weight <= maxWeight[other])
+                    best = other;
+                }
+              bestGain = -static_cast<int64_t> (connection[own]);
+            }
+
+          if (best != own &&
+              (bestGain > 0 || overweight ||
+               (bestGain == 0 && partWeight[best] + weight < partWeight[own])))
+            {
+              partWeight[own] -= weight;
+              partWeight[best] += weight;
+              part[vertex] = best;
+              moves++;
+            }
+
+          for (size_t i = 0; i < adjacent.size (); i++)
+            connection[adjacent[i]] = 0;
+          connection[own] = 0;
+          adjacent.clear ();
+        }
+
+      if (moves == 0)
+        break;
+    }
+}
+
+
+/**
+ * @brief Fiduccia-Mattheyses refinement of a bisection
+ *
+ * Unlike Refine, vertices are moved even if the cut temporarily increases (every vertex at most
+ * once per pass, the vertex with the highest gain first), and the pass is then rolled back to the
+ * smallest cut seen.  This allows escaping from local minima of the greedy refinement.
+ */
+static void
+RefineBisection (const Graph &graph, const std::vector<uint32_t> &maxWeight, std::vector<uint32_t> &part)
+{
+  uint32_t n = graph.GetN ();
+
+  std::vector<uint32_t> partWeight (2, 0);
+  for (uint32_t vertex = 0; vertex < n; vertex++)
+    partWeight[part[vertex]] += graph.m_weights[vertex];
+
+  std::vector<int64_t> gain (n);
+  std::vector<uint8_t> locked (n);
+  std::vector<uint32_t> moves;
+  for (uint32_t pass = 0; pass < MAX_REFINE_PASSES; pass++)
+    {
+      // (gain, n - vertex) of vertices of each side: the highest gain first, then the lowest vertex
+      std::priority_queue< std::pair<int64_t, uint32_t> > candidates[2];
+      for (uint32_t vertex = 0; vertex < n; vertex++)
+        {
+          gain[vertex] = 0;
+          for (uint32_t edge = graph.m_offsets[vertex]; edge < graph.m_offsets[vertex + 1]; edge++)
+            {
+              if (part[graph.m_targets[edge]] == part[vertex])
+                gain[vertex] -= graph.m_edgeWeights[edge];
+              else
+                gain[vertex] += graph.m_edgeWeights[edge];
+            }
+          candidates[part[vertex]].push (std::make_pair (gain[vertex], n - vertex));
+        }
+      std::fill (locked.begin (), locked.end (), 0);
+      moves.clear ();
+
+      int64_t cut = 0;
+      int64_t bestCut = 0;
+      size_t bestMoves = 0;
+      while (moves.size () < bestMoves + MAX_UNPRODUCTIVE_MOVES)
+        {
+          uint32_t vertex = NONE;
+          for (uint32_t side = 0; side < 2; side++)
+            {
+              while (!candidates[side].empty ())
+                {
+                  uint32_t candidate = n - candidates[side].top ().second;
+                  if (!locked[candidate] && gain[candidate] == candidates[side].top ().first)
+                    break;
+                  candidates[side].pop ();
+                }
+              if (candidates[side].empty ())
+                continue;
+
+              uint32_t candidate = n - candidates[side].top ().second;
+              if (partWeight[1 - side] + graph.m_weights[candidate] > maxWeight[1 - side])
+                continue; // the other side cannot take the vertex
+
+              if (vertex == NONE || gain[candidate] > gain[vertex] ||
+                  (gain[candidate] == gain[vertex] && partWeight[side] > partWeight[part[vertex]]))
+                vertex = candidate;
+            }
+          if (vertex == NONE)
+            break;
+
+          uint32_t from = part[vertex];
+          candidates[from].pop ();
+          cut -= gain[vertex];
+          partWeight[from] -= graph.m_weights[vertex];
+          partWeight[1 - from] += graph.m_weights[vertex];
+          part[vertex] = 1 - from;
+          locked[vertex] = 1;
+          moves.push_back (vertex);
+
+          for (uint32_t edge = graph.m_offsets[vertex]; edge < graph.m_offsets[vertex + 1]; edge++)
+            {
+              uint32_t neighbor = graph.m_targets[edge];
+              if (locked[neighbor])
+                continue;
+
+              if (part[neighbor] == part[vertex])
+                gain[neighbor] -= 2 * static_cast<int64_t> (graph.m_edgeWeights[edge]);
+              else
+                gain[neighbor] += 2 * static_cast<int64_t> (graph.m_edgeWeights[edge]);
+              candidates[part[neighbor]].push (std::make_pair (gain[neighbor], n - neighbor));
+            }
+
+          if (cut < bestCut)
+            {
+              bestCut = cut;
+              bestMoves = moves.size ();
+            }
+        }
+
+      // roll back moves after the smallest cut
+      for (size_t i = moves.size (); i-- > bestMoves; )
+        {
+          uint32_t vertex = moves[i];
+          partWeight[part[vertex]] -= graph.m_weights[vertex];
+          part[vertex] = 1 - part[vertex];
+          partWeight[part[vertex]] += graph.m_weights[vertex];
+        }
+
+      if (bestMoves == 0)
+        break;
+    }
+}
+
+/**
+ * @brief Initial partitioning by recursive bisection
+ *
+ * Each bisection grows one half from several different seeds, refines it, and keeps the one with
+ * the smallest cut.  Vertices of the graph are assigned to partitions [first, first + partitions).
+ */
+static void
+Bisect (const Graph &graph, uint32_t partitions, double imbalance, uint32_t first, std::vector<uint32_t> &part)
+{
+  uint32_t n = graph.GetN ();
+  if (partitions == 1 || n == 0)
+    {
+      part.assign (n, first);
+      return;
+    }
+
+  uint32_t total = graph.GetTotalWeight ();
+  uint32_t heaviest = *std::max_element (graph.m_weights.begin (), graph.m_weights.end ());
+  uint32_t left = partitions / 2;
+
+  std::vector<uint32_t> targets (2);
+  targets[0] = static_cast<uint64_t> (total) * left / partitions;
+  targets[1] = total - targets[0];
+
+  std::vector<uint32_t> maxWeight (2);
+  for (int side = 0; side < 2; side++)
+    maxWeight[side] = std::max<uint32_t> (std::ceil (imbalance * targets[side]), targets[side] + heaviest);
+
+  std::vector<uint32_t> halves;
+  uint64_t bestCut = std::numeric_limits<uint64_t>::max ();
+  for (uint32_t attempt = 0; attempt < BISECTION_ATTEMPTS; attempt++)
+    {
+      std::vector<uint32_t> candidate;
+      GrowRegion (graph, targets[0], BreadthFirstOrder (graph, attempt * n / BISECTION_ATTEMPTS, attempt == 0), candidate);
+      Refine (graph, maxWeight, candidate); // fixes the balance, if needed
+      RefineBisection (graph, maxWeight, candidate);
+
+      uint64_t cut = GetCut (graph, candidate);
+      if (cut < bestCut)
+        {
+          bestCut = cut;
+          halves.swap (candidate);
+        }
+    }
+
+  part.resize (n);
+  for (uint32_t side = 0; side < 2; side++)
+    {
+      // subgraph induced by the half
+      Graph subgraph;
+      std::vector<uint32_t> vertices;
+      std::vector<uint32_t> index (n, NONE);
+      for (uint32_t vertex = 0; vertex < n; vertex++)
+        {
+          if (halves[vertex] == side)
+            {
+              index[vertex] = vertices.size ();
+              vertices.push_back (vertex);
+              subgraph.m_weights.push_back (graph.m_weights[vertex]);
+            }
+        }
+
+      GraphBuilder builder (subgraph, vertices.size ());
+      BOOST_FOREACH (uint32_t vertex, vertices)
+        {
+          for (uint32_t edge = graph.m_offsets[vertex]; edge < graph.m_offsets[vertex + 1]; edge++)
+            {
+              if (index[graph.m_targets[edge]] != NONE)
+                builder.AddEdge (index[graph.m_targets[edge]], graph.m_edgeWeights[edge]);
+            }
+          builder.EndVertex ();
+        }
+
+      std::vector<uint32_t> subpart;
+      Bisect (subgraph, side == 0 ? left : partitions - left, imbalance, side == 0 ? first : first + left, subpart);
+      for (uint32_t i = 0; i < vertices.size (); i++)
+        part[vertices[i]] = subpart[i];
+    }
+}
+
+} // namespace
+/// @endcond
+
+PartitionHelper::PartitionHelper ()
+  : m_imbalance (1.05)
+{
+}
+
+void
+PartitionHelper::SetImbalance (double imbalance)
+{
+  NS_ASSERT_MSG (imbalance >= 1.0, "Imbalance should not be less than 1.0");
+  m_imbalance = imbalance;
+}
+
+void
+PartitionHelper::AddLink (Ptr<Node> node1, Ptr<Node> node2, uint32_t weight/* = 1*/)
+{
+  m_links.push_back (std::make_pair (std::make_pair (node1, node2), weight));
+}
+
+std::vector<uint32_t>
+PartitionHelper::Calculate (const NodeContainer &nodes, uint32_t partitions) const
+{
+  NS_ASSERT_MSG (partitions > 0, "Number of partitions should be positive");
+
+  uint32_t n = nodes.GetN ();
+  if (partitions <= 1 || n == 0)
+    return std::vector<uint32_t> (n, 0);
+
+  std::map<const Node*, uint32_t> index;
+  for (uint32_t i = 0; i < n; i++)
+    index[PeekPointer (nodes.Get (i))] = i;
+
+  // adjacency of the input graph (both directions of every link)
+  std::vector< std::vector< std::pair<uint32_t, uint32_t> > > adjacency (n);
+  for (size_t i = 0; i < m_links.size (); i++)
+    {
+      std::map<const Node*, uint32_t>::const_iterator from = index.find (PeekPointer (m_links[i].first.first));
+      std::map<const Node*, uint32_t>::const_iterator to = index.find (PeekPointer (m_links[i].first.second));
+      if (from == index.end () || to == index.end () || from->second == to->second)
+        continue;
+
+      adjacency[from->second].push_back (std::make_pair (to->second, m_links[i].second));
+      adjacency[to->second].push_back (std::make_pair (from->second, m_links[i].second));
+    }
+
+  std::vector<Graph> levels (1);
+  levels[0].m_weights.assign (n, 1);
+  GraphBuilder builder (levels[0], n);
+  for (uint32_t vertex = 0; vertex < n; vertex++)
+    {
+      for (size_t i = 0; i < adjacency[vertex].size (); i++)
+        builder.AddEdge (adjacency[vertex][i].first, adjacency[vertex][i].second);
+      builder.EndVertex ();
+    }
+  adjacency.clear ();
+
+  // coarsening phase
+  uint32_t coarsenTo = std::max<uint32_t> (100, 20 * partitions);
+  uint32_t maxVertexWeight = std::max<uint32_t> (1, 1.5 * n / coarsenTo);
+  std::vector< std::vector<uint32_t> > maps;
+  while (levels.back ().GetN () > coarsenTo)
+    {
+      Graph coarse;
+      std::vector<uint32_t> map;
+      Coarsen (levels.back (), maxVertexWeight, coarse, map);
+      if (coarse.GetN () > 0.95 * levels.back ().GetN ())
+        break; // graph does not shrink anymore
+
+      levels.push_back (coarse);
+      maps.push_back (map);
+    }
+
+  NS_LOG_DEBUG ("Coarsened " << n << " vertices to " << levels.back ().GetN () << " in " << maps.size () << " levels");
+
+  // initial partitioning of the coarsest graph and refinement while projecting it back
+  uint32_t average = (n + partitions - 1) / partitions;
+  uint32_t maxWeight = std::max<uint32_t> (average + 1, std::ceil (m_imbalance * n / partitions));
+
+  std::vector<uint32_t> part;
+  Bisect (levels.back (), partitions, m_imbalance, 0, part);
+  for (size_t level = levels.size (); level-- > 0; )
+    {
+      if (level < maps.size ())
+        {
+          std::vector<uint32_t> finePart (levels[level].GetN ());
+          for (uint32_t vertex = 0; vertex < finePart.size (); vertex++)
+            finePart[vertex] = part[maps[level][vertex]];
+          part.swap (finePart);
+        }
+
+      uint32_t heaviest = *std::max_element (levels[level].m_weights.begin (), levels[level].m_weights.end ());
+      Refine (levels[level], std::vector<uint32_t> (partitions, std::max (maxWeight, average + heaviest)), part);
+    }
+
+  return part;
+}
+
+uint32_t
+PartitionHelper::Partition (const NodeContainer &nodes, uint32_t partitions) const
+{
+  std::vector<uint32_t> part = Calculate (nodes, partitions);
+
+  std::map<const Node*, uint32_t> partOf;
+  for (uint32_t i = 0; i < nodes.GetN (); i++)
+    {
+      nodes.Get (i)->SetAttribute ("SystemId", UintegerValue (part[i]));
+      partOf[PeekPointer (nodes.Get (i))] = part[i];
+    }
+
+  uint32_t cut = 0;
+  for (size_t i = 0; i < m_links.size (); i++)
+    {
+      std::map<const Node*, uint32_t>::const_iterator from = partOf.find (PeekPointer (m_links[i].first.first));
+      std::map<const Node*, uint32_t>::const_iterator to = partOf.find (PeekPointer (m_links[i].first.second));
+      if (from != partOf.end () && to != partOf.end () && from->second != to->second)
+        cut += m_links[i].second;
+    }
+
+  NS_LOG_INFO ("Partitioned " << nodes.GetN () << " nodes into " << partitions << " partitions, " << cut << " links are cut");
+  return cut;
+}
+
+bool
+PartitionHelper::IsLocal (Ptr<const Node> node)
+{
+#ifdef NS3_MPI
+  return !MpiInterface::IsEnabled () || node->GetSystemId () == MpiInterface::GetSystemId ();
+#else
+  return true;
+#endif
+}
+
+uint32_t
+PartitionHelper::GetSystemId ()
+{
+#ifdef NS3_MPI
+  return MpiInterface::IsEnabled () ? MpiInterface::GetSystemId () : 0;
+#else
+  return 0;
+#endif
+}
+
+uint32_t
+PartitionHelper::GetSize ()
+{
+#ifdef NS3_MPI
+  return MpiInterface::IsEnabled () ? MpiInterface::GetSize () : 1;
+#else
+  return 1;
+#endif
+}
+
+std::string
+PartitionHelper::GetRankFileName (const std::string &file)
+{
+  if (GetSize () <= 1 || file == "-")
+    return file;
+
+  return GetRankFileName (file, GetSystemId ());
+}
+
+std::string
+PartitionHelper::GetRankFileName (const std::string &file, uint32_t systemId)
+{
+  std::string suffix = "-rank" + boost::lexical_cast<std::string> (systemId);
+
+  size_t extension = file.rfind ('.');
+  size_t directory = file.rfind ('/');
+  if (extension == std::string::npos || extension == 0 ||
+      (directory != std::string::npos && extension <= directory + 1))
+    return file + suffix;
+
+  return file.substr (0, extension) + suffix + file.substr (extension);
+}
+
+} // namespace ndn
+} // namespace ns3
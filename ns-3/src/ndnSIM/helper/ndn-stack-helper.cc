@@ -55,6 +55,7 @@
 
 #include <limits>
 #include <map>
+#include <vector>
 #include <boost/foreach.hpp>
 #include <boost/lexical_cast.hpp>
 
@@ -189,13 +190,25 @@ StackHelper::EnableLimits (bool enable/* = true*/,
   m_avgInterestSize = avgInterest;
 }
 
+/**
+ * @brief State of Install, which is resolved once per NodeContainer and reused for all nodes
+ */
+struct StackHelper::InstallCache
+{
+  typedef std::map<TypeId, std::vector<NetDeviceFaceCreateCallback> > CallbackMap;
+
+  Ptr<const Name> m_defaultPrefix; ///< @brief Prefix of default routes (0, if not yet parsed)
+  CallbackMap m_callbacks;         ///< @brief Face creation callbacks that fit each NetDevice type
+};
+
 Ptr<FaceContainer>
 StackHelper::Install (const NodeContainer &c) const
 {
   Ptr<FaceContainer> faces = Create<FaceContainer> ();
+  InstallCache cache;
   for (NodeContainer::Iterator i = c.Begin (); i != c.End (); ++i)
     {
-      faces->AddAll (Install (*i));
+      DoInstall (*i, cache, faces);
     }
   return faces;
 }
@@ -209,14 +222,22 @@ StackHelper::InstallAll () const
 Ptr<FaceContainer>
 StackHelper::Install (Ptr<Node> node) const
 {
-  // NS_ASSERT_MSG (m_forwarding, "SetForwardingHelper() should be set prior calling Install() method");
   Ptr<FaceContainer> faces = Create<FaceContainer> ();
+  InstallCache cache;
+  DoInstall (node, cache, faces);
+  return faces;
+}
+
+void
+StackHelper::DoInstall (Ptr<Node> node, InstallCache &cache, Ptr<FaceContainer> faces) const
+{
+  // NS_ASSERT_MSG (m_forwarding, "SetForwardingHelper() should be set prior calling Install() method");
 
   if (node->GetObject<L3Protocol> () != 0)
     {
       NS_FATAL_ERROR ("StackHelper::Install (): Installing "
                       "a NdnStack to a node with an existing Ndn object");
-      return 0;
+      return;
     }
 
   // Create L3Protocol
@@ -238,6 +259,11 @@ StackHelper::Install (Ptr<Node> node) const
   // Aggregate L3Protocol on node
   node->AggregateObject (ndn);
 
+  if (m_needSetDefaultRoutes && cache.m_defaultPrefix == 0)
+    {
+      cache.m_defaultPrefix = Create<Name> ("/");
+    }
+
   for (uint32_t index=0; index < node->GetNDevices (); index++)
     {
       Ptr<NetDevice> device = node->GetDevice (index);
@@ -246,20 +272,32 @@ StackHelper::Install (Ptr<Node> node) const
       // if (DynamicCast<LoopbackNetDevice> (device) != 0)
       //   continue; // don't create face for a LoopbackNetDevice
 
-      Ptr<NetDeviceFace> face;
-
-      for (std::list< std::pair<TypeId, NetDeviceFaceCreateCallback> >::const_iterator item = m_netDeviceCallbacks.begin ();
-           item != m_netDeviceCallbacks.end ();
-           item++)
+      TypeId deviceType = device->GetInstanceTypeId ();
+      InstallCache::CallbackMap::iterator callbacks = cache.m_callbacks.find (deviceType);
+      if (callbacks == cache.m_callbacks.end ())
         {
-          if (device->GetInstanceTypeId () == item->first ||
-              device->GetInstanceTypeId ().IsChildOf (item->first))
+          callbacks = cache.m_callbacks.insert (std::make_pair (deviceType, std::vector<NetDeviceFaceCreateCallback> ())).first;
+          for (NetDeviceCallbackList::const_iterator item = m_netDeviceCallbacks.begin ();
+               item != m_netDeviceCallbacks.end ();
+               item++)
             {
-              face = item->second (node, ndn, device);
-              if (face != 0)
-                break;
+              if (deviceType == item->first ||
+                  deviceType.IsChildOf (item->first))
+                {
+                  callbacks->second.push_back (item->second);
+                }
             }
         }
+
+      Ptr<NetDeviceFace> face;
+      for (std::vector<NetDeviceFaceCreateCallback>::const_iterator callback = callbacks->second.begin ();
+           callback != callbacks->second.end ();
+           callback++)
+        {
+          face = (*callback) (node, ndn, device);
+          if (face != 0)
+            break;
+        }
       if (face == 0)
         {
           face = DefaultNetDeviceCallback (node, ndn, device);
@@ -268,14 +306,13 @@ StackHelper::Install (Ptr<Node> node) const
       if (m_needSetDefaultRoutes)
         {
           // default route with lowest priority possible
-          AddRoute (node, "/", StaticCast<Face> (face), std::numeric_limits<int32_t>::max ());
+          NS_LOG_LOGIC ("[" << node->GetId () << "]$ route add / via " << *face << " metric " << std::numeric_limits<int32_t>::max ());
+          fib->Add (cache.m_defaultPrefix, face, std::numeric_limits<int32_t>::max ());
         }
 
       face->SetUp ();
       faces->Add (face);
     }
-
-  return faces;
 }
 
 void
@@ -206,6 +206,9 @@ public:
    * The program will assert if this method is called on a container with a node
    * that already has an ndn object aggregated to it.
    *
+   * Prefix of default routes (see SetDefaultRoutes) and face creation callbacks for each
+   * NetDevice type are resolved only once for the whole container.
+   *
    * \param c NodeContainer that holds the set of nodes on which to install the
    * new stacks.
    *
@@ -286,6 +289,11 @@ public:
   SetDefaultRoutes (bool needSet);
 
 private:
+  struct InstallCache;
+
+  void
+  DoInstall (Ptr<Node> node, InstallCache &cache, Ptr<FaceContainer> faces) const;
+
   Ptr<NetDeviceFace>
   DefaultNetDeviceCallback (Ptr<Node> node, Ptr<L3Protocol> ndn, Ptr<NetDevice> netDevice) const;
 
@@ -24,8 +24,14 @@
 #include "../../utils/trie/lru-policy.h"
 #include "../../utils/trie/fifo-policy.h"
 #include "../../utils/trie/lfu-policy.h"
+#include "../../utils/trie/lfu-bucket-policy.h"
 #include "../../utils/trie/multi-policy.h"
 #include "../../utils/trie/aggregate-stats-policy.h"
+#include "../../utils/trie/flat-trie.h"
+
+#include "custom-policies/tinylfu-policy.h"
+#include "custom-policies/arc-policy.h"
+#include "custom-policies/s3fifo-policy.h"
 
 #define NS_OBJECT_ENSURE_REGISTERED_TEMPL(type, templ)  \
   static struct X ## type ## templ ## RegistrationClass \
@@ -36,6 +42,15 @@
     }                                                   \
   } x_ ## type ## templ ## RegistrationVariable
 
+#define NS_OBJECT_ENSURE_REGISTERED_TEMPL_TRIE(type, templ, trie)    \
+  static struct X ## type ## templ ## trie ## RegistrationClass      \
+  {                                                                 \
+    X ## type ## templ ## trie ## RegistrationClass () {             \
+      ns3::TypeId tid = type<templ, trie>::GetTypeId ();             \
+      tid.GetParent ();                                             \
+    }                                                               \
+  } x_ ## type ## templ ## trie ## RegistrationVariable
+
 namespace ns3 {
 namespace ndn {
 
@@ -64,10 +79,34 @@ template class ContentStoreImpl<fifo_policy_traits>;
  **/
 template class ContentStoreImpl<lfu_policy_traits>;
 
+/**
+ * @brief ContentStore with LFU cache replacement policy and constant time updates
+ **/
+template class ContentStoreImpl<lfu_bucket_policy_traits>;
+
+/**
+ * @brief ContentStore with LRU cache replacement policy and TinyLFU admission filter
+ **/
+template class ContentStoreImpl<tinylfu_policy_traits>;
+
+/**
+ * @brief ContentStore with Adaptive Replacement Cache (ARC) policy
+ **/
+template class ContentStoreImpl<arc_policy_traits>;
+
+/**
+ * @brief ContentStore with S3-FIFO cache replacement policy
+ **/
+template class ContentStoreImpl<s3fifo_policy_traits>;
+
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, lru_policy_traits);
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, random_policy_traits);
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, fifo_policy_traits);
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, lfu_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, lfu_bucket_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, tinylfu_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, arc_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, s3fifo_policy_traits);
 
 
 typedef multi_policy_traits< boost::mpl::vector2< lru_policy_traits,
@@ -91,6 +130,21 @@ NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, FifoWithCountsTraits);
 template class ContentStoreImpl<LfuWithCountsTraits>;
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, LfuWithCountsTraits);
 
+/**
+ * @brief ContentStores using flat (arena-allocated) trie as a backend
+ **/
+template class ContentStoreImpl<lru_policy_traits, flat_trie_traits>;
+template class ContentStoreImpl<random_policy_traits, flat_trie_traits>;
+template class ContentStoreImpl<fifo_policy_traits, flat_trie_traits>;
+template class ContentStoreImpl<lfu_policy_traits, flat_trie_traits>;
+template class ContentStoreImpl<lfu_bucket_policy_traits, flat_trie_traits>;
+
+NS_OBJECT_ENSURE_REGISTERED_TEMPL_TRIE(ContentStoreImpl, lru_policy_traits, flat_trie_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL_TRIE(ContentStoreImpl, random_policy_traits, flat_trie_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL_TRIE(ContentStoreImpl, fifo_policy_traits, flat_trie_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL_TRIE(ContentStoreImpl, lfu_policy_traits, flat_trie_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL_TRIE(ContentStoreImpl, lfu_bucket_policy_traits, flat_trie_traits);
+
 #ifdef DOXYGEN
 // /**
 //  * \brief Content Store implementing LRU cache replacement policy
@@ -111,6 +165,51 @@ class Random : public ContentStoreImpl<random_policy_traits> { };
  * \brief Content Store implementing Least Frequently Used cache replacement policy
  */
 class Lfu : public ContentStoreImpl<lfu_policy_traits> { };
+
+/**
+ * \brief Content Store implementing Least Frequently Used cache replacement policy with constant time updates
+ */
+class BucketLfu : public ContentStoreImpl<lfu_bucket_policy_traits> { };
+
+/**
+ * \brief Content Store implementing LRU cache replacement policy with TinyLFU admission filter
+ */
+class TinyLfu : public ContentStoreImpl<tinylfu_policy_traits> { };
+
+/**
+ * \brief Content Store implementing Adaptive Replacement Cache (ARC) policy
+ */
+class Arc : public ContentStoreImpl<arc_policy_traits> { };
+
+/**
+ * \brief Content Store implementing S3-FIFO cache replacement policy
+ */
+class S3Fifo : public ContentStoreImpl<s3fifo_policy_traits> { };
+
+/**
+ * \brief Content Store implementing LRU cache replacement policy on top of flat (arena-allocated) trie
+ */
+class Flat::Lru : public ContentStoreImpl<lru_policy_traits, flat_trie_traits> { };
+
+/**
+ * \brief Content Store implementing FIFO cache replacement policy on top of flat (arena-allocated) trie
+ */
+class Flat::Fifo : public ContentStoreImpl<fifo_policy_traits, flat_trie_traits> { };
+
+/**
+ * \brief Content Store implementing Random cache replacement policy on top of flat (arena-allocated) trie
+ */
+class Flat::Random : public ContentStoreImpl<random_policy_traits, flat_trie_traits> { };
+
+/**
+ * \brief Content Store implementing Least Frequently Used cache replacement policy on top of flat (arena-allocated) trie
+ */
+class Flat::Lfu : public ContentStoreImpl<lfu_policy_traits, flat_trie_traits> { };
+
+/**
+ * \brief Content Store implementing Least Frequently Used cache replacement policy with constant time updates on top of flat (arena-allocated) trie
+ */
+class Flat::BucketLfu : public ContentStoreImpl<lfu_bucket_policy_traits, flat_trie_traits> { };
 #endif
 
 
@@ -73,18 +73,20 @@ private:
  * @ingroup ndn-cs
  * @brief Base implementation of NDN content store
  */
-template<class Policy>
+template<class Policy, class TrieTraits = ndnSIM::node_trie_traits>
 class ContentStoreImpl : public ContentStore,
                          protected ndnSIM::trie_with_policy< Name,
-                                                             ndnSIM::smart_pointer_payload_traits< EntryImpl< ContentStoreImpl< Policy > >, Entry >,
-                                                             Policy >
+                                                             ndnSIM::smart_pointer_payload_traits< EntryImpl< ContentStoreImpl< Policy, TrieTraits > >, Entry >,
+                                                             Policy,
+                                                             TrieTraits >
 {
 public:
   typedef ndnSIM::trie_with_policy< Name,
-                                    ndnSIM::smart_pointer_payload_traits< EntryImpl< ContentStoreImpl< Policy > >, Entry >,
-                                    Policy > super;
+                                    ndnSIM::smart_pointer_payload_traits< EntryImpl< ContentStoreImpl< Policy, TrieTraits > >, Entry >,
+                                    Policy,
+                                    TrieTraits > super;
 
-  typedef EntryImpl< ContentStoreImpl< Policy > > entry;
+  typedef EntryImpl< ContentStoreImpl< Policy, TrieTraits > > entry;
 
   static TypeId
   GetTypeId ();
@@ -143,27 +145,27 @@ private:
 //////////////////////////////////////////
 
 
-template<class Policy>
-LogComponent ContentStoreImpl< Policy >::g_log = LogComponent (("ndn.cs." + Policy::GetName ()).c_str ());
+template<class Policy, class TrieTraits>
+LogComponent ContentStoreImpl<Policy, TrieTraits>::g_log = LogComponent (("ndn.cs." + TrieTraits::GetLogPrefix () + Policy::GetName ()).c_str ());
 
 
-template<class Policy>
+template<class Policy, class TrieTraits>
 TypeId
-ContentStoreImpl< Policy >::GetTypeId ()
+ContentStoreImpl<Policy, TrieTraits>::GetTypeId ()
 {
-  static TypeId tid = TypeId (("ns3::ndn::cs::"+Policy::GetName ()).c_str ())
+  static TypeId tid = TypeId (("ns3::ndn::cs::" + TrieTraits::GetTypeIdPrefix () + Policy::GetName ()).c_str ())
     .SetGroupName ("Ndn")
     .SetParent<ContentStore> ()
-    .AddConstructor< ContentStoreImpl< Policy > > ()
+    .AddConstructor< ContentStoreImpl<Policy, TrieTraits> > ()
     .AddAttribute ("MaxSize",
                    "Set maximum number of entries in ContentStore. If 0, limit is not enforced",
                    StringValue ("100"),
-                   MakeUintegerAccessor (&ContentStoreImpl< Policy >::GetMaxSize,
-                                         &ContentStoreImpl< Policy >::SetMaxSize),
+                   MakeUintegerAccessor (&ContentStoreImpl<Policy, TrieTraits>::GetMaxSize,
+                                         &ContentStoreImpl<Policy, TrieTraits>::SetMaxSize),
                    MakeUintegerChecker<uint32_t> ())
 
     .AddTraceSource ("DidAddEntry", "Trace fired every time entry is successfully added to the cache",
-                     MakeTraceSourceAccessor (&ContentStoreImpl< Policy >::m_didAddEntry))
+                     MakeTraceSourceAccessor (&ContentStoreImpl<Policy, TrieTraits>::m_didAddEntry))
     ;
 
   return tid;
@@ -187,9 +189,9 @@ private:
   const Exclude &m_exclude;
 };
 
-template<class Policy>
+template<class Policy, class TrieTraits>
 Ptr<Data>
-ContentStoreImpl<Policy>::Lookup (Ptr<const Interest> interest)
+ContentStoreImpl<Policy, TrieTraits>::Lookup (Ptr<const Interest> interest)
 {
   NS_LOG_FUNCTION (this << interest->GetName ());
 
@@ -208,9 +210,8 @@ ContentStoreImpl<Policy>::Lookup (Ptr<const Interest> interest)
     {
       this->m_cacheHitsTrace (interest, node->payload ()->GetData ());
 
-      Ptr<Data> copy = Create<Data> (*node->payload ()->GetData ());
-      ConstCast<Packet> (copy->GetPayload ())->RemoveAllPacketTags ();
-      return copy;
+      // cached data is stored without packet tags, copy shares name, buffers, and wire encoding
+      return Create<Data> (*node->payload ()->GetData ());
     }
   else
     {
@@ -219,13 +220,17 @@ ContentStoreImpl<Policy>::Lookup (Ptr<const Interest> interest)
     }
 }
 
-template<class Policy>
+template<class Policy, class TrieTraits>
 bool
-ContentStoreImpl<Policy>::Add (Ptr<const Data> data)
+ContentStoreImpl<Policy, TrieTraits>::Add (Ptr<const Data> data)
 {
   NS_LOG_FUNCTION (this << data->GetName ());
 
-  Ptr< entry > newEntry = Create< entry > (this, data);
+  // packet tags are stripped only once, when data is placed into the cache
+  Ptr<Data> cached = Create<Data> (*data);
+  ConstCast<Packet> (cached->GetPayload ())->RemoveAllPacketTags ();
+
+  Ptr< entry > newEntry = Create< entry > (this, cached);
   std::pair< typename super::iterator, bool > result = super::insert (data->GetName (), newEntry);
 
   if (result.first != super::end ())
@@ -248,9 +253,9 @@ ContentStoreImpl<Policy>::Add (Ptr<const Data> data)
     return false; // cannot insert entry
 }
 
-template<class Policy>
+template<class Policy, class TrieTraits>
 void
-ContentStoreImpl<Policy>::Print (std::ostream &os) const
+ContentStoreImpl<Policy, TrieTraits>::Print (std::ostream &os) const
 {
   for (typename super::policy_container::const_iterator item = this->getPolicy ().begin ();
        item != this->getPolicy ().end ();
@@ -260,30 +265,30 @@ ContentStoreImpl<Policy>::Print (std::ostream &os) const
     }
 }
 
-template<class Policy>
+template<class Policy, class TrieTraits>
 void
-ContentStoreImpl<Policy>::SetMaxSize (uint32_t maxSize)
+ContentStoreImpl<Policy, TrieTraits>::SetMaxSize (uint32_t maxSize)
 {
   this->getPolicy ().set_max_size (maxSize);
 }
 
-template<class Policy>
+template<class Policy, class TrieTraits>
 uint32_t
-ContentStoreImpl<Policy>::GetMaxSize () const
+ContentStoreImpl<Policy, TrieTraits>::GetMaxSize () const
 {
   return this->getPolicy ().get_max_size ();
 }
 
-template<class Policy>
+template<class Policy, class TrieTraits>
 uint32_t
-ContentStoreImpl<Policy>::GetSize () const
+ContentStoreImpl<Policy, TrieTraits>::GetSize () const
 {
   return this->getPolicy ().size ();
 }
 
-template<class Policy>
+template<class Policy, class TrieTraits>
 Ptr<Entry>
-ContentStoreImpl<Policy>::Begin ()
+ContentStoreImpl<Policy, TrieTraits>::Begin ()
 {
   typename super::parent_trie::recursive_iterator item (super::getTrie ()), end (0);
   for (; item != end; item++)
@@ -298,16 +303,16 @@ ContentStoreImpl<Policy>::Begin ()
     return item->payload ();
 }
 
-template<class Policy>
+template<class Policy, class TrieTraits>
 Ptr<Entry>
-ContentStoreImpl<Policy>::End ()
+ContentStoreImpl<Policy, TrieTraits>::End ()
 {
   return 0;
 }
 
-template<class Policy>
+template<class Policy, class TrieTraits>
 Ptr<Entry>
-ContentStoreImpl<Policy>::Next (Ptr<Entry> from)
+ContentStoreImpl<Policy, TrieTraits>::Next (Ptr<Entry> from)
 {
   if (from == 0) return 0;
 
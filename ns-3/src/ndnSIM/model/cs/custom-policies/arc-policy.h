@@ -0,0 +1,293 @@
+/* -*- Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef ARC_POLICY_H_
+#define ARC_POLICY_H_
+
+#include <boost/intrusive/options.hpp>
+#include <boost/intrusive/list.hpp>
+
+#include "../../../utils/ghost-queue.h"
+
+#include <algorithm>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+/**
+ * @brief Traits for Adaptive Replacement Cache (ARC) policy
+ *
+ * Resident items are split between T1 (seen once recently) and T2 (seen at least twice
+ * recently) LRU lists.  Hashes of items evicted from T1 and T2 are remembered in B1 and B2
+ * ghost queues and used to adapt the target size of T1.  Items that are requested only once
+ * (e.g., scans) never leave T1 and cannot push frequently requested items out of T2.
+ *
+ * Both T1 and T2 are kept in one list (T1 followed by T2), so the policy container can be
+ * iterated as usual.
+ *
+ * The policy is intended for content stores: payload should provide GetName () method.
+ */
+struct arc_policy_traits
+{
+  /// @brief Name that can be used to identify the policy (for NS-3 object model and logging)
+  static std::string GetName () { return "Arc"; }
+
+  struct policy_hook_type : public boost::intrusive::list_member_hook<> { bool frequent; };
+
+  template<class Container>
+  struct container_hook
+  {
+    typedef boost::intrusive::member_hook< Container,
+                                           policy_hook_type,
+                                           &Container::policy_hook_ > type;
+  };
+
+  template<class Base,
+           class Container,
+           class Hook>
+  struct policy
+  {
+    static bool& get_frequent (typename Container::iterator item)
+    {
+      return static_cast<policy_hook_type*>
+        (policy_container::value_traits::to_node_ptr(*item))->frequent;
+    }
+
+    typedef typename boost::intrusive::list< Container, Hook > policy_container;
+
+    // could be just typedef
+    class type : public policy_container
+    {
+    public:
+      typedef policy policy_base; // to get access to get_frequent methods from outside
+      typedef Container parent_trie;
+
+      type (Base &base)
+        : base_ (base)
+        , max_size_ (100)
+        , t1_size_ (0)
+        , t2_head_ (0)
+        , p_ (0)
+      {
+        set_max_size (max_size_);
+      }
+
+      inline void
+      update (typename parent_trie::iterator item)
+      {
+        lookup (item);
+      }
+
+      inline bool
+      insert (typename parent_trie::iterator item)
+      {
+        size_t c = max_size_;
+        size_t hash = get_hash (item);
+
+        if (c == 0)
+          {
+            push_t1 (item);
+            return true;
+          }
+
+        if (b1_.contains (hash))
+          {
+            // recently evicted from T1: T1 should be larger
+            p_ = std::min (c, p_ + std::max<size_t> (b2_.size () / b1_.size (), 1));
+            b1_.erase (hash);
+            replace (false);
+            push_t2 (item);
+          }
+        else if (b2_.contains (hash))
+          {
+            // recently evicted from T2: T2 should be larger
+            size_t delta = std::max<size_t> (b1_.size () / b2_.size (), 1);
+            p_ = (p_ > delta) ? p_ - delta : 0;
+            b2_.erase (hash);
+            replace (true);
+            push_t2 (item);
+          }
+        else
+          {
+            size_t total = policy_container::size () + b1_.size () + b2_.size ();
+            if (t1_size_ + b1_.size () >= c)
+              {
+                if (t1_size_ < c)
+                  {
+                    b1_.pop_live ();
+                    replace (false);
+                  }
+                else
+                  {
+                    base_.erase (&(*policy_container::begin ()));
+                  }
+              }
+            else if (total >= c)
+              {
+                if (total >= 2 * c)
+                  b2_.pop_live ();
+                replace (false);
+              }
+            push_t1 (item);
+          }
+
+        return true;
+      }
+
+      inline void
+      lookup (typename parent_trie::iterator item)
+      {
+        // move to MRU position of T2
+        typename policy_container::iterator position = policy_container::s_iterator_to (*item);
+        if (get_frequent (item))
+          {
+            if (t2_head_ == &(*item))
+              {
+                typename policy_container::iterator next = position;
+                next++;
+                if (next != policy_container::end ())
+                  t2_head_ = &(*next);
+              }
+          }
+        else
+          {
+            get_frequent (item) = true;
+            t1_size_--;
+            if (t2_head_ == 0)
+              t2_head_ = &(*item);
+          }
+
+        policy_container::splice (policy_container::end (), *this, position);
+      }
+
+      inline void
+      erase (typename parent_trie::iterator item)
+      {
+        typename policy_container::iterator position = policy_container::s_iterator_to (*item);
+        if (get_frequent (item))
+          {
+            if (t2_head_ == &(*item))
+              {
+                typename policy_container::iterator next = position;
+                next++;
+                t2_head_ = (next != policy_container::end ()) ? &(*next) : 0;
+              }
+          }
+        else
+          t1_size_--;
+
+        policy_container::erase (position);
+      }
+
+      inline void
+      clear ()
+      {
+        policy_container::clear ();
+        t1_size_ = 0;
+        t2_head_ = 0;
+        p_ = 0;
+        b1_.clear ();
+        b2_.clear ();
+      }
+
+      inline void
+      set_max_size (size_t max_size)
+      {
+        max_size_ = max_size;
+        p_ = 0;
+        b1_.set_capacity (max_size_);
+        b2_.set_capacity (max_size_);
+      }
+
+      inline size_t
+      get_max_size () const
+      {
+        return max_size_;
+      }
+
+    private:
+      type () : base_(*((Base*)0)) { };
+
+      static size_t
+      get_hash (typename parent_trie::iterator item)
+      {
+        return item->payload ()->GetName ().getHash ();
+      }
+
+      void
+      push_t1 (typename parent_trie::iterator item)
+      {
+        get_frequent (item) = false;
+        if (t2_head_ != 0)
+          policy_container::insert (policy_container::s_iterator_to (*t2_head_), *item);
+        else
+          policy_container::push_back (*item);
+        t1_size_++;
+      }
+
+      void
+      push_t2 (typename parent_trie::iterator item)
+      {
+        get_frequent (item) = true;
+        policy_container::push_back (*item);
+        if (t2_head_ == 0)
+          t2_head_ = &(*item);
+      }
+
+      /**
+       * @brief Evict LRU item from T1 or T2 (depending on target size of T1) to the ghost queue
+       */
+      void
+      replace (bool inB2)
+      {
+        if (policy_container::size () < max_size_)
+          return;
+
+        typename parent_trie::iterator victim;
+        if (t2_head_ == 0 ||
+            (t1_size_ >= 1 && (t1_size_ > p_ || (inB2 && t1_size_ == p_))))
+          {
+            victim = &(*policy_container::begin ());
+            b1_.push (get_hash (victim));
+          }
+        else
+          {
+            victim = t2_head_;
+            b2_.push (get_hash (victim));
+          }
+        base_.erase (victim);
+      }
+
+    private:
+      Base &base_;
+      size_t max_size_;
+
+      size_t t1_size_;          ///< @brief number of items in T1 (the beginning of the list)
+      parent_trie *t2_head_;    ///< @brief LRU item of T2 (0 if T2 is empty)
+      size_t p_;                ///< @brief target size of T1
+      ghost_queue b1_;          ///< @brief hashes of items recently evicted from T1
+      ghost_queue b2_;          ///< @brief hashes of items recently evicted from T2
+    };
+  };
+};
+
+} // ndnSIM
+} // ndn
+} // ns3
+
+#endif // ARC_POLICY_H_
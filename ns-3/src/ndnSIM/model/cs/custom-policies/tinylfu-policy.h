@@ -0,0 +1,157 @@
+/* -*- Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef TINYLFU_POLICY_H_
+#define TINYLFU_POLICY_H_
+
+#include <boost/intrusive/options.hpp>
+#include <boost/intrusive/list.hpp>
+
+#include "../../../utils/count-min-sketch.h"
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+/**
+ * @brief Traits for LRU replacement policy with TinyLFU admission filter
+ *
+ * Approximate access frequency of recently requested names (cache hits and Data packets
+ * offered to the cache) is tracked by a count-min sketch.  When the cache is full, new item is
+ * admitted only if its estimated frequency is higher than that of the LRU victim, so one-time
+ * content (e.g., scans) does not push popular items out of the cache.
+ *
+ * The policy is intended for content stores: payload should provide GetName () method.
+ */
+struct tinylfu_policy_traits
+{
+  /// @brief Name that can be used to identify the policy (for NS-3 object model and logging)
+  static std::string GetName () { return "TinyLfu"; }
+
+  struct policy_hook_type : public boost::intrusive::list_member_hook<> {};
+
+  template<class Container>
+  struct container_hook
+  {
+    typedef boost::intrusive::member_hook< Container,
+                                           policy_hook_type,
+                                           &Container::policy_hook_ > type;
+  };
+
+  template<class Base,
+           class Container,
+           class Hook>
+  struct policy
+  {
+    typedef typename boost::intrusive::list< Container, Hook > policy_container;
+
+    // could be just typedef
+    class type : public policy_container
+    {
+    public:
+      typedef Container parent_trie;
+
+      type (Base &base)
+        : base_ (base)
+        , max_size_ (100)
+      {
+        sketch_.resize (max_size_);
+      }
+
+      inline void
+      update (typename parent_trie::iterator item)
+      {
+        lookup (item);
+      }
+
+      inline bool
+      insert (typename parent_trie::iterator item)
+      {
+        size_t hash = get_hash (item);
+        sketch_.increment (hash);
+
+        if (max_size_ != 0 && policy_container::size () >= max_size_)
+          {
+            typename parent_trie::iterator victim = &(*policy_container::begin ());
+            if (sketch_.estimate (hash) <= sketch_.estimate (get_hash (victim)))
+              return false; // don't allow caching
+
+            base_.erase (victim);
+          }
+
+        policy_container::push_back (*item);
+        return true;
+      }
+
+      inline void
+      lookup (typename parent_trie::iterator item)
+      {
+        sketch_.increment (get_hash (item));
+
+        // do relocation
+        policy_container::splice (policy_container::end (),
+                                  *this,
+                                  policy_container::s_iterator_to (*item));
+      }
+
+      inline void
+      erase (typename parent_trie::iterator item)
+      {
+        policy_container::erase (policy_container::s_iterator_to (*item));
+      }
+
+      inline void
+      clear ()
+      {
+        policy_container::clear ();
+      }
+
+      inline void
+      set_max_size (size_t max_size)
+      {
+        max_size_ = max_size;
+        sketch_.resize (max_size_);
+      }
+
+      inline size_t
+      get_max_size () const
+      {
+        return max_size_;
+      }
+
+    private:
+      type () : base_(*((Base*)0)) { };
+
+      static size_t
+      get_hash (typename parent_trie::iterator item)
+      {
+        return item->payload ()->GetName ().getHash ();
+      }
+
+    private:
+      Base &base_;
+      size_t max_size_;
+      count_min_sketch sketch_;
+    };
+  };
+};
+
+} // ndnSIM
+} // ndn
+} // ns3
+
+#endif // TINYLFU_POLICY_H_
@@ -29,6 +29,8 @@
 #define NDN_RTO_BETA 0.25
 #define NDN_RTO_K 4
 
+#include <algorithm>
+
 #include <boost/ref.hpp>
 #include <boost/lambda/lambda.hpp>
 #include <boost/lambda/bind.hpp>
@@ -40,17 +42,6 @@ namespace ns3 {
 namespace ndn {
 namespace fib {
 
-//////////////////////////////////////////////////////////////////////
-// Helpers
-//////////////////////////////////////////////////////////////////////
-
-struct FaceMetricByFace
-{
-  typedef FaceMetricContainer::type::index<i_face>::type
-  type;
-};
-
-
 void
 FaceMetric::UpdateRtt (const Time &rttSample)
 {
@@ -74,20 +65,184 @@ FaceMetric::UpdateRtt (const Time &rttSample)
 
 /////////////////////////////////////////////////////////////////////
 
+FaceMetricContainer::FaceMetricContainer ()
+{
+}
+
+FaceMetricContainer::~FaceMetricContainer ()
+{
+  for (std::vector<FaceMetric*>::iterator i = m_slots.begin (); i != m_slots.end (); i++)
+    delete *i;
+}
+
+bool
+FaceMetricContainer::MetricLess (const FaceMetric *a, const FaceMetric *b)
+{
+  if (a->GetStatus () != b->GetStatus ())
+    return a->GetStatus () < b->GetStatus ();
+  return a->GetRoutingCost () < b->GetRoutingCost ();
+}
+
+FaceMetricContainer::iterator
+FaceMetricContainer::find (const Ptr<Face> &face) const
+{
+  const Face *key = PeekPointer (face);
+  if (m_index.empty ())
+    {
+      for (std::vector<FaceMetric*>::const_iterator i = m_slots.begin (); i != m_slots.end (); i++)
+        {
+          if (PeekPointer ((*i)->m_face) == key)
+            return iterator (i);
+        }
+      return end ();
+    }
+
+  std::vector<IndexRecord>::const_iterator record =
+    std::lower_bound (m_index.begin (), m_index.end (), IndexRecord (key, 0));
+  if (record == m_index.end () || record->first != key)
+    return end ();
+
+  return iterator (m_slots.begin () + record->second);
+}
+
+std::pair<FaceMetricContainer::iterator, bool>
+FaceMetricContainer::insert (const FaceMetric &metric)
+{
+  iterator existing = find (metric.m_face);
+  if (existing != end ())
+    return std::make_pair (existing, false);
+
+  return std::make_pair (Place (new FaceMetric (metric)), true);
+}
+
+std::pair<FaceMetricContainer::iterator, bool>
+FaceMetricContainer::insert (const Ptr<Face> &face, int32_t cost)
+{
+  iterator existing = find (face);
+  if (existing != end ())
+    return std::make_pair (existing, false);
+
+  // record is constructed in place, as copying FaceMetric is relatively expensive
+  return std::make_pair (Place (new FaceMetric (face, cost)), true);
+}
+
+FaceMetricContainer::iterator
+FaceMetricContainer::Place (FaceMetric *item)
+{
+  // new face goes after all faces with the same (status, routing cost)
+  std::vector<FaceMetric*>::iterator position =
+    m_slots.insert (std::upper_bound (m_slots.begin (), m_slots.end (), item, MetricLess), item);
+
+  size_type slot = position - m_slots.begin ();
+  if (m_index.empty ())
+    {
+      if (m_slots.size () > LinearLookupLimit)
+        RebuildIndex ();
+    }
+  else
+    {
+      // faces after the new one moved one slot further
+      for (std::vector<IndexRecord>::iterator record = m_index.begin (); record != m_index.end (); record++)
+        {
+          if (record->second >= slot)
+            record->second ++;
+        }
+
+      IndexRecord record (PeekPointer (item->m_face), slot);
+      m_index.insert (std::lower_bound (m_index.begin (), m_index.end (), record), record);
+    }
+
+  return iterator (position);
+}
+
+FaceMetricContainer::size_type
+FaceMetricContainer::erase (const Ptr<Face> &face)
+{
+  iterator item = find (face);
+  if (item == end ())
+    return 0;
+
+  size_type slot = item.base () - m_slots.begin ();
+  delete *item.base ();
+  m_slots.erase (m_slots.begin () + slot);
+
+  if (m_slots.size () <= LinearLookupLimit)
+    {
+      // back to linear lookup, release the index
+      std::vector<IndexRecord> ().swap (m_index);
+    }
+  else
+    {
+      m_index.erase (std::lower_bound (m_index.begin (), m_index.end (), IndexRecord (PeekPointer (face), 0)));
+
+      // faces after the removed one moved one slot closer
+      for (std::vector<IndexRecord>::iterator record = m_index.begin (); record != m_index.end (); record++)
+        {
+          if (record->second > slot)
+            record->second --;
+        }
+    }
+  return 1;
+}
+
+FaceMetricContainer::size_type
+FaceMetricContainer::Reposition (size_type slot)
+{
+  FaceMetric *item = m_slots [slot];
+  if ((slot == 0 || !MetricLess (item, m_slots [slot - 1])) &&
+      (slot + 1 == m_slots.size () || !MetricLess (m_slots [slot + 1], item)))
+    {
+      // order is preserved, face stays in place
+      return slot;
+    }
+
+  m_slots.erase (m_slots.begin () + slot);
+  std::vector<FaceMetric*>::iterator position =
+    m_slots.insert (std::upper_bound (m_slots.begin (), m_slots.end (), item, MetricLess), item);
+
+  size_type newSlot = position - m_slots.begin ();
+  UpdateIndex (std::min (slot, newSlot), std::max (slot, newSlot));
+  return newSlot;
+}
+
+void
+FaceMetricContainer::UpdateIndex (size_type from, size_type to)
+{
+  if (m_index.empty ())
+    return;
+
+  for (size_type slot = from; slot <= to; slot++)
+    {
+      const Face *key = PeekPointer (m_slots [slot]->m_face);
+      std::lower_bound (m_index.begin (), m_index.end (), IndexRecord (key, 0))->second = slot;
+    }
+}
+
+void
+FaceMetricContainer::RebuildIndex ()
+{
+  m_index.clear ();
+  m_index.reserve (m_slots.size ());
+  for (size_type slot = 0; slot < m_slots.size (); slot++)
+    {
+      m_index.push_back (IndexRecord (PeekPointer (m_slots [slot]->m_face), slot));
+    }
+  std::sort (m_index.begin (), m_index.end ());
+}
+
+/////////////////////////////////////////////////////////////////////
+
 void
 Entry::UpdateFaceRtt (Ptr<Face> face, const Time &sample)
 {
-  FaceMetricByFace::type::iterator record = m_faces.get<i_face> ().find (face);
-  if (record == m_faces.get<i_face> ().end ())
+  FaceMetricContainer::iterator record = m_faces.find (face);
+  if (record == m_faces.end ())
     {
       return;
     }
 
   m_faces.modify (record,
                   ll::bind (&FaceMetric::UpdateRtt, ll::_1, sample));
-
-  // reordering random access index same way as by metric index
-  m_faces.get<i_nth> ().rearrange (m_faces.get<i_metric> ().begin ());
 }
 
 void
@@ -95,17 +250,14 @@ Entry::UpdateStatus (Ptr<Face> face, FaceMetric::Status status)
 {
   NS_LOG_FUNCTION (this << boost::cref(*face) << status);
 
-  FaceMetricByFace::type::iterator record = m_faces.get<i_face> ().find (face);
-  if (record == m_faces.get<i_face> ().end ())
+  FaceMetricContainer::iterator record = m_faces.find (face);
+  if (record == m_faces.end ())
     {
       return;
     }
 
   m_faces.modify (record,
                   ll::bind (&FaceMetric::SetStatus, ll::_1, status));
-
-  // reordering random access index same way as by metric index
-  m_faces.get<i_nth> ().rearrange (m_faces.get<i_metric> ().begin ());
 }
 
 void
@@ -114,26 +266,23 @@ Entry::AddOrUpdateRoutingMetric (Ptr<Face> face, int32_t metric)
   NS_LOG_FUNCTION (this);
   NS_ASSERT_MSG (face != NULL, "Trying to Add or Update NULL face");
 
-  FaceMetricByFace::type::iterator record = m_faces.get<i_face> ().find (face);
-  if (record == m_faces.get<i_face> ().end ())
+  FaceMetricContainer::iterator record = m_faces.find (face);
+  if (record == m_faces.end ())
     {
-      m_faces.insert (FaceMetric (face, metric));
+      m_faces.insert (face, metric);
     }
   else
   {
     // don't update metric to higher value
     if (record->GetRoutingCost () > metric || record->GetStatus () == FaceMetric::NDN_FIB_RED)
       {
-        m_faces.modify (record,
-                        ll::bind (&FaceMetric::SetRoutingCost, ll::_1, metric));
+        record = m_faces.modify (record,
+                                 ll::bind (&FaceMetric::SetRoutingCost, ll::_1, metric));
 
         m_faces.modify (record,
                         ll::bind (&FaceMetric::SetStatus, ll::_1, FaceMetric::NDN_FIB_YELLOW));
       }
   }
-
-  // reordering random access index same way as by metric index
-  m_faces.get<i_nth> ().rearrange (m_faces.get<i_metric> ().begin ());
 }
 
 void
@@ -142,8 +291,8 @@ Entry::SetRealDelayToProducer (Ptr<Face> face, Time delay)
   NS_LOG_FUNCTION (this);
   NS_ASSERT_MSG (face != NULL, "Trying to Update NULL face");
 
-  FaceMetricByFace::type::iterator record = m_faces.get<i_face> ().find (face);
-  if (record != m_faces.get<i_face> ().end ())
+  FaceMetricContainer::iterator record = m_faces.find (face);
+  if (record != m_faces.end ())
     {
       m_faces.modify (record,
                       ll::bind (&FaceMetric::SetRealDelay, ll::_1, delay));
@@ -154,16 +303,40 @@ Entry::SetRealDelayToProducer (Ptr<Face> face, Time delay)
 void
 Entry::Invalidate ()
 {
-  for (FaceMetricByFace::type::iterator face = m_faces.begin ();
+  // m_faces is ordered by metric and every InvalidateFace call moves the face to the end of
+  // that order, so faces are collected first.  They are invalidated in the order of face
+  // pointers (the order of the face index), so the result does not depend on the metrics
+  std::vector<Ptr<Face> > faces;
+  for (FaceMetricContainer::iterator face = m_faces.begin ();
        face != m_faces.end ();
        face++)
     {
-      m_faces.modify (face,
-                      ll::bind (&FaceMetric::SetRoutingCost, ll::_1, std::numeric_limits<uint16_t>::max ()));
+      faces.push_back (face->GetFace ());
+    }
+  std::sort (faces.begin (), faces.end ());
+
+  for (std::vector<Ptr<Face> >::iterator face = faces.begin ();
+       face != faces.end ();
+       face++)
+    {
+      InvalidateFace (*face);
+    }
+}
 
-      m_faces.modify (face,
-                      ll::bind (&FaceMetric::SetStatus, ll::_1, FaceMetric::NDN_FIB_RED));
+void
+Entry::InvalidateFace (Ptr<Face> face)
+{
+  FaceMetricContainer::iterator record = m_faces.find (face);
+  if (record == m_faces.end ())
+    {
+      return;
     }
+
+  record = m_faces.modify (record,
+                           ll::bind (&FaceMetric::SetRoutingCost, ll::_1, std::numeric_limits<uint16_t>::max ()));
+
+  m_faces.modify (record,
+                  ll::bind (&FaceMetric::SetStatus, ll::_1, FaceMetric::NDN_FIB_RED));
 }
 
 const FaceMetric &
@@ -171,7 +344,7 @@ Entry::FindBestCandidate (uint32_t skip/* = 0*/) const
 {
   if (m_faces.size () == 0) throw Entry::NoFaces ();
   skip = skip % m_faces.size();
-  return m_faces.get<i_nth> () [skip];
+  return m_faces [skip];
 }
 
 Ptr<Fib>
@@ -183,12 +356,11 @@ Entry::GetFib ()
 
 std::ostream& operator<< (std::ostream& os, const Entry &entry)
 {
-  for (FaceMetricContainer::type::index<i_nth>::type::iterator metric =
-         entry.m_faces.get<i_nth> ().begin ();
-       metric != entry.m_faces.get<i_nth> ().end ();
+  for (FaceMetricContainer::iterator metric = entry.m_faces.begin ();
+       metric != entry.m_faces.end ();
        metric++)
     {
-      if (metric != entry.m_faces.get<i_nth> ().begin ())
+      if (metric != entry.m_faces.begin ())
         os << ", ";
 
       os << *metric;
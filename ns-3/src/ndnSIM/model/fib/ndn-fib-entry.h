@@ -28,14 +28,9 @@
 #include "ns3/ndn-limits.h"
 #include "ns3/traced-value.h"
 
-#include <boost/multi_index_container.hpp>
-#include <boost/multi_index/tag.hpp>
-#include <boost/multi_index/ordered_index.hpp>
-#include <boost/multi_index/composite_key.hpp>
-#include <boost/multi_index/hashed_index.hpp>
-#include <boost/multi_index/random_access_index.hpp>
-#include <boost/multi_index/member.hpp>
-#include <boost/multi_index/mem_fun.hpp>
+#include <boost/iterator/indirect_iterator.hpp>
+
+#include <vector>
 
 namespace ns3 {
 namespace ndn {
@@ -75,9 +70,9 @@ public:
     : m_face (face)
     , m_status (NDN_FIB_YELLOW)
     , m_routingCost (cost)
-    , m_sRtt   (Seconds (0))
-    , m_rttVar (Seconds (0))
-    , m_realDelay (Seconds (0))
+    , m_sRtt   ()
+    , m_rttVar ()
+    , m_realDelay ()
   { }
 
   /**
@@ -188,6 +183,7 @@ public:
 
 private:
   friend std::ostream& operator<< (std::ostream& os, const FaceMetric &metric);
+  friend class FaceMetricContainer;
 
 private:
   Ptr<Face> m_face; ///< Face
@@ -206,7 +202,6 @@ private:
 };
 
 /// @cond include_hidden
-class i_face {};
 class i_metric {};
 class i_nth {};
 /// @endcond
@@ -214,49 +209,140 @@ class i_nth {};
 
 /**
  * @ingroup ndn-fib
- * @brief Typedef for indexed face container of Entry
+ * @brief Compact face container of Entry
+ *
+ * Faces are kept in a single vector ordered by (status, m_routingCost), which is used both
+ * for face ranking and for fast lookup of the nth face.  Ties are ordered the same way as
+ * in the boost::multi_index container that was used before (a face, whose metric is
+ * changed, keeps its position if the order is still preserved, otherwise it is moved after
+ * all faces with the same metric).
  *
- * Currently, there are 2 indexes:
- * - by face (used to find record and update metric)
- * - by metric (face ranking)
- * - random access index (for fast lookup on nth face). Order is
- *   maintained manually to be equal to the 'by metric' order
+ * FaceMetric records are allocated individually and never move in memory, so references
+ * obtained through iterators (e.g., to connect to the status trace) stay valid until the
+ * face is removed.  Lookup by face is a linear scan for small entries; a sorted
+ * face-to-slot index is maintained only if there are more than LinearLookupLimit faces.
+ * The index is built once, when the entry grows past the limit, and then updated in place
+ * on every insert, erase, and reposition (no re-sorting).
+ *
+ * For compatibility, get<i_metric> () and get<i_nth> () return the container itself.
  */
-struct FaceMetricContainer
+class FaceMetricContainer
 {
+public:
   /// @cond include_hidden
-  typedef boost::multi_index::multi_index_container<
-    FaceMetric,
-    boost::multi_index::indexed_by<
-      // For fast access to elements using Face
-      boost::multi_index::ordered_unique<
-        boost::multi_index::tag<i_face>,
-        boost::multi_index::const_mem_fun<FaceMetric,Ptr<Face>,&FaceMetric::GetFace>
-      >,
-
-      // List of available faces ordered by (status, m_routingCost)
-      boost::multi_index::ordered_non_unique<
-        boost::multi_index::tag<i_metric>,
-        boost::multi_index::composite_key<
-          FaceMetric,
-          boost::multi_index::const_mem_fun<FaceMetric,FaceMetric::Status,&FaceMetric::GetStatus>,
-          boost::multi_index::const_mem_fun<FaceMetric,int32_t,&FaceMetric::GetRoutingCost>
-        >
-      >,
-
-      // To optimize nth candidate selection (sacrifice a little bit space to gain speed)
-      boost::multi_index::random_access<
-        boost::multi_index::tag<i_nth>
-      >
-    >
-   > type;
+  typedef FaceMetricContainer type;
+
+  template<class Tag>
+  struct index
+  {
+    typedef FaceMetricContainer type;
+  };
   /// @endcond
+
+  typedef boost::indirect_iterator<std::vector<FaceMetric*>::const_iterator, const FaceMetric> iterator;
+  typedef iterator const_iterator;
+  typedef FaceMetric value_type;
+  typedef size_t size_type;
+
+  FaceMetricContainer ();
+  ~FaceMetricContainer ();
+
+  iterator begin () const { return iterator (m_slots.begin ()); }
+  iterator end () const { return iterator (m_slots.end ()); }
+  size_type size () const { return m_slots.size (); }
+  bool empty () const { return m_slots.empty (); }
+
+  /**
+   * @brief Get nth face in (status, m_routingCost) order
+   */
+  const FaceMetric &
+  operator [] (size_type n) const { return *m_slots [n]; }
+
+  template<class Tag>
+  FaceMetricContainer &
+  get () { return *this; }
+
+  template<class Tag>
+  const FaceMetricContainer &
+  get () const { return *this; }
+
+  /**
+   * @brief Find record for the face
+   * @returns iterator to the record or end ()
+   */
+  iterator
+  find (const Ptr<Face> &face) const;
+
+  /**
+   * @brief Insert a copy of the metric, if there is no record for the same face yet
+   */
+  std::pair<iterator, bool>
+  insert (const FaceMetric &metric);
+
+  /**
+   * @brief Insert a new record for the face with the specified routing cost, if there is no record for the face yet
+   */
+  std::pair<iterator, bool>
+  insert (const Ptr<Face> &face, int32_t cost);
+
+  /**
+   * @brief Apply modifier to the record and restore (status, m_routingCost) order
+   *
+   * Unlike boost::multi_index, the operation invalidates iterators
+   *
+   * @returns iterator to the modified record
+   */
+  template<class Modifier>
+  iterator
+  modify (iterator item, Modifier mod)
+  {
+    size_type slot = item.base () - m_slots.begin ();
+    mod (*m_slots [slot]);
+    return begin () + Reposition (slot);
+  }
+
+  /**
+   * @brief Remove record for the face
+   * @returns number of removed records (0 or 1)
+   */
+  size_type
+  erase (const Ptr<Face> &face);
+
+private:
+  FaceMetricContainer (const FaceMetricContainer &); ///< \brief Disabled copy constructor
+  FaceMetricContainer &operator = (const FaceMetricContainer &); ///< \brief Disabled copy operator
+
+  static bool
+  MetricLess (const FaceMetric *a, const FaceMetric *b);
+
+  iterator
+  Place (FaceMetric *item);
+
+  size_type
+  Reposition (size_type slot);
+
+  void
+  UpdateIndex (size_type from, size_type to);
+
+  void
+  RebuildIndex ();
+
+private:
+  enum { LinearLookupLimit = 8 };
+
+  typedef std::pair<const Face*, uint32_t> IndexRecord;
+
+  std::vector<FaceMetric*> m_slots; ///< \brief faces ordered by (status, m_routingCost)
+  std::vector<IndexRecord> m_index; ///< \brief face-to-slot index sorted by face (empty for small containers)
 };
 
 /**
  * @ingroup ndn-fib
  * \brief Structure for FIB table entry, holding indexed list of
  *        available faces and their respective metrics
+ *
+ * Methods adding or removing faces are virtual, in case index rearrangement is necessary in the
+ * derived classes
  */
 class Entry : public Object
 {
@@ -288,7 +374,7 @@ public:
    *
    * Initial status of the next hop is set to YELLOW
    */
-  void AddOrUpdateRoutingMetric (Ptr<Face> face, int32_t metric);
+  virtual void AddOrUpdateRoutingMetric (Ptr<Face> face, int32_t metric);
 
   /**
    * \brief Set real delay to the producer
@@ -299,11 +385,20 @@ public:
   /**
    * @brief Invalidate face
    *
-   * Set routing metric on all faces to max and status to RED
+   * Set routing metric on all faces to max and status to RED.  Faces are invalidated in the
+   * order of the face index (i.e., by face pointer), not in the metric order of the container
    */
   void
   Invalidate ();
 
+  /**
+   * @brief Invalidate one face
+   *
+   * Set routing metric of the face to max and status to RED (does nothing if face is not in the entry)
+   */
+  void
+  InvalidateFace (Ptr<Face> face);
+
   /**
    * @brief Update RTT averages for the face
    */
@@ -327,7 +422,7 @@ public:
   /**
    * @brief Remove record associated with `face`
    */
-  void
+  virtual void
   RemoveFace (const Ptr<Face> &face)
   {
     m_faces.erase (face);
@@ -346,7 +441,7 @@ public:
   Ptr<Fib> m_fib; ///< \brief FIB to which entry is added
 
   Ptr<const Name> m_prefix; ///< \brief Prefix of the FIB entry
-  FaceMetricContainer::type m_faces; ///< \brief Indexed list of faces
+  FaceMetricContainer m_faces; ///< \brief Indexed list of faces
 
   bool m_needsProbing;      ///< \brief flag indicating that probing should be performed
 };
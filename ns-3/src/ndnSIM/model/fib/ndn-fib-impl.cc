@@ -19,6 +19,7 @@
  */
 
 #include "ndn-fib-impl.h"
+#include "../../utils/trie/flat-trie.h"
 
 #include "ns3/ndn-face.h"
 #include "ns3/ndn-interest.h"
@@ -29,6 +30,8 @@
 #include "ns3/names.h"
 #include "ns3/log.h"
 
+#include <algorithm>
+
 #include <boost/ref.hpp>
 #include <boost/lambda/lambda.hpp>
 #include <boost/lambda/bind.hpp>
@@ -36,45 +39,68 @@ namespace ll = boost::lambda;
 
 NS_LOG_COMPONENT_DEFINE ("ndn.fib.FibImpl");
 
+#define NS_OBJECT_ENSURE_REGISTERED_TEMPL(type, templ)  \
+  static struct X ## type ## templ ## RegistrationClass \
+  {                                                     \
+    X ## type ## templ ## RegistrationClass () {        \
+      ns3::TypeId tid = type<templ>::GetTypeId ();      \
+      tid.GetParent ();                                 \
+    }                                                   \
+  } x_ ## type ## templ ## RegistrationVariable
+
 namespace ns3 {
 namespace ndn {
 namespace fib {
 
-NS_OBJECT_ENSURE_REGISTERED (FibImpl);
+using namespace ndnSIM;
 
+template<class TrieTraits>
 TypeId 
-FibImpl::GetTypeId (void)
+FibImpl<TrieTraits>::GetTypeId (void)
 {
-  static TypeId tid = TypeId ("ns3::ndn::fib::Default") // cheating ns3 object system
+  static TypeId tid = TypeId (("ns3::ndn::fib::" + TrieTraits::GetTypeIdPrefix () + "Default").c_str ()) // cheating ns3 object system
     .SetParent<Fib> ()
     .SetGroupName ("Ndn")
-    .AddConstructor<FibImpl> ()
+    .template AddConstructor< FibImpl<TrieTraits> > ()
   ;
   return tid;
 }
 
-FibImpl::FibImpl ()
+template<class TrieTraits>
+FibImpl<TrieTraits>::FibImpl ()
 {
 }
 
+template<class TrieTraits>
 void
-FibImpl::NotifyNewAggregate ()
+FibImpl<TrieTraits>::NotifyNewAggregate ()
 {
   Object::NotifyNewAggregate ();
 }
 
+template<class TrieTraits>
 void 
-FibImpl::DoDispose (void)
+FibImpl<TrieTraits>::DoDispose (void)
 {
-  clear ();
+  typename super::parent_trie::recursive_iterator item (super::getTrie ());
+  typename super::parent_trie::recursive_iterator end (0);
+  for (; item != end; item++)
+    {
+      if (item->payload () == 0) continue;
+      item->payload ()->SetTrie (0);
+    }
+  m_faceIndex.clear ();
+
+  super::clear ();
   Object::DoDispose ();
 }
 
 
+template<class TrieTraits>
 Ptr<Entry>
-FibImpl::LongestPrefixMatch (const Interest &interest)
+FibImpl<TrieTraits>::LongestPrefixMatch (const Interest &interest)
 {
-  super::iterator item = super::longest_prefix_match (interest.GetName ());
+  typename super::iterator item = super::longest_prefix_match (interest.GetName ());
   // @todo use predicate to search with exclude filters
 
   if (item == super::end ())
@@ -83,10 +109,11 @@ FibImpl::LongestPrefixMatch (const Interest &interest)
     return item->payload ();
 }
 
+template<class TrieTraits>
 Ptr<fib::Entry>
-FibImpl::Find (const Name &prefix)
+FibImpl<TrieTraits>::Find (const Name &prefix)
 {
-  super::iterator item = super::find_exact (prefix);
+  typename super::iterator item = super::find_exact (prefix);
 
   if (item == super::end ())
     return 0;
@@ -95,24 +122,26 @@ FibImpl::Find (const Name &prefix)
 }
 
 
+template<class TrieTraits>
 Ptr<Entry>
-FibImpl::Add (const Name &prefix, Ptr<Face> face, int32_t metric)
+FibImpl<TrieTraits>::Add (const Name &prefix, Ptr<Face> face, int32_t metric)
 {
   return Add (Create<Name> (prefix), face, metric);
 }
   
+template<class TrieTraits>
 Ptr<Entry>
-FibImpl::Add (const Ptr<const Name> &prefix, Ptr<Face> face, int32_t metric)
+FibImpl<TrieTraits>::Add (const Ptr<const Name> &prefix, Ptr<Face> face, int32_t metric)
 {
   NS_LOG_FUNCTION (this->GetObject<Node> ()->GetId () << boost::cref(*prefix) << boost::cref(*face) << metric);
 
   // will add entry if doesn't exists, or just return an iterator to the existing entry
-  std::pair< super::iterator, bool > result = super::insert (*prefix, 0);
+  std::pair< typename super::iterator, bool > result = super::insert (*prefix, 0);
   if (result.first != super::end ())
     {
       if (result.second)
         {
-          Ptr<EntryImpl> newEntry = Create<EntryImpl> (this, prefix);
+          Ptr<entry> newEntry = Create<entry> (this, prefix);
           newEntry->SetTrie (result.first);
           result.first->set_payload (newEntry);
         }
@@ -133,18 +162,20 @@ FibImpl::Add (const Ptr<const Name> &prefix, Ptr<Face> face, int32_t metric)
     return 0;
 }
 
+template<class TrieTraits>
 void
-FibImpl::Remove (const Ptr<const Name> &prefix)
+FibImpl<TrieTraits>::Remove (const Ptr<const Name> &prefix)
 {
   NS_LOG_FUNCTION (this->GetObject<Node> ()->GetId () << boost::cref(*prefix));
 
-  super::iterator fibEntry = super::find_exact (*prefix);
+  typename super::iterator fibEntry = super::find_exact (*prefix);
   if (fibEntry != super::end ())
     {
       // notify forwarding strategy about soon be removed FIB entry
       NS_ASSERT (this->GetObject<ForwardingStrategy> () != 0);
       this->GetObject<ForwardingStrategy> ()->WillRemoveFibEntry (fibEntry->payload ());
 
+      Detach (*fibEntry->payload ());
       super::erase (fibEntry);
     }
   // else do nothing
@@ -155,7 +186,7 @@ FibImpl::Remove (const Ptr<const Name> &prefix)
 // {
 //   NS_LOG_FUNCTION (this->GetObject<Node> ()->GetId () << boost::cref(*prefix));
 
-//   super::iterator foundItem, lastItem;
+//   typename super::iterator foundItem, lastItem;
 //   bool reachLast;
 //   boost::tie (foundItem, reachLast, lastItem) = super::getTrie ().find (*prefix);
   
@@ -166,13 +197,14 @@ FibImpl::Remove (const Ptr<const Name> &prefix)
 //                  ll::bind (&Entry::Invalidate, ll::_1));
 // }
 
+template<class TrieTraits>
 void
-FibImpl::InvalidateAll ()
+FibImpl<TrieTraits>::InvalidateAll ()
 {
   NS_LOG_FUNCTION (this->GetObject<Node> ()->GetId ());
 
-  super::parent_trie::recursive_iterator item (super::getTrie ());
-  super::parent_trie::recursive_iterator end (0);
+  typename super::parent_trie::recursive_iterator item (super::getTrie ());
+  typename super::parent_trie::recursive_iterator end (0);
   for (; item != end; item++)
     {
       if (item->payload () == 0) continue;
@@ -182,8 +214,9 @@ FibImpl::InvalidateAll ()
     }
 }
 
+template<class TrieTraits>
 void
-FibImpl::RemoveFace (super::parent_trie &item, Ptr<Face> face)
+FibImpl<TrieTraits>::RemoveFace (typename super::parent_trie &item, Ptr<Face> face)
 {
   if (item.payload () == 0) return;
   NS_LOG_FUNCTION (this);
@@ -192,39 +225,102 @@ FibImpl::RemoveFace (super::parent_trie &item, Ptr<Face> face)
                  ll::bind (&Entry::RemoveFace, ll::_1, face));
 }
 
+template<class TrieTraits>
 void
-FibImpl::RemoveFromAll (Ptr<Face> face)
+FibImpl<TrieTraits>::RemoveFromAll (Ptr<Face> face)
 {
   NS_LOG_FUNCTION (this);
 
-  Ptr<Entry> entry = Begin ();
-  while (entry != End ())
+  typename face_index::iterator record = m_faceIndex.find (PeekPointer (face));
+  if (record == m_faceIndex.end ())
+    return;
+
+  // only entries that have the face are visited, face index record is removed beforehand
+  std::vector< Ptr<entry> > entries (record->second.begin (), record->second.end ());
+  m_faceIndex.erase (record);
+
+  for (typename std::vector< Ptr<entry> >::iterator item = entries.begin ();
+       item != entries.end ();
+       item++)
     {
-      entry->RemoveFace (face);
-      if (entry->m_faces.size () == 0)
-        {
-          Ptr<Entry> nextEntry = Next (entry);
+      Ptr<entry> fibEntry = *item;
+      if (fibEntry->to_iterator () == 0)
+        continue; // entry is no longer in FIB, keep it as is
 
+      fibEntry->RemoveFace (face);
+      if (fibEntry->m_faces.size () == 0)
+        {
           // notify forwarding strategy about soon be removed FIB entry
           NS_ASSERT (this->GetObject<ForwardingStrategy> () != 0);
-          this->GetObject<ForwardingStrategy> ()->WillRemoveFibEntry (entry);
+          this->GetObject<ForwardingStrategy> ()->WillRemoveFibEntry (fibEntry);
 
-          super::erase (StaticCast<EntryImpl> (entry)->to_iterator ());
-          entry = nextEntry;
-        }
-      else
-        {
-          entry = Next (entry);
+          typename super::iterator trieItem = fibEntry->to_iterator ();
+          Detach (*fibEntry);
+          super::erase (trieItem);
         }
     }
 }
 
+template<class TrieTraits>
+std::vector< Ptr<Entry> >
+FibImpl<TrieTraits>::GetEntriesWithFace (Ptr<Face> face)
+{
+  typename face_index::iterator record = m_faceIndex.find (PeekPointer (face));
+  if (record == m_faceIndex.end ())
+    return std::vector< Ptr<Entry> > ();
+
+  return std::vector< Ptr<Entry> > (record->second.begin (), record->second.end ());
+}
+
+template<class TrieTraits>
+void
+FibImpl<TrieTraits>::Detach (entry &item)
+{
+  item.SetTrie (0);
+}
+
+template<class TrieTraits>
+void
+FibImpl<TrieTraits>::AddToFaceIndex (const Ptr<Face> &face, entry *item)
+{
+  std::vector<entry*> &entries = m_faceIndex [PeekPointer (face)];
+  item->SetIndexPosition (PeekPointer (face), entries.size ());
+  entries.push_back (item);
+}
+
+template<class TrieTraits>
+void
+FibImpl<TrieTraits>::RemoveFromFaceIndex (const Ptr<Face> &face, entry *item)
+{
+  size_t position;
+  if (!item->TakeIndexPosition (PeekPointer (face), position))
+    return;
+
+  typename face_index::iterator record = m_faceIndex.find (PeekPointer (face));
+  if (record == m_faceIndex.end ())
+    return; // record has been removed by RemoveFromAll
+
+  std::vector<entry*> &entries = record->second;
+  if (position >= entries.size () || entries [position] != item)
+    return; // position is from a record removed by RemoveFromAll
+
+  if (position + 1 != entries.size ())
+    {
+      entries [position] = entries.back ();
+      entries [position]->SetIndexPosition (PeekPointer (face), position);
+    }
+  entries.pop_back ();
+  if (entries.empty ())
+    m_faceIndex.erase (record);
+}
+
+template<class TrieTraits>
 void
-FibImpl::Print (std::ostream &os) const
+FibImpl<TrieTraits>::Print (std::ostream &os) const
 {
   // !!! unordered_set imposes "random" order of item in the same level !!!
-  super::parent_trie::const_recursive_iterator item (super::getTrie ());
-  super::parent_trie::const_recursive_iterator end (0);
+  typename super::parent_trie::const_recursive_iterator item (super::getTrie ());
+  typename super::parent_trie::const_recursive_iterator end (0);
   for (; item != end; item++)
     {
       if (item->payload () == 0) continue;
@@ -233,17 +329,19 @@ FibImpl::Print (std::ostream &os) const
     }
 }
 
+template<class TrieTraits>
 uint32_t
-FibImpl::GetSize () const
+FibImpl<TrieTraits>::GetSize () const
 {
   return super::getPolicy ().size ();
 }
 
+template<class TrieTraits>
 Ptr<const Entry>
-FibImpl::Begin () const
+FibImpl<TrieTraits>::Begin () const
 {
-  super::parent_trie::const_recursive_iterator item (super::getTrie ());
-  super::parent_trie::const_recursive_iterator end (0);
+  typename super::parent_trie::const_recursive_iterator item (super::getTrie ());
+  typename super::parent_trie::const_recursive_iterator end (0);
   for (; item != end; item++)
     {
       if (item->payload () == 0) continue;
@@ -256,19 +354,21 @@ FibImpl::Begin () const
     return item->payload ();
 }
 
+template<class TrieTraits>
 Ptr<const Entry>
-FibImpl::End () const
+FibImpl<TrieTraits>::End () const
 {
   return 0;
 }
 
+template<class TrieTraits>
 Ptr<const Entry>
-FibImpl::Next (Ptr<const Entry> from) const
+FibImpl<TrieTraits>::Next (Ptr<const Entry> from) const
 {
   if (from == 0) return 0;
   
-  super::parent_trie::const_recursive_iterator item (*StaticCast<const EntryImpl> (from)->to_iterator ());
-  super::parent_trie::const_recursive_iterator end (0);
+  typename super::parent_trie::const_recursive_iterator item (*StaticCast< const EntryImpl<TrieTraits> > (from)->to_iterator ());
+  typename super::parent_trie::const_recursive_iterator end (0);
   for (item++; item != end; item++)
     {
       if (item->payload () == 0) continue;
@@ -281,11 +381,12 @@ FibImpl::Next (Ptr<const Entry> from) const
     return item->payload ();
 }
 
+template<class TrieTraits>
 Ptr<Entry>
-FibImpl::Begin ()
+FibImpl<TrieTraits>::Begin ()
 {
-  super::parent_trie::recursive_iterator item (super::getTrie ());
-  super::parent_trie::recursive_iterator end (0);
+  typename super::parent_trie::recursive_iterator item (super::getTrie ());
+  typename super::parent_trie::recursive_iterator end (0);
   for (; item != end; item++)
     {
       if (item->payload () == 0) continue;
@@ -298,19 +399,21 @@ FibImpl::Begin ()
     return item->payload ();
 }
 
+template<class TrieTraits>
 Ptr<Entry>
-FibImpl::End ()
+FibImpl<TrieTraits>::End ()
 {
   return 0;
 }
 
+template<class TrieTraits>
 Ptr<Entry>
-FibImpl::Next (Ptr<Entry> from)
+FibImpl<TrieTraits>::Next (Ptr<Entry> from)
 {
   if (from == 0) return 0;
   
-  super::parent_trie::recursive_iterator item (*StaticCast<EntryImpl> (from)->to_iterator ());
-  super::parent_trie::recursive_iterator end (0);
+  typename super::parent_trie::recursive_iterator item (*StaticCast< EntryImpl<TrieTraits> > (from)->to_iterator ());
+  typename super::parent_trie::recursive_iterator end (0);
   for (item++; item != end; item++)
     {
       if (item->payload () == 0) continue;
@@ -324,6 +427,25 @@ FibImpl::Next (Ptr<Entry> from)
 }
 
 
+// explicit instantiation and registering
+template class FibImpl<node_trie_traits>;
+template class FibImpl<flat_trie_traits>;
+
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(FibImpl, node_trie_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(FibImpl, flat_trie_traits);
+
+#ifdef DOXYGEN
+/**
+ * \brief Default FIB implementation (node-based trie)
+ */
+class Default : public FibImpl<node_trie_traits> { };
+
+/**
+ * \brief FIB implementation using flat (arena-allocated) trie backend
+ */
+class Flat::Default : public FibImpl<flat_trie_traits> { };
+#endif
+
 } // namespace fib
 } // namespace ndn
 } // namespace ns3
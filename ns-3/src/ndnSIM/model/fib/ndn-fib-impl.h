@@ -27,21 +27,30 @@
 #include "../../utils/trie/trie-with-policy.h"
 #include "../../utils/trie/counting-policy.h"
 
+#include <boost/unordered_map.hpp>
+#include <utility>
+#include <vector>
+
 namespace ns3 {
 namespace ndn {
 namespace fib {
 
+template<class TrieTraits>
+class FibImpl;
+
 /**
  * @ingroup ndn-fib
  * @brief FIB entry implementation with with additional references to the base container
  */
+template<class TrieTraits = ndnSIM::node_trie_traits>
 class EntryImpl : public Entry
 {
 public:
   typedef ndnSIM::trie_with_policy<
     Name,
     ndnSIM::smart_pointer_payload_traits<EntryImpl>,
-    ndnSIM::counting_policy_traits
+    ndnSIM::counting_policy_traits,
+    TrieTraits
     > trie;
 
   EntryImpl (Ptr<Fib> fib, const Ptr<const Name> &prefix)
@@ -50,32 +59,117 @@ public:
   {
   }
 
+  virtual
+  ~EntryImpl ()
+  {
+    // entry stays in the face index after it has been detached from the trie (PIT entries may
+    // still refer to it), until it is destroyed
+    for (FaceMetricContainer::iterator face = m_faces.begin (); face != m_faces.end (); face++)
+      GetContainer ().RemoveFromFaceIndex (face->GetFace (), this);
+  }
+
   void
-  SetTrie (trie::iterator item)
+  SetTrie (typename trie::iterator item)
   {
     item_ = item;
   }
 
-  trie::iterator to_iterator () { return item_; }
-  trie::const_iterator to_iterator () const { return item_; }
-  
+  typename trie::iterator to_iterator () { return item_; }
+  typename trie::const_iterator to_iterator () const { return item_; }
+
+  virtual void
+  AddOrUpdateRoutingMetric (Ptr<Face> face, int32_t metric)
+  {
+    bool newFace = m_faces.find (face) == m_faces.end ();
+    Entry::AddOrUpdateRoutingMetric (face, metric);
+
+    if (newFace)
+      GetContainer ().AddToFaceIndex (face, this);
+  }
+
+  virtual void
+  RemoveFace (const Ptr<Face> &face)
+  {
+    if (m_faces.erase (face) > 0)
+      GetContainer ().RemoveFromFaceIndex (face, this);
+  }
+
 private:
-  trie::iterator item_;
+  FibImpl<TrieTraits> &
+  GetContainer ()
+  {
+    return static_cast<FibImpl<TrieTraits>&> (*m_fib);
+  }
+
+  /**
+   * @brief Remember position of the entry in the face index record of the face
+   */
+  void
+  SetIndexPosition (const Face *face, size_t position)
+  {
+    for (index_positions::iterator i = m_indexPositions.begin (); i != m_indexPositions.end (); i++)
+      {
+        if (i->first == face)
+          {
+            i->second = position;
+            return;
+          }
+      }
+    m_indexPositions.push_back (std::make_pair (face, position));
+  }
+
+  /**
+   * @brief Get and forget position of the entry in the face index record of the face
+   * @returns false if position is not known
+   */
+  bool
+  TakeIndexPosition (const Face *face, size_t &position)
+  {
+    for (index_positions::iterator i = m_indexPositions.begin (); i != m_indexPositions.end (); i++)
+      {
+        if (i->first == face)
+          {
+            position = i->second;
+            *i = m_indexPositions.back ();
+            m_indexPositions.pop_back ();
+            return true;
+          }
+      }
+    return false;
+  }
+
+private:
+  typename trie::iterator item_;
+
+  // (face, position in the face index record) for every face of the entry (an entry has only a
+  // few faces, so vector is smaller and faster than a map)
+  typedef std::vector< std::pair<const Face*, size_t> > index_positions;
+  index_positions m_indexPositions;
+
+  friend class FibImpl<TrieTraits>;
 };
 
 /**
  * @ingroup ndn-fib
- * \brief Class implementing FIB functionality
+ * @brief FIB implementation on top of ndnSIM::trie_with_policy
+ *
+ * TrieTraits selects the trie backend: ndnSIM::node_trie_traits (ns3::ndn::fib::Default)
+ * or ndnSIM::flat_trie_traits (ns3::ndn::fib::Flat::Default)
  */
+template<class TrieTraits = ndnSIM::node_trie_traits>
 class FibImpl : public Fib,
                 protected ndnSIM::trie_with_policy< Name,
-                                                    ndnSIM::smart_pointer_payload_traits< EntryImpl >,
-                                                    ndnSIM::counting_policy_traits >
+                                                    ndnSIM::smart_pointer_payload_traits< EntryImpl<TrieTraits> >,
+                                                    ndnSIM::counting_policy_traits,
+                                                    TrieTraits >
 {
 public:
   typedef ndnSIM::trie_with_policy< Name,
-                                    ndnSIM::smart_pointer_payload_traits<EntryImpl>,
-                                    ndnSIM::counting_policy_traits > super;
+                                    ndnSIM::smart_pointer_payload_traits< EntryImpl<TrieTraits> >,
+                                    ndnSIM::counting_policy_traits,
+                                    TrieTraits > super;
+
+  typedef EntryImpl<TrieTraits> entry;
   
   /**
    * \brief Interface ID
@@ -110,6 +204,9 @@ public:
   virtual void
   RemoveFromAll (Ptr<Face> face);
 
+  virtual std::vector< Ptr<Entry> >
+  GetEntriesWithFace (Ptr<Face> face);
+
   virtual void
   Print (std::ostream &os) const;
 
@@ -145,7 +242,35 @@ private:
    * entry will be removed
    */
   void
-  RemoveFace (super::parent_trie &item, Ptr<Face> face);
+  RemoveFace (typename super::parent_trie &item, Ptr<Face> face);
+
+  /**
+   * @brief Detach entry from the trie (entry is removed from the face index only when destroyed)
+   */
+  void
+  Detach (entry &item);
+
+  void
+  AddToFaceIndex (const Ptr<Face> &face, entry *item);
+
+  void
+  RemoveFromFaceIndex (const Ptr<Face> &face, entry *item);
+
+private:
+  /**
+   * @brief Reverse index: face -> FIB entries that have this face as one of the next hops
+   *
+   * Includes entries that have been removed from the FIB, but are still alive (referenced by
+   * PIT entries), so PIT can find PIT entries that rely on the face being removed.
+   *
+   * Entries are stored in insertion order (removal swaps with the last element).  Every entry
+   * remembers its position in the records of its faces, so removal of an entry is O(1) and
+   * removal of a face with n entries is O(n).
+   */
+  typedef boost::unordered_map< const Face*, std::vector<entry*> > face_index;
+  face_index m_faceIndex;
+
+  friend class EntryImpl<TrieTraits>;
 };
 
 } // namespace fib
@@ -128,6 +128,15 @@ public:
   virtual void
   RemoveFromAll (Ptr<Face> face) = 0;
 
+  /**
+   * @brief Get all FIB entries that have the face as one of the next hops (no order guaranteed)
+   *
+   * Entries that have been removed from FIB, but are still referenced (e.g., by PIT entries), are
+   * included as well
+   */
+  virtual std::vector< Ptr<fib::Entry> >
+  GetEntriesWithFace (Ptr<Face> face) = 0;
+
   /**
    * @brief Print out entries in FIB
    */
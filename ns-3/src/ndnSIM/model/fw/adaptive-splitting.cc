@@ -0,0 +1,272 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "adaptive-splitting.h"
+
+#include "ns3/ndn-interest.h"
+#include "ns3/ndn-pit.h"
+#include "ns3/ndn-pit-entry.h"
+#include "ns3/ndn-fib.h"
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+#include <boost/foreach.hpp>
+
+#include <algorithm>
+
+namespace ns3 {
+namespace ndn {
+namespace fw {
+
+NS_OBJECT_ENSURE_REGISTERED (AdaptiveSplitting);
+
+LogComponent AdaptiveSplitting::g_log = LogComponent (AdaptiveSplitting::GetLogName ().c_str ());
+
+std::string
+AdaptiveSplitting::GetLogName ()
+{
+  return super::GetLogName ()+".AdaptiveSplitting";
+}
+
+TypeId
+AdaptiveSplitting::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::ndn::fw::AdaptiveSplitting")
+    .SetGroupName ("Ndn")
+    .SetParent <super> ()
+    .AddConstructor <AdaptiveSplitting> ()
+
+    .AddAttribute ("ProbingInterval", "Minimum interval between probes of alternative faces (per FIB entry)",
+                   TimeValue (Seconds (1.0)),
+                   MakeTimeAccessor (&AdaptiveSplitting::m_probingInterval),
+                   MakeTimeChecker ())
+    ;
+  return tid;
+}
+
+TypeId
+AdaptiveSplitting::Measurements::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::ndn::fw::AdaptiveSplitting::Measurements")
+    .SetGroupName ("Ndn")
+    .SetParent <Object> ()
+    ;
+  return tid;
+}
+
+int
+AdaptiveSplitting::Measurements::Get (Ptr<Face> face)
+{
+  int index = Find (face);
+  if (index >= 0)
+    return index;
+
+  m_faces.push_back (FaceState (face));
+  return m_faces.size () - 1;
+}
+
+int
+AdaptiveSplitting::Measurements::Find (Ptr<Face> face) const
+{
+  for (size_t i = 0; i < m_faces.size (); i++)
+    {
+      if (m_faces[i].m_face == face)
+        return i;
+    }
+
+  return -1;
+}
+
+AdaptiveSplitting::AdaptiveSplitting ()
+{
+}
+
+Ptr<AdaptiveSplitting::Measurements>
+AdaptiveSplitting::GetMeasurements (Ptr<fib::Entry> fibEntry)
+{
+  Ptr<Measurements> measurements = fibEntry->GetObject<Measurements> ();
+  if (measurements == 0)
+    {
+      measurements = CreateObject<Measurements> ();
+      fibEntry->AggregateObject (measurements);
+    }
+  else if (measurements->m_faces.size () > fibEntry->m_faces.size ())
+    {
+      // some faces have been removed from the FIB entry
+      std::vector<Measurements::FaceState> faces;
+      for (std::vector<Measurements::FaceState>::iterator state = measurements->m_faces.begin ();
+           state != measurements->m_faces.end ();
+           state++)
+        {
+          if (fibEntry->m_faces.find (state->m_face) != fibEntry->m_faces.end ())
+            faces.push_back (*state);
+        }
+      measurements->m_faces.swap (faces);
+    }
+
+  return measurements;
+}
+
+bool
+AdaptiveSplitting::DoPropagateInterest (Ptr<Face> inFace,
+                                        Ptr<const Interest> interest,
+                                        Ptr<pit::Entry> pitEntry)
+{
+  NS_LOG_FUNCTION (this << interest->GetName ());
+
+  Ptr<fib::Entry> fibEntry = pitEntry->GetFibEntry ();
+  Ptr<Measurements> measurements = GetMeasurements (fibEntry);
+
+  // Faces without RTT measurements get the same weight as the best measured face
+  double bestWeight = 0;
+  BOOST_FOREACH (const fib::FaceMetric &metricFace, fibEntry->m_faces)
+    {
+      if (metricFace.GetStatus () != fib::FaceMetric::NDN_FIB_RED &&
+          !metricFace.GetSRtt ().IsZero () &&
+          metricFace.GetFace () != inFace)
+        bestWeight = std::max (bestWeight, 1.0 / metricFace.GetSRtt ().ToDouble (Time::S));
+    }
+
+  // Smooth weighted round robin: every face gets credit equal to its weight, the face with
+  // the largest credit is selected and its credit is decreased by the total weight
+  int selected = -1;
+  double totalWeight = 0;
+  BOOST_FOREACH (const fib::FaceMetric &metricFace, fibEntry->m_faces)
+    {
+      if (bestWeight == 0)
+        break; // no measurements at all
+
+      if (metricFace.GetStatus () == fib::FaceMetric::NDN_FIB_RED ||
+          metricFace.GetFace () == inFace)
+        continue;
+
+      int index = measurements->Get (metricFace.GetFace ());
+      double weight = metricFace.GetSRtt ().IsZero () ? bestWeight : 1.0 / metricFace.GetSRtt ().ToDouble (Time::S);
+
+      measurements->m_faces[index].m_credit += weight;
+      totalWeight += weight;
+      if (selected < 0 || measurements->m_faces[index].m_credit > measurements->m_faces[selected].m_credit)
+        selected = index;
+    }
+
+  Ptr<Face> outFace;
+  if (selected >= 0)
+    {
+      measurements->m_faces[selected].m_credit -= totalWeight;
+      if (TrySendOutInterest (inFace, measurements->m_faces[selected].m_face, interest, pitEntry))
+        outFace = measurements->m_faces[selected].m_face;
+    }
+
+  if (outFace == 0)
+    {
+      // no measurements yet or the selected face cannot be used, fall back to the FIB order
+      BOOST_FOREACH (const fib::FaceMetric &metricFace, fibEntry->m_faces)
+        {
+          if (metricFace.GetStatus () == fib::FaceMetric::NDN_FIB_RED) // all non-red faces are in front
+            break;
+
+          if (TrySendOutInterest (inFace, metricFace.GetFace (), interest, pitEntry))
+            {
+              outFace = metricFace.GetFace ();
+              measurements->Get (outFace); // the face is measured when Data comes back or Interest times out
+              break;
+            }
+        }
+    }
+
+  bool probed = false;
+  if (measurements->m_lastProbe.IsNegative () ||
+      Simulator::Now () - measurements->m_lastProbe >= m_probingInterval)
+    {
+      Ptr<Face> probeFace;
+      Time oldest;
+      BOOST_FOREACH (const fib::FaceMetric &metricFace, fibEntry->m_faces)
+        {
+          if (metricFace.GetStatus () == fib::FaceMetric::NDN_FIB_RED)
+            break;
+
+          if (metricFace.GetFace () == outFace || metricFace.GetFace () == inFace)
+            continue;
+
+          Time lastMeasured = measurements->m_faces[measurements->Get (metricFace.GetFace ())].m_lastMeasured;
+          if (probeFace == 0 || lastMeasured < oldest)
+            {
+              probeFace = metricFace.GetFace ();
+              oldest = lastMeasured;
+            }
+        }
+
+      if (probeFace != 0)
+        {
+          NS_LOG_DEBUG ("Probing " << *probeFace);
+          measurements->m_lastProbe = Simulator::Now ();
+          probed = TrySendOutInterest (inFace, probeFace, interest, pitEntry);
+        }
+    }
+
+  NS_LOG_INFO ("Propagated: " << (outFace != 0) << ", probed: " << probed);
+  return outFace != 0 || probed;
+}
+
+void
+AdaptiveSplitting::WillSatisfyPendingInterest (Ptr<Face> inFace,
+                                               Ptr<pit::Entry> pitEntry)
+{
+  if (inFace != 0 &&
+      pitEntry->GetOutgoing ().find (inFace) != pitEntry->GetOutgoing ().end ())
+    {
+      Ptr<fib::Entry> fibEntry = pitEntry->GetFibEntry ();
+      Ptr<Measurements> measurements = GetMeasurements (fibEntry);
+
+      // Data may come from a face that has been removed from the FIB entry
+      int index = measurements->Find (inFace);
+      if (index >= 0 && fibEntry->m_faces.find (inFace) != fibEntry->m_faces.end ())
+        measurements->m_faces[index].m_lastMeasured = Simulator::Now ();
+    }
+
+  super::WillSatisfyPendingInterest (inFace, pitEntry);
+}
+
+void
+AdaptiveSplitting::WillEraseTimedOutPendingInterest (Ptr<pit::Entry> pitEntry)
+{
+  Ptr<fib::Entry> fibEntry = pitEntry->GetFibEntry ();
+  Ptr<Measurements> measurements = GetMeasurements (fibEntry);
+
+  for (pit::Entry::out_container::iterator face = pitEntry->GetOutgoing ().begin ();
+       face != pitEntry->GetOutgoing ().end ();
+       face ++)
+    {
+      // skip faces that have been removed from the FIB entry since the Interest has been sent
+      int index = measurements->Find (face->m_face);
+      if (index < 0 || fibEntry->m_faces.find (face->m_face) == fibEntry->m_faces.end ())
+        continue;
+
+      // time the Interest has been waiting for Data is used as an RTT sample
+      fibEntry->UpdateFaceRtt (face->m_face, Simulator::Now () - face->m_sendTime);
+      measurements->m_faces[index].m_lastMeasured = Simulator::Now ();
+    }
+
+  super::WillEraseTimedOutPendingInterest (pitEntry);
+}
+
+} // namespace fw
+} // namespace ndn
+} // namespace ns3
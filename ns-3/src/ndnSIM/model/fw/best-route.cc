@@ -99,6 +99,13 @@ BestRoute::DoPropagateInterest (Ptr<Face> inFace,
   return propagatedCount > 0;
 }
 
+bool
+BestRoute::SupportsSingleNextHopFastPath () const
+{
+  // derived strategies may change DoPropagateInterest, so they have to opt in themselves
+  return GetInstanceTypeId () == BestRoute::GetTypeId ();
+}
+
 } // namespace fw
 } // namespace ndn
 } // namespace ns3
@@ -61,6 +61,10 @@ public:
                        Ptr<const Interest> interest,
                        Ptr<pit::Entry> pitEntry);
 protected:
+  // inherited from ForwardingStrategy
+  virtual bool
+  SupportsSingleNextHopFastPath () const;
+
   static LogComponent g_log;
 };
 
@@ -91,6 +91,12 @@ Flooding::DoPropagateInterest (Ptr<Face> inFace,
   return propagatedCount > 0;
 }
 
+bool
+Flooding::SupportsSingleNextHopFastPath () const
+{
+  return GetInstanceTypeId () == Flooding::GetTypeId ();
+}
+
 } // namespace fw
 } // namespace ndn
 } // namespace ns3
@@ -71,6 +71,9 @@ protected:
                        Ptr<const Interest> interest,
                        Ptr<pit::Entry> pitEntry);
 
+  virtual bool
+  SupportsSingleNextHopFastPath () const;
+
 protected:
   static LogComponent g_log;
 };
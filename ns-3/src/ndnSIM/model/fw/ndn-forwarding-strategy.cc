@@ -29,6 +29,7 @@
 #include "ns3/ndn-fib.h"
 #include "ns3/ndn-content-store.h"
 #include "ns3/ndn-face.h"
+#include "ns3/ndn-limits.h"
 
 #include "ns3/assert.h"
 #include "ns3/ptr.h"
@@ -39,6 +40,8 @@
 
 #include "ns3/ndnSIM/utils/ndn-fw-hop-count-tag.h"
 
+#include <algorithm>
+
 #include <boost/ref.hpp>
 #include <boost/foreach.hpp>
 #include <boost/lambda/lambda.hpp>
@@ -46,6 +49,12 @@
 #include <boost/tuple/tuple.hpp>
 namespace ll = boost::lambda;
 
+#ifdef NDNSIM_FW_COUNTERS
+#define COUNT(face, counter) GetCounters (face).counter ++
+#else
+#define COUNT(face, counter)
+#endif
+
 namespace ns3 {
 namespace ndn {
 
@@ -100,11 +109,22 @@ TypeId ForwardingStrategy::GetTypeId (void)
                    BooleanValue (true),
                    MakeBooleanAccessor (&ForwardingStrategy::m_detectRetransmissions),
                    MakeBooleanChecker ())
+
+    .AddAttribute ("SingleNextHopFastPath", "Forward Interests for prefixes with a single non-RED next hop without "
+                                            "calling the strategy (see PropagateInterestToSingleNextHop). "
+                                            "Ignored by strategies that do not support the fast path",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&ForwardingStrategy::m_singleNextHopFastPath),
+                   MakeBooleanChecker ())
     ;
   return tid;
 }
 
 ForwardingStrategy::ForwardingStrategy ()
+#ifdef NDNSIM_FW_COUNTERS
+  : m_satisfiedInterestsCount (0)
+  , m_timedOutInterestsCount (0)
+#endif
 {
 }
 
@@ -147,6 +167,7 @@ ForwardingStrategy::OnInterest (Ptr<Face> inFace,
 {
   NS_LOG_FUNCTION (inFace << interest->GetName ());
   m_inInterests (interest, inFace);
+  COUNT (inFace, m_inInterests);
 
   Ptr<pit::Entry> pitEntry = m_pit->Lookup (*interest);
   bool similarInterest = true;
@@ -207,6 +228,7 @@ ForwardingStrategy::OnInterest (Ptr<Face> inFace,
       // Suppress this interest if we're still expecting data from some other face
       NS_LOG_DEBUG ("Suppress interests");
       m_dropInterests (interest, inFace);
+      COUNT (inFace, m_dropInterests);
 
       DidSuppressSimilarInterest (inFace, interest, pitEntry);
       return;
@@ -226,6 +248,7 @@ ForwardingStrategy::OnData (Ptr<Face> inFace,
 {
   NS_LOG_FUNCTION (inFace << data->GetName ());
   m_inData (data, inFace);
+  COUNT (inFace, m_inData);
 
   // Lookup PIT entry
   Ptr<pit::Entry> pitEntry = m_pit->Lookup (*data);
@@ -245,6 +268,7 @@ ForwardingStrategy::OnData (Ptr<Face> inFace,
 
           //drop dulicated or not requested data packet
           m_dropData (data, inFace);
+          COUNT (inFace, m_dropData);
         }
 
       DidReceiveUnsolicitedData (inFace, data, cached);
@@ -281,6 +305,7 @@ ForwardingStrategy::FailedToCreatePitEntry (Ptr<Face> inFace,
                                             Ptr<const Interest> interest)
 {
   m_dropInterests (interest, inFace);
+  COUNT (inFace, m_dropInterests);
 }
 
 void
@@ -295,6 +320,7 @@ ForwardingStrategy::DidReceiveDuplicateInterest (Ptr<Face> inFace,
   /////////////////////////////////////////////////////////////////////////////////////////
   pitEntry->AddIncoming (inFace);
   m_dropInterests (interest, inFace);
+  COUNT (inFace, m_dropInterests);
 }
 
 void
@@ -320,6 +346,7 @@ ForwardingStrategy::DidExhaustForwardingOptions (Ptr<Face> inFace,
   if (pitEntry->AreAllOutgoingInVain ())
     {
       m_dropInterests (interest, inFace);
+      COUNT (inFace, m_dropInterests);
 
       // All incoming interests cannot be satisfied. Remove them
       pitEntry->ClearIncoming ();
@@ -371,6 +398,7 @@ ForwardingStrategy::SatisfyPendingInterest (Ptr<Face> inFace,
       if (!ok)
         {
           m_dropData (data, incoming.m_face);
+          COUNT (incoming.m_face, m_dropData);
           NS_LOG_DEBUG ("Cannot satisfy data to " << *incoming.m_face);
         }
     }
@@ -414,6 +442,9 @@ ForwardingStrategy::WillSatisfyPendingInterest (Ptr<Face> inFace,
     }
 
   m_satisfiedInterests (pitEntry);
+#ifdef NDNSIM_FW_COUNTERS
+  m_satisfiedInterestsCount ++;
+#endif
 }
 
 bool
@@ -455,6 +486,23 @@ ForwardingStrategy::PropagateInterest (Ptr<Face> inFace,
                                        Ptr<const Interest> interest,
                                        Ptr<pit::Entry> pitEntry)
 {
+  if (m_singleNextHopFastPath && SupportsSingleNextHopFastPath ())
+    {
+      Ptr<fib::Entry> fibEntry = pitEntry->GetFibEntry ();
+      if (fibEntry->m_faces.size () == 1)
+        {
+          const fib::FaceMetric &nextHop = fibEntry->m_faces[0];
+          if (nextHop.GetStatus () != fib::FaceMetric::NDN_FIB_RED &&
+              nextHop.GetFace () != inFace &&
+              fibEntry->GetObject<Limits> () == 0 &&
+              nextHop.GetFace ()->GetObject<Limits> () == 0)
+            {
+              PropagateInterestToSingleNextHop (inFace, nextHop.GetFace (), interest, pitEntry);
+              return;
+            }
+        }
+    }
+
   bool isRetransmitted = m_detectRetransmissions && // a small guard
                          DetectRetransmittedInterest (inFace, interest, pitEntry);
 
@@ -489,6 +537,57 @@ ForwardingStrategy::PropagateInterest (Ptr<Face> inFace,
     }
 }
 
+void
+ForwardingStrategy::PropagateInterestToSingleNextHop (Ptr<Face> inFace,
+                                                      Ptr<Face> outFace,
+                                                      Ptr<const Interest> interest,
+                                                      Ptr<pit::Entry> pitEntry)
+{
+  bool isRetransmitted = m_detectRetransmissions &&
+    pitEntry->GetIncoming ().find (inFace) != pitEntry->GetIncoming ().end ();
+
+  pitEntry->AddIncoming (inFace);
+  pitEntry->UpdateLifetime (interest->GetInterestLifetime ());
+
+  // outFace is never the same as inFace
+  pit::Entry::out_iterator outgoing = pitEntry->GetOutgoing ().find (outFace);
+  bool canSend = outgoing == pitEntry->GetOutgoing ().end () ||
+    (m_detectRetransmissions && outgoing->m_retxCount < pitEntry->GetMaxRetxCount ());
+
+  if (!canSend && isRetransmitted) //give another chance if retransmitted
+    {
+      pitEntry->IncreaseAllowedRetxCount ();
+      canSend = m_detectRetransmissions && outgoing->m_retxCount < pitEntry->GetMaxRetxCount ();
+    }
+
+  if (!canSend)
+    {
+      if (pitEntry->AreAllOutgoingInVain ())
+        {
+          DidExhaustForwardingOptions (inFace, interest, pitEntry);
+        }
+      return;
+    }
+
+  pitEntry->AddOutgoing (outFace);
+
+  //transmission
+  if (!outFace->SendInterest (interest))
+    {
+      m_dropInterests (interest, outFace);
+      COUNT (outFace, m_dropInterests);
+    }
+
+  m_outInterests (interest, outFace);
+  COUNT (outFace, m_outInterests);
+}
+
+bool
+ForwardingStrategy::SupportsSingleNextHopFastPath () const
+{
+  return false;
+}
+
 bool
 ForwardingStrategy::CanSendOutInterest (Ptr<Face> inFace,
                                         Ptr<Face> outFace,
@@ -537,6 +636,7 @@ ForwardingStrategy::TrySendOutInterest (Ptr<Face> inFace,
   if (!successSend)
     {
       m_dropInterests (interest, outFace);
+      COUNT (outFace, m_dropInterests);
     }
 
   DidSendOutInterest (inFace, outFace, interest, pitEntry);
@@ -551,6 +651,7 @@ ForwardingStrategy::DidSendOutInterest (Ptr<Face> inFace,
                                         Ptr<pit::Entry> pitEntry)
 {
   m_outInterests (interest, outFace);
+  COUNT (outFace, m_outInterests);
 }
 
 void
@@ -560,14 +661,66 @@ ForwardingStrategy::DidSendOutData (Ptr<Face> inFace,
                                     Ptr<pit::Entry> pitEntry)
 {
   m_outData (data, inFace == 0, outFace);
+  COUNT (outFace, m_outData);
 }
 
 void
 ForwardingStrategy::WillEraseTimedOutPendingInterest (Ptr<pit::Entry> pitEntry)
 {
   m_timedOutInterests (pitEntry);
+#ifdef NDNSIM_FW_COUNTERS
+  m_timedOutInterestsCount ++;
+#endif
+}
+
+#ifdef NDNSIM_FW_COUNTERS
+
+ForwardingStrategy::FaceCounters &
+ForwardingStrategy::GetCounters (Ptr<const Face> face)
+{
+  uint32_t id = face->GetId ();
+  if (id >= m_faceCounters.size ())
+    {
+      m_faceCounters.resize (id + 1);
+    }
+  return m_faceCounters[id];
+}
+
+const ForwardingStrategy::FaceCounters &
+ForwardingStrategy::GetFaceCounters (Ptr<const Face> face) const
+{
+  static const FaceCounters zero;
+
+  uint32_t id = face->GetId ();
+  if (id >= m_faceCounters.size ())
+    {
+      return zero;
+    }
+  return m_faceCounters[id];
+}
+
+uint64_t
+ForwardingStrategy::GetSatisfiedInterests () const
+{
+  return m_satisfiedInterestsCount;
 }
 
+uint64_t
+ForwardingStrategy::GetTimedOutInterests () const
+{
+  return m_timedOutInterestsCount;
+}
+
+void
+ForwardingStrategy::ResetCounters ()
+{
+  std::fill (m_faceCounters.begin (), m_faceCounters.end (), FaceCounters ());
+  m_satisfiedInterestsCount = 0;
+  m_timedOutInterestsCount = 0;
+}
+
+#endif // NDNSIM_FW_COUNTERS
+
 void
 ForwardingStrategy::AddFace (Ptr<Face> face)
 {
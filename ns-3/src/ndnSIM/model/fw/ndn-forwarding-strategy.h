@@ -26,6 +26,18 @@
 #include "ns3/object.h"
 #include "ns3/traced-callback.h"
 
+#include <vector>
+
+/**
+ * @brief Per-face packet counters in forwarding strategy (see ForwardingStrategy::GetFaceCounters)
+ *
+ * Enabled by default.  Can be disabled during configuration (``./waf configure --disable-ndn-fw-counters``),
+ * in which case the counters and the introspection methods are not compiled in
+ */
+#ifndef NDNSIM_DISABLE_FW_COUNTERS
+#define NDNSIM_FW_COUNTERS 1
+#endif
+
 namespace ns3 {
 namespace ndn {
 
@@ -134,6 +146,55 @@ public:
   virtual void
   WillRemoveFibEntry (Ptr<fib::Entry> fibEntry);
 
+#ifdef NDNSIM_FW_COUNTERS
+  /**
+   * @brief Packet counters of the face (number of packets since the creation or the last ResetCounters call)
+   *
+   * Counters are updated in the same places where the corresponding trace sources (InInterests, OutData, etc.)
+   * are fired, but do not require connecting to the trace sources
+   */
+  struct FaceCounters
+  {
+    FaceCounters ()
+      : m_inInterests (0), m_outInterests (0), m_dropInterests (0)
+      , m_inData (0), m_outData (0), m_dropData (0)
+    {
+    }
+
+    uint64_t m_inInterests;
+    uint64_t m_outInterests;
+    uint64_t m_dropInterests;
+
+    uint64_t m_inData;
+    uint64_t m_outData;
+    uint64_t m_dropData;
+  };
+
+  /**
+   * @brief Get packet counters of the face (all zeros, if there were no packets on the face)
+   */
+  const FaceCounters &
+  GetFaceCounters (Ptr<const Face> face) const;
+
+  /**
+   * @brief Get number of satisfied Interests (PIT entries)
+   */
+  uint64_t
+  GetSatisfiedInterests () const;
+
+  /**
+   * @brief Get number of timed out Interests (PIT entries)
+   */
+  uint64_t
+  GetTimedOutInterests () const;
+
+  /**
+   * @brief Set all counters to zero
+   */
+  void
+  ResetCounters ();
+#endif // NDNSIM_FW_COUNTERS
+
 protected:
   /**
    * @brief An event that is fired every time a new PIT entry is created
@@ -398,6 +459,11 @@ protected:
    * @param interest   Interest packet
    * @param pitEntry   reference to PIT entry (reference to corresponding FIB entry inside)
    *
+   * If SingleNextHopFastPath attribute is set, the strategy supports the fast path (see
+   * SupportsSingleNextHopFastPath), and FIB entry has only one next hop that is not RED (and neither
+   * the next hop nor FIB entry has Limits object), DoPropagateInterest is not called and the
+   * Interest is forwarded by PropagateInterestToSingleNextHop
+   *
    * @see DoPropagateInterest
    */
   virtual void
@@ -405,6 +471,38 @@ protected:
                      Ptr<const Interest> interest,
                      Ptr<pit::Entry> pitEntry);
 
+  /**
+   * @brief Fast path of PropagateInterest for FIB entries with a single next hop
+   *
+   * Performs exactly the same actions as the default implementations of PropagateInterest,
+   * DetectRetransmittedInterest, TrySendOutInterest, CanSendOutInterest, and DidSendOutInterest
+   * would do for such FIB entry, but without virtual calls.  Therefore, it is used only for
+   * strategies that return true from SupportsSingleNextHopFastPath.
+   *
+   * @param inFace     incoming face
+   * @param outFace    the only next hop
+   * @param interest   Interest packet
+   * @param pitEntry   reference to PIT entry (reference to corresponding FIB entry inside)
+   */
+  void
+  PropagateInterestToSingleNextHop (Ptr<Face> inFace,
+                                    Ptr<Face> outFace,
+                                    Ptr<const Interest> interest,
+                                    Ptr<pit::Entry> pitEntry);
+
+  /**
+   * @brief Check if PropagateInterestToSingleNextHop can be used instead of DoPropagateInterest
+   *
+   * Should return true only if the strategy forwards Interest to the only non-RED next hop and
+   * does not override any of the methods listed for PropagateInterestToSingleNextHop.  Default
+   * implementation returns false, so SingleNextHopFastPath attribute has no effect.
+   *
+   * Flooding, SmartFlooding, and BestRoute return true only for their own TypeId, so strategies
+   * derived from them do not use the fast path unless they override this method.
+   */
+  virtual bool
+  SupportsSingleNextHopFastPath () const;
+
   /**
    * @brief Virtual method to perform Interest propagation according to the forwarding strategy logic
    *
@@ -441,6 +539,7 @@ protected:
   bool m_cacheUnsolicitedDataFromApps;
   bool m_cacheUnsolicitedData;
   bool m_detectRetransmissions;
+  bool m_singleNextHopFastPath;
 
   TracedCallback<Ptr<const Interest>,
                  Ptr<const Face> > m_outInterests; ///< @brief Transmitted interests trace
@@ -471,6 +570,15 @@ protected:
 
   TracedCallback< Ptr<const pit::Entry> > m_satisfiedInterests;
   TracedCallback< Ptr<const pit::Entry> > m_timedOutInterests;
+
+#ifdef NDNSIM_FW_COUNTERS
+  FaceCounters &
+  GetCounters (Ptr<const Face> face);
+
+  std::vector<FaceCounters> m_faceCounters; ///< @brief counters, indexed by face ID
+  uint64_t m_satisfiedInterestsCount;
+  uint64_t m_timedOutInterestsCount;
+#endif // NDNSIM_FW_COUNTERS
 };
 
 } // namespace ndn
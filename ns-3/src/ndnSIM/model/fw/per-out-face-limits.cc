@@ -27,6 +27,7 @@
 #include "best-route.h"
 #include "flooding.h"
 #include "smart-flooding.h"
+#include "adaptive-splitting.h"
 
 namespace ns3 {
 namespace ndn {
@@ -44,6 +45,10 @@ template class PerOutFaceLimits<SmartFlooding>;
 typedef PerOutFaceLimits<SmartFlooding> PerOutFaceLimitsSmartFlooding;
 NS_OBJECT_ENSURE_REGISTERED (PerOutFaceLimitsSmartFlooding);
 
+template class PerOutFaceLimits<AdaptiveSplitting>;
+typedef PerOutFaceLimits<AdaptiveSplitting> PerOutFaceLimitsAdaptiveSplitting;
+NS_OBJECT_ENSURE_REGISTERED (PerOutFaceLimitsAdaptiveSplitting);
+
 #ifdef DOXYGEN
 // /**
 //  * \brief Strategy implementing per-out-face limits on top of BestRoute strategy
@@ -59,6 +64,11 @@ class Flooding::PerOutFaceLimits : public ::ns3::ndn::fw::PerOutFaceLimits<Flood
  * \brief Strategy implementing per-out-face limits on top of SmartFlooding strategy
  */
 class SmartFlooding::PerOutFaceLimits : public ::ns3::ndn::fw::PerOutFaceLimits<SmartFlooding> { };
+
+/**
+ * \brief Strategy implementing per-out-face limits on top of AdaptiveSplitting strategy
+ */
+class AdaptiveSplitting::PerOutFaceLimits : public ::ns3::ndn::fw::PerOutFaceLimits<AdaptiveSplitting> { };
 #endif
 
 } // namespace fw
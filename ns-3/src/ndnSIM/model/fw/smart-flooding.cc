@@ -96,6 +96,12 @@ SmartFlooding::DoPropagateInterest (Ptr<Face> inFace,
   return propagatedCount > 0;
 }
 
+bool
+SmartFlooding::SupportsSingleNextHopFastPath () const
+{
+  return GetInstanceTypeId () == SmartFlooding::GetTypeId ();
+}
+
 } // namespace fw
 } // namespace ndn
 } // namespace ns3
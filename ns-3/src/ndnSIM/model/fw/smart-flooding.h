@@ -60,6 +60,10 @@ public:
                        Ptr<pit::Entry> pitEntry);
 
 protected:
+  // inherited from ForwardingStrategy
+  virtual bool
+  SupportsSingleNextHopFastPath () const;
+
   static LogComponent g_log;
 };
 
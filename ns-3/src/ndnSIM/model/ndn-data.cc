@@ -44,17 +44,17 @@ Data::Data (Ptr<Packet> payload/* = Create<Packet> ()*/)
 }
 
 Data::Data (const Data &other)
-  : m_name (Create<Name> (other.GetName ()))
+  : m_name (other.m_name)
   , m_freshness (other.GetFreshness ())
   , m_timestamp (other.GetTimestamp ())
   , m_signature (other.GetSignature ())
   , m_payload (other.GetPayload ()->Copy ())
-  , m_wire (0)
+  , m_keyLocator (other.m_keyLocator)
+  , m_wire (other.m_wire)
 {
-  if (other.GetKeyLocator ())
-    {
-      m_keyLocator = Create<Name> (*other.GetKeyLocator ());
-    }
+  // Name, key locator, and wire encoding are never modified in place (setters replace pointers),
+  // so they can be safely shared between copies.  Payload is copied (copy-on-write buffers),
+  // so each copy has its own set of packet tags
 }
 
 void
@@ -129,6 +129,7 @@ void
 Data::SetKeyLocator (Ptr<Name> keyLocator)
 {
   m_keyLocator = keyLocator;
+  m_wire = 0;
 }
 
 Ptr<const Name>
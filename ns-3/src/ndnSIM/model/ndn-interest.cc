@@ -38,6 +38,7 @@ Interest::Interest (Ptr<Packet> payload/* = Create<Packet> ()*/)
   , m_exclude (0)
   , m_payload (payload)
   , m_wire (0)
+  , m_wireStale (false)
 {
   if (m_payload == 0) // just in case
     {
@@ -46,16 +47,19 @@ Interest::Interest (Ptr<Packet> payload/* = Create<Packet> ()*/)
 }
 
 Interest::Interest (const Interest &interest)
-  : m_name             (Create<Name> (interest.GetName ()))
+  : m_name             (interest.m_name)
   , m_scope            (interest.m_scope)
   , m_interestLifetime (interest.m_interestLifetime)
   , m_nonce            (interest.m_nonce)
   , m_nackType         (interest.m_nackType)
-  , m_exclude          (interest.m_exclude ? Create<Exclude> (*interest.GetExclude ()) : 0)
+  , m_exclude          (interest.m_exclude)
   , m_payload          (interest.GetPayload ()->Copy ())
-  , m_wire             (0)
+  , m_wire             (interest.m_wire)
+  , m_wireStale        (interest.m_wireStale)
 {
   NS_LOG_FUNCTION ("correct copy constructor");
+  // Name, exclude filter, and wire encoding are never modified in place (setters replace pointers),
+  // so they can be safely shared between copies
 }
 
 void
@@ -89,7 +93,7 @@ void
 Interest::SetScope (int8_t scope)
 {
   m_scope = scope;
-  m_wire = 0;
+  m_wireStale = true;
 }
 
 int8_t
@@ -102,7 +106,7 @@ void
 Interest::SetInterestLifetime (Time lifetime)
 {
   m_interestLifetime = lifetime;
-  m_wire = 0;
+  m_wireStale = true;
 }
 
 Time
@@ -115,7 +119,7 @@ void
 Interest::SetNonce (uint32_t nonce)
 {
   m_nonce = nonce;
-  m_wire = 0;
+  m_wireStale = true;
 }
 
 uint32_t
@@ -128,7 +132,7 @@ void
 Interest::SetNack (uint8_t nackType)
 {
   m_nackType = nackType;
-  m_wire = 0;
+  m_wireStale = true;
 }
 
 uint8_t
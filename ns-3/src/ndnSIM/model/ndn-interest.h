@@ -211,11 +211,28 @@ public:
   /**
    * @brief Get wire formatted packet
    *
-   * If wire formatted packet has not been set before, 0 will be returned
+   * If wire formatted packet has not been set before or interest has been modified since then,
+   * 0 will be returned
    */
   inline Ptr<const Packet>
   GetWire () const;
 
+  /**
+   * @brief Get cached wire formatted packet, even if fixed-size fields (nonce, scope, nack type,
+   *        and interest lifetime) have been modified after the packet was cached
+   *
+   * Wire formats that can update these fields in place can use this call to avoid re-encoding
+   * the whole interest.  IsWireStale () tells whether the fields need to be updated.
+   */
+  inline Ptr<const Packet>
+  GetStaleWire () const;
+
+  /**
+   * @brief Check if fixed-size fields have been modified after wire formatted packet was cached
+   */
+  inline bool
+  IsWireStale () const;
+
   /**
    * @brief Set (cache) wire formatted packet
    */
@@ -244,6 +261,7 @@ private:
   Ptr<Packet> m_payload;    ///< @brief virtual payload
 
   mutable Ptr<const Packet> m_wire;
+  mutable bool m_wireStale; ///< @brief fixed-size fields of m_wire do not correspond to the current values
 };
 
 inline std::ostream &
@@ -255,14 +273,27 @@ operator << (std::ostream &os, const Interest &i)
 
 inline Ptr<const Packet>
 Interest::GetWire () const
+{
+  return m_wireStale ? 0 : m_wire;
+}
+
+inline Ptr<const Packet>
+Interest::GetStaleWire () const
 {
   return m_wire;
 }
 
+inline bool
+Interest::IsWireStale () const
+{
+  return m_wireStale;
+}
+
 inline void
 Interest::SetWire (Ptr<const Packet> packet) const
 {
   m_wire = packet;
+  m_wireStale = false;
 }
 
 /**
@@ -48,35 +48,89 @@ public:
   : Entry (pit, header, fibEntry)
   , item_ (0)
   {
-    CONTAINER.i_time.insert (*this);
-    CONTAINER.RescheduleCleaning ();
+    CONTAINER.ScheduleExpiration (*this);
+    CONTAINER.AddToFibIndex (*this);
   }
   
   virtual ~EntryImpl ()
   {
-    CONTAINER.i_time.erase (Pit::time_index::s_iterator_to (*this));
-    
-    CONTAINER.RescheduleCleaning ();
+    CONTAINER.i_time.erase (*this);
+    CONTAINER.RemoveFromFibIndex (*this);
+
+    for (in_iterator face = m_incoming.begin (); face != m_incoming.end (); face++)
+      CONTAINER.RemoveFromFaceIndex (face->m_face, *this);
+    for (out_iterator face = m_outgoing.begin (); face != m_outgoing.end (); face++)
+      if (m_incoming.find (face->m_face) == m_incoming.end ())
+        CONTAINER.RemoveFromFaceIndex (face->m_face, *this);
   }
 
   virtual void
   UpdateLifetime (const Time &offsetTime)
   {
-    CONTAINER.i_time.erase (Pit::time_index::s_iterator_to (*this));
+    CONTAINER.i_time.erase (*this);
     super::UpdateLifetime (offsetTime);
-    CONTAINER.i_time.insert (*this);
-
-    CONTAINER.RescheduleCleaning ();
+    CONTAINER.ScheduleExpiration (*this);
   }
 
   virtual void
   OffsetLifetime (const Time &offsetTime)
   {
-    CONTAINER.i_time.erase (Pit::time_index::s_iterator_to (*this));
+    CONTAINER.i_time.erase (*this);
     super::OffsetLifetime (offsetTime);
-    CONTAINER.i_time.insert (*this);
+    CONTAINER.ScheduleExpiration (*this);
+  }
+
+  virtual in_iterator
+  AddIncoming (Ptr<Face> face)
+  {
+    bool newFace = !IsFaceReferenced (face);
+    in_iterator ret = super::AddIncoming (face);
+    if (newFace)
+      CONTAINER.AddToFaceIndex (face, *this);
+    return ret;
+  }
+
+  virtual void
+  RemoveIncoming (Ptr<Face> face)
+  {
+    super::RemoveIncoming (face);
+    if (!IsFaceReferenced (face))
+      CONTAINER.RemoveFromFaceIndex (face, *this);
+  }
+
+  virtual void
+  ClearIncoming ()
+  {
+    for (in_iterator face = m_incoming.begin (); face != m_incoming.end (); face++)
+      if (m_outgoing.find (face->m_face) == m_outgoing.end ())
+        CONTAINER.RemoveFromFaceIndex (face->m_face, *this);
+    super::ClearIncoming ();
+  }
+
+  virtual out_iterator
+  AddOutgoing (Ptr<Face> face)
+  {
+    bool newFace = !IsFaceReferenced (face);
+    out_iterator ret = super::AddOutgoing (face);
+    if (newFace)
+      CONTAINER.AddToFaceIndex (face, *this);
+    return ret;
+  }
 
-    CONTAINER.RescheduleCleaning ();
+  virtual void
+  ClearOutgoing ()
+  {
+    for (out_iterator face = m_outgoing.begin (); face != m_outgoing.end (); face++)
+      if (m_incoming.find (face->m_face) == m_incoming.end ())
+        CONTAINER.RemoveFromFaceIndex (face->m_face, *this);
+    super::ClearOutgoing ();
+  }
+
+  virtual void
+  RemoveAllReferencesToFace (Ptr<Face> face)
+  {
+    super::RemoveAllReferencesToFace (face);
+    CONTAINER.RemoveFromFaceIndex (face, *this);
   }
   
   // to make sure policies work
@@ -86,24 +140,20 @@ public:
   typename Pit::super::iterator to_iterator () { return item_; }
   typename Pit::super::const_iterator to_iterator () const { return item_; }
 
-public:
-  boost::intrusive::set_member_hook<> time_hook_;
-  
 private:
-  typename Pit::super::iterator item_;
-};
-
-/// @cond include_hidden
-template<class T>
-struct TimestampIndex
-{
   bool
-  operator () (const T &a, const T &b) const
+  IsFaceReferenced (const Ptr<Face> &face) const
   {
-    return a.GetExpireTime () < b.GetExpireTime ();
+    return m_incoming.find (face) != m_incoming.end () || m_outgoing.find (face) != m_outgoing.end ();
   }
+
+public:
+  TimerWheelHook time_hook_;
+  boost::intrusive::list_member_hook<> fib_hook_;
+  
+private:
+  typename Pit::super::iterator item_;
 };
-/// @endcond
 
 } // namespace pit
 } // namespace ndn
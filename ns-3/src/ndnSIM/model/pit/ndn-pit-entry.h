@@ -29,6 +29,8 @@
 #include "ns3/ndn-pit-entry-incoming-face.h"
 #include "ns3/ndn-pit-entry-outgoing-face.h"
 
+#include "ns3/ndnSIM/utils/small-sorted-set.h"
+
 #include <boost/multi_index_container.hpp>
 #include <boost/multi_index/tag.hpp>
 #include <boost/multi_index/ordered_index.hpp>
@@ -57,14 +59,17 @@ namespace pit {
 class Entry : public SimpleRefCount<Entry>
 {
 public:
-  typedef std::set< IncomingFace > in_container; ///< @brief incoming faces container type
+  // Almost all PIT entries have one or two incoming/outgoing faces and very few nonces,
+  // so small sorted arrays (with inline storage for the first elements) are used instead of std::set
+
+  typedef ndnSIM::small_sorted_set< IncomingFace, 1 > in_container; ///< @brief incoming faces container type
   typedef in_container::iterator in_iterator;                ///< @brief iterator to incoming faces
 
   // typedef OutgoingFaceContainer::type out_container; ///< @brief outgoing faces container type
-  typedef std::set< OutgoingFace > out_container; ///< @brief outgoing faces container type
+  typedef ndnSIM::small_sorted_set< OutgoingFace, 1 > out_container; ///< @brief outgoing faces container type
   typedef out_container::iterator out_iterator;              ///< @brief iterator to outgoing faces
 
-  typedef std::set< uint32_t > nonce_container;  ///< @brief nonce container type
+  typedef ndnSIM::small_sorted_set< uint32_t, 2 > nonce_container;  ///< @brief nonce container type
 
   /**
    * \brief PIT entry constructor
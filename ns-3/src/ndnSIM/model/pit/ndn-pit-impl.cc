@@ -26,12 +26,14 @@
 #include "../../utils/trie/lru-policy.h"
 #include "../../utils/trie/multi-policy.h"
 #include "../../utils/trie/aggregate-stats-policy.h"
+#include "../../utils/trie/flat-trie.h"
 
 #include "ns3/log.h"
 
 NS_LOG_COMPONENT_DEFINE ("ndn.pit.PitImpl");
 
 #include "custom-policies/serialized-size-policy.h"
+#include "custom-policies/name-hash-index-policy.h"
 
 #include "ns3/string.h"
 #include "ns3/uinteger.h"
@@ -54,6 +56,15 @@ namespace ll = boost::lambda;
     }                                                   \
   } x_ ## type ## templ ## RegistrationVariable
 
+#define NS_OBJECT_ENSURE_REGISTERED_TEMPL_TRIE(type, templ, trie)    \
+  static struct X ## type ## templ ## trie ## RegistrationClass      \
+  {                                                                 \
+    X ## type ## templ ## trie ## RegistrationClass () {             \
+      ns3::TypeId tid = type<templ, trie>::GetTypeId ();             \
+      tid.GetParent ();                                             \
+    }                                                               \
+  } x_ ## type ## templ ## trie ## RegistrationVariable
+
 namespace ns3 {
 namespace ndn {
 namespace pit {
@@ -67,6 +78,57 @@ PitImpl<serialized_size_policy_traits>::GetCurrentSize () const
   return super::getPolicy ().get_current_space_used ();
 }
 
+/**
+ * @brief Persistent policy combined with the index of PIT entries by precomputed name hashes
+ */
+struct hashed_persistent_policy_traits
+  : public multi_policy_traits< boost::mpl::vector2< persistent_policy_traits,
+                                                     name_hash_index_policy_traits > >
+{
+  /// @brief Name that can be used to identify the policy (for NS-3 object model and logging)
+  static std::string GetName () { return "HashedPersistent"; }
+};
+
+template<>
+Ptr<Entry>
+PitImpl<hashed_persistent_policy_traits>::Lookup (const Data &header)
+{
+  super::iterator item = super::getPolicy ().get<1> ().longest_prefix_match_if (header.GetName (), EntryIsNotEmpty ());
+
+  if (item == super::end ())
+    return 0;
+
+  super::getPolicy ().lookup (item);
+  return item->payload ();
+}
+
+template<>
+Ptr<Entry>
+PitImpl<hashed_persistent_policy_traits>::Lookup (const Interest &header)
+{
+  NS_ASSERT_MSG (m_fib != 0, "FIB should be set");
+  NS_ASSERT_MSG (m_forwardingStrategy != 0, "Forwarding strategy  should be set");
+
+  super::iterator item = super::getPolicy ().get<1> ().find_exact (header.GetName ());
+
+  if (item == super::end ())
+    return 0;
+  else
+    return item->payload ();
+}
+
+template<>
+Ptr<Entry>
+PitImpl<hashed_persistent_policy_traits>::Find (const Name &prefix)
+{
+  super::iterator item = super::getPolicy ().get<1> ().find_exact (prefix);
+
+  if (item == super::end ())
+    return 0;
+  else
+    return item->payload ();
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -82,6 +144,9 @@ NS_OBJECT_ENSURE_REGISTERED_TEMPL(PitImpl, random_policy_traits);
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(PitImpl, lru_policy_traits);
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(PitImpl, serialized_size_policy_traits);
 
+template class PitImpl<hashed_persistent_policy_traits>;
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(PitImpl, hashed_persistent_policy_traits);
+
 
 typedef multi_policy_traits< boost::mpl::vector2< persistent_policy_traits,
                                                   aggregate_stats_policy_traits > > PersistentWithCountsTraits;
@@ -104,6 +169,15 @@ NS_OBJECT_ENSURE_REGISTERED_TEMPL(PitImpl, LruWithCountsTraits);
 template class PitImpl<SerializedSizeWithCountsTraits>;
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(PitImpl, SerializedSizeWithCountsTraits);
 
+// PIT variants using flat (arena-allocated) trie as a backend
+template class PitImpl<persistent_policy_traits, flat_trie_traits>;
+template class PitImpl<random_policy_traits, flat_trie_traits>;
+template class PitImpl<lru_policy_traits, flat_trie_traits>;
+
+NS_OBJECT_ENSURE_REGISTERED_TEMPL_TRIE(PitImpl, persistent_policy_traits, flat_trie_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL_TRIE(PitImpl, random_policy_traits, flat_trie_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL_TRIE(PitImpl, lru_policy_traits, flat_trie_traits);
+
 #ifdef DOXYGEN
 // /**
 //  * \brief PIT in which new entries will be rejected if PIT size reached its limit
@@ -126,6 +200,27 @@ class Lru : public PitImpl<lru_policy_traits> { };
  */
 class SerializedSize : public PitImpl<serialized_size_policy_traits> { };
 
+/**
+ * @brief A variant of persistent PIT implementation, in which entries are additionally indexed by precomputed
+ * name hashes: exact-match lookups take one hash probe, data lookups take one hash probe per prefix length
+ */
+class HashedPersistent : public PitImpl<hashed_persistent_policy_traits> { };
+
+/**
+ * \brief PIT with persistent policy, using flat (arena-allocated) trie backend
+ */
+class Flat::Persistent : public PitImpl<persistent_policy_traits, flat_trie_traits> { };
+
+/**
+ * \brief PIT with random policy, using flat (arena-allocated) trie backend
+ */
+class Flat::Random : public PitImpl<random_policy_traits, flat_trie_traits> { };
+
+/**
+ * \brief PIT with LRU policy, using flat (arena-allocated) trie backend
+ */
+class Flat::Lru : public PitImpl<lru_policy_traits, flat_trie_traits> { };
+
 #endif
 
 } // namespace pit
@@ -27,8 +27,13 @@
 #include "ns3/simulator.h"
 
 #include "../../utils/trie/trie-with-policy.h"
+#include "../../utils/timer-wheel.h"
 #include "ndn-pit-entry-impl.h"
 
+#include <boost/intrusive/list.hpp>
+#include <boost/unordered_map.hpp>
+#include <boost/unordered_set.hpp>
+
 #include "ns3/ndn-interest.h"
 #include "ns3/ndn-data.h"
 #include "ns3/ndn-forwarding-strategy.h"
@@ -46,21 +51,23 @@ namespace pit {
  * @ingroup ndn-pit
  * @brief Class implementing Pending Interests Table
  */
-template<class Policy>
+template<class Policy, class TrieTraits = ndnSIM::node_trie_traits>
 class PitImpl : public Pit
               , protected ndnSIM::trie_with_policy<Name,
-                                                   ndnSIM::smart_pointer_payload_traits< EntryImpl< PitImpl< Policy > > >,
+                                                   ndnSIM::smart_pointer_payload_traits< EntryImpl< PitImpl< Policy, TrieTraits > > >,
                                                    // ndnSIM::persistent_policy_traits
-                                                   Policy
+                                                   Policy,
+                                                   TrieTraits
                                                    >
 {
 public:
   typedef ndnSIM::trie_with_policy<Name,
-                                   ndnSIM::smart_pointer_payload_traits< EntryImpl< PitImpl< Policy > > >,
+                                   ndnSIM::smart_pointer_payload_traits< EntryImpl< PitImpl< Policy, TrieTraits > > >,
                                    // ndnSIM::persistent_policy_traits
-                                   Policy
+                                   Policy,
+                                   TrieTraits
                                    > super;
-  typedef EntryImpl< PitImpl< Policy > > entry;
+  typedef EntryImpl< PitImpl< Policy, TrieTraits > > entry;
 
   /**
    * \brief Interface ID
@@ -95,6 +102,9 @@ public:
   virtual void
   MarkErased (Ptr<Entry> entry);
 
+  virtual void
+  RemoveFromAll (Ptr<Face> face);
+
   virtual void
   Print (std::ostream &os) const;
 
@@ -117,6 +127,11 @@ public:
   GetPolicy () { return super::getPolicy (); }
 
 protected:
+  void ScheduleExpiration (entry &item);
+  void AddToFaceIndex (const Ptr<Face> &face, entry &item);
+  void RemoveFromFaceIndex (const Ptr<Face> &face, entry &item);
+  void AddToFibIndex (entry &item);
+  void RemoveFromFibIndex (entry &item);
   void RescheduleCleaning ();
   void CleanExpired ();
 
@@ -134,23 +149,34 @@ private:
   uint32_t
   GetCurrentSize () const;
 
+  uint64_t
+  ToTick (const Time &time) const;
+
 private:
+  Time m_tick; ///< @brief Granularity of the timing wheel
   EventId m_cleanEvent;
+  uint64_t m_cleanTick; ///< @brief Wheel tick for which m_cleanEvent is scheduled
   Ptr<Fib> m_fib; ///< \brief Link to FIB table
   Ptr<ForwardingStrategy> m_forwardingStrategy;
 
   static LogComponent g_log; ///< @brief Logging variable
 
   // indexes
-  typedef
-  boost::intrusive::multiset<entry,
-                        boost::intrusive::compare < TimestampIndex< entry > >,
-                        boost::intrusive::member_hook< entry,
-                                                       boost::intrusive::set_member_hook<>,
-                                                       &entry::time_hook_>
-                        > time_index;
+  typedef TimerWheel<entry, &entry::time_hook_> time_index;
   time_index i_time;
 
+  // face -> entries that have the face in incoming or outgoing lists
+  typedef boost::unordered_map< const Face*, boost::unordered_set<entry*> > face_index;
+  face_index i_face;
+
+  // FIB entry -> entries created using this FIB entry
+  typedef boost::intrusive::list< entry,
+                                  boost::intrusive::member_hook< entry,
+                                                                 boost::intrusive::list_member_hook<>,
+                                                                 &entry::fib_hook_ > > fib_entries;
+  typedef boost::unordered_map< const fib::Entry*, fib_entries > fib_index;
+  fib_index i_fib;
+
   friend class EntryImpl< PitImpl >;
 };
 
@@ -158,69 +184,77 @@ private:
 ////////// Implementation ////////////////
 //////////////////////////////////////////
 
-template<class Policy>
-LogComponent PitImpl< Policy >::g_log = LogComponent (("ndn.pit." + Policy::GetName ()).c_str ());
+template<class Policy, class TrieTraits>
+LogComponent PitImpl<Policy, TrieTraits>::g_log = LogComponent (("ndn.pit." + TrieTraits::GetLogPrefix () + Policy::GetName ()).c_str ());
 
 
-template<class Policy>
+template<class Policy, class TrieTraits>
 TypeId
-PitImpl< Policy >::GetTypeId ()
+PitImpl<Policy, TrieTraits>::GetTypeId ()
 {
-  static TypeId tid = TypeId (("ns3::ndn::pit::"+Policy::GetName ()).c_str ())
+  static TypeId tid = TypeId (("ns3::ndn::pit::" + TrieTraits::GetTypeIdPrefix () + Policy::GetName ()).c_str ())
     .SetGroupName ("Ndn")
     .SetParent<Pit> ()
-    .AddConstructor< PitImpl< Policy > > ()
+    .AddConstructor< PitImpl<Policy, TrieTraits> > ()
     .AddAttribute ("MaxSize",
                    "Set maximum size of PIT in bytes. If 0, limit is not enforced",
                    UintegerValue (0),
-                   MakeUintegerAccessor (&PitImpl< Policy >::GetMaxSize,
-                                         &PitImpl< Policy >::SetMaxSize),
+                   MakeUintegerAccessor (&PitImpl<Policy, TrieTraits>::GetMaxSize,
+                                         &PitImpl<Policy, TrieTraits>::SetMaxSize),
                    MakeUintegerChecker<uint32_t> ())
 
     .AddAttribute ("CurrentSize", "Get current size of PIT in bytes",
                    TypeId::ATTR_GET,
                    UintegerValue (0),
-                   MakeUintegerAccessor (&PitImpl< Policy >::GetCurrentSize),
+                   MakeUintegerAccessor (&PitImpl<Policy, TrieTraits>::GetCurrentSize),
                    MakeUintegerChecker<uint32_t> ())
+
+    .AddAttribute ("TimerWheelTick",
+                   "Granularity of the timing wheel used to expire PIT entries (entries are removed "
+                   "at most one tick later than their expiration time). Should be set before PIT is used",
+                   TimeValue (MilliSeconds (1)),
+                   MakeTimeAccessor (&PitImpl<Policy, TrieTraits>::m_tick),
+                   MakeTimeChecker (TimeStep (1)))
     ;
 
   return tid;
 }
 
-template<class Policy>
+template<class Policy, class TrieTraits>
 uint32_t
-PitImpl<Policy>::GetCurrentSize () const
+PitImpl<Policy, TrieTraits>::GetCurrentSize () const
 {
   return super::getPolicy ().size ();
 }
 
-template<class Policy>
-PitImpl<Policy>::PitImpl ()
+template<class Policy, class TrieTraits>
+PitImpl<Policy, TrieTraits>::PitImpl ()
+  : m_cleanTick (0)
 {
 }
 
-template<class Policy>
-PitImpl<Policy>::~PitImpl ()
+template<class Policy, class TrieTraits>
+PitImpl<Policy, TrieTraits>::~PitImpl ()
 {
 }
 
-template<class Policy>
+template<class Policy, class TrieTraits>
 uint32_t
-PitImpl<Policy>::GetMaxSize () const
+PitImpl<Policy, TrieTraits>::GetMaxSize () const
 {
   return super::getPolicy ().get_max_size ();
 }
 
-template<class Policy>
+template<class Policy, class TrieTraits>
 void
-PitImpl<Policy>::SetMaxSize (uint32_t maxSize)
+PitImpl<Policy, TrieTraits>::SetMaxSize (uint32_t maxSize)
 {
   super::getPolicy ().set_max_size (maxSize);
 }
 
-template<class Policy>
+template<class Policy, class TrieTraits>
 void
-PitImpl<Policy>::NotifyNewAggregate ()
+PitImpl<Policy, TrieTraits>::NotifyNewAggregate ()
 {
   if (m_fib == 0)
     {
@@ -234,11 +268,13 @@ PitImpl<Policy>::NotifyNewAggregate ()
   Pit::NotifyNewAggregate ();
 }
 
-template<class Policy>
+template<class Policy, class TrieTraits>
 void
-PitImpl<Policy>::DoDispose ()
+PitImpl<Policy, TrieTraits>::DoDispose ()
 {
   super::clear ();
+  i_face.clear ();
+  i_fib.clear ();
 
   m_forwardingStrategy = 0;
   m_fib = 0;
@@ -246,48 +282,119 @@ PitImpl<Policy>::DoDispose ()
   Pit::DoDispose ();
 }
 
-template<class Policy>
+template<class Policy, class TrieTraits>
+uint64_t
+PitImpl<Policy, TrieTraits>::ToTick (const Time &time) const
+{
+  // round up, so entries never expire earlier than requested
+  return (time.GetTimeStep () + m_tick.GetTimeStep () - 1) / m_tick.GetTimeStep ();
+}
+
+template<class Policy, class TrieTraits>
 void
-PitImpl<Policy>::RescheduleCleaning ()
+PitImpl<Policy, TrieTraits>::ScheduleExpiration (entry &item)
 {
-  // m_cleanEvent.Cancel ();
-  Simulator::Remove (m_cleanEvent); // slower, but better for memory
   if (i_time.empty ())
+    {
+      i_time.reset (Simulator::Now ().GetTimeStep () / m_tick.GetTimeStep ());
+    }
+
+  i_time.insert (item, ToTick (item.GetExpireTime ()));
+  RescheduleCleaning ();
+}
+
+template<class Policy, class TrieTraits>
+void
+PitImpl<Policy, TrieTraits>::AddToFaceIndex (const Ptr<Face> &face, entry &item)
+{
+  i_face [PeekPointer (face)].insert (&item);
+}
+
+template<class Policy, class TrieTraits>
+void
+PitImpl<Policy, TrieTraits>::RemoveFromFaceIndex (const Ptr<Face> &face, entry &item)
+{
+  typename face_index::iterator record = i_face.find (PeekPointer (face));
+  if (record == i_face.end ())
+    return;
+
+  record->second.erase (&item);
+  if (record->second.empty ())
+    i_face.erase (record);
+}
+
+template<class Policy, class TrieTraits>
+void
+PitImpl<Policy, TrieTraits>::AddToFibIndex (entry &item)
+{
+  i_fib [PeekPointer (item.GetFibEntry ())].push_back (item);
+}
+
+template<class Policy, class TrieTraits>
+void
+PitImpl<Policy, TrieTraits>::RemoveFromFibIndex (entry &item)
+{
+  if (!item.fib_hook_.is_linked ())
+    return;
+
+  typename fib_index::iterator record = i_fib.find (PeekPointer (item.GetFibEntry ()));
+  record->second.erase (record->second.iterator_to (item));
+  if (record->second.empty ())
+    i_fib.erase (record);
+}
+
+template<class Policy, class TrieTraits>
+void
+PitImpl<Policy, TrieTraits>::RescheduleCleaning ()
+{
+  uint64_t nextTick = i_time.next ();
+  if (nextTick == time_index::npos)
     {
       // NS_LOG_DEBUG ("No items in PIT");
-      return;
+      return; // if event is still scheduled, it will just find nothing to clean
+    }
+
+  if (m_cleanEvent.IsRunning ())
+    {
+      if (m_cleanTick <= nextTick)
+        return; // wheel tick is already scheduled early enough
+
+      Simulator::Remove (m_cleanEvent);
     }
 
-  Time nextEvent = i_time.begin ()->GetExpireTime () - Simulator::Now ();
+  Time nextEvent = TimeStep (m_tick.GetTimeStep () * nextTick) - Simulator::Now ();
   if (nextEvent <= 0) nextEvent = Seconds (0);
 
   NS_LOG_DEBUG ("Schedule next cleaning in " <<
-                nextEvent.ToDouble (Time::S) << "s (at " <<
-                i_time.begin ()->GetExpireTime () << "s abs time");
+                nextEvent.ToDouble (Time::S) << "s (tick " << nextTick << ")");
 
+  m_cleanTick = nextTick;
   m_cleanEvent = Simulator::Schedule (nextEvent,
-                                      &PitImpl<Policy>::CleanExpired, this);
+                                      &PitImpl<Policy, TrieTraits>::CleanExpired, this);
 }
 
-template<class Policy>
+template<class Policy, class TrieTraits>
 void
-PitImpl<Policy>::CleanExpired ()
+PitImpl<Policy, TrieTraits>::CleanExpired ()
 {
   NS_LOG_LOGIC ("Cleaning PIT. Total: " << i_time.size ());
   Time now = Simulator::Now ();
 
-  // uint32_t count = 0;
-  while (!i_time.empty ())
+  i_time.expire (now.GetTimeStep () / m_tick.GetTimeStep ());
+
+  entry *item;
+  while ((item = i_time.pop ()) != 0)
     {
-      typename time_index::iterator entry = i_time.begin ();
-      if (entry->GetExpireTime () <= now) // is the record stale?
+      if (item->GetExpireTime () <= now) // is the record stale?
         {
-          m_forwardingStrategy->WillEraseTimedOutPendingInterest (entry->to_iterator ()->payload ());
-          super::erase (entry->to_iterator ());
-          // count ++;
+          m_forwardingStrategy->WillEraseTimedOutPendingInterest (item->to_iterator ()->payload ());
+          super::erase (item->to_iterator ());
         }
       else
-        break; // nothing else to do. All later records will not be stale
+        {
+          // should not really happen, as expiration time is rounded up to wheel ticks
+          i_time.insert (*item, ToTick (item->GetExpireTime ()));
+        }
     }
 
   if (super::getPolicy ().size ())
@@ -298,9 +405,9 @@ PitImpl<Policy>::CleanExpired ()
   RescheduleCleaning ();
 }
 
-template<class Policy>
+template<class Policy, class TrieTraits>
 Ptr<Entry>
-PitImpl<Policy>::Lookup (const Data &header)
+PitImpl<Policy, TrieTraits>::Lookup (const Data &header)
 {
   /// @todo use predicate to search with exclude filters
   typename super::iterator item = super::longest_prefix_match_if (header.GetName (), EntryIsNotEmpty ());
@@ -311,9 +418,9 @@ PitImpl<Policy>::Lookup (const Data &header)
     return item->payload (); // which could also be 0
 }
 
-template<class Policy>
+template<class Policy, class TrieTraits>
 Ptr<Entry>
-PitImpl<Policy>::Lookup (const Interest &header)
+PitImpl<Policy, TrieTraits>::Lookup (const Interest &header)
 {
   // NS_LOG_FUNCTION (header.GetName ());
   NS_ASSERT_MSG (m_fib != 0, "FIB should be set");
@@ -329,9 +436,9 @@ PitImpl<Policy>::Lookup (const Interest &header)
     return lastItem->payload (); // which could also be 0
 }
 
-template<class Policy>
+template<class Policy, class TrieTraits>
 Ptr<Entry>
-PitImpl<Policy>::Find (const Name &prefix)
+PitImpl<Policy, TrieTraits>::Find (const Name &prefix)
 {
   typename super::iterator item = super::find_exact (prefix);
 
@@ -342,9 +449,9 @@ PitImpl<Policy>::Find (const Name &prefix)
 }
 
 
-template<class Policy>
+template<class Policy, class TrieTraits>
 Ptr<Entry>
-PitImpl<Policy>::Create (Ptr<const Interest> header)
+PitImpl<Policy, TrieTraits>::Create (Ptr<const Interest> header)
 {
   NS_LOG_DEBUG (header->GetName ());
   Ptr<fib::Entry> fibEntry = m_fib->LongestPrefixMatch (*header);
@@ -376,9 +483,9 @@ PitImpl<Policy>::Create (Ptr<const Interest> header)
 }
 
 
-template<class Policy>
+template<class Policy, class TrieTraits>
 void
-PitImpl<Policy>::MarkErased (Ptr<Entry> item)
+PitImpl<Policy, TrieTraits>::MarkErased (Ptr<Entry> item)
 {
   if (this->m_PitEntryPruningTimout.IsZero ())
     {
@@ -391,9 +498,61 @@ PitImpl<Policy>::MarkErased (Ptr<Entry> item)
 }
 
 
-template<class Policy>
+template<class Policy, class TrieTraits>
+void
+PitImpl<Policy, TrieTraits>::RemoveFromAll (Ptr<Face> face)
+{
+  NS_LOG_FUNCTION (this);
+
+  // If this face is the only for the associated FIB entry, then FIB entry will be removed soon.
+  // Thus, we have to remove the whole PIT entry
+  std::vector< Ptr<entry> > entriesToRemove;
+  std::vector< Ptr<fib::Entry> > fibEntries = m_fib->GetEntriesWithFace (face);
+  for (std::vector< Ptr<fib::Entry> >::iterator fibEntry = fibEntries.begin ();
+       fibEntry != fibEntries.end ();
+       fibEntry++)
+    {
+      if ((*fibEntry)->m_faces.size () != 1)
+        continue;
+
+      typename fib_index::iterator record = i_fib.find (PeekPointer (*fibEntry));
+      if (record == i_fib.end ())
+        continue;
+
+      for (typename fib_entries::iterator item = record->second.begin ();
+           item != record->second.end ();
+           item++)
+        {
+          entriesToRemove.push_back (&(*item));
+        }
+    }
+
+  typename face_index::iterator record = i_face.find (PeekPointer (face));
+  if (record != i_face.end ())
+    {
+      // just to be on a safe side. Do the process in two steps
+      std::vector< Ptr<entry> > entries (record->second.begin (), record->second.end ());
+      i_face.erase (record);
+
+      for (typename std::vector< Ptr<entry> >::iterator item = entries.begin ();
+           item != entries.end ();
+           item++)
+        {
+          (*item)->RemoveAllReferencesToFace (face);
+        }
+    }
+
+  for (typename std::vector< Ptr<entry> >::iterator item = entriesToRemove.begin ();
+       item != entriesToRemove.end ();
+       item++)
+    {
+      MarkErased (*item);
+    }
+}
+
+template<class Policy, class TrieTraits>
 void
-PitImpl<Policy>::Print (std::ostream& os) const
+PitImpl<Policy, TrieTraits>::Print (std::ostream& os) const
 {
   // !!! unordered_set imposes "random" order of item in the same level !!!
   typename super::parent_trie::const_recursive_iterator item (super::getTrie ()), end (0);
@@ -405,16 +564,16 @@ PitImpl<Policy>::Print (std::ostream& os) const
     }
 }
 
-template<class Policy>
+template<class Policy, class TrieTraits>
 uint32_t
-PitImpl<Policy>::GetSize () const
+PitImpl<Policy, TrieTraits>::GetSize () const
 {
   return super::getPolicy ().size ();
 }
 
-template<class Policy>
+template<class Policy, class TrieTraits>
 Ptr<Entry>
-PitImpl<Policy>::Begin ()
+PitImpl<Policy, TrieTraits>::Begin ()
 {
   typename super::parent_trie::recursive_iterator item (super::getTrie ()), end (0);
   for (; item != end; item++)
@@ -429,16 +588,16 @@ PitImpl<Policy>::Begin ()
     return item->payload ();
 }
 
-template<class Policy>
+template<class Policy, class TrieTraits>
 Ptr<Entry>
-PitImpl<Policy>::End ()
+PitImpl<Policy, TrieTraits>::End ()
 {
   return 0;
 }
 
-template<class Policy>
+template<class Policy, class TrieTraits>
 Ptr<Entry>
-PitImpl<Policy>::Next (Ptr<Entry> from)
+PitImpl<Policy, TrieTraits>::Next (Ptr<Entry> from)
 {
   if (from == 0) return 0;
 
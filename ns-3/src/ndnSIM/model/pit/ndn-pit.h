@@ -130,6 +130,15 @@ public:
   virtual void
   MarkErased (Ptr<pit::Entry> entry) = 0;
 
+  /**
+   * @brief Remove all references to a face from PIT entries
+   *
+   * If for some entry the face was the only next hop of the corresponding FIB entry (i.e., FIB
+   * entry will be removed together with the face), the whole PIT entry will be marked erased
+   */
+  virtual void
+  RemoveFromAll (Ptr<Face> face) = 0;
+
   /**
    * @brief Print out PIT contents for debugging purposes
    *
@@ -22,6 +22,7 @@
 #include "../ccnb.h"
 
 #include "wire-ccnb.h"
+#include "../ndn-wire.h"
 
 #include "ns3/log.h"
 
@@ -145,18 +146,24 @@ Data::ToWire (Ptr<const ndn::Data> data)
   static DataTrailer trailer;
 
   Ptr<const Packet> p = data->GetWire ();
-  if (!p)
+  if (p)
     {
-      Ptr<Packet> packet = Create<Packet> (*data->GetPayload ());
-      Data wireEncoding (ConstCast<ndn::Data> (data));
-      packet->AddHeader (wireEncoding);
-      packet->AddTrailer (trailer);
-      data->SetWire (packet);
-
-      p = packet;
+      // cached wire encoding does not include packet tags, they are taken from the current payload
+      Ptr<Packet> packet = p->Copy ();
+      if (Wire::CopyPacketTags (data->GetPayload (), packet))
+        return packet;
     }
 
-  return p->Copy ();
+  Ptr<Packet> packet = Create<Packet> (*data->GetPayload ());
+  Data wireEncoding (ConstCast<ndn::Data> (data));
+  packet->AddHeader (wireEncoding);
+  packet->AddTrailer (trailer);
+
+  Ptr<Packet> wire = packet->Copy ();
+  wire->RemoveAllPacketTags ();
+  data->SetWire (wire);
+
+  return packet;
 }
 
 Ptr<ndn::Data>
@@ -164,14 +171,15 @@ Data::FromWire (Ptr<Packet> packet)
 {
   static DataTrailer trailer;
 
-  Ptr<ndn::Data> data = Create<ndn::Data> ();
+  // packet itself becomes payload after the header is removed (no extra payload allocation)
+  Ptr<ndn::Data> data = Create<ndn::Data> (packet);
   Ptr<Packet> wire = packet->Copy ();
+  wire->RemoveAllPacketTags ();
 
   Data wireEncoding (data);
   packet->RemoveHeader (wireEncoding);
   packet->RemoveTrailer (trailer);
 
-  data->SetPayload (packet);
   data->SetWire (wire);
 
   return data;
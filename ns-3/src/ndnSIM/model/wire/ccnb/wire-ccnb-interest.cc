@@ -22,6 +22,7 @@
 #include "../ccnb.h"
 
 #include "wire-ccnb.h"
+#include "../ndn-wire.h"
 
 #include "ns3/log.h"
 #include "ns3/unused.h"
@@ -83,29 +84,36 @@ Ptr<Packet>
 Interest::ToWire (Ptr<const ndn::Interest> interest)
 {
   Ptr<const Packet> p = interest->GetWire ();
-  if (!p)
+  if (p)
     {
-      Ptr<Packet> packet = Create<Packet> (*interest->GetPayload ());
-      Interest wireEncoding (ConstCast<ndn::Interest> (interest));
-      packet->AddHeader (wireEncoding);
-      interest->SetWire (packet);
-
-      p = packet;
+      // cached wire encoding does not include packet tags, they are taken from the current payload
+      Ptr<Packet> packet = p->Copy ();
+      if (Wire::CopyPacketTags (interest->GetPayload (), packet))
+        return packet;
     }
-  
-  return p->Copy ();
+
+  Ptr<Packet> packet = Create<Packet> (*interest->GetPayload ());
+  Interest wireEncoding (ConstCast<ndn::Interest> (interest));
+  packet->AddHeader (wireEncoding);
+
+  Ptr<Packet> wire = packet->Copy ();
+  wire->RemoveAllPacketTags ();
+  interest->SetWire (wire);
+
+  return packet;
 }
 
 Ptr<ndn::Interest>
 Interest::FromWire (Ptr<Packet> packet)
 {
-  Ptr<ndn::Interest> interest = Create<ndn::Interest> ();
+  // packet itself becomes payload after the header is removed (no extra payload allocation)
+  Ptr<ndn::Interest> interest = Create<ndn::Interest> (packet);
   Ptr<Packet> wire = packet->Copy ();
+  wire->RemoveAllPacketTags ();
 
   Interest wireEncoding (interest);
   packet->RemoveHeader (wireEncoding);
 
-  interest->SetPayload (packet);
   interest->SetWire (wire);
 
   return interest;
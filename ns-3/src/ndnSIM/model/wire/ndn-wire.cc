@@ -16,6 +16,9 @@
 #include "ns3/ndn-interest.h"
 #include "ns3/ndn-data.h"
 #include "ns3/ndn-header-helper.h"
+#include "ns3/tag.h"
+
+#include <vector>
 
 #include "ndnsim.h"
 #include "ndnsim/wire-ndnsim.h"
@@ -303,4 +306,37 @@ Wire::ToName (const std::string &name, int8_t wireFormat/* = WIRE_FORMAT_DEFAULT
     }
 }
 
+bool
+Wire::CopyPacketTags (Ptr<const Packet> from, Ptr<Packet> to)
+{
+  std::vector<Tag*> tags;
+  bool ok = true;
+
+  PacketTagIterator i = from->GetPacketTagIterator ();
+  while (i.HasNext ())
+    {
+      PacketTagIterator::Item item = i.Next ();
+      if (!item.GetTypeId ().HasConstructor ())
+        {
+          ok = false;
+          break;
+        }
+
+      Tag *tag = dynamic_cast<Tag*> (item.GetTypeId ().GetConstructor () ());
+      NS_ASSERT (tag != 0);
+      item.GetTag (*tag);
+      tags.push_back (tag);
+    }
+
+  // tags are added in reverse order to preserve their original order in the tag list
+  for (std::vector<Tag*>::reverse_iterator tag = tags.rbegin (); tag != tags.rend (); tag++)
+    {
+      if (ok)
+        to->AddPacketTag (**tag);
+      delete *tag;
+    }
+
+  return ok;
+}
+
 NDN_NAMESPACE_END
@@ -74,6 +74,18 @@ struct Wire
    */
   static Ptr<Name>
   ToName (const std::string &wire, int8_t wireFormat = WIRE_FORMAT_DEFAULT);
+
+  /**
+   * @brief Copy all packet tags from one packet to another
+   *
+   * Cached wire encodings do not carry packet tags, so tags of the current payload
+   * are attached to every copy of the cached wire that is sent out
+   *
+   * @returns false if some of the tags cannot be copied (tag type does not have
+   *          a registered constructor), in which case the caller should encode the packet from scratch
+   */
+  static bool
+  CopyPacketTags (Ptr<const Packet> from, Ptr<Packet> to);
 };
 
 inline std::string
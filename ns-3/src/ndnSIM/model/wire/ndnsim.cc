@@ -17,6 +17,7 @@ using namespace std;
 #include <ns3/log.h>
 
 #include "ndnsim/wire-ndnsim.h"
+#include "ndn-wire.h"
 
 NS_LOG_COMPONENT_DEFINE ("ndn.wire.ndnSIM");
 
@@ -66,33 +67,147 @@ Interest::GetInstanceTypeId (void) const
   return GetTypeId ();
 }
 
+/**
+ * @brief Helper header to update fixed-size fields at the beginning of the cached
+ *        wire-formatted interest (version, type, length, nonce, scope, nack type, interest lifetime)
+ */
+class InterestFixedFields : public Header
+{
+public:
+  InterestFixedFields ()
+    : m_valid (false)
+    , m_length (0)
+  {
+  }
+
+  /**
+   * @brief Check if deserialized fields belong to ndnSIM-formatted interest
+   */
+  bool
+  IsValid () const
+  {
+    return m_valid;
+  }
+
+  void
+  SetFields (Ptr<const ndn::Interest> interest)
+  {
+    m_interest = interest;
+  }
+
+  static TypeId
+  GetTypeId (void)
+  {
+    static TypeId tid = TypeId ("ns3::ndn::Interest::ndnSIM::FixedFields")
+      .SetGroupName ("Ndn")
+      .SetParent<Header> ()
+      ;
+    return tid;
+  }
+
+  virtual TypeId
+  GetInstanceTypeId (void) const
+  {
+    return GetTypeId ();
+  }
+
+  virtual void
+  Print (std::ostream &os) const
+  {
+  }
+
+  virtual uint32_t
+  GetSerializedSize (void) const
+  {
+    return 1/*version*/ + 1/*type*/ + 2/*length*/ + 4/*nonce*/ + 1/*scope*/ + 1/*nack type*/ + 2/*timestamp*/;
+  }
+
+  virtual void
+  Serialize (Buffer::Iterator start) const
+  {
+    start.WriteU8 (0x80); // version
+    start.WriteU8 (0x00); // packet type
+    start.WriteU16 (m_length); // length does not change
+
+    start.WriteU32 (m_interest->GetNonce ());
+    start.WriteU8 (m_interest->GetScope ());
+    start.WriteU8 (m_interest->GetNack ());
+
+    NS_ASSERT_MSG (0 <= m_interest->GetInterestLifetime ().ToInteger (Time::S) && m_interest->GetInterestLifetime ().ToInteger (Time::S) < 65535,
+                   "Incorrect InterestLifetime (should not be smaller than 0 and larger than 65535");
+    start.WriteU16 (static_cast<uint16_t> (m_interest->GetInterestLifetime ().ToInteger (Time::S)));
+  }
+
+  virtual uint32_t
+  Deserialize (Buffer::Iterator start)
+  {
+    uint8_t version = start.ReadU8 ();
+    uint8_t type = start.ReadU8 ();
+    m_valid = (version == 0x80 && type == 0x00);
+    m_length = start.ReadU16 ();
+    start.Next (4 + 1 + 1 + 2);
+    return GetSerializedSize ();
+  }
+
+private:
+  bool m_valid;
+  uint16_t m_length;
+  Ptr<const ndn::Interest> m_interest;
+};
+
 Ptr<Packet>
 Interest::ToWire (Ptr<const ndn::Interest> interest)
 {
-  Ptr<const Packet> p = interest->GetWire ();
-  if (!p)
+  Ptr<const Packet> p = interest->GetStaleWire ();
+  if (p && interest->IsWireStale ())
     {
-      Ptr<Packet> packet = Create<Packet> (*interest->GetPayload ());
-      Interest wireEncoding (ConstCast<ndn::Interest> (interest));
-      packet->AddHeader (wireEncoding);
-      interest->SetWire (packet);
+      // only nonce, scope, nack type, or lifetime have changed, update them in place
+      // instead of re-encoding name and selectors
+      InterestFixedFields fields;
+      if (p->GetSize () >= fields.GetSerializedSize () && p->PeekHeader (fields) && fields.IsValid ())
+        {
+          Ptr<Packet> wire = p->Copy ();
+          wire->RemoveHeader (fields);
+          fields.SetFields (interest);
+          wire->AddHeader (fields);
+
+          interest->SetWire (wire);
+          p = wire;
+        }
+      else
+        p = 0;
+    }
 
-      p = packet;
+  if (p)
+    {
+      // cached wire encoding does not include packet tags, they are taken from the current payload
+      Ptr<Packet> packet = p->Copy ();
+      if (Wire::CopyPacketTags (interest->GetPayload (), packet))
+        return packet;
     }
-  
-  return p->Copy ();
+
+  Ptr<Packet> packet = Create<Packet> (*interest->GetPayload ());
+  Interest wireEncoding (ConstCast<ndn::Interest> (interest));
+  packet->AddHeader (wireEncoding);
+
+  Ptr<Packet> wire = packet->Copy ();
+  wire->RemoveAllPacketTags ();
+  interest->SetWire (wire);
+
+  return packet;
 }
 
 Ptr<ndn::Interest>
 Interest::FromWire (Ptr<Packet> packet)
 {
-  Ptr<ndn::Interest> interest = Create<ndn::Interest> ();
+  // packet itself becomes payload after the header is removed (no extra payload allocation)
+  Ptr<ndn::Interest> interest = Create<ndn::Interest> (packet);
   Ptr<Packet> wire = packet->Copy ();
+  wire->RemoveAllPacketTags ();
 
   Interest wireEncoding (interest);
   packet->RemoveHeader (wireEncoding);
 
-  interest->SetPayload (packet);
   interest->SetWire (wire);
 
   return interest;
@@ -169,7 +284,7 @@ Interest::Deserialize (Buffer::Iterator start)
 
   m_interest->SetInterestLifetime (Seconds (i.ReadU16 ()));
 
-  m_interest->SetName (NdnSim::DeserializeName (i));
+  m_interest->SetName (NdnSim::DeserializeSharedName (i));
   
   uint32_t selectorsLen = i.ReadU16 ();
   if (selectorsLen > 0)
@@ -235,29 +350,36 @@ Ptr<Packet>
 Data::ToWire (Ptr<const ndn::Data> data)
 {
   Ptr<const Packet> p = data->GetWire ();
-  if (!p)
+  if (p)
     {
-      Ptr<Packet> packet = Create<Packet> (*data->GetPayload ());
-      Data wireEncoding (ConstCast<ndn::Data> (data));
-      packet->AddHeader (wireEncoding);
-      data->SetWire (packet);
-
-      p = packet;
+      // cached wire encoding does not include packet tags, they are taken from the current payload
+      Ptr<Packet> packet = p->Copy ();
+      if (Wire::CopyPacketTags (data->GetPayload (), packet))
+        return packet;
     }
-  
-  return p->Copy ();
+
+  Ptr<Packet> packet = Create<Packet> (*data->GetPayload ());
+  Data wireEncoding (ConstCast<ndn::Data> (data));
+  packet->AddHeader (wireEncoding);
+
+  Ptr<Packet> wire = packet->Copy ();
+  wire->RemoveAllPacketTags ();
+  data->SetWire (wire);
+
+  return packet;
 }
 
 Ptr<ndn::Data>
 Data::FromWire (Ptr<Packet> packet)
 {
-  Ptr<ndn::Data> data = Create<ndn::Data> ();
+  // packet itself becomes payload after the header is removed (no extra payload allocation)
+  Ptr<ndn::Data> data = Create<ndn::Data> (packet);
   Ptr<Packet> wire = packet->Copy ();
+  wire->RemoveAllPacketTags ();
 
   Data wireEncoding (data);
   packet->RemoveHeader (wireEncoding);
 
-  data->SetPayload (packet);
   data->SetWire (wire);
 
   return data;
@@ -340,7 +462,7 @@ Data::Deserialize (Buffer::Iterator start)
   else
     throw new DataException ();
 
-  m_data->SetName (NdnSim::DeserializeName (i));
+  m_data->SetName (NdnSim::DeserializeSharedName (i));
 
   if (i.ReadU16 () != (2 + 4 + 2 + 2 + (2 + 0))) // content length
     throw new DataException ();
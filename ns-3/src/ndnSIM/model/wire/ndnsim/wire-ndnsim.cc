@@ -9,7 +9,12 @@
  */
 
 #include "wire-ndnsim.h"
+
+#include "ns3/simulator.h"
+
 #include <boost/foreach.hpp>
+#include <boost/functional/hash.hpp>
+#include <boost/unordered_map.hpp>
 
 NDN_NAMESPACE_BEGIN
 
@@ -64,15 +69,158 @@ NdnSim::DeserializeName (Buffer::Iterator &i)
       uint16_t length = i.ReadU16 ();
       nameLength = nameLength - 2 - length;
 
-      uint8_t tmp[length];
-      i.Read (tmp, length);
+      // read directly into the component storage
+      name::Component component;
+      component.resize (length);
+      i.Read (reinterpret_cast<uint8_t*> (component.buf ()), length);
 
-      name->append (tmp, length);
+      name->appendBySwap (component);
     }
 
   return name;
 }
 
+namespace {
+
+/**
+ * @brief Table of shared name objects, indexed by hash of the name in ndnSIM wire format
+ */
+class NameTable
+{
+public:
+  NameTable ()
+    : m_sweepThreshold (MinSweepThreshold)
+    , m_destroyScheduled (false)
+  {
+  }
+
+  /**
+   * @brief Get shared name object for the name encoded as a sequence of (2-byte length, value) components
+   *
+   * The encoded name is read directly from the packet buffer: once to calculate the hash, then
+   * to compare with names that have the same hash or, if there is no such name, to create a new one
+   */
+  Ptr<Name>
+  Get (Buffer::Iterator start, size_t length)
+  {
+    size_t hash = 0;
+    Buffer::Iterator i = start;
+    for (size_t pos = 0; pos < length; pos++)
+      boost::hash_combine (hash, i.ReadU8 ());
+
+    std::pair<container::iterator, container::iterator> range = m_names.equal_range (hash);
+    for (container::iterator item = range.first; item != range.second; item++)
+      {
+        if (Matches (*item->second, start, length))
+          return item->second;
+      }
+
+    Ptr<Name> name = Create<Name> ();
+    i = start;
+    for (size_t pos = 0; pos + 2 <= length; )
+      {
+        uint16_t componentLength = i.ReadU16 ();
+        name::Component component;
+        component.resize (componentLength);
+        i.Read (reinterpret_cast<uint8_t*> (component.buf ()), componentLength);
+        name->appendBySwap (component);
+        pos += 2 + componentLength;
+      }
+
+    if (m_names.size () >= m_sweepThreshold)
+      Sweep ();
+    m_names.insert (std::make_pair (hash, name));
+
+    if (!m_destroyScheduled)
+      {
+        Simulator::ScheduleDestroy (&NameTable::Clear, this);
+        m_destroyScheduled = true;
+      }
+    return name;
+  }
+
+  /**
+   * @brief Release all names and memory of the table (called when simulation is destroyed)
+   */
+  void
+  Clear ()
+  {
+    container empty;
+    m_names.swap (empty); // clear () keeps the bucket array
+    m_sweepThreshold = MinSweepThreshold;
+    m_destroyScheduled = false;
+  }
+
+private:
+  static bool
+  Matches (const Name &name, Buffer::Iterator i, size_t length)
+  {
+    size_t pos = 0;
+    for (Name::const_iterator component = name.begin (); component != name.end (); component++)
+      {
+        if (pos + 2 > length || i.ReadU16 () != component->size () ||
+            pos + 2 + component->size () > length)
+          return false;
+
+        for (name::Component::const_iterator byte = component->begin (); byte != component->end (); byte++)
+          {
+            if (i.ReadU8 () != static_cast<uint8_t> (*byte))
+              return false;
+          }
+
+        pos += 2 + component->size ();
+      }
+    return pos == length;
+  }
+
+  /**
+   * @brief Remove names that are not referenced by anything else than the table
+   *
+   * Threshold for the next sweep is set proportionally to the number of live names, so the
+   * cost of sweeping is amortized over insertions
+   */
+  void
+  Sweep ()
+  {
+    for (container::iterator item = m_names.begin (); item != m_names.end (); )
+      {
+        if (item->second->GetReferenceCount () == 1)
+          item = m_names.erase (item);
+        else
+          item++;
+      }
+
+    m_sweepThreshold = std::max<size_t> (MinSweepThreshold, 2 * m_names.size ());
+    m_names.rehash (0); // shrink the bucket array to the number of live names
+  }
+
+private:
+  typedef boost::unordered_multimap<size_t, Ptr<Name> > container;
+
+  enum { MinSweepThreshold = 1024 };
+
+  container m_names;
+  size_t m_sweepThreshold;
+  bool m_destroyScheduled;
+};
+
+/**
+ * The table lives as long as the program, but it holds names only while simulation is running:
+ * it is emptied (and its memory released) on Simulator::Destroy
+ */
+NameTable g_nameTable;
+
+} // namespace
+
+Ptr<Name>
+NdnSim::DeserializeSharedName (Buffer::Iterator &i)
+{
+  uint16_t nameLength = i.ReadU16 ();
+  Ptr<Name> name = g_nameTable.Get (i, nameLength);
+  i.Next (nameLength);
+  return name;
+}
+
 
 size_t
 NdnSim::SerializeExclude (Buffer::Iterator &i, const Exclude &exclude)
@@ -141,8 +289,9 @@ NdnSim::DeserializeExclude (Buffer::Iterator &i)
           uint16_t length = i.ReadU16 ();
           excludeLength = excludeLength - 2 - length;
 
-          uint8_t tmp[length];
-          i.Read (tmp, length);
+          name::Component component;
+          component.resize (length);
+          i.Read (reinterpret_cast<uint8_t*> (component.buf ()), length);
 
           bool any = false;
           if (excludeLength > 0)
@@ -159,7 +308,7 @@ NdnSim::DeserializeExclude (Buffer::Iterator &i)
                 }
             }
 
-          exclude->appendExclude (name::Component (tmp, length), any);
+          exclude->appendExclude (component, any);
         }
       else
         {
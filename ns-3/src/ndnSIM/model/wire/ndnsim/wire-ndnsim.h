@@ -55,6 +55,21 @@ public:
   static Ptr<Name>
   DeserializeName (Buffer::Iterator &start);
 
+  /**
+   * @brief Deserialize Name from ndnSIM wire format, reusing already existing name object if possible
+   *
+   * Names of all packets that are currently in flight (or stored in PIT/CS) are kept in a table
+   * and packets with the same names share one Name object, which saves one name allocation
+   * (vector of components) per decoded packet.  Entries that are no longer referenced are
+   * periodically swept out (the table shrinks to the number of names still in use), and the
+   * table is emptied and its memory released on Simulator::Destroy.
+   *
+   * @param start Buffer to deserialize name from
+   * @returns shared name object, which must not be modified
+   */
+  static Ptr<Name>
+  DeserializeSharedName (Buffer::Iterator &start);
+
 
   enum Selectors {
     SelectorExclude = 0x01
@@ -91,7 +91,7 @@ Component::compare (const Component &other) const
 
   // now we know that sizes are equal
 
-  std::pair<const_iterator, const_iterator> diff = mismatch (begin (), end (), other.begin ());
+  std::pair<const_iterator, const_iterator> diff = std::mismatch (begin (), end (), other.begin ());
   if (diff.first == end ()) // components are actually equal
     return 0;
 
@@ -14,6 +14,7 @@
 
 #include "detail/error.h"
 #include <boost/algorithm/string.hpp>
+#include <boost/functional/hash.hpp>
 
 #include <ctype.h>
 
@@ -102,12 +103,14 @@ Name::Name (const string &uri)
 Name::Name (const Name &other)
 {
   m_comps = other.m_comps;
+  m_prefixHashes = other.m_prefixHashes;
 }
 
 Name &
 Name::operator= (const Name &other)
 {
   m_comps = other.m_comps;
+  m_prefixHashes = other.m_prefixHashes;
   return *this;
 }
 
@@ -171,9 +174,36 @@ Name::get (int index)
                              << error::msg ("Index out of range")
                              << error::pos (index));
     }
+  invalidateHashes ();
   return m_comps [index];
 }
 
+size_t
+Name::getPrefixHash (size_t len) const
+{
+  if (len > size ())
+    {
+      BOOST_THROW_EXCEPTION (error::Name ()
+                             << error::msg ("getPrefixHash parameter out of range")
+                             << error::pos (len));
+    }
+
+  if (m_prefixHashes.empty ())
+    {
+      m_prefixHashes.reserve (size () + 1);
+
+      size_t hash = 0;
+      m_prefixHashes.push_back (hash);
+      for (const_iterator comp = begin (); comp != end (); comp++)
+        {
+          boost::hash_combine (hash, boost::hash_range (comp->begin (), comp->end ()));
+          m_prefixHashes.push_back (hash);
+        }
+    }
+
+  return m_prefixHashes [len];
+}
+
 
 /////
 ///// Static helpers to convert name component to appropriate value
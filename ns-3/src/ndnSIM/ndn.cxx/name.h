@@ -238,7 +238,8 @@ public:
    * @param index index of the name component.  If less than 0, then getting component from the back
    * @returns reference to binary blob of the requested name component
    *
-   * If index is out of range, an exception will be thrown
+   * If index is out of range, an exception will be thrown.  Cached hashes are dropped (see
+   * getPrefixHash), so const version should be used to read the component.
    */
   name::Component &
   get (int index);
@@ -250,25 +251,25 @@ public:
   begin () const;           ///< @brief Begin iterator (const)
 
   inline Name::iterator
-  begin ();                 ///< @brief Begin iterator
+  begin ();                 ///< @brief Begin iterator (drops cached hashes, see getPrefixHash)
 
   inline Name::const_iterator
   end () const;             ///< @brief End iterator (const)
 
   inline Name::iterator
-  end ();                   ///< @brief End iterator
+  end ();                   ///< @brief End iterator (drops cached hashes, see getPrefixHash)
 
   inline Name::const_reverse_iterator
   rbegin () const;          ///< @brief Reverse begin iterator (const)
 
   inline Name::reverse_iterator
-  rbegin ();                ///< @brief Reverse begin iterator
+  rbegin ();                ///< @brief Reverse begin iterator (drops cached hashes, see getPrefixHash)
 
   inline Name::const_reverse_iterator
   rend () const;            ///< @brief Reverse end iterator (const)
 
   inline Name::reverse_iterator
-  rend ();                  ///< @brief Reverse end iterator
+  rend ();                  ///< @brief Reverse end iterator (drops cached hashes, see getPrefixHash)
 
 
   /////
@@ -299,6 +300,33 @@ public:
   inline Name
   getPostfix (size_t len, size_t skip = 0) const;
 
+  /**
+   * @brief Get hash value of the name prefix of the specified length
+   * @param len length of the prefix (0 corresponds to the empty name "/")
+   *
+   * Hashes of all prefixes are calculated incrementally on the first call and are cached
+   * inside the name object until the name is modified.  As a result, the name hash and all
+   * its prefix hashes are calculated at most once per packet.
+   *
+   * The cache is dropped when a mutable iterator or reference to a component is obtained
+   * (non-const begin, end, rbegin, rend, get, and operator []), not when a component is written
+   * through it.  A mutable iterator or reference must not be used to modify the name after
+   * getHash or getPrefixHash has been called; it should be obtained again instead.  Code that only
+   * reads the name (e.g., PIT and FIB lookups) should access it through a const reference, so
+   * that the cache is kept.
+   *
+   * If len is larger than the number of name components, an exception will be thrown
+   */
+  size_t
+  getPrefixHash (size_t len) const;
+
+  /**
+   * @brief Get hash value of the whole name
+   * @see getPrefixHash
+   */
+  inline size_t
+  getHash () const;
+
   /**
    * @brief Get text representation of the name (URI)
    */
@@ -362,7 +390,7 @@ public:
   operator > (const Name &name) const;
 
   /**
-   * @brief Operator [] to simplify access to name components
+   * @brief Operator [] to simplify access to name components (drops cached hashes, see getPrefixHash)
    * @see get
    */
   inline name::Component &
@@ -394,8 +422,16 @@ public:
   const static size_t npos = static_cast<size_t> (-1);
   const static uint64_t nversion = static_cast<uint64_t> (-1);
 
+private:
+  /**
+   * @brief Drop cached prefix hashes (must be called whenever name is modified)
+   */
+  inline void
+  invalidateHashes ();
+
 private:
   std::vector<name::Component> m_comps;
+  mutable std::vector<size_t> m_prefixHashes; ///< @brief cached hashes of all prefixes (empty if not calculated)
 };
 
 inline std::ostream &
@@ -429,7 +465,10 @@ inline Name &
 Name::append (const name::Component &comp)
 {
   if (comp.size () != 0)
-    m_comps.push_back (comp);
+    {
+      m_comps.push_back (comp);
+      invalidateHashes ();
+    }
   return *this;
 }
 
@@ -440,6 +479,7 @@ Name::appendBySwap (name::Component &comp)
     {
       Name::iterator newComp = m_comps.insert (end (), name::Component ());
       newComp->swap (comp);
+      invalidateHashes ();
     }
   return *this;
 }
@@ -530,6 +570,7 @@ Name::begin () const
 inline Name::iterator
 Name::begin ()
 {
+  invalidateHashes ();
   return m_comps.begin ();
 }
 
@@ -542,6 +583,7 @@ Name::end () const
 inline Name::iterator
 Name::end ()
 {
+  invalidateHashes ();
   return m_comps.end ();
 }
 
@@ -554,6 +596,7 @@ Name::rbegin () const
 inline Name::reverse_iterator
 Name::rbegin ()
 {
+  invalidateHashes ();
   return m_comps.rbegin ();
 }
 
@@ -567,6 +610,7 @@ Name::rend () const
 inline Name::reverse_iterator
 Name::rend ()
 {
+  invalidateHashes ();
   return m_comps.rend ();
 }
 
@@ -597,13 +641,23 @@ Name::push_back (const T &comp)
 inline bool
 Name::operator ==(const Name &name) const
 {
-  return (compare (name) == 0);
+  if (this == &name) // the same (shared) name object
+    return true;
+
+  if (size () != name.size ())
+    return false;
+
+  if (!m_prefixHashes.empty () && !name.m_prefixHashes.empty () &&
+      m_prefixHashes.back () != name.m_prefixHashes.back ())
+    return false;
+
+  return std::equal (begin (), end (), name.begin ());
 }
 
 inline bool
 Name::operator !=(const Name &name) const
 {
-  return (compare (name) != 0);
+  return !(*this == name);
 }
 
 inline bool
@@ -630,6 +684,18 @@ Name::operator > (const Name &name) const
   return (compare (name) > 0);
 }
 
+inline size_t
+Name::getHash () const
+{
+  return getPrefixHash (size ());
+}
+
+inline void
+Name::invalidateHashes ()
+{
+  m_prefixHashes.clear ();
+}
+
 inline name::Component &
 Name::operator [] (int index)
 {
@@ -28,6 +28,7 @@
 #include "ns3/net-device-container.h"
 #include "ns3/point-to-point-helper.h"
 #include "ns3/point-to-point-net-device.h"
+#include "ns3/channel.h"
 #include "ns3/internet-stack-helper.h"
 #include "ns3/ipv4-address-helper.h"
 #include "ns3/ipv4-global-routing-helper.h"
@@ -40,6 +41,7 @@
 #include "ns3/ipv4-address.h"
 #include "ns3/ndn-l3-protocol.h"
 #include "ns3/ndn-face.h"
+#include "ns3/ndn-partition-helper.h"
 #include "ns3/random-variable.h"
 #include "ns3/error-model.h"
 
@@ -53,6 +55,9 @@
 #include <boost/graph/graphviz.hpp>
 
 #include <set>
+#include <map>
+#include <cstdlib>
+#include <limits>
 
 #ifdef NS3_MPI
 #include <ns3/mpi-interface.h>
@@ -70,6 +75,7 @@ AnnotatedTopologyReader::AnnotatedTopologyReader (const std::string &path, doubl
   , m_randY (0, 100.0)
   , m_scale (scale)
   , m_requiredPartitions (1)
+  , m_partitions (0)
 {
   NS_LOG_FUNCTION (this);
 
@@ -92,6 +98,13 @@ AnnotatedTopologyReader::SetMobilityModel (const std::string &model)
   m_mobilityFactory.SetTypeId (model);
 }
 
+void
+AnnotatedTopologyReader::SetPartitions (uint32_t partitions)
+{
+  NS_LOG_FUNCTION (this << partitions);
+  m_partitions = partitions;
+}
+
 AnnotatedTopologyReader::~AnnotatedTopologyReader ()
 {
   NS_LOG_FUNCTION (this);
@@ -141,6 +154,77 @@ AnnotatedTopologyReader::GetLinks () const
   return m_linksList;
 }
 
+void
+AnnotatedTopologyReader::ReleaseLinks ()
+{
+  NS_LOG_FUNCTION (this);
+
+  std::list<Link> ().swap (m_linksList);
+}
+
+/**
+ * \brief Split the line into whitespace-separated tokens (no more than maxTokens, the rest is ignored)
+ * \returns number of tokens
+ */
+static size_t
+Tokenize (const string &line, string *tokens, size_t maxTokens)
+{
+  size_t count = 0;
+  const char *pos = line.c_str ();
+  while (count < maxTokens)
+    {
+      while (*pos == ' ' || *pos == '\t' || *pos == '\r' || *pos == '\n' || *pos == '\v' || *pos == '\f')
+        pos++;
+      if (*pos == '\0')
+        break;
+
+      const char *begin = pos;
+      while (*pos != '\0' && *pos != ' ' && *pos != '\t' && *pos != '\r' && *pos != '\n' && *pos != '\v' && *pos != '\f')
+        pos++;
+
+      tokens[count++].assign (begin, pos);
+    }
+  return count;
+}
+
+/**
+ * \brief Parse the whole token as a decimal number
+ *
+ * Unlike plain strtod, hexadecimal numbers, infinity, NaN, and tokens with trailing characters are
+ * rejected.  Integer values should not have sign, fraction, or exponent, and should fit into T.
+ *
+ * \returns false if token is not a number (value is set to 0)
+ */
+template<class T>
+static bool
+ParseNumber (const string &token, T &value)
+{
+  value = 0;
+
+  const char *allowed = numeric_limits<T>::is_integer ? "0123456789" : "0123456789+-.eE";
+  if (token.empty () || token.find_first_not_of (allowed) != string::npos)
+    return false;
+
+  char *end = 0;
+  double number = strtod (token.c_str (), &end);
+  if (end != token.c_str () + token.size () ||
+      number > numeric_limits<T>::max () || number < -numeric_limits<T>::max ())
+    return false;
+
+  value = static_cast<T> (number);
+  return true;
+}
+
+static Ptr<Node>
+FindNode (const map<string, Ptr<Node> > &nodes, const string &path, const string &name)
+{
+  map<string, Ptr<Node> >::const_iterator node = nodes.find (name);
+  if (node != nodes.end ())
+    return node->second;
+  else
+    return Names::Find<Node> (path, name); // not defined in the router section
+}
+
 NodeContainer
 AnnotatedTopologyReader::Read (void)
 {
@@ -167,20 +251,31 @@ AnnotatedTopologyReader::Read (void)
       return m_nodes;
     }
 
+  // nodes are looked up by name directly, without going through ns3::Names
+  map<string, Ptr<Node> > nodes;
+  string line;
+  string tokens[7];
+
   while (!topgen.eof ())
     {
-      string line;
       getline (topgen,line);
       if (line[0] == '#') continue; // comments
       if (line=="link") break; // stop reading nodes
 
-      istringstream lineBuffer (line);
-      string name, city;
+      size_t count = Tokenize (line, tokens, 5);
+      if (count == 0) continue;
+
+      const string &name = tokens[0];
       double latitude = 0, longitude = 0;
       uint32_t systemId = 0;
 
-      lineBuffer >> name >> city >> latitude >> longitude >> systemId;
-      if (name.empty ()) continue;
+      // the same as istringstream: parsing stops at the first invalid number
+      if (count > 2 && ParseNumber (tokens[2], latitude) &&
+          count > 3 && ParseNumber (tokens[3], longitude) &&
+          count > 4)
+        {
+          ParseNumber (tokens[4], systemId);
+        }
 
       Ptr<Node> node;
 
@@ -192,9 +287,10 @@ AnnotatedTopologyReader::Read (void)
           node = CreateNode (name, var.GetValue (), var.GetValue (), systemId);
           // node = CreateNode (name, systemId);
         }
+      nodes[name] = node;
     }
 
-  map<string, set<string> > processedLinks; // to eliminate duplications
+  set< pair<Node*, Node*> > processedLinks; // to eliminate duplications
 
   if (topgen.eof ())
     {
@@ -205,30 +301,32 @@ AnnotatedTopologyReader::Read (void)
   // SeekToSection ("link");
   while (!topgen.eof ())
     {
-      string line;
       getline (topgen,line);
       if (line == "") continue;
       if (line[0] == '#') continue; // comments
 
       // NS_LOG_DEBUG ("Input: [" << line << "]");
 
-      istringstream lineBuffer (line);
-      string from, to, capacity, metric, delay, maxPackets, lossRate;
-
-      lineBuffer >> from >> to >> capacity >> metric >> delay >> maxPackets >> lossRate;
-
-      if (processedLinks[to].size () != 0 &&
-          processedLinks[to].find (from) != processedLinks[to].end ())
+      size_t count = Tokenize (line, tokens, 7);
+      for (size_t i = count; i < 7; i++)
         {
-          continue; // duplicated link
+          tokens[i].clear ();
         }
-      processedLinks[from].insert (to);
 
-      Ptr<Node> fromNode = Names::Find<Node> (m_path, from);
+      const string &from = tokens[0], &to = tokens[1], &capacity = tokens[2], &metric = tokens[3],
+        &delay = tokens[4], &maxPackets = tokens[5], &lossRate = tokens[6];
+
+      Ptr<Node> fromNode = FindNode (nodes, m_path, from);
       NS_ASSERT_MSG (fromNode != 0, from << " node not found");
-      Ptr<Node> toNode   = Names::Find<Node> (m_path, to);
+      Ptr<Node> toNode   = FindNode (nodes, m_path, to);
       NS_ASSERT_MSG (toNode != 0, to << " node not found");
 
+      if (processedLinks.find (make_pair (PeekPointer (toNode), PeekPointer (fromNode))) != processedLinks.end ())
+        {
+          continue; // duplicated link
+        }
+      processedLinks.insert (make_pair (PeekPointer (fromNode), PeekPointer (toNode)));
+
       Link link (fromNode, from, toNode, to);
 
       link.SetAttribute ("DataRate", capacity);
@@ -323,6 +421,21 @@ AnnotatedTopologyReader::ApplyOspfMetric ()
 void
 AnnotatedTopologyReader::ApplySettings ()
 {
+  if (m_partitions > 0)
+    {
+      // nodes should be partitioned before links are created, otherwise links between
+      // partitions would not become remote channels
+      ndn::PartitionHelper partitioner;
+      BOOST_FOREACH (const Link &link, m_linksList)
+        {
+          partitioner.AddLink (link.GetFromNode (), link.GetToNode ());
+        }
+      uint32_t cut = partitioner.Partition (m_nodes, m_partitions);
+      NS_LOG_INFO (m_partitions << " partitions with " << cut << " links between them");
+
+      m_requiredPartitions = m_partitions;
+    }
+
 #ifdef NS3_MPI
   if (MpiInterface::IsEnabled () &&
       MpiInterface::GetSize () != m_requiredPartitions)
@@ -335,6 +448,18 @@ AnnotatedTopologyReader::ApplySettings ()
 
   PointToPointHelper p2p;
 
+  // DataRate, Delay, and numeric MaxPackets are parsed once per distinct value and set directly
+  // on the created devices, channels, and queues, instead of re-configuring object factories of
+  // p2p helper for every link.  As before, the value of the attribute stays in effect for the
+  // following links that do not specify it.
+  map<string, DataRate> dataRates;
+  map<string, Time> delays;
+  const DataRate *dataRate = 0;
+  const Time *delay = 0;
+  bool customQueue = false;
+  bool hasMaxPackets = false;
+  uint32_t maxPackets = 0;
+
   BOOST_FOREACH (Link &link, m_linksList)
     {
       // cout << "Link: " << Findlink.GetFromNode () << ", " << link.GetToNode () << endl;
@@ -343,20 +468,27 @@ AnnotatedTopologyReader::ApplySettings ()
       ////////////////////////////////////////////////
       if (link.GetAttributeFailSafe ("MaxPackets", tmp))
         {
-          NS_LOG_INFO ("MaxPackets = " + link.GetAttribute ("MaxPackets"));
+          NS_LOG_INFO ("MaxPackets = " + tmp);
 
           try
             {
-              uint32_t maxPackets = boost::lexical_cast<uint32_t> (link.GetAttribute ("MaxPackets"));
+              maxPackets = boost::lexical_cast<uint32_t> (tmp);
+              hasMaxPackets = true;
 
               // compatibility mode. Only DropTailQueue is supported
-              p2p.SetQueue ("ns3::DropTailQueue",
-                            "MaxPackets", UintegerValue (maxPackets));
+              if (customQueue)
+                {
+                  p2p.SetQueue ("ns3::DropTailQueue");
+                  customQueue = false;
+                }
             }
           catch (...)
             {
+              hasMaxPackets = false;
+              customQueue = true;
+
               typedef boost::tokenizer<boost::escaped_list_separator<char> > tokenizer;
-              tokenizer tok (link.GetAttribute ("MaxPackets"));
+              tokenizer tok (tmp);
 
               tokenizer::iterator token = tok.begin ();
               p2p.SetQueue (*token);
@@ -386,26 +518,43 @@ AnnotatedTopologyReader::ApplySettings ()
       
       if (link.GetAttributeFailSafe ("DataRate", tmp))
         {
-          NS_LOG_INFO ("DataRate = " + link.GetAttribute("DataRate"));
-          p2p.SetDeviceAttribute ("DataRate", StringValue (link.GetAttribute ("DataRate")));
+          NS_LOG_INFO ("DataRate = " + tmp);
+          map<string, DataRate>::iterator item = dataRates.find (tmp);
+          if (item == dataRates.end ())
+            item = dataRates.insert (make_pair (tmp, DataRate (tmp))).first;
+          dataRate = &item->second;
         }
 
       if (link.GetAttributeFailSafe ("Delay", tmp))
         {
-          NS_LOG_INFO ("Delay = " + link.GetAttribute("Delay"));
-          p2p.SetChannelAttribute ("Delay", StringValue (link.GetAttribute ("Delay")));
+          NS_LOG_INFO ("Delay = " + tmp);
+          map<string, Time>::iterator item = delays.find (tmp);
+          if (item == delays.end ())
+            item = delays.insert (make_pair (tmp, Time (tmp))).first;
+          delay = &item->second;
         }
 
       NetDeviceContainer nd = p2p.Install(link.GetFromNode (), link.GetToNode ());
       link.SetNetDevices (nd.Get (0), nd.Get (1));
 
+      for (uint32_t i = 0; i < nd.GetN (); i++)
+        {
+          Ptr<PointToPointNetDevice> device = StaticCast<PointToPointNetDevice> (nd.Get (i));
+          if (dataRate != 0)
+            device->SetDataRate (*dataRate);
+          if (hasMaxPackets)
+            device->GetQueue ()->SetAttribute ("MaxPackets", UintegerValue (maxPackets));
+        }
+      if (delay != 0)
+        nd.Get (0)->GetChannel ()->SetAttribute ("Delay", TimeValue (*delay));
+
       ////////////////////////////////////////////////
       if (link.GetAttributeFailSafe ("LossRate", tmp))
         {
           NS_LOG_INFO ("LinkError = " + link.GetAttribute("LossRate"));
 
           typedef boost::tokenizer<boost::escaped_list_separator<char> > tokenizer;
-          tokenizer tok (link.GetAttribute("LossRate"));
+          tokenizer tok (tmp);
 
           tokenizer::iterator token = tok.begin ();
           ObjectFactory factory (*token);
@@ -449,7 +598,7 @@ AnnotatedTopologyReader::SaveTopology (const std::string &file)
      << "router\n"
      << "\n"
      << "# each line in this section represents one router and should have the following data\n"
-     << "# node  comment     yPos    xPos\n";
+     << "# node  comment     yPos    xPos" << (m_requiredPartitions > 1 ? "    systemId" : "") << "\n";
 
   for (NodeContainer::Iterator node = m_nodes.Begin ();
        node != m_nodes.End ();
@@ -459,7 +608,10 @@ AnnotatedTopologyReader::SaveTopology (const std::string &file)
       Ptr<MobilityModel> mobility = (*node)->GetObject<MobilityModel> ();
       Vector position = mobility->GetPosition ();
 
-      os << name << "\t" << "NA" << "\t" << -position.y << "\t" << position.x << "\n";
+      os << name << "\t" << "NA" << "\t" << -position.y << "\t" << position.x;
+      if (m_requiredPartitions > 1)
+        os << "\t" << (*node)->GetSystemId ();
+      os << "\n";
     }
 
   os << "# link section defines point-to-point links between nodes and characteristics of these links\n"
@@ -67,6 +67,16 @@ public:
    */  
   virtual const std::list<Link>&
   GetLinks () const;
+
+  /**
+   * \brief Release memory used by links read by the reader
+   *
+   * Links are needed only while the topology is being set up (ApplySettings, AssignIpv4Addresses,
+   * ApplyOspfMetric, SaveTopology, SaveGraphviz).  In large topologies, it makes sense to release
+   * them afterwards, as link records are not used by the simulation itself.
+   */
+  virtual void
+  ReleaseLinks ();
   
   /**
    * \brief Assign IPv4 addresses to all links
@@ -97,6 +107,19 @@ public:
   virtual void
   SetMobilityModel (const std::string &model);
 
+  /**
+   * \brief Split nodes between the specified number of partitions (ranks of the distributed simulation)
+   *
+   * Should be called before Read.  SystemId of nodes specified in the topology file is replaced
+   * with the result of ndn::PartitionHelper, which balances nodes between partitions and
+   * minimizes the number of links between them.  Partitioning is done before links are
+   * installed, so links between partitions become remote channels.
+   *
+   * \param partitions number of partitions (0 to use SystemId from the topology file)
+   */
+  virtual void
+  SetPartitions (uint32_t partitions);
+
   /**
    * \brief Apply OSPF metric on Ipv4 (if exists) and Ccnx (if exists) stacks
    */
@@ -105,6 +128,8 @@ public:
 
   /**
    * \brief Save positions (e.g., after manual modification using visualizer)
+   *
+   * If nodes are split between several partitions, SystemId of every node is saved as well
    */
   virtual void
   SaveTopology (const std::string &file);
@@ -145,6 +170,7 @@ private:
   double m_scale;
 
   uint32_t m_requiredPartitions;
+  uint32_t m_partitions;
 };
 
 }
@@ -302,9 +302,19 @@ RocketfuelMapReader::Read (RocketfuelParams params, bool keepOneComponent/*=true
     return m_nodes;
   }
 
+  // the expression is compiled only once for the whole file
+  regex_t regex;
+  int ret = regcomp (&regex, ROCKETFUEL_MAPS_LINE, REG_EXTENDED | REG_NEWLINE);
+  if (ret != 0)
+  {
+    regerror (ret, &regex, errbuf, sizeof (errbuf));
+    regfree (&regex);
+    NS_FATAL_ERROR ("Cannot compile regular expression for maps file: " << errbuf);
+    return m_nodes;
+  }
+
   while (!topgen.eof ())
   {
-    int ret;
     int argc;
     char *argv[REGMATCH_MAX];
     char *buf;
@@ -317,21 +327,11 @@ RocketfuelMapReader::Read (RocketfuelParams params, bool keepOneComponent/*=true
     buf = (char *)line.c_str ();
 
     regmatch_t regmatch[REGMATCH_MAX];
-    regex_t regex;
-
-    ret = regcomp (&regex, ROCKETFUEL_MAPS_LINE, REG_EXTENDED | REG_NEWLINE);
-    if (ret != 0)
-    {
-      regerror (ret, &regex, errbuf, sizeof (errbuf));
-      regfree (&regex);
-      continue;
-    }
 
     ret = regexec (&regex, buf, REGMATCH_MAX, regmatch, 0);
     if (ret == REG_NOMATCH)
     {
       NS_LOG_WARN ("match failed (maps file): %s" << buf);
-      regfree (&regex);
       continue;
     }
 
@@ -354,8 +354,8 @@ RocketfuelMapReader::Read (RocketfuelParams params, bool keepOneComponent/*=true
     }
 
     GenerateFromMapsFile (argc, argv);
-    regfree (&regex);
   }
+  regfree (&regex);
 
   if (keepOneComponent)
     {
@@ -0,0 +1,134 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "ndnSIM-adaptive-splitting.h"
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM/model/fw/adaptive-splitting.h"
+
+NS_LOG_COMPONENT_DEFINE ("ndn.AdaptiveSplittingTest");
+
+namespace ns3 {
+
+static void
+CountInterests (uint32_t *counter, Ptr<const ndn::Interest>, Ptr<const ndn::Face>)
+{
+  (*counter) ++;
+}
+
+static void
+RemoveRoute (Ptr<ndn::Fib> fib, const std::string &prefix)
+{
+  fib->Remove (Create<ndn::Name> (prefix));
+}
+
+static void
+RemoveNextHop (Ptr<ndn::Fib> fib, const std::string &prefix, Ptr<ndn::Face> face)
+{
+  fib->Find (ndn::Name (prefix))->RemoveFace (face);
+}
+
+// counts Interests that were sent to the removed face and timed out (first counter), and how many
+// times the strategy had state for the removed face afterwards (second counter)
+static void
+CheckRemovedFace (std::pair<uint32_t, uint32_t> *counters, Ptr<ndn::Face> removed, Ptr<const ndn::pit::Entry> pitEntry)
+{
+  if (pitEntry->GetOutgoing ().find (removed) == pitEntry->GetOutgoing ().end ())
+    return;
+  counters->first ++;
+
+  Ptr<ndn::fw::AdaptiveSplitting::Measurements> measurements =
+    ConstCast<ndn::pit::Entry> (pitEntry)->GetFibEntry ()->GetObject<ndn::fw::AdaptiveSplitting::Measurements> ();
+  for (size_t i = 0; i < measurements->m_faces.size (); i++)
+    {
+      if (measurements->m_faces[i].m_face == removed)
+        counters->second ++;
+    }
+}
+
+void
+AdaptiveSplittingTest::DoRun ()
+{
+  Config::SetDefault ("ns3::PointToPointNetDevice::DataRate", StringValue ("10Mbps"));
+
+  //          +-- 1 --+
+  //   0 -----|       |----- 3
+  //          +-- 2 --+      (path through node 2 has 3 times larger delay)
+  NodeContainer nodes;
+  nodes.Create (4);
+
+  PointToPointHelper p2p;
+  p2p.SetChannelAttribute ("Delay", StringValue ("10ms"));
+  p2p.Install (nodes.Get (0), nodes.Get (1));
+  p2p.Install (nodes.Get (1), nodes.Get (3));
+  p2p.SetChannelAttribute ("Delay", StringValue ("30ms"));
+  NetDeviceContainer slowLink = p2p.Install (nodes.Get (0), nodes.Get (2));
+  p2p.Install (nodes.Get (2), nodes.Get (3));
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.SetForwardingStrategy (m_strategy);
+  ndnHelper.InstallAll ();
+
+  ndnHelper.AddRoute (nodes.Get (0), "/prefix", nodes.Get (1), 1);
+  ndnHelper.AddRoute (nodes.Get (0), "/prefix", nodes.Get (2), 1);
+  ndnHelper.AddRoute (nodes.Get (1), "/prefix", nodes.Get (3), 1);
+  ndnHelper.AddRoute (nodes.Get (2), "/prefix", nodes.Get (3), 1);
+
+  ndn::AppHelper consumerHelper ("ns3::ndn::ConsumerCbr");
+  consumerHelper.SetPrefix ("/prefix");
+  consumerHelper.SetAttribute ("Frequency", StringValue ("100"));
+  consumerHelper.SetAttribute ("RetxTimer", StringValue ("10s")); // lost Interests time out in the PIT of node 0
+  consumerHelper.SetAttribute ("LifeTime", StringValue ("1s"));
+  consumerHelper.Install (nodes.Get (0)).Stop (Seconds (5.0));
+
+  ndn::AppHelper producerHelper ("ns3::ndn::Producer");
+  producerHelper.SetPrefix ("/prefix");
+  producerHelper.Install (nodes.Get (3));
+
+  uint32_t fast = 0, slow = 0;
+  nodes.Get (1)->GetObject<ndn::ForwardingStrategy> ()->TraceConnectWithoutContext ("OutInterests",
+                                                                                   MakeBoundCallback (CountInterests, &fast));
+  nodes.Get (2)->GetObject<ndn::ForwardingStrategy> ()->TraceConnectWithoutContext ("OutInterests",
+                                                                                   MakeBoundCallback (CountInterests, &slow));
+
+  // at the end, Interests to the slow path are lost, and the slow path is removed from the FIB of
+  // node 0 before these Interests time out
+  Ptr<ndn::Fib> fib = nodes.Get (0)->GetObject<ndn::Fib> ();
+  Ptr<ndn::Face> slowFace = nodes.Get (0)->GetObject<ndn::L3Protocol> ()->GetFaceByNetDevice (slowLink.Get (0));
+  Simulator::Schedule (Seconds (4.8), RemoveRoute, nodes.Get (2)->GetObject<ndn::Fib> (), "/prefix");
+  Simulator::Schedule (Seconds (5.0), RemoveNextHop, fib, "/prefix", slowFace);
+
+  std::pair<uint32_t, uint32_t> timeouts (0, 0);
+  nodes.Get (0)->GetObject<ndn::ForwardingStrategy> ()->TraceConnectWithoutContext ("TimedOutInterests",
+                                                                                   MakeBoundCallback (CheckRemovedFace, &timeouts, slowFace));
+
+  Simulator::Stop (Seconds (8.0));
+  Simulator::Run ();
+
+  NS_LOG_DEBUG ("Fast path: " << fast << ", slow path: " << slow);
+  NS_TEST_ASSERT_MSG_GT (slow, 50, "Slower path should get a share of Interests");
+  NS_TEST_ASSERT_MSG_GT (fast, 2 * slow, "Faster path should get most of Interests");
+
+  NS_TEST_ASSERT_MSG_GT (timeouts.first, 0, "Interests to the removed face should time out");
+  NS_TEST_ASSERT_MSG_EQ (timeouts.second, 0, "Timed out Interests should not restore state of removed faces");
+
+  Simulator::Destroy ();
+}
+
+}
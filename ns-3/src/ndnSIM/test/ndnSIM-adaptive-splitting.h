@@ -0,0 +1,43 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef NDNSIM_TEST_ADAPTIVE_SPLITTING_H
+#define NDNSIM_TEST_ADAPTIVE_SPLITTING_H
+
+#include "ns3/test.h"
+
+namespace ns3 {
+
+class AdaptiveSplittingTest : public TestCase
+{
+public:
+  AdaptiveSplittingTest (const std::string &strategy = "ns3::ndn::fw::AdaptiveSplitting")
+    : TestCase ("AdaptiveSplitting strategy uses both paths, preferring the faster one (" + strategy + ")")
+    , m_strategy (strategy)
+  {
+  }
+
+private:
+  virtual void DoRun ();
+
+private:
+  std::string m_strategy;
+};
+
+}
+
+#endif // NDNSIM_TEST_ADAPTIVE_SPLITTING_H
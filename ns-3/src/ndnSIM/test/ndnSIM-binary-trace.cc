@@ -0,0 +1,112 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "ndnSIM-binary-trace.h"
+
+#include "ns3/core-module.h"
+#include "../utils/tracers/binary-trace-writer.h"
+
+#include <boost/lexical_cast.hpp>
+
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.BinaryTraceTest");
+
+namespace ns3 {
+
+void
+BinaryTraceTest::DoRun ()
+{
+  std::string file = CreateTempDirFilename ("trace.bin");
+  std::ostringstream expected;
+
+  {
+    // small buffer to make sure that records and strings span several flushes
+    boost::shared_ptr<BinaryTraceWriter> writer = BinaryTraceWriter::Open (file, 100);
+    NS_TEST_ASSERT_MSG_EQ ((writer ? true : false), true, "Trace file should be opened");
+
+    writer->AddColumn ("Time",   BinaryTraceWriter::DOUBLE);
+    writer->AddColumn ("Node",   BinaryTraceWriter::STRING);
+    writer->AddColumn ("FaceId", BinaryTraceWriter::INT32);
+    writer->AddColumn ("SeqNo",  BinaryTraceWriter::UINT32);
+    writer->AddColumn ("Bytes",  BinaryTraceWriter::UINT64);
+    expected << "Time\tNode\tFaceId\tSeqNo\tBytes\n";
+
+    std::string longName (10000, 'x');
+    for (uint32_t i = 0; i < 1000; i++)
+      {
+        std::string node = (i % 7 == 3) ? longName : ("node" + boost::lexical_cast<std::string> (i % 10));
+        int32_t face = static_cast<int32_t> (i % 5) - 1;
+        uint64_t bytes = static_cast<uint64_t> (i) << 33;
+
+        uint32_t nodeString = writer->Intern (node);
+        writer->BeginRecord ();
+        writer->PutDouble (i / 3.0);
+        writer->PutString (nodeString);
+        writer->PutInt32 (face);
+        writer->PutUint32 (i);
+        writer->PutUint64 (bytes);
+
+        expected << i / 3.0 << "\t" << node << "\t" << face << "\t" << i << "\t" << bytes << "\n";
+      }
+  }
+
+  std::ifstream is (file.c_str (), std::ios_base::in | std::ios_base::binary);
+  std::ostringstream converted;
+  NS_TEST_ASSERT_MSG_EQ (BinaryTraceWriter::ConvertToTsv (is, converted), true, "Conversion should succeed");
+  NS_TEST_ASSERT_MSG_EQ ((converted.str () == expected.str ()), true, "Converted trace differs from the expected text");
+
+  std::istringstream text ("Time\tNode\n");
+  std::ostringstream ignored;
+  NS_TEST_ASSERT_MSG_EQ (BinaryTraceWriter::ConvertToTsv (text, ignored), false, "Text trace is not a binary trace");
+
+  // string ID and length come from the file and should be validated
+  std::string small = CreateTempDirFilename ("small.bin");
+  {
+    boost::shared_ptr<BinaryTraceWriter> writer = BinaryTraceWriter::Open (small);
+    writer->AddColumn ("Node", BinaryTraceWriter::STRING);
+    uint32_t nodeString = writer->Intern ("node");
+    writer->BeginRecord ();
+    writer->PutString (nodeString);
+  }
+
+  std::ifstream smallIs (small.c_str (), std::ios_base::in | std::ios_base::binary);
+  std::string valid ((std::istreambuf_iterator<char> (smallIs)), std::istreambuf_iterator<char> ());
+
+  // magic, version, column count, column type, name length, name
+  size_t stringRecord = 8 + 4 + 4 + 1 + 4 + 4;
+  NS_TEST_ASSERT_MSG_EQ (valid[stringRecord], 'S', "String record should follow the schema");
+
+  std::string badId = valid;
+  badId.replace (stringRecord + 1, 4, "\xf0\xff\xff\xff", 4);
+  std::istringstream badIdIs (badId);
+  NS_TEST_ASSERT_MSG_EQ (BinaryTraceWriter::ConvertToTsv (badIdIs, ignored), false, "Out of order string ID should be rejected");
+
+  std::string badLength = valid;
+  badLength.replace (stringRecord + 5, 4, "\xff\xff\xff\xff", 4);
+  std::istringstream badLengthIs (badLength);
+  NS_TEST_ASSERT_MSG_EQ (BinaryTraceWriter::ConvertToTsv (badLengthIs, ignored), false, "Truncated string should be rejected");
+
+  std::string badCount = valid;
+  badCount.replace (8 + 4, 4, "\xff\xff\xff\xff", 4);
+  std::istringstream badCountIs (badCount);
+  NS_TEST_ASSERT_MSG_EQ (BinaryTraceWriter::ConvertToTsv (badCountIs, ignored), false, "Truncated schema should be rejected");
+}
+
+}
@@ -0,0 +1,143 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ndnSIM-blob.h"
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM/ndn.cxx/blob.h"
+
+#include <string>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.BlobTest");
+
+namespace ns3 {
+
+using ndn::Blob;
+
+namespace {
+
+// content of the given size that differs in every byte position
+std::string
+Pattern (size_t size, char first = 'a')
+{
+  std::string data;
+  for (size_t i = 0; i < size; i++)
+    data.push_back (static_cast<char> (first + i % 26));
+  return data;
+}
+
+std::string
+ToString (const Blob &blob)
+{
+  return std::string (blob.begin (), blob.end ());
+}
+
+} // namespace
+
+void
+BlobTest::DoRun ()
+{
+  const size_t sizes[] = { 0, 1, Blob::InlineSize - 1, Blob::InlineSize, Blob::InlineSize + 1, 100 };
+  const size_t count = sizeof (sizes) / sizeof (sizes[0]);
+
+  for (size_t i = 0; i < count; i++)
+    {
+      std::string data = Pattern (sizes[i]);
+      Blob blob (data);
+      NS_TEST_ASSERT_MSG_EQ (blob.size (), data.size (), "");
+      NS_TEST_ASSERT_MSG_EQ (ToString (blob), data, "Construction failed");
+
+      // copy construction
+      Blob copy (blob);
+      NS_TEST_ASSERT_MSG_EQ (ToString (copy), data, "Copy construction failed");
+      NS_TEST_ASSERT_MSG_EQ ((copy.size () == 0 || copy.buf () != blob.buf ()), true, "Copy should not share storage");
+      NS_TEST_ASSERT_MSG_EQ ((copy == blob), true, "");
+
+      // assignment to blobs of all sizes (inline to heap, heap to inline, ...)
+      for (size_t j = 0; j < count; j++)
+        {
+          Blob target (Pattern (sizes[j], 'A'));
+          target = blob;
+          NS_TEST_ASSERT_MSG_EQ (ToString (target), data, "Assignment failed");
+          NS_TEST_ASSERT_MSG_EQ (ToString (blob), data, "Assignment should not change the source");
+
+          target = target;
+          NS_TEST_ASSERT_MSG_EQ (ToString (target), data, "Self-assignment failed");
+
+          // swap (used to move components into names) between all combinations of storage
+          Blob other (Pattern (sizes[j], 'A'));
+          Blob mine (data);
+          mine.swap (other);
+          NS_TEST_ASSERT_MSG_EQ (ToString (mine), Pattern (sizes[j], 'A'), "Swap failed");
+          NS_TEST_ASSERT_MSG_EQ (ToString (other), data, "Swap failed");
+          other.swap (other);
+          NS_TEST_ASSERT_MSG_EQ (ToString (other), data, "Self-swap failed");
+        }
+    }
+
+  // growing byte by byte across the inline boundary
+  {
+    Blob blob;
+    std::string data = Pattern (3 * Blob::InlineSize);
+    for (size_t i = 0; i < data.size (); i++)
+      {
+        blob.push_back (data[i]);
+        NS_TEST_ASSERT_MSG_EQ (ToString (blob), data.substr (0, i + 1), "push_back failed");
+      }
+  }
+
+  // resize keeps the prefix of the content in both directions
+  {
+    std::string data = Pattern (Blob::InlineSize);
+    Blob blob (data);
+
+    blob.resize (Blob::InlineSize + 1);
+    NS_TEST_ASSERT_MSG_EQ (std::string (blob.begin (), blob.begin () + data.size ()), data,
+                           "Resize from inline to heap storage should keep the content");
+    blob[Blob::InlineSize] = '!';
+    NS_TEST_ASSERT_MSG_EQ (ToString (blob), data + "!", "");
+
+    blob.resize (Blob::InlineSize - 1);
+    NS_TEST_ASSERT_MSG_EQ (ToString (blob), data.substr (0, Blob::InlineSize - 1), "Shrinking failed");
+
+    blob.resize (200);
+    NS_TEST_ASSERT_MSG_EQ (std::string (blob.begin (), blob.begin () + Blob::InlineSize - 1),
+                           data.substr (0, Blob::InlineSize - 1), "Resize of heap storage should keep the content");
+
+    blob.clear ();
+    NS_TEST_ASSERT_MSG_EQ (blob.empty (), true, "");
+    blob.resize (2);
+    blob[0] = 'x';
+    blob[1] = 'y';
+    NS_TEST_ASSERT_MSG_EQ (ToString (blob), "xy", "");
+  }
+
+  // comparison does not depend on the storage
+  {
+    Blob small (Pattern (Blob::InlineSize));
+    Blob large (Pattern (Blob::InlineSize + 1));
+    NS_TEST_ASSERT_MSG_EQ ((small < large), true, "");
+    NS_TEST_ASSERT_MSG_EQ ((large < small), false, "");
+
+    large.resize (Blob::InlineSize); // still heap storage
+    NS_TEST_ASSERT_MSG_EQ ((small == large), true, "");
+    NS_TEST_ASSERT_MSG_EQ (boost::hash_value (small), boost::hash_value (large), "");
+  }
+}
+
+}
@@ -0,0 +1,97 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "ndnSIM-cs-policies.h"
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include <cmath>
+#include <sstream>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.CsPoliciesTest");
+
+namespace ns3 {
+
+static const uint32_t CacheSize = 100;
+static const uint32_t Contents = 1000;
+static const uint32_t Requests = 20000;
+
+double
+CsPoliciesTest::Run (const std::string &cs)
+{
+  ObjectFactory factory (cs);
+  factory.Set ("MaxSize", UintegerValue (CacheSize));
+  Ptr<ndn::ContentStore> store = factory.Create<ndn::ContentStore> ();
+
+  std::vector<double> pcum (Contents + 1, 0.0);
+  for (uint32_t i = 1; i <= Contents; i++)
+    pcum[i] = pcum[i-1] + 1.0 / std::pow (i + 0.7, 0.7);
+
+  Ptr<UniformRandomVariable> rand = CreateObject<UniformRandomVariable> ();
+  rand->SetStream (1);
+
+  // Zipf-Mandelbrot requests, mixed with 30% of requests for one-time contents
+  uint32_t hits = 0;
+  uint32_t scanned = 0;
+  for (uint32_t i = 0; i < Requests; i++)
+    {
+      uint32_t seq;
+      if (rand->GetValue () < 0.3)
+        seq = Contents + 1 + scanned++;
+      else
+        seq = std::lower_bound (pcum.begin () + 1, pcum.end (), rand->GetValue (0, pcum[Contents])) - pcum.begin ();
+
+      Ptr<ndn::Name> name = Create<ndn::Name> ("/prefix");
+      name->appendSeqNum (seq);
+
+      Ptr<ndn::Interest> interest = Create<ndn::Interest> ();
+      interest->SetName (name);
+      if (store->Lookup (interest) != 0)
+        {
+          hits++;
+          continue;
+        }
+
+      Ptr<ndn::Data> data = Create<ndn::Data> (Create<Packet> (10));
+      data->SetName (name);
+      store->Add (data);
+
+      NS_TEST_EXPECT_MSG_LT_OR_EQ (store->GetSize (), CacheSize, cs << " exceeds the limit");
+    }
+
+  // all entries should be reachable through the policy container
+  std::ostringstream os;
+  store->Print (os);
+  std::string entries = os.str ();
+  uint32_t lines = std::count (entries.begin (), entries.end (), '\n');
+  NS_TEST_EXPECT_MSG_EQ (lines, store->GetSize (), cs << " policy container is inconsistent");
+
+  return 1.0 * hits / Requests;
+}
+
+void
+CsPoliciesTest::DoRun ()
+{
+  double lru = Run ("ns3::ndn::cs::Lru");
+
+  NS_TEST_EXPECT_MSG_GT (Run ("ns3::ndn::cs::TinyLfu"), lru, "TinyLfu should be better than LRU under scan traffic");
+  NS_TEST_EXPECT_MSG_GT (Run ("ns3::ndn::cs::Arc"), lru, "ARC should be better than LRU under scan traffic");
+  NS_TEST_EXPECT_MSG_GT (Run ("ns3::ndn::cs::S3Fifo"), lru, "S3-FIFO should be better than LRU under scan traffic");
+}
+
+}
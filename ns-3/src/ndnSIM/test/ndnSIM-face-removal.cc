@@ -0,0 +1,255 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ndnSIM-face-removal.h"
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include <boost/foreach.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <set>
+#include <sstream>
+#include <vector>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.FaceRemovalTest");
+
+namespace ns3 {
+
+using namespace ndn;
+
+namespace {
+
+// prefix -> list of faces (PIT: incoming and outgoing, FIB: next hops)
+typedef std::map<std::string, std::string> Snapshot;
+
+std::string
+PitFaces (Ptr<pit::Entry> entry, Ptr<Face> except = 0)
+{
+  std::ostringstream os;
+  BOOST_FOREACH (const pit::IncomingFace &face, entry->GetIncoming ())
+    {
+      if (face.m_face != except)
+        os << "i" << face.m_face->GetId () << " ";
+    }
+  BOOST_FOREACH (const pit::OutgoingFace &face, entry->GetOutgoing ())
+    {
+      if (face.m_face != except)
+        os << "o" << face.m_face->GetId () << " ";
+    }
+  return os.str ();
+}
+
+std::string
+FibFaces (Ptr<fib::Entry> entry, Ptr<Face> except = 0)
+{
+  std::ostringstream os;
+  BOOST_FOREACH (const fib::FaceMetric &metric, entry->m_faces)
+    {
+      if (metric.GetFace () != except)
+        os << metric.GetFace ()->GetId () << " ";
+    }
+  return os.str ();
+}
+
+} // namespace
+
+void
+FaceRemovalTest::DoRun ()
+{
+  const uint32_t faceCount = 20;
+  const uint32_t prefixCount = 50;
+  const uint32_t pitCount = 2000;
+
+  NodeContainer nodes;
+  nodes.Create (1);
+  StackHelper ndnHelper;
+  ndnHelper.Install (nodes);
+
+  Ptr<Node> node = nodes.Get (0);
+  Ptr<L3Protocol> ndn = node->GetObject<L3Protocol> ();
+  Ptr<Fib> fib = node->GetObject<Fib> ();
+  Ptr<Pit> pit = node->GetObject<Pit> ();
+
+  std::vector< Ptr<Face> > faces;
+  for (uint32_t i = 0; i < faceCount; i++)
+    {
+      Ptr<App> app = CreateObject<App> ();
+      node->AddApplication (app);
+      Ptr<Face> face = CreateObject<AppFace> (app);
+      ndn->AddFace (face);
+      face->SetUp (true);
+      faces.push_back (face);
+    }
+
+  // face index after removal of the face from individual FIB entries (in random order)
+  {
+    std::vector<std::string> names;
+    for (uint32_t prefix = 0; prefix < 100; prefix++)
+      {
+        std::ostringstream name;
+        name << "/index" << prefix;
+        names.push_back (name.str ());
+        fib->Add (Name (name.str ()), faces[0], 0);
+        fib->Add (Name (name.str ()), faces[1], 1);
+      }
+
+    std::set<const fib::Entry*> expected;
+    for (std::vector<std::string>::iterator name = names.begin (); name != names.end (); name++)
+      expected.insert (PeekPointer (fib->Find (Name (*name))));
+
+    srand (1);
+    std::random_shuffle (names.begin (), names.end ());
+    for (std::vector<std::string>::iterator name = names.begin (); name != names.end (); name++)
+      {
+        Ptr<fib::Entry> entry = fib->Find (Name (*name));
+        entry->RemoveFace (faces[0]);
+        expected.erase (PeekPointer (entry));
+
+        std::vector< Ptr<fib::Entry> > entries = fib->GetEntriesWithFace (faces[0]);
+        std::set<const fib::Entry*> indexed;
+        for (std::vector< Ptr<fib::Entry> >::iterator i = entries.begin (); i != entries.end (); i++)
+          indexed.insert (PeekPointer (*i));
+        NS_TEST_ASSERT_MSG_EQ (entries.size (), expected.size (), "Wrong size of the face index");
+        NS_TEST_ASSERT_MSG_EQ ((indexed == expected), true, "Wrong FIB entries in the face index");
+      }
+
+    for (std::vector<std::string>::iterator name = names.begin (); name != names.end (); name++)
+      fib->Remove (Create<Name> (*name));
+    NS_TEST_ASSERT_MSG_EQ (fib->GetEntriesWithFace (faces[1]).size (), 0, "Removed FIB entries should not be in the face index");
+  }
+
+  srand (2);
+  for (uint32_t prefix = 0; prefix < prefixCount; prefix++)
+    {
+      std::ostringstream name;
+      name << "/p" << prefix;
+      for (int hops = 1 + rand () % 3; hops > 0; hops--)
+        fib->Add (Name (name.str ()), faces[rand () % faceCount], rand () % 10);
+    }
+
+  for (uint32_t i = 0; i < pitCount; i++)
+    {
+      std::ostringstream name;
+      name << "/p" << rand () % prefixCount << "/" << i;
+      Ptr<Interest> interest = Create<Interest> ();
+      interest->SetName (Create<Name> (name.str ()));
+      interest->SetInterestLifetime (Seconds (100));
+
+      Ptr<pit::Entry> entry = pit->Create (interest);
+      NS_TEST_ASSERT_MSG_NE (entry, 0, "");
+      for (int count = rand () % 3; count > 0; count--)
+        entry->AddIncoming (faces[rand () % faceCount]);
+      for (int count = rand () % 3; count > 0; count--)
+        entry->AddOutgoing (faces[rand () % faceCount]);
+      if (rand () % 5 == 0)
+        entry->RemoveIncoming (faces[rand () % faceCount]);
+      if (rand () % 7 == 0)
+        entry->ClearOutgoing ();
+      if (rand () % 11 == 0)
+        entry->ClearIncoming ();
+    }
+
+  // some FIB entries are removed from FIB, while PIT entries still refer to them
+  for (uint32_t prefix = 0; prefix < prefixCount; prefix += 7)
+    {
+      std::ostringstream name;
+      name << "/p" << prefix;
+      fib->Remove (Create<Name> (name.str ()));
+    }
+
+  std::vector<uint32_t> order;
+  for (uint32_t i = 0; i < faceCount; i++)
+    order.push_back (i);
+  std::random_shuffle (order.begin (), order.end ());
+
+  for (uint32_t step = 0; step < faceCount; step++)
+    {
+      Ptr<Face> face = faces[order[step]];
+
+      // expected result, the same as of the full scan of PIT and FIB (previous implementation)
+      Snapshot expectedPit, expectedFib;
+      for (Ptr<pit::Entry> entry = pit->Begin (); entry != 0; entry = pit->Next (entry))
+        {
+          Ptr<fib::Entry> fibEntry = entry->GetFibEntry ();
+          if (fibEntry->m_faces.size () == 1 && fibEntry->m_faces.begin ()->GetFace () == face)
+            continue; // whole PIT entry is removed
+
+          expectedPit[entry->GetPrefix ().toUri ()] = PitFaces (entry, face);
+        }
+      for (Ptr<fib::Entry> entry = fib->Begin (); entry != fib->End (); entry = fib->Next (entry))
+        {
+          std::string hops = FibFaces (entry, face);
+          if (hops != "")
+            expectedFib[entry->GetPrefix ().toUri ()] = hops;
+        }
+
+      ndn->RemoveFace (face);
+
+      Snapshot pitSnapshot, fibSnapshot;
+      std::map<uint32_t, std::set<const fib::Entry*> > fibFaces;
+      for (Ptr<pit::Entry> entry = pit->Begin (); entry != 0; entry = pit->Next (entry))
+        {
+          pitSnapshot[entry->GetPrefix ().toUri ()] = PitFaces (entry);
+
+          // FIB entries that are no longer in FIB are still in the face index
+          BOOST_FOREACH (const fib::FaceMetric &metric, entry->GetFibEntry ()->m_faces)
+            fibFaces[metric.GetFace ()->GetId ()].insert (PeekPointer (entry->GetFibEntry ()));
+        }
+      for (Ptr<fib::Entry> entry = fib->Begin (); entry != fib->End (); entry = fib->Next (entry))
+        {
+          fibSnapshot[entry->GetPrefix ().toUri ()] = FibFaces (entry);
+          BOOST_FOREACH (const fib::FaceMetric &metric, entry->m_faces)
+            fibFaces[metric.GetFace ()->GetId ()].insert (PeekPointer (entry));
+        }
+
+      NS_TEST_ASSERT_MSG_EQ (pitSnapshot.size (), expectedPit.size (), "Wrong set of PIT entries after removal " << step);
+      NS_TEST_ASSERT_MSG_EQ ((pitSnapshot == expectedPit), true, "Wrong PIT entries after removal " << step);
+      NS_TEST_ASSERT_MSG_EQ (fibSnapshot.size (), expectedFib.size (), "Wrong set of FIB entries after removal " << step);
+      NS_TEST_ASSERT_MSG_EQ ((fibSnapshot == expectedFib), true, "Wrong FIB entries after removal " << step);
+
+      // FIB face index of the remaining faces
+      for (uint32_t i = step + 1; i < faceCount; i++)
+        {
+          Ptr<Face> remaining = faces[order[i]];
+          std::vector< Ptr<fib::Entry> > entries = fib->GetEntriesWithFace (remaining);
+          std::set<const fib::Entry*> indexed;
+          for (std::vector< Ptr<fib::Entry> >::iterator entry = entries.begin (); entry != entries.end (); entry++)
+            {
+              NS_TEST_ASSERT_MSG_EQ (((*entry)->m_faces.find (remaining) != (*entry)->m_faces.end ()), true,
+                                     "Indexed FIB entry should have the face");
+              indexed.insert (PeekPointer (*entry));
+            }
+          NS_TEST_ASSERT_MSG_EQ (indexed.size (), entries.size (), "FIB entries should be indexed only once");
+
+          const std::set<const fib::Entry*> &used = fibFaces[remaining->GetId ()];
+          NS_TEST_ASSERT_MSG_EQ (std::includes (indexed.begin (), indexed.end (), used.begin (), used.end ()), true,
+                                 "FIB entries with the face should be in the face index");
+        }
+    }
+
+  NS_TEST_ASSERT_MSG_EQ (fib->GetSize (), 0, "All FIB entries should be removed with the last face");
+
+  Simulator::Destroy ();
+}
+
+}
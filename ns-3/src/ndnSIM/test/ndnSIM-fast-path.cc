@@ -0,0 +1,152 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ndnSIM-fast-path.h"
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM/model/fw/best-route.h"
+
+#include <algorithm>
+#include <sstream>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.FastPathTest");
+
+namespace ns3 {
+
+/**
+ * BestRoute that does not forward every fifth Interest: uses DoPropagateInterest of its own, so
+ * the fast path should not be used for it
+ */
+class FastPathTestStrategy : public ndn::fw::BestRoute
+{
+public:
+  static TypeId
+  GetTypeId ()
+  {
+    static TypeId tid = TypeId ("ns3::ndn::test::FastPathTestStrategy")
+      .SetParent<ndn::fw::BestRoute> ()
+      .AddConstructor<FastPathTestStrategy> ()
+      ;
+
+    return tid;
+  }
+
+protected:
+  virtual bool
+  DoPropagateInterest (Ptr<ndn::Face> inFace,
+                       Ptr<const ndn::Interest> interest,
+                       Ptr<ndn::pit::Entry> pitEntry)
+  {
+    if (interest->GetName ().get (-1).toSeqNum () % 5 == 0)
+      return false;
+
+    return ndn::fw::BestRoute::DoPropagateInterest (inFace, interest, pitEntry);
+  }
+};
+
+NS_OBJECT_ENSURE_REGISTERED (FastPathTestStrategy);
+
+namespace {
+
+void
+OutInterest (std::ostream *log, uint32_t node, Ptr<const ndn::Interest> interest, Ptr<const ndn::Face> face)
+{
+  *log << Simulator::Now ().GetNanoSeconds () << " " << node << " out " << face->GetId () << " " << interest->GetName () << "\n";
+}
+
+void
+DropInterest (std::ostream *log, uint32_t node, Ptr<const ndn::Interest> interest, Ptr<const ndn::Face> face)
+{
+  *log << Simulator::Now ().GetNanoSeconds () << " " << node << " drop " << face->GetId () << " " << interest->GetName () << "\n";
+}
+
+}
+
+std::string
+FastPathTest::Run (bool fastPath)
+{
+  Config::SetDefault ("ns3::PointToPointNetDevice::DataRate", StringValue ("10Mbps"));
+
+  //          +-- 1 --+
+  //   0 -----|       |----- 3
+  //          +-- 2 --+
+  //
+  // Node 0 has two next hops, nodes 1 and 2 have one.  Link 1-3 is congested, so Data packets are
+  // lost and consumers retransmit Interests.  Consumers on nodes 0 and 1 request the same names,
+  // so Interests are aggregated in PIT of node 1.
+  NodeContainer nodes;
+  nodes.Create (4);
+
+  PointToPointHelper p2p;
+  p2p.SetChannelAttribute ("Delay", StringValue ("10ms"));
+  p2p.Install (nodes.Get (0), nodes.Get (1));
+  p2p.Install (nodes.Get (0), nodes.Get (2));
+  p2p.Install (nodes.Get (2), nodes.Get (3));
+  p2p.SetDeviceAttribute ("DataRate", StringValue ("256Kbps"));
+  p2p.SetQueue ("ns3::DropTailQueue", "MaxPackets", StringValue ("10"));
+  p2p.Install (nodes.Get (1), nodes.Get (3));
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.SetForwardingStrategy (m_strategy, "SingleNextHopFastPath", fastPath ? "true" : "false");
+  ndnHelper.InstallAll ();
+
+  ndnHelper.AddRoute (nodes.Get (0), "/prefix", nodes.Get (1), 1);
+  ndnHelper.AddRoute (nodes.Get (0), "/prefix", nodes.Get (2), 2);
+  ndnHelper.AddRoute (nodes.Get (1), "/prefix", nodes.Get (3), 1);
+  ndnHelper.AddRoute (nodes.Get (2), "/prefix", nodes.Get (3), 1);
+
+  ndn::AppHelper consumerHelper ("ns3::ndn::ConsumerCbr");
+  consumerHelper.SetPrefix ("/prefix");
+  consumerHelper.SetAttribute ("Frequency", StringValue ("100"));
+  consumerHelper.SetAttribute ("RetxTimer", StringValue ("10ms"));
+  consumerHelper.Install (nodes.Get (0)).Stop (Seconds (2.0));
+  consumerHelper.Install (nodes.Get (1)).Stop (Seconds (2.0));
+
+  ndn::AppHelper producerHelper ("ns3::ndn::Producer");
+  producerHelper.SetPrefix ("/prefix");
+  producerHelper.SetAttribute ("PayloadSize", StringValue ("1024"));
+  producerHelper.Install (nodes.Get (3));
+
+  std::ostringstream log;
+  for (uint32_t i = 0; i < nodes.GetN (); i++)
+    {
+      Ptr<ndn::ForwardingStrategy> fw = nodes.Get (i)->GetObject<ndn::ForwardingStrategy> ();
+      fw->TraceConnectWithoutContext ("OutInterests", MakeBoundCallback (OutInterest, &log, i));
+      fw->TraceConnectWithoutContext ("DropInterests", MakeBoundCallback (DropInterest, &log, i));
+    }
+
+  Simulator::Stop (Seconds (3.0));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  return log.str ();
+}
+
+void
+FastPathTest::DoRun ()
+{
+  std::string slow = Run (false);
+  std::string fast = Run (true);
+
+  NS_LOG_DEBUG (m_strategy << ": " << std::count (slow.begin (), slow.end (), '\n') << " forwarding events");
+  NS_TEST_ASSERT_MSG_EQ ((slow == fast), true, "Forwarding decisions differ when SingleNextHopFastPath is enabled");
+}
+
+}
@@ -29,6 +29,10 @@
 #include <boost/shared_ptr.hpp>
 #include <boost/make_shared.hpp>
 
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
 #include "ns3/ndn-fib-entry.h"
 
 NS_LOG_COMPONENT_DEFINE ("ndn.FibEntryTest");
@@ -149,4 +153,131 @@ FibEntryTest::DoRun ()
   NS_TEST_ASSERT_MSG_EQ (recorders.front ()->count, 2, "two events should have been reported");
 }
 
+namespace {
+
+struct FaceRecord
+{
+  Ptr<ndn::Face> face;
+  int32_t status;
+  int32_t cost;
+};
+
+bool
+RecordLess (const FaceRecord &a, const FaceRecord &b)
+{
+  if (a.status != b.status)
+    return a.status < b.status;
+  return a.cost < b.cost;
+}
+
+struct SetMetric
+{
+  SetMetric (int32_t status, int32_t cost)
+    : m_status (status)
+    , m_cost (cost)
+  {
+  }
+
+  void
+  operator () (ndn::fib::FaceMetric &metric) const
+  {
+    metric.SetStatus (static_cast<ndn::fib::FaceMetric::Status> (m_status));
+    metric.SetRoutingCost (m_cost);
+  }
+
+  int32_t m_status;
+  int32_t m_cost;
+};
+
+} // namespace
+
+void
+FaceMetricContainerTest::DoRun ()
+{
+  Ptr<Node> node = CreateObject<Node> ();
+  std::vector< Ptr<ndn::Face> > faces;
+  for (int i = 0; i < 20; i++)
+    faces.push_back (CreateObject<ndn::Face> (node));
+
+  srand (2013);
+  ndn::fib::FaceMetricContainer container;
+
+  // reference model: faces ordered by (status, cost); inserted or moved faces go after all
+  // faces with the same metric, a modified face keeps its place if the order is preserved
+  std::vector<FaceRecord> expected;
+
+  for (int step = 0; step < 5000; step++)
+    {
+      Ptr<ndn::Face> face = faces[rand () % faces.size ()];
+      std::vector<FaceRecord>::iterator record = expected.begin ();
+      while (record != expected.end () && record->face != face)
+        record++;
+
+      int32_t cost = rand () % 4; // many ties
+      int32_t status = ndn::fib::FaceMetric::NDN_FIB_GREEN + rand () % 3;
+
+      // grow to the full set of faces, then shrink below the threshold, and so on
+      bool growing = (step / 500) % 2 == 0;
+      int action = rand () % 3;
+      if (record == expected.end ())
+        {
+          if (growing || action == 0)
+            {
+              FaceRecord inserted = { face, ndn::fib::FaceMetric::NDN_FIB_YELLOW, cost };
+              expected.insert (std::upper_bound (expected.begin (), expected.end (), inserted, RecordLess), inserted);
+
+              std::pair<ndn::fib::FaceMetricContainer::iterator, bool> result = container.insert (face, cost);
+              NS_TEST_ASSERT_MSG_EQ (result.second, true, "Face should be inserted");
+              NS_TEST_ASSERT_MSG_EQ (result.first->GetFace (), face, "Insert should return the new record");
+            }
+        }
+      else if (action == 0 || !growing)
+        {
+          expected.erase (record);
+          NS_TEST_ASSERT_MSG_EQ (container.erase (face), 1, "Face should be removed");
+          NS_TEST_ASSERT_MSG_EQ (container.erase (face), 0, "Face should already be removed");
+        }
+      else
+        {
+          FaceRecord modified = { face, status, cost };
+          size_t slot = record - expected.begin ();
+          if ((slot > 0 && RecordLess (modified, expected[slot - 1])) ||
+              (slot + 1 < expected.size () && RecordLess (expected[slot + 1], modified)))
+            {
+              expected.erase (record);
+              expected.insert (std::upper_bound (expected.begin (), expected.end (), modified, RecordLess), modified);
+            }
+          else
+            *record = modified;
+
+          ndn::fib::FaceMetricContainer::iterator item = container.find (face);
+          item = container.modify (item, SetMetric (status, cost));
+          NS_TEST_ASSERT_MSG_EQ (item->GetFace (), face, "Modify should return the modified record");
+        }
+
+      // order and nth access
+      NS_TEST_ASSERT_MSG_EQ (container.size (), expected.size (), "");
+      for (size_t n = 0; n < expected.size (); n++)
+        {
+          NS_TEST_ASSERT_MSG_EQ (container[n].GetFace (), expected[n].face, "Wrong order of faces at step " << step);
+          NS_TEST_ASSERT_MSG_EQ (container[n].GetRoutingCost (), expected[n].cost, "");
+          NS_TEST_ASSERT_MSG_EQ (container[n].GetStatus (), expected[n].status, "");
+        }
+
+      // lookup of every face, present or not
+      for (size_t i = 0; i < faces.size (); i++)
+        {
+          size_t slot = 0;
+          while (slot < expected.size () && expected[slot].face != faces[i])
+            slot++;
+
+          ndn::fib::FaceMetricContainer::iterator item = container.find (faces[i]);
+          if (slot == expected.size ())
+            NS_TEST_ASSERT_MSG_EQ ((item == container.end ()), true, "Removed face should not be found");
+          else
+            NS_TEST_ASSERT_MSG_EQ ((item == container.begin () + slot), true, "Wrong lookup at step " << step);
+        }
+    }
+}
+
 }
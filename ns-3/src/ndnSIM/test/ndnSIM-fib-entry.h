@@ -43,6 +43,18 @@ private:
   virtual void DoRun ();
 };
 
+class FaceMetricContainerTest : public TestCase
+{
+public:
+  FaceMetricContainerTest ()
+    : TestCase ("FIB entry face container keeps order and face lookup across the index threshold")
+  {
+  }
+
+private:
+  virtual void DoRun ();
+};
+
 }
 
 #endif // NDNSIM_TEST_FIB_ENTRY_H
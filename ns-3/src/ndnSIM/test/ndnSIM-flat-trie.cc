@@ -0,0 +1,133 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ndnSIM-flat-trie.h"
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "../utils/trie/trie-with-policy.h"
+#include "../utils/trie/flat-trie.h"
+#include "../utils/trie/persistent-policy.h"
+
+#include <boost/lexical_cast.hpp>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.FlatTrieTest");
+
+namespace ns3 {
+
+using namespace ndn::ndnSIM;
+
+typedef trie_with_policy<ndn::Name,
+                         pointer_payload_traits<uint32_t>,
+                         persistent_policy_traits> NodeTrie;
+
+typedef trie_with_policy<ndn::Name,
+                         pointer_payload_traits<uint32_t>,
+                         persistent_policy_traits,
+                         flat_trie_traits> FlatTrie;
+
+template<class Iterator>
+static uint32_t
+value (Iterator item)
+{
+  if (item == 0 || item->payload () == 0)
+    return 0;
+  return *item->payload ();
+}
+
+void
+FlatTrieTest::DoRun ()
+{
+  const uint32_t nValues = 1000;
+  std::vector<uint32_t> values (nValues);
+  for (uint32_t i = 0; i < nValues; i++)
+    values[i] = i + 1;
+
+  NodeTrie nodeTrie;
+  FlatTrie flatTrie;
+  nodeTrie.getPolicy ().set_max_size (0);
+  flatTrie.getPolicy ().set_max_size (0);
+
+  Ptr<UniformRandomVariable> rand = CreateObject<UniformRandomVariable> ();
+  rand->SetStream (1);
+
+  for (uint32_t step = 0; step < 20000; step++)
+    {
+      ndn::Name name;
+      uint32_t depth = rand->GetInteger (0, 4);
+      for (uint32_t i = 0; i < depth; i++)
+        {
+          name.append (boost::lexical_cast<std::string> (rand->GetInteger (0, 5)));
+        }
+
+      uint32_t op = rand->GetInteger (0, 3);
+      switch (op)
+        {
+        case 0:
+          {
+            uint32_t *payload = &values[rand->GetInteger (0, nValues - 1)];
+            bool nodeInserted = nodeTrie.insert (name, payload).second;
+            bool flatInserted = flatTrie.insert (name, payload).second;
+            NS_TEST_ASSERT_MSG_EQ (flatInserted, nodeInserted, "insert of " << name << " differs");
+            break;
+          }
+        case 1:
+          nodeTrie.erase (name);
+          flatTrie.erase (name);
+          break;
+        case 2:
+          NS_TEST_ASSERT_MSG_EQ (value (flatTrie.longest_prefix_match (name)),
+                                 value (nodeTrie.longest_prefix_match (name)),
+                                 "longest prefix match of " << name << " differs");
+          break;
+        case 3:
+          NS_TEST_ASSERT_MSG_EQ (value (flatTrie.find_exact (name)),
+                                 value (nodeTrie.find_exact (name)),
+                                 "exact match of " << name << " differs");
+          NS_TEST_ASSERT_MSG_EQ ((flatTrie.deepest_prefix_match (name) == flatTrie.end ()),
+                                 (nodeTrie.deepest_prefix_match (name) == nodeTrie.end ()),
+                                 "deepest prefix match of " << name << " differs");
+          break;
+        }
+
+      NS_TEST_ASSERT_MSG_EQ (flatTrie.getPolicy ().size (), nodeTrie.getPolicy ().size (),
+                             "number of entries differs");
+    }
+
+  // recursive iteration should visit every entry exactly once
+  uint32_t count = 0;
+  FlatTrie::parent_trie::recursive_iterator item (flatTrie.getTrie ()), end (0);
+  for (; item != end; item++)
+    {
+      if (item->payload () != 0)
+        count ++;
+    }
+  NS_TEST_ASSERT_MSG_EQ (count, flatTrie.getPolicy ().size (), "iteration should visit all entries");
+
+  // after removing all entries, only the root should be left
+  while (flatTrie.getPolicy ().size () > 0)
+    {
+      flatTrie.erase (&(*flatTrie.getPolicy ().begin ()));
+    }
+  FlatTrie::parent_trie::recursive_iterator root (flatTrie.getTrie ());
+  root++;
+  NS_TEST_ASSERT_MSG_EQ ((root == end), true, "all nodes should be pruned");
+}
+
+}
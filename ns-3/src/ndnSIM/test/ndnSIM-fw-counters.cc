@@ -0,0 +1,125 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "ndnSIM-fw-counters.h"
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/point-to-point-module.h"
+
+#include <map>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.FwCountersTest");
+
+namespace ns3 {
+
+#ifdef NDNSIM_FW_COUNTERS
+
+typedef std::map<Ptr<const ndn::Face>, ndn::ForwardingStrategy::FaceCounters> TracedCounters;
+
+static void
+InInterests (TracedCounters *counters, Ptr<const ndn::Interest>, Ptr<const ndn::Face> face)
+{
+  (*counters)[face].m_inInterests ++;
+}
+
+static void
+OutInterests (TracedCounters *counters, Ptr<const ndn::Interest>, Ptr<const ndn::Face> face)
+{
+  (*counters)[face].m_outInterests ++;
+}
+
+static void
+InData (TracedCounters *counters, Ptr<const ndn::Data>, Ptr<const ndn::Face> face)
+{
+  (*counters)[face].m_inData ++;
+}
+
+static void
+OutData (TracedCounters *counters, Ptr<const ndn::Data>, bool, Ptr<const ndn::Face> face)
+{
+  (*counters)[face].m_outData ++;
+}
+
+static void
+Satisfied (uint64_t *counter, Ptr<const ndn::pit::Entry>)
+{
+  (*counter) ++;
+}
+
+#endif // NDNSIM_FW_COUNTERS
+
+void
+FwCountersTest::DoRun ()
+{
+#ifdef NDNSIM_FW_COUNTERS
+  NodeContainer nodes;
+  nodes.Create (3);
+
+  PointToPointHelper p2p;
+  p2p.Install (nodes.Get (0), nodes.Get (1));
+  p2p.Install (nodes.Get (1), nodes.Get (2));
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.SetDefaultRoutes (true);
+  ndnHelper.InstallAll ();
+
+  ndn::AppHelper consumerHelper ("ns3::ndn::ConsumerCbr");
+  consumerHelper.SetPrefix ("/prefix");
+  consumerHelper.SetAttribute ("Frequency", StringValue ("10"));
+  consumerHelper.Install (nodes.Get (0)).Stop (Seconds (2.0));
+
+  ndn::AppHelper producerHelper ("ns3::ndn::Producer");
+  producerHelper.SetPrefix ("/prefix");
+  producerHelper.Install (nodes.Get (2));
+
+  Ptr<ndn::ForwardingStrategy> fw = nodes.Get (1)->GetObject<ndn::ForwardingStrategy> ();
+
+  TracedCounters traced;
+  uint64_t satisfied = 0;
+  fw->TraceConnectWithoutContext ("InInterests",  MakeBoundCallback (InInterests, &traced));
+  fw->TraceConnectWithoutContext ("OutInterests", MakeBoundCallback (OutInterests, &traced));
+  fw->TraceConnectWithoutContext ("InData",       MakeBoundCallback (InData, &traced));
+  fw->TraceConnectWithoutContext ("OutData",      MakeBoundCallback (OutData, &traced));
+  fw->TraceConnectWithoutContext ("SatisfiedInterests", MakeBoundCallback (Satisfied, &satisfied));
+
+  Simulator::Stop (Seconds (3.0));
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_EQ (traced.size (), 2, "Router should see packets on both faces");
+  for (TracedCounters::iterator i = traced.begin (); i != traced.end (); i++)
+    {
+      const ndn::ForwardingStrategy::FaceCounters &counters = fw->GetFaceCounters (i->first);
+      NS_TEST_ASSERT_MSG_EQ (counters.m_inInterests,  i->second.m_inInterests,  "");
+      NS_TEST_ASSERT_MSG_EQ (counters.m_outInterests, i->second.m_outInterests, "");
+      NS_TEST_ASSERT_MSG_EQ (counters.m_inData,       i->second.m_inData,       "");
+      NS_TEST_ASSERT_MSG_EQ (counters.m_outData,      i->second.m_outData,      "");
+      NS_TEST_ASSERT_MSG_EQ (counters.m_dropInterests + counters.m_dropData, 0, "");
+    }
+  NS_TEST_ASSERT_MSG_GT (satisfied, 0, "Some Interests should be satisfied");
+  NS_TEST_ASSERT_MSG_EQ (fw->GetSatisfiedInterests (), satisfied, "");
+  NS_TEST_ASSERT_MSG_EQ (fw->GetTimedOutInterests (), 0, "");
+
+  fw->ResetCounters ();
+  NS_TEST_ASSERT_MSG_EQ (fw->GetFaceCounters (traced.begin ()->first).m_inInterests, 0, "");
+  NS_TEST_ASSERT_MSG_EQ (fw->GetSatisfiedInterests (), 0, "");
+
+  Simulator::Destroy ();
+#endif // NDNSIM_FW_COUNTERS
+}
+
+}
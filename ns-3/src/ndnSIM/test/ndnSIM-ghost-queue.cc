@@ -0,0 +1,160 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ndnSIM-ghost-queue.h"
+
+#include "ns3/core-module.h"
+#include "../utils/ghost-queue.h"
+
+#include <deque>
+#include <map>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.GhostQueueTest");
+
+namespace ns3 {
+
+namespace {
+
+/**
+ * @brief Straightforward model of ghost_queue: FIFO of (hash, sequence number), only the latest
+ * copy of every hash is live
+ */
+class ReferenceQueue
+{
+public:
+  ReferenceQueue (size_t capacity)
+    : m_capacity (capacity)
+    , m_seq (0)
+  {
+  }
+
+  void
+  push (size_t hash)
+  {
+    if (m_queue.size () == m_capacity)
+      pop ();
+    m_queue.push_back (std::make_pair (hash, ++m_seq));
+    m_live[hash] = m_seq;
+  }
+
+  void
+  pop ()
+  {
+    if (m_queue.empty ())
+      return;
+
+    std::map<size_t, uint32_t>::iterator item = m_live.find (m_queue.front ().first);
+    if (item != m_live.end () && item->second == m_queue.front ().second)
+      m_live.erase (item);
+    m_queue.pop_front ();
+  }
+
+  void
+  pop_live ()
+  {
+    size_t live = m_live.size ();
+    while (!m_queue.empty () && m_live.size () == live)
+      pop ();
+  }
+
+  bool
+  erase (size_t hash)
+  {
+    return m_live.erase (hash) > 0;
+  }
+
+  bool
+  contains (size_t hash) const
+  {
+    return m_live.find (hash) != m_live.end ();
+  }
+
+  size_t
+  size () const
+  {
+    return m_live.size ();
+  }
+
+private:
+  size_t m_capacity;
+  uint32_t m_seq;
+  std::deque< std::pair<size_t, uint32_t> > m_queue;
+  std::map<size_t, uint32_t> m_live;
+};
+
+}
+
+void
+GhostQueueTest::DoRun ()
+{
+  const uint32_t capacities[] = { 1, 7, 64 };
+
+  Ptr<UniformRandomVariable> rand = CreateObject<UniformRandomVariable> ();
+  rand->SetStream (1);
+
+  for (uint32_t c = 0; c < sizeof (capacities) / sizeof (capacities[0]); c++)
+    {
+      uint32_t capacity = capacities[c];
+      ndn::ndnSIM::ghost_queue queue;
+      queue.set_capacity (capacity);
+      ReferenceQueue reference (capacity);
+
+      // hashes are drawn from a small range, so the same hash is often pushed again while still live
+      uint32_t range = 2 * capacity + 2;
+      for (uint32_t step = 0; step < 20000; step++)
+        {
+          size_t hash = rand->GetInteger (0, range - 1) * 0x9e3779b97f4a7c15ULL;
+          uint32_t op = rand->GetInteger (0, 9);
+          if (op < 6)
+            {
+              queue.push (hash);
+              reference.push (hash);
+            }
+          else if (op < 8)
+            {
+              NS_TEST_ASSERT_MSG_EQ (queue.erase (hash), reference.erase (hash),
+                                     "erase differs at step " << step << ", capacity " << capacity);
+            }
+          else if (op < 9)
+            {
+              queue.pop_live ();
+              reference.pop_live ();
+            }
+          else
+            {
+              queue.pop ();
+              reference.pop ();
+            }
+
+          NS_TEST_ASSERT_MSG_EQ (queue.size (), reference.size (),
+                                 "size differs at step " << step << ", capacity " << capacity);
+          for (uint32_t value = 0; value < range; value++)
+            {
+              size_t other = value * 0x9e3779b97f4a7c15ULL;
+              NS_TEST_ASSERT_MSG_EQ (queue.contains (other), reference.contains (other),
+                                     "membership differs at step " << step << ", capacity " << capacity);
+            }
+        }
+
+      queue.clear ();
+      NS_TEST_ASSERT_MSG_EQ (queue.size (), 0, "Queue should be empty after clear");
+      NS_TEST_ASSERT_MSG_EQ (queue.contains (0x9e3779b97f4a7c15ULL), false, "Queue should be empty after clear");
+    }
+}
+
+} // namespace ns3
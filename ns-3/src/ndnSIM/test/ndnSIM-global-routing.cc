@@ -0,0 +1,218 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "ndnSIM-global-routing.h"
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/point-to-point-module.h"
+
+#include <boost/foreach.hpp>
+#include <boost/graph/dijkstra_shortest_paths.hpp>
+#include "../helper/boost-graph-ndn-global-routing-helper.h"
+
+#include <limits>
+#include <map>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.GlobalRoutingTest");
+
+namespace ns3 {
+
+static Ptr<ndn::Face>
+FindFace (Ptr<Node> node, Ptr<Node> neighbor)
+{
+  Ptr<ndn::L3Protocol> ndn = node->GetObject<ndn::L3Protocol> ();
+  for (uint32_t faceId = 0; faceId < ndn->GetNFaces (); faceId++)
+    {
+      Ptr<ndn::NetDeviceFace> face = DynamicCast<ndn::NetDeviceFace> (ndn->GetFace (faceId));
+      if (face == 0)
+        continue;
+
+      Ptr<Channel> channel = face->GetNetDevice ()->GetChannel ();
+      for (uint32_t deviceId = 0; deviceId < channel->GetNDevices (); deviceId++)
+        {
+          if (channel->GetDevice (deviceId)->GetNode () == neighbor)
+            return face;
+        }
+    }
+  return 0;
+}
+
+static void
+Link (Ptr<Node> a, Ptr<Node> b, uint16_t metric)
+{
+  FindFace (a, b)->SetMetric (metric);
+  FindFace (b, a)->SetMetric (metric);
+}
+
+namespace {
+
+/**
+ * Restores routing global values and destroys the simulator when the test exits, even if one of
+ * the checks has failed and returned early
+ */
+class RoutingStateGuard
+{
+public:
+  RoutingStateGuard ()
+  {
+    GlobalValue::GetValueByName ("NdnGlobalRoutingThreads", m_threads);
+    GlobalValue::GetValueByName ("NdnGlobalRoutingIncremental", m_incremental);
+  }
+
+  ~RoutingStateGuard ()
+  {
+    // incremental routing state is released by the simulator
+    Simulator::Destroy ();
+    Config::SetGlobal ("NdnGlobalRoutingThreads", m_threads);
+    Config::SetGlobal ("NdnGlobalRoutingIncremental", m_incremental);
+  }
+
+private:
+  UintegerValue m_threads;
+  BooleanValue m_incremental;
+};
+
+}
+
+// distance found by Dijkstra on the boost graph adaptor of GlobalRouter objects
+static uint32_t
+BoostGraphDistance (Ptr<Node> from, Ptr<Node> to)
+{
+  boost::NdnGlobalRouterGraph graph;
+  boost::DistancesMap distances;
+
+  // GlobalRouter IDs keep growing across simulations (e.g., earlier test cases), so they cannot be
+  // used as vertex indexes
+  std::map<Ptr<ndn::GlobalRouter>, uint32_t> indexes;
+  BOOST_FOREACH (const boost::NdnGlobalRouterGraph::Vertice &vertex, graph.GetVertices ())
+    {
+      indexes.insert (std::make_pair (vertex, indexes.size ()));
+    }
+
+  boost::dijkstra_shortest_paths (graph, from->GetObject<ndn::GlobalRouter> (),
+                                  boost::distance_map (boost::ref (distances))
+                                  .vertex_index_map (boost::make_assoc_property_map (indexes))
+                                  .distance_inf (boost::WeightInf)
+                                  .distance_zero (boost::WeightZero)
+                                  .distance_compare (boost::WeightCompare ())
+                                  .distance_combine (boost::WeightCombine ()));
+
+  return distances[to->GetObject<ndn::GlobalRouter> ()].get<1> ();
+}
+
+void
+GlobalRoutingTest::CheckRoute (Ptr<Node> node, Ptr<Node> neighbor, int32_t metric)
+{
+  Ptr<ndn::fib::Entry> entry = node->GetObject<ndn::Fib> ()->Find (ndn::Name ("/prefix"));
+  NS_TEST_ASSERT_MSG_NE (entry, 0, "FIB entry should exist on node " << node->GetId ());
+
+  ndn::fib::FaceMetricContainer::iterator record = entry->m_faces.find (FindFace (node, neighbor));
+
+  if (metric < 0)
+    {
+      NS_TEST_EXPECT_MSG_EQ ((record == entry->m_faces.end ()), true,
+                             "Node " << node->GetId () << " should not have route via node " << neighbor->GetId ());
+    }
+  else
+    {
+      NS_TEST_ASSERT_MSG_EQ ((record != entry->m_faces.end ()), true,
+                             "Node " << node->GetId () << " should have route via node " << neighbor->GetId ());
+      NS_TEST_EXPECT_MSG_EQ (record->GetRoutingCost (), metric, "");
+    }
+}
+
+void
+GlobalRoutingTest::DoRun ()
+{
+  RoutingStateGuard guard;
+  Config::SetGlobal ("NdnGlobalRoutingThreads", UintegerValue (m_threads));
+
+  //      1       1       1
+  //  A ----- B ----- C ----- D (producer)
+  //  |               |
+  //  +---------------+
+  //          5
+  NodeContainer nodes;
+  nodes.Create (4);
+  Ptr<Node> a = nodes.Get (0), b = nodes.Get (1), c = nodes.Get (2), d = nodes.Get (3);
+
+  PointToPointHelper p2p;
+  p2p.Install (a, b);
+  p2p.Install (b, c);
+  p2p.Install (a, c);
+  p2p.Install (c, d);
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll ();
+
+  Link (a, b, 1);
+  Link (b, c, 1);
+  Link (a, c, 5);
+  Link (c, d, 1);
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll ();
+  ndnGlobalRoutingHelper.AddOrigin ("/prefix", d);
+
+  ndn::GlobalRoutingHelper::CalculateRoutes ();
+
+  CheckRoute (a, b, 3);
+  CheckRoute (a, c, -1);
+  CheckRoute (b, c, 2);
+  CheckRoute (b, a, -1);
+  CheckRoute (c, d, 1);
+
+  NS_TEST_EXPECT_MSG_EQ (BoostGraphDistance (a, d), 3, "");
+  NS_TEST_EXPECT_MSG_EQ (BoostGraphDistance (b, d), 2, "");
+  NS_TEST_EXPECT_MSG_EQ (BoostGraphDistance (c, d), 1, "");
+
+  ndn::GlobalRoutingHelper::CalculateAllPossibleRoutes ();
+
+  CheckRoute (a, b, 3);
+  CheckRoute (a, c, 6);
+  CheckRoute (b, c, 2);
+  CheckRoute (b, a, 7); // the best path from A goes back via B
+  CheckRoute (c, d, 1);
+  CheckRoute (c, a, -1); // all paths from A and B go back via C
+  CheckRoute (c, b, -1);
+
+  // incremental updates after link failure and recovery
+  const int32_t invalid = std::numeric_limits<uint16_t>::max ();
+  Config::SetGlobal ("NdnGlobalRoutingIncremental", BooleanValue (true));
+  ndn::GlobalRoutingHelper::CalculateRoutes ();
+
+  CheckRoute (a, b, 3);
+  CheckRoute (a, c, invalid);
+
+  ndn::LinkControlHelper::FailLink (b, c);
+
+  CheckRoute (a, b, invalid);
+  CheckRoute (a, c, 6);
+  CheckRoute (b, a, 7);
+  CheckRoute (b, c, invalid);
+  CheckRoute (c, d, 1);
+
+  ndn::LinkControlHelper::UpLink (b, c);
+
+  CheckRoute (a, b, 3);
+  CheckRoute (a, c, invalid);
+  CheckRoute (b, a, invalid);
+  CheckRoute (b, c, 2);
+}
+
+}
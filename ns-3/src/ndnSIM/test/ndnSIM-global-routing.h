@@ -0,0 +1,51 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef NDNSIM_TEST_GLOBAL_ROUTING_H
+#define NDNSIM_TEST_GLOBAL_ROUTING_H
+
+#include "ns3/test.h"
+#include "ns3/ptr.h"
+
+#include <boost/lexical_cast.hpp>
+
+namespace ns3 {
+
+class Node;
+
+class GlobalRoutingTest : public TestCase
+{
+public:
+  GlobalRoutingTest (uint32_t threads)
+    : TestCase ("GlobalRoutingHelper routes with " + boost::lexical_cast<std::string> (threads) + " thread(s)")
+    , m_threads (threads)
+  {
+  }
+
+private:
+  virtual void DoRun ();
+
+  void
+  CheckRoute (Ptr<Node> node, Ptr<Node> neighbor, int32_t metric);
+
+private:
+  uint32_t m_threads;
+};
+
+}
+
+#endif // NDNSIM_TEST_GLOBAL_ROUTING_H
@@ -0,0 +1,157 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "ndnSIM-lfu-policy.h"
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "../utils/trie/trie-with-policy.h"
+#include "../utils/trie/lfu-policy.h"
+#include "../utils/trie/lfu-bucket-policy.h"
+
+#include <boost/lexical_cast.hpp>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.LfuPolicyTest");
+
+namespace ns3 {
+
+using namespace ndn::ndnSIM;
+
+typedef trie_with_policy<ndn::Name,
+                         pointer_payload_traits<uint32_t>,
+                         lfu_policy_traits> LfuTrie;
+
+typedef trie_with_policy<ndn::Name,
+                         pointer_payload_traits<uint32_t>,
+                         lfu_bucket_policy_traits> BucketLfuTrie;
+
+// both policies should keep entries in the same (eviction) order
+static bool
+SameOrder (LfuTrie &lfu, BucketLfuTrie &bucketLfu)
+{
+  LfuTrie::policy_container::iterator item = lfu.getPolicy ().begin ();
+  BucketLfuTrie::policy_container::iterator bucketItem = bucketLfu.getPolicy ().begin ();
+  for (; item != lfu.getPolicy ().end (); item++, bucketItem++)
+    {
+      if (*bucketItem->payload () != *item->payload ())
+        return false;
+    }
+  return true;
+}
+
+void
+LfuPolicyTest::DoRun ()
+{
+  const uint32_t nValues = 200;
+  std::vector<uint32_t> values (nValues);
+  for (uint32_t i = 0; i < nValues; i++)
+    values[i] = i;
+
+  LfuTrie lfu;
+  BucketLfuTrie bucketLfu;
+  lfu.getPolicy ().set_max_size (50);
+  bucketLfu.getPolicy ().set_max_size (50);
+  bucketLfu.getPolicy ().set_aging_period (0); // exact LFU
+
+  Ptr<UniformRandomVariable> rand = CreateObject<UniformRandomVariable> ();
+  rand->SetStream (1);
+
+  for (uint32_t step = 0; step < 20000; step++)
+    {
+      uint32_t value = rand->GetInteger (0, nValues - 1);
+      ndn::Name name;
+      name.append (boost::lexical_cast<std::string> (value));
+
+      uint32_t op = rand->GetInteger (0, 9);
+      if (op < 4)
+        {
+          lfu.insert (name, &values[value]);
+          bucketLfu.insert (name, &values[value]);
+        }
+      else if (op == 4)
+        {
+          lfu.erase (name);
+          bucketLfu.erase (name);
+        }
+      else
+        {
+          lfu.longest_prefix_match (name);
+          bucketLfu.longest_prefix_match (name);
+        }
+
+      NS_TEST_ASSERT_MSG_EQ (bucketLfu.getPolicy ().size (), lfu.getPolicy ().size (),
+                             "number of entries differs");
+      NS_TEST_ASSERT_MSG_EQ (SameOrder (lfu, bucketLfu), true, "order of entries differs at step " << step);
+    }
+
+  // with aging, entries that were popular in the past are eventually replaced by the currently popular ones
+  BucketLfuTrie aging;
+  aging.getPolicy ().set_max_size (10);
+  aging.getPolicy ().set_aging_period (100);
+  BucketLfuTrie exact;
+  exact.getPolicy ().set_max_size (10);
+  exact.getPolicy ().set_aging_period (0);
+
+  for (uint32_t phase = 0; phase < 2; phase++)
+    {
+      // phase 0: values 0..9, phase 1: values 100..109
+      for (uint32_t round = 0; round < 100; round++)
+        {
+          for (uint32_t i = 0; i < 10; i++)
+            {
+              uint32_t value = 100 * phase + i;
+              ndn::Name name;
+              name.append (boost::lexical_cast<std::string> (value));
+
+              if (aging.find_exact (name) == aging.end ())
+                aging.insert (name, &values[value % nValues]);
+              else
+                aging.longest_prefix_match (name);
+
+              if (exact.find_exact (name) == exact.end ())
+                exact.insert (name, &values[value % nValues]);
+              else
+                exact.longest_prefix_match (name);
+
+              // frequencies never decrease along the list
+              uint32_t last = 0;
+              for (BucketLfuTrie::policy_container::iterator item = aging.getPolicy ().begin ();
+                   item != aging.getPolicy ().end ();
+                   item++)
+                {
+                  uint32_t frequency = BucketLfuTrie::policy_container::policy_base::get_order (&(*item));
+                  NS_TEST_ASSERT_MSG_EQ ((frequency >= last), true, "Entries should stay ordered by frequency");
+                  last = frequency;
+                }
+            }
+        }
+    }
+
+  uint32_t agingCurrent = 0, exactCurrent = 0;
+  for (uint32_t i = 100; i < 110; i++)
+    {
+      ndn::Name name;
+      name.append (boost::lexical_cast<std::string> (i));
+      agingCurrent += (aging.find_exact (name) != aging.end ()) ? 1 : 0;
+      exactCurrent += (exact.find_exact (name) != exact.end ()) ? 1 : 0;
+    }
+  NS_TEST_ASSERT_MSG_EQ (agingCurrent, 10, "Currently popular entries should be cached with aging");
+  NS_TEST_ASSERT_MSG_EQ (exactCurrent, 1, "Without aging, only one slot is left for new entries");
+}
+
+}
\ No newline at end of file
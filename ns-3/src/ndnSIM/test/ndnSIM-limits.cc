@@ -0,0 +1,131 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ndnSIM-limits.h"
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/ndnSIM/utils/ndn-limits-rate.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.LimitsRateTest");
+
+namespace ns3 {
+
+namespace {
+
+/**
+ * @brief Sends as many interests as the limit allows, the same way as PerOutFaceLimits does:
+ *        when the limit is reached, waits for the available slot callback
+ */
+class Sender
+{
+public:
+  Sender (Ptr<ndn::Limits> limits)
+    : m_limits (limits)
+    , m_sent (0)
+  {
+    m_limits->RegisterAvailableSlotCallback (MakeCallback (&Sender::Send, this));
+  }
+
+  void
+  Send ()
+  {
+    while (m_limits->IsBelowLimit ())
+      {
+        m_limits->BorrowLimit ();
+        m_sent++;
+      }
+  }
+
+  void
+  Record ()
+  {
+    m_history.push_back (m_sent);
+  }
+
+  Ptr<ndn::Limits> m_limits;
+  uint32_t m_sent;
+  std::vector<uint32_t> m_history; ///< @brief number of sent interests at every check point
+};
+
+Ptr<ndn::Limits>
+CreateLimits (Ptr<Node> node, bool lazy)
+{
+  Ptr<ndn::Face> face = CreateObject<ndn::Face> (node);
+  Ptr<ndn::Limits> limits = CreateObject<ndn::LimitsRate> ();
+  limits->SetAttribute ("LazyLeak", BooleanValue (lazy));
+  limits->SetAttribute ("RandomizeLeak", TimeValue (Seconds (0)));
+  face->AggregateObject (limits);
+  limits->SetLimits (100.0, 0.1);
+  return limits;
+}
+
+} // namespace
+
+void
+LimitsRateTest::DoRun ()
+{
+  Ptr<Node> node = CreateObject<Node> ();
+
+  Sender eager (CreateLimits (node, false));
+  Sender lazy (CreateLimits (node, true));
+
+  // initial burst, then interests are sent whenever the limit allows and at random times
+  srand (11);
+  for (double time = 0; time < 20.0; time += 0.001 * (rand () % 50))
+    {
+      Simulator::Schedule (Seconds (time), &Sender::Send, &eager);
+      Simulator::Schedule (Seconds (time), &Sender::Send, &lazy);
+    }
+
+  // limit is reduced and restored in the middle of the run
+  Simulator::Schedule (Seconds (5.0), &ndn::Limits::UpdateCurrentLimit, eager.m_limits, 30.0);
+  Simulator::Schedule (Seconds (5.0), &ndn::Limits::UpdateCurrentLimit, lazy.m_limits, 30.0);
+  Simulator::Schedule (Seconds (10.0), &ndn::Limits::UpdateCurrentLimit, eager.m_limits, 100.0);
+  Simulator::Schedule (Seconds (10.0), &ndn::Limits::UpdateCurrentLimit, lazy.m_limits, 100.0);
+
+  for (double time = 0.05; time < 20.0; time += 0.1)
+    {
+      Simulator::Schedule (Seconds (time), &Sender::Record, &eager);
+      Simulator::Schedule (Seconds (time), &Sender::Record, &lazy);
+    }
+
+  Simulator::Stop (Seconds (20.0));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  // 10 + 5s * 100/s + 5s * 30/s + 10s * 100/s
+  NS_TEST_ASSERT_MSG_EQ_TOL (static_cast<double> (eager.m_sent), 1660.0, 20.0, "Unexpected number of interests (periodic leak)");
+  NS_TEST_ASSERT_MSG_EQ_TOL (static_cast<double> (lazy.m_sent), 1660.0, 20.0, "Unexpected number of interests (lazy leak)");
+
+  // periodic leak returns tokens in discrete steps of 1.001 token, lazy leak continuously:
+  // at any point of time both have admitted the same number of interests, give or take a token
+  NS_TEST_ASSERT_MSG_EQ (eager.m_history.size (), lazy.m_history.size (), "");
+  for (size_t i = 0; i < eager.m_history.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ_TOL (static_cast<double> (lazy.m_history[i]), static_cast<double> (eager.m_history[i]), 1.0,
+                                 "Lazy and periodic limits differ at " << (0.05 + 0.1 * i) << "s");
+    }
+}
+
+}
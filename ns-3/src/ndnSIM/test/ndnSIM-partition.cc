@@ -0,0 +1,100 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "ndnSIM-partition.h"
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/ndn-partition-helper.h"
+
+NS_LOG_COMPONENT_DEFINE ("ndn.PartitionTest");
+
+namespace ns3 {
+
+void
+PartitionTest::DoRun ()
+{
+  // two cliques connected by a single link
+  {
+    NodeContainer nodes;
+    nodes.Create (20);
+
+    ndn::PartitionHelper partitioner;
+    for (uint32_t clique = 0; clique < 2; clique++)
+      for (uint32_t i = 0; i < 10; i++)
+        for (uint32_t j = i + 1; j < 10; j++)
+          partitioner.AddLink (nodes.Get (clique * 10 + i), nodes.Get (clique * 10 + j));
+    partitioner.AddLink (nodes.Get (3), nodes.Get (17));
+
+    NS_TEST_ASSERT_MSG_EQ (partitioner.Partition (nodes, 2), 1, "Only the link between cliques should be cut");
+    for (uint32_t i = 0; i < 20; i++)
+      {
+        NS_TEST_ASSERT_MSG_EQ (nodes.Get (i)->GetSystemId (), nodes.Get (i < 10 ? 0 : 10)->GetSystemId (),
+                               "Clique should not be split");
+      }
+    NS_TEST_ASSERT_MSG_NE (nodes.Get (0)->GetSystemId (), nodes.Get (10)->GetSystemId (), "Cliques should be in different partitions");
+
+    std::vector<uint32_t> single = partitioner.Calculate (nodes, 1);
+    NS_TEST_ASSERT_MSG_EQ ((single == std::vector<uint32_t> (20, 0)), true, "All nodes should be in the only partition");
+  }
+
+  // grid: partitions should be balanced, cut should be close to the optimal
+  // (two straight cuts across the grid, 2 * 30 links)
+  {
+    const uint32_t size = 30;
+    const uint32_t partitions = 4;
+
+    NodeContainer nodes;
+    nodes.Create (size * size);
+
+    ndn::PartitionHelper partitioner;
+    for (uint32_t row = 0; row < size; row++)
+      for (uint32_t column = 0; column < size; column++)
+        {
+          if (column + 1 < size)
+            partitioner.AddLink (nodes.Get (row * size + column), nodes.Get (row * size + column + 1));
+          if (row + 1 < size)
+            partitioner.AddLink (nodes.Get (row * size + column), nodes.Get ((row + 1) * size + column));
+        }
+
+    std::vector<uint32_t> part = partitioner.Calculate (nodes, partitions);
+    NS_TEST_ASSERT_MSG_EQ ((part == partitioner.Calculate (nodes, partitions)), true, "Partitioning should be deterministic");
+
+    std::vector<uint32_t> weights (partitions, 0);
+    for (uint32_t i = 0; i < part.size (); i++)
+      {
+        NS_TEST_ASSERT_MSG_LT (part[i], partitions, "Invalid partition");
+        weights[part[i]] ++;
+      }
+    for (uint32_t partition = 0; partition < partitions; partition++)
+      {
+        NS_TEST_ASSERT_MSG_LT_OR_EQ (weights[partition], 1.05 * size * size / partitions + 1, "Partitions should be balanced");
+      }
+
+    uint32_t cut = partitioner.Partition (nodes, partitions);
+    NS_TEST_ASSERT_MSG_LT_OR_EQ (cut, 1.25 * 2 * size, "Too many links between partitions");
+  }
+
+  NS_TEST_ASSERT_MSG_EQ (ndn::PartitionHelper::GetRankFileName ("rate-trace.txt", 1), "rate-trace-rank1.txt", "");
+  NS_TEST_ASSERT_MSG_EQ (ndn::PartitionHelper::GetRankFileName ("results/trace.bin", 12), "results/trace-rank12.bin", "");
+  NS_TEST_ASSERT_MSG_EQ (ndn::PartitionHelper::GetRankFileName ("results.d/trace", 0), "results.d/trace-rank0", "");
+  NS_TEST_ASSERT_MSG_EQ (ndn::PartitionHelper::GetRankFileName ("rate-trace.txt"), "rate-trace.txt", "Not distributed simulation");
+
+  Simulator::Destroy ();
+}
+
+}
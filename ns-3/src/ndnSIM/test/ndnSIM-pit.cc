@@ -113,6 +113,7 @@ PitTest::DoRun ()
   p2p.Install (node, nodeSink);
   
   ndn::StackHelper ndn;
+  ndn.SetPit (m_pitClass);
   ndn.Install (node);
   ndn.Install (nodeSink);
 
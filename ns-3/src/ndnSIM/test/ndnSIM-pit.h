@@ -24,6 +24,8 @@
 #include "ns3/test.h"
 #include "ns3/ptr.h"
 
+#include <string>
+
 namespace ns3 {
 
 namespace ndn {
@@ -34,8 +36,9 @@ class Pit;
 class PitTest : public TestCase
 {
 public:
-  PitTest ()
-    : TestCase ("PIT test")
+  PitTest (const std::string &pitClass = "ns3::ndn::pit::Persistent")
+    : TestCase ("PIT test (" + pitClass + ")")
+    , m_pitClass (pitClass)
   {
   }
     
@@ -47,6 +50,9 @@ private:
   void Check1 (Ptr<ndn::Pit> pit);
   void Check2 (Ptr<ndn::Pit> pit);
   void Check3 (Ptr<ndn::Pit> pit);
+
+private:
+  std::string m_pitClass;
 };
   
 }
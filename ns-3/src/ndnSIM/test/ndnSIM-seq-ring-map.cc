@@ -0,0 +1,263 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ndnSIM-seq-ring-map.h"
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM/apps/ndn-consumer-cbr.h"
+#include "ns3/ndnSIM/apps/ndn-producer.h"
+#include "../utils/seq-ring-map.h"
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.SeqRingMapTest");
+
+namespace ns3 {
+
+namespace {
+
+typedef ndn::ndnSIM::seq_ring_map<uint32_t, 64> RingMap;
+typedef std::map<uint32_t, uint32_t> ReferenceMap;
+
+bool
+SameContent (RingMap &map, const ReferenceMap &reference, uint32_t from, uint32_t to)
+{
+  if (map.size () != reference.size ())
+    return false;
+
+  for (uint32_t seq = from; seq != to; seq++)
+    {
+      ReferenceMap::const_iterator item = reference.find (seq);
+      uint32_t *value = map.find (seq);
+      if ((item == reference.end ()) != (value == 0))
+        return false;
+      if (value != 0 && *value != item->second)
+        return false;
+    }
+  return true;
+}
+
+/**
+ * @brief Consumer that records every retransmission timeout
+ */
+class TimeoutRecorder : public ndn::ConsumerCbr
+{
+public:
+  struct Timeout
+  {
+    uint32_t seq;
+    Time time;       ///< @brief when the timeout fired
+    Time lastSent;   ///< @brief when the timed out Interest was sent
+    uint32_t retxCount;
+  };
+
+  virtual void
+  OnTimeout (uint32_t seq)
+  {
+    Timeout timeout;
+    timeout.seq = seq;
+    timeout.time = Simulator::Now ();
+    SeqState *state = m_seqStates.find (seq);
+    timeout.lastSent = (state != 0) ? state->lastSent : Seconds (-1);
+    timeout.retxCount = (state != 0) ? state->retxCount : 0;
+    m_timeouts.push_back (timeout);
+
+    ndn::ConsumerCbr::OnTimeout (seq);
+  }
+
+  std::vector<Timeout> m_timeouts;
+};
+
+/**
+ * @brief Producer that does not reply to every Modulo-th sequence number
+ */
+class LossyProducer : public ndn::Producer
+{
+public:
+  static const uint32_t Modulo = 3;
+
+  virtual void
+  OnInterest (Ptr<const ndn::Interest> interest)
+  {
+    if (interest->GetName ().get (-1).toSeqNum () % Modulo == 0)
+      return;
+
+    ndn::Producer::OnInterest (interest);
+  }
+};
+
+}
+
+void
+SeqRingMapTest::DoRun ()
+{
+  Ptr<UniformRandomVariable> rand = CreateObject<UniformRandomVariable> ();
+  rand->SetStream (1);
+
+  // sliding window of sequence numbers with gaps, crossing the 32-bit wrap-around and
+  // wrapping around the ring many times
+  {
+    RingMap map;
+    ReferenceMap reference;
+    uint32_t first = 0xfffff000;
+    uint32_t next = first;
+    for (uint32_t step = 0; step < 20000; step++)
+      {
+        uint32_t op = rand->GetInteger (0, 9);
+        if (op < 5)
+          {
+            next += rand->GetInteger (1, 3); // gaps of up to two sequence numbers
+            map.insert (next) = next ^ step;
+            reference[next] = next ^ step;
+          }
+        else if (op < 9)
+          {
+            // acknowledge a random sequence number of the window (most are acknowledged in order)
+            uint32_t seq = next - rand->GetInteger (0, 40);
+            map.erase (seq);
+            reference.erase (seq);
+          }
+        else
+          {
+            // value of the existing sequence number is updated in place
+            uint32_t seq = next - rand->GetInteger (0, 40);
+            uint32_t *value = map.find (seq);
+            if (value != 0)
+              {
+                (*value)++;
+                NS_TEST_ASSERT_MSG_EQ (map.insert (seq), *value, "insert should return the existing value");
+                reference[seq]++;
+              }
+          }
+
+        // entries that fell out of the window are dropped (e.g., given up after retransmissions)
+        while (!reference.empty () && next - reference.begin ()->first > 200 && reference.begin ()->first <= next)
+          {
+            map.erase (reference.begin ()->first);
+            reference.erase (reference.begin ());
+          }
+
+        NS_TEST_ASSERT_MSG_EQ (SameContent (map, reference, next - 250, next + 1), true,
+                               "content differs at step " << step << ", sequence number " << next);
+      }
+    NS_TEST_ASSERT_MSG_LT (next, first, "sequence numbers should wrap around");
+
+    map.clear ();
+    NS_TEST_ASSERT_MSG_EQ (map.empty (), true, "map should be empty after clear");
+    NS_TEST_ASSERT_MSG_EQ ((map.find (next) == 0), true, "map should be empty after clear");
+  }
+
+  // random sequence numbers (e.g., Zipf-Mandelbrot consumer) collide in the ring and go to the
+  // fallback table once the ring cannot grow anymore
+  {
+    RingMap map;
+    ReferenceMap reference;
+    for (uint32_t step = 0; step < 5000; step++)
+      {
+        uint32_t seq = rand->GetInteger (0, 499);
+        if (rand->GetInteger (0, 2) > 0)
+          {
+            map.insert (seq) = step;
+            reference[seq] = step;
+          }
+        else
+          {
+            map.erase (seq);
+            reference.erase (seq);
+          }
+
+        NS_TEST_ASSERT_MSG_EQ (SameContent (map, reference, 0, 500), true,
+                               "content differs at step " << step << ", sequence number " << seq);
+      }
+  }
+}
+
+void
+ConsumerTimeoutTest::DoRun ()
+{
+  NodeContainer nodes;
+  nodes.Create (2);
+
+  PointToPointHelper p2p;
+  p2p.SetDeviceAttribute ("DataRate", StringValue ("10Mbps"));
+  p2p.SetChannelAttribute ("Delay", StringValue ("10ms"));
+  p2p.Install (nodes.Get (0), nodes.Get (1));
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.SetDefaultRoutes (true);
+  ndnHelper.InstallAll ();
+
+  Ptr<TimeoutRecorder> consumer = CreateObject<TimeoutRecorder> ();
+  consumer->SetAttribute ("Prefix", StringValue ("/prefix"));
+  consumer->SetAttribute ("Frequency", StringValue ("50"));
+  consumer->SetAttribute ("LifeTime", StringValue ("1s"));
+  nodes.Get (0)->AddApplication (consumer);
+  consumer->SetStartTime (Seconds (0.0));
+  consumer->SetStopTime (Seconds (10.0));
+
+  Ptr<LossyProducer> producer = CreateObject<LossyProducer> ();
+  producer->SetAttribute ("Prefix", StringValue ("/prefix"));
+  nodes.Get (1)->AddApplication (producer);
+
+  Simulator::Stop (Seconds (10.0));
+  Simulator::Run ();
+
+  const std::vector<TimeoutRecorder::Timeout> &timeouts = consumer->m_timeouts;
+  NS_TEST_ASSERT_MSG_GT (timeouts.size (), 0, "Interests that are not answered should time out");
+
+  std::map<uint32_t, uint32_t> lastRetxCount;
+  for (size_t i = 0; i < timeouts.size (); i++)
+    {
+      const TimeoutRecorder::Timeout &timeout = timeouts[i];
+      NS_TEST_ASSERT_MSG_EQ (timeout.seq % LossyProducer::Modulo, 0,
+                             "Interest " << timeout.seq << " was answered, but timed out");
+      NS_TEST_ASSERT_MSG_GT (timeout.lastSent.GetSeconds (), -1.0,
+                             "timed out Interest " << timeout.seq << " should have a pending state");
+      NS_TEST_ASSERT_MSG_GT (timeout.time, timeout.lastSent,
+                             "timeout of " << timeout.seq << " fired before the Interest was sent");
+
+      // timeouts are processed in the order of the (re)transmissions
+      if (i > 0)
+        NS_TEST_ASSERT_MSG_GT_OR_EQ (timeout.lastSent, timeouts[i-1].lastSent,
+                                     "timeout of " << timeout.seq << " is out of order");
+
+      // every timeout corresponds to a new transmission
+      NS_TEST_ASSERT_MSG_GT (timeout.retxCount, lastRetxCount[timeout.seq],
+                             "Interest " << timeout.seq << " timed out twice after one transmission");
+      lastRetxCount[timeout.seq] = timeout.retxCount;
+    }
+
+  uint32_t maxRetxCount = 0;
+  for (std::map<uint32_t, uint32_t>::iterator item = lastRetxCount.begin (); item != lastRetxCount.end (); item++)
+    maxRetxCount = std::max (maxRetxCount, item->second);
+  NS_TEST_ASSERT_MSG_GT (maxRetxCount, 1, "Retransmitted Interests should time out again");
+
+  // every unanswered Interest of the first second times out (RTO doubles with every timeout, so
+  // later Interests may not time out before the end of the simulation)
+  for (uint32_t seq = 0; seq < 50; seq += LossyProducer::Modulo)
+    NS_TEST_ASSERT_MSG_EQ ((lastRetxCount.find (seq) != lastRetxCount.end ()), true,
+                           "Interest " << seq << " never timed out");
+
+  Simulator::Destroy ();
+}
+
+} // namespace ns3
@@ -24,6 +24,7 @@
 #include "ndnSIM-serialization.h"
 
 #include <boost/lexical_cast.hpp>
+#include <vector>
 #include "ns3/ndnSIM/model/wire/ndnsim.h"
 
 using namespace std;
@@ -77,14 +78,14 @@ InterestSerializationTest::DoRun ()
   source->SetExclude (exclude);
   
   NS_TEST_ASSERT_MSG_EQ (boost::lexical_cast<std::string> (*source->GetExclude ()),
-                         " ----> ", "exclude should contain only <ANY/>");
+                         "... ----> ", "exclude should contain only <ANY/> after the empty component");
 
   exclude->appendExclude (name::Component ("alex"), false);
   exclude->excludeAfter (name::Component ("zhenkai"));
 
   source->SetExclude (exclude);  
   NS_TEST_ASSERT_MSG_EQ (boost::lexical_cast<std::string> (*source->GetExclude ()),
-                         " ----> alex zhenkai ----> ", "exclude should contain only <ANY/>");
+                         "... ----> alex zhenkai ----> ", "exclude should contain alex and <ANY/> ranges");
 
   NS_TEST_ASSERT_MSG_EQ (source->GetWire (), 0, "Wire should be empty");
   NS_TEST_ASSERT_MSG_NE (source->GetPayload (), 0, "Payload should not be empty");
@@ -94,7 +95,74 @@ InterestSerializationTest::DoRun ()
   NS_TEST_ASSERT_MSG_NE (target->GetExclude (), 0, "exclude should not be empty");
 
   NS_TEST_ASSERT_MSG_EQ (boost::lexical_cast<std::string> (*target->GetExclude ()),
-                         " ----> alex zhenkai ----> ", "exclude should contain only <ANY/>");
+                         "... ----> alex zhenkai ----> ", "exclude should contain alex and <ANY/> ranges");
+}
+
+static std::vector<uint8_t>
+GetBytes (Ptr<const Packet> packet)
+{
+  std::vector<uint8_t> bytes (packet->GetSize ());
+  packet->CopyData (&bytes[0], bytes.size ());
+  return bytes;
+}
+
+void
+InterestWirePatchingTest::DoRun ()
+{
+  Ptr<Exclude> exclude = Create<Exclude> ();
+  exclude->excludeAfter (name::Component ("alex"));
+
+  Ptr<Interest> source = Create<Interest> ();
+  source->SetName (Create<Name> (boost::lexical_cast<Name> ("/test/test2/3")));
+  source->SetExclude (exclude);
+  source->SetNonce (1);
+  source->SetScope (0);
+  source->SetInterestLifetime (Seconds (4));
+
+  Ptr<Packet> packet = wire::ndnSIM::Interest::ToWire (source);
+  NS_TEST_ASSERT_MSG_NE (source->GetWire (), 0, "Wire should be cached");
+
+  // only fixed-size fields change (e.g., when the consumer retransmits the interest)
+  source->SetNonce (0xdeadbeef);
+  source->SetScope (2);
+  source->SetNack (Interest::NACK_GIVEUP_PIT);
+  source->SetInterestLifetime (Seconds (100));
+  NS_TEST_ASSERT_MSG_EQ (source->GetWire (), 0, "Wire should become stale");
+  NS_TEST_ASSERT_MSG_EQ (source->IsWireStale (), true, "Wire should become stale");
+
+  Ptr<Packet> patched = wire::ndnSIM::Interest::ToWire (source);
+  NS_TEST_ASSERT_MSG_EQ (source->IsWireStale (), false, "Wire should be patched");
+
+  // the same interest encoded from scratch
+  Ptr<Interest> fresh = Create<Interest> ();
+  fresh->SetName (Create<Name> (boost::lexical_cast<Name> ("/test/test2/3")));
+  fresh->SetExclude (exclude);
+  fresh->SetNonce (0xdeadbeef);
+  fresh->SetScope (2);
+  fresh->SetNack (Interest::NACK_GIVEUP_PIT);
+  fresh->SetInterestLifetime (Seconds (100));
+
+  Ptr<Packet> encoded = wire::ndnSIM::Interest::ToWire (fresh);
+
+  NS_TEST_ASSERT_MSG_EQ (patched->GetSize (), encoded->GetSize (), "Patched and fresh encodings should have the same size");
+  NS_TEST_ASSERT_MSG_EQ ((GetBytes (patched) == GetBytes (encoded)), true, "Patched and fresh encodings should be identical");
+
+  Ptr<Interest> target = wire::ndnSIM::Interest::FromWire (patched);
+  NS_TEST_ASSERT_MSG_EQ (target->GetName ()            , fresh->GetName ()            , "patched name failed");
+  NS_TEST_ASSERT_MSG_EQ (target->GetNonce ()           , fresh->GetNonce ()           , "patched nonce failed");
+  NS_TEST_ASSERT_MSG_EQ (target->GetScope ()           , fresh->GetScope ()           , "patched scope failed");
+  NS_TEST_ASSERT_MSG_EQ (target->GetNack ()            , fresh->GetNack ()            , "patched NACK failed");
+  NS_TEST_ASSERT_MSG_EQ (target->GetInterestLifetime (), fresh->GetInterestLifetime (), "patched interest lifetime failed");
+  NS_TEST_ASSERT_MSG_NE (target->GetExclude ()         , 0, "exclude should not be empty");
+  NS_TEST_ASSERT_MSG_EQ (boost::lexical_cast<std::string> (*target->GetExclude ()),
+                         boost::lexical_cast<std::string> (*exclude), "patched exclude failed");
+
+  // patching a decoded interest (e.g., forwarder changes the nonce) gives the same result
+  target->SetNonce (7);
+  fresh->SetNonce (7);
+  NS_TEST_ASSERT_MSG_EQ ((GetBytes (wire::ndnSIM::Interest::ToWire (target)) ==
+                          GetBytes (wire::ndnSIM::Interest::ToWire (fresh))), true,
+                         "Patched decoded interest should be identical to fresh encoding");
 }
 
 void
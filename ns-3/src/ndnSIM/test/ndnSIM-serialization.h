@@ -39,6 +39,18 @@ private:
   virtual void DoRun ();
 };
 
+class InterestWirePatchingTest : public TestCase
+{
+public:
+  InterestWirePatchingTest ()
+    : TestCase ("Interest Wire Patching Test")
+  {
+  }
+
+private:
+  virtual void DoRun ();
+};
+
 class DataSerializationTest : public TestCase
 {
 public:
@@ -0,0 +1,183 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ndnSIM-small-sorted-set.h"
+
+#include "ns3/core-module.h"
+#include "../utils/small-sorted-set.h"
+
+#include <cstdlib>
+#include <functional>
+#include <vector>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.SmallSortedSetTest");
+
+namespace ns3 {
+
+namespace {
+
+/**
+ * @brief Element that counts its live copies (to check that every constructed element is destroyed)
+ */
+struct Element
+{
+  Element (int value)
+    : m_value (value)
+  {
+    s_live++;
+  }
+
+  Element (const Element &other)
+    : m_value (other.m_value)
+  {
+    s_live++;
+  }
+
+  ~Element ()
+  {
+    s_live--;
+  }
+
+  Element &
+  operator = (const Element &other)
+  {
+    m_value = other.m_value;
+    return *this;
+  }
+
+  bool
+  operator < (const Element &other) const
+  {
+    return m_value < other.m_value;
+  }
+
+  operator int () const
+  {
+    return m_value;
+  }
+
+  int m_value;
+  static int s_live;
+};
+
+int Element::s_live = 0;
+
+} // namespace
+
+template<class Set>
+void
+SmallSortedSetTest::Compare (const Set &set, const std::set<int> &expected, const std::string &msg)
+{
+  NS_TEST_ASSERT_MSG_EQ (set.size (), expected.size (), msg);
+  NS_TEST_ASSERT_MSG_EQ (set.empty (), expected.empty (), msg);
+
+  std::vector<int> actual (set.begin (), set.end ());
+  NS_TEST_ASSERT_MSG_EQ ((actual == std::vector<int> (expected.begin (), expected.end ())), true,
+                         msg << ": elements should be sorted as in std::set");
+}
+
+template<size_t InlineCapacity>
+void
+SmallSortedSetTest::RunRandom ()
+{
+  typedef ndn::ndnSIM::small_sorted_set<Element, InlineCapacity> Set;
+
+  srand (InlineCapacity);
+  {
+    Set set;
+    std::set<int> expected;
+    for (int step = 0; step < 20000; step++)
+      {
+        // more inserts than erases at first, so the set grows well past the inline capacity
+        int value = rand () % 64;
+        if (rand () % 100 < (step < 10000 ? 70 : 30))
+          {
+            std::pair<typename Set::iterator, bool> result = set.insert (Element (value));
+            bool inserted = expected.insert (value).second;
+            NS_TEST_ASSERT_MSG_EQ (result.second, inserted, "Duplicate insert should be rejected");
+            NS_TEST_ASSERT_MSG_EQ (static_cast<int> (*result.first), value, "Insert should point to the element");
+          }
+        else if (rand () % 2 == 0)
+          {
+            NS_TEST_ASSERT_MSG_EQ (set.erase (Element (value)), expected.erase (value), "Erase by key failed");
+          }
+        else if (!set.empty ())
+          {
+            typename Set::iterator item = set.begin () + rand () % set.size ();
+            int erased = *item;
+            expected.erase (erased);
+            std::set<int>::iterator next = expected.upper_bound (erased);
+            item = set.erase (item);
+            NS_TEST_ASSERT_MSG_EQ ((item == set.end ()), (next == expected.end ()), "Erase should return the following element");
+            if (item != set.end ())
+              NS_TEST_ASSERT_MSG_EQ (static_cast<int> (*item), *next, "Erase should return the following element");
+          }
+
+        NS_TEST_ASSERT_MSG_EQ (set.count (Element (value)), expected.count (value), "Find failed");
+        Compare (set, expected, "Random operations");
+      }
+
+    // copies are independent from the original
+    Set copy (set);
+    Compare (copy, expected, "Copy");
+    copy.insert (Element (1000));
+    Compare (set, expected, "Original after modification of the copy");
+
+    Set assigned;
+    assigned.insert (Element (-1));
+    assigned = set;
+    Compare (assigned, expected, "Assignment");
+    assigned = assigned;
+    Compare (assigned, expected, "Self-assignment");
+
+    set.clear ();
+    Compare (set, std::set<int> (), "Clear");
+    set.insert (Element (5));
+    NS_TEST_ASSERT_MSG_EQ (set.size (), 1, "Set should be usable after clear");
+  }
+  NS_TEST_ASSERT_MSG_EQ (Element::s_live, 0, "All elements should be destroyed");
+}
+
+void
+SmallSortedSetTest::DoRun ()
+{
+  // growth from the inline storage to the heap and back
+  {
+    ndn::ndnSIM::small_sorted_set<int, 2> set;
+    std::set<int> expected;
+    int values[] = { 5, 3, 5, 1, 4, 2, 3, 0 };
+    for (size_t i = 0; i < sizeof (values) / sizeof (values[0]); i++)
+      {
+        set.insert (values[i]);
+        expected.insert (values[i]);
+        Compare (set, expected, "Insert");
+      }
+    while (!expected.empty ())
+      {
+        set.erase (*expected.rbegin ());
+        expected.erase (*expected.rbegin ());
+        Compare (set, expected, "Erase");
+      }
+  }
+
+  RunRandom<1> ();
+  RunRandom<4> ();
+  RunRandom<16> ();
+}
+
+}
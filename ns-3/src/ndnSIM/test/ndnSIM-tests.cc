@@ -25,6 +25,24 @@
 #include "ndnSIM-pit.h"
 #include "ndnSIM-fib-entry.h"
 #include "ndnSIM-api.h"
+#include "ndnSIM-flat-trie.h"
+#include "ndnSIM-lfu-policy.h"
+#include "ndnSIM-cs-policies.h"
+#include "ndnSIM-binary-trace.h"
+#include "ndnSIM-fw-counters.h"
+#include "ndnSIM-adaptive-splitting.h"
+#include "ndnSIM-global-routing.h"
+#include "ndnSIM-partition.h"
+#include "ndnSIM-timer-wheel.h"
+#include "ndnSIM-blob.h"
+#include "ndnSIM-small-sorted-set.h"
+#include "ndnSIM-face-removal.h"
+#include "ndnSIM-limits.h"
+#include "ndnSIM-ghost-queue.h"
+#include "ndnSIM-zipf-mandelbrot.h"
+#include "ndnSIM-seq-ring-map.h"
+#include "ndnSIM-fast-path.h"
+#include "ndnSIM-topology-reader.h"
 
 namespace ns3
 {
@@ -38,10 +56,39 @@ public:
     SetDataDir (NS_TEST_SOURCEDIR);
 
     AddTestCase (new InterestSerializationTest (), TestCase::QUICK);
+    AddTestCase (new InterestWirePatchingTest (), TestCase::QUICK);
     AddTestCase (new DataSerializationTest (), TestCase::QUICK);
     AddTestCase (new FibEntryTest (), TestCase::QUICK);
+    AddTestCase (new FaceMetricContainerTest (), TestCase::QUICK);
     AddTestCase (new PitTest (), TestCase::QUICK);
+    AddTestCase (new PitTest ("ns3::ndn::pit::HashedPersistent"), TestCase::QUICK);
     AddTestCase (new ApiTest (), TestCase::QUICK);
+    AddTestCase (new FlatTrieTest (), TestCase::QUICK);
+    AddTestCase (new LfuPolicyTest (), TestCase::QUICK);
+    AddTestCase (new CsPoliciesTest (), TestCase::QUICK);
+    AddTestCase (new BinaryTraceTest (), TestCase::QUICK);
+    AddTestCase (new FwCountersTest (), TestCase::QUICK);
+    AddTestCase (new AdaptiveSplittingTest (), TestCase::QUICK);
+    AddTestCase (new AdaptiveSplittingTest ("ns3::ndn::fw::AdaptiveSplitting::PerOutFaceLimits"), TestCase::QUICK);
+    AddTestCase (new GlobalRoutingTest (1), TestCase::QUICK);
+    AddTestCase (new GlobalRoutingTest (3), TestCase::QUICK);
+    AddTestCase (new PartitionTest (), TestCase::QUICK);
+    AddTestCase (new TimerWheelTest (), TestCase::QUICK);
+    AddTestCase (new BlobTest (), TestCase::QUICK);
+    AddTestCase (new SmallSortedSetTest (), TestCase::QUICK);
+    AddTestCase (new FaceRemovalTest (), TestCase::QUICK);
+    AddTestCase (new LimitsRateTest (), TestCase::QUICK);
+    AddTestCase (new GhostQueueTest (), TestCase::QUICK);
+    AddTestCase (new ZipfMandelbrotTest (), TestCase::QUICK);
+    AddTestCase (new SeqRingMapTest (), TestCase::QUICK);
+    AddTestCase (new ConsumerTimeoutTest (), TestCase::QUICK);
+    AddTestCase (new FastPathTest ("ns3::ndn::fw::Flooding"), TestCase::QUICK);
+    AddTestCase (new FastPathTest ("ns3::ndn::fw::SmartFlooding"), TestCase::QUICK);
+    AddTestCase (new FastPathTest ("ns3::ndn::fw::BestRoute"), TestCase::QUICK);
+    AddTestCase (new FastPathTest ("ns3::ndn::fw::AdaptiveSplitting"), TestCase::QUICK);
+    AddTestCase (new FastPathTest ("ns3::ndn::fw::BestRoute::PerOutFaceLimits"), TestCase::QUICK);
+    AddTestCase (new FastPathTest ("ns3::ndn::test::FastPathTestStrategy"), TestCase::QUICK);
+    AddTestCase (new TopologyReaderTest (), TestCase::QUICK);
   }
 };
 
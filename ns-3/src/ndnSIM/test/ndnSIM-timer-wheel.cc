@@ -0,0 +1,145 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "ndnSIM-timer-wheel.h"
+
+#include "ns3/core-module.h"
+#include "../utils/timer-wheel.h"
+
+#include <cstdlib>
+#include <map>
+#include <set>
+#include <vector>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.TimerWheelTest");
+
+namespace ns3 {
+
+namespace {
+
+struct WheelItem
+{
+  uint32_t id;
+  ndn::TimerWheelHook hook;
+};
+
+typedef ndn::TimerWheel<WheelItem, &WheelItem::hook, 3> Wheel;
+
+} // namespace
+
+void
+TimerWheelTest::DoRun ()
+{
+  // explicit items around level boundaries (256 and 65536 ticks) and beyond the wheel range
+  {
+    Wheel wheel;
+    wheel.reset (100);
+
+    uint64_t ticks[] = { 100, 101, 355, 356, 400, 65635, 65636, 70000, 16777316, 20000000 };
+    const size_t count = sizeof (ticks) / sizeof (ticks[0]);
+    std::vector<WheelItem> items (count);
+    for (size_t i = 0; i < count; i++)
+      {
+        items[i].id = i;
+        wheel.insert (items[i], ticks[i]);
+      }
+
+    // cancelled items are never reported
+    wheel.erase (items[3]);
+    wheel.erase (items[3]); // no-op
+    NS_TEST_ASSERT_MSG_EQ (wheel.size (), count - 1, "");
+
+    std::vector<uint64_t> reported;
+    while (!wheel.empty ())
+      {
+        uint64_t tick = wheel.next ();
+        NS_TEST_ASSERT_MSG_NE (tick, Wheel::npos, "");
+        wheel.expire (tick);
+        while (WheelItem *item = wheel.pop ())
+          {
+            NS_TEST_ASSERT_MSG_EQ (ticks[item->id], tick, "Item should be reported exactly at its due tick");
+            reported.push_back (item->id);
+          }
+      }
+    NS_TEST_ASSERT_MSG_EQ (reported.size (), count - 1, "");
+    NS_TEST_ASSERT_MSG_EQ (wheel.next (), Wheel::npos, "");
+  }
+
+  // random inserts and cancellations, compared with std::multimap
+  {
+    srand (12345);
+
+    Wheel wheel;
+    std::vector<WheelItem> items (2000);
+    std::multimap<uint64_t, uint32_t> expected;
+    std::map<uint32_t, uint64_t> due;
+
+    uint64_t now = 0;
+    wheel.reset (now);
+    for (uint32_t step = 0; step < 20000; step++)
+      {
+        uint32_t id = rand () % items.size ();
+        if (due.find (id) == due.end ())
+          {
+            // mostly short timeouts, some of them across level 1 and level 2 boundaries
+            uint64_t delay = (rand () % 10 == 0) ? rand () % 200000 : rand () % 1000;
+            items[id].id = id;
+            wheel.insert (items[id], now + delay);
+            expected.insert (std::make_pair (now + delay, id));
+            due[id] = now + delay;
+          }
+        else if (rand () % 3 == 0)
+          {
+            wheel.erase (items[id]);
+            std::multimap<uint64_t, uint32_t>::iterator i = expected.lower_bound (due[id]);
+            while (i->second != id)
+              i++;
+            expected.erase (i);
+            due.erase (id);
+          }
+        else
+          {
+            // advance the wheel to the next reported tick
+            uint64_t tick = wheel.next ();
+            if (tick == Wheel::npos)
+              continue;
+
+            NS_TEST_ASSERT_MSG_EQ ((expected.empty () || tick <= expected.begin ()->first), true,
+                                   "Next tick should not be after the earliest item");
+            now = tick;
+            wheel.expire (now);
+            std::set<uint32_t> popped;
+            while (WheelItem *item = wheel.pop ())
+              popped.insert (item->id);
+
+            std::set<uint32_t> expectedPopped;
+            while (!expected.empty () && expected.begin ()->first <= now)
+              {
+                NS_TEST_ASSERT_MSG_EQ (expected.begin ()->first, now, "Item should not be reported late");
+                expectedPopped.insert (expected.begin ()->second);
+                due.erase (expected.begin ()->second);
+                expected.erase (expected.begin ());
+              }
+            NS_TEST_ASSERT_MSG_EQ ((popped == expectedPopped), true, "Different items are due");
+            now++;
+          }
+        NS_TEST_ASSERT_MSG_EQ (wheel.size (), expected.size (), "");
+      }
+  }
+}
+
+}
@@ -0,0 +1,117 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ndnSIM-topology-reader.h"
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-model.h"
+#include "ns3/ndnSIM-module.h"
+
+#include <cmath>
+#include <fstream>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.TopologyReaderTest");
+
+namespace ns3 {
+
+namespace {
+
+Vector
+Position (const std::string &name)
+{
+  return Names::Find<Node> (name)->GetObject<MobilityModel> ()->GetPosition ();
+}
+
+// position is random (in [0, 200) range) if coordinates are missing or malformed
+bool
+IsRandomPosition (const std::string &name)
+{
+  Vector position = Position (name);
+  return position.x >= 0 && position.x < 200 && position.y >= 0 && position.y < 200;
+}
+
+}
+
+void
+TopologyReaderTest::DoRun ()
+{
+  std::string file = CreateTempDirFilename ("topology.txt");
+  {
+    std::ofstream os (file.c_str ());
+    os << "# comment\n"
+       << "router\n"
+       << "# node comment\n"
+       << "rt-a\tNA\t1.5\t2.5\t0\r\n"       // tabs and CRLF line ending
+       << "  rt-b   NA  -3  4e1  \n"      // extra spaces, exponent, no system ID
+       << "rt-hex NA 0x10 5\n"
+       << "rt-inf NA inf 5\n"
+       << "rt-nan NA nan 5\n"
+       << "rt-trailing NA 10abc 5\n"
+       << "rt-system NA 7 8 1x\n"
+       << "rt-none NA\n"
+       << "\n"
+       << "link\n"
+       << "# link comment\n"
+       << "rt-a\trt-b\t1Mbps\t3\t10ms\t20\r\n"
+       << "rt-b   rt-none  2Mbps 4\n"
+       << "rt-b rt-a 5Mbps 5 1ms 1\n";    // duplicate of the first link
+  }
+
+  AnnotatedTopologyReader reader;
+  reader.SetFileName (file);
+  NodeContainer nodes = reader.Read ();
+
+  NS_TEST_ASSERT_MSG_EQ (nodes.GetN (), 8, "All nodes should be created");
+
+  NS_TEST_EXPECT_MSG_EQ (Position ("rt-a").x, 2.5, "Longitude should be parsed");
+  NS_TEST_EXPECT_MSG_EQ (Position ("rt-a").y, -1.5, "Latitude should be parsed");
+  NS_TEST_EXPECT_MSG_EQ (Position ("rt-b").x, 40, "Exponent should be parsed");
+  NS_TEST_EXPECT_MSG_EQ (Position ("rt-b").y, 3, "Negative latitude should be parsed");
+
+  NS_TEST_EXPECT_MSG_EQ (IsRandomPosition ("rt-hex"), true, "Hexadecimal numbers should be rejected");
+  NS_TEST_EXPECT_MSG_EQ (IsRandomPosition ("rt-inf"), true, "Infinity should be rejected");
+  NS_TEST_EXPECT_MSG_EQ (IsRandomPosition ("rt-nan"), true, "NaN should be rejected");
+  NS_TEST_EXPECT_MSG_EQ (IsRandomPosition ("rt-trailing"), true, "Numbers with trailing characters should be rejected");
+  NS_TEST_EXPECT_MSG_EQ (IsRandomPosition ("rt-none"), true, "Missing coordinates should give random position");
+
+  NS_TEST_EXPECT_MSG_EQ (Position ("rt-system").x, 8, "");
+  NS_TEST_EXPECT_MSG_EQ (Names::Find<Node> ("rt-system")->GetSystemId (), 0, "Malformed system ID should be ignored");
+
+  const std::list<TopologyReader::Link> &links = reader.GetLinks ();
+  NS_TEST_ASSERT_MSG_EQ (links.size (), 2, "Duplicated link should be skipped");
+
+  const TopologyReader::Link &first = links.front ();
+  NS_TEST_EXPECT_MSG_EQ (first.GetFromNodeName (), "rt-a", "");
+  NS_TEST_EXPECT_MSG_EQ (first.GetToNodeName (), "rt-b", "");
+  NS_TEST_EXPECT_MSG_EQ (first.GetAttribute ("DataRate"), "1Mbps", "");
+  NS_TEST_EXPECT_MSG_EQ (first.GetAttribute ("OSPF"), "3", "");
+  NS_TEST_EXPECT_MSG_EQ (first.GetAttribute ("Delay"), "10ms", "");
+  NS_TEST_EXPECT_MSG_EQ (first.GetAttribute ("MaxPackets"), "20", "CR should not be a part of the last field");
+
+  const TopologyReader::Link &second = links.back ();
+  NS_TEST_EXPECT_MSG_EQ (second.GetToNodeName (), "rt-none", "");
+  NS_TEST_EXPECT_MSG_EQ (second.GetAttribute ("DataRate"), "2Mbps", "");
+  NS_TEST_EXPECT_MSG_EQ (second.GetAttribute ("OSPF"), "4", "");
+  std::string delay;
+  NS_TEST_EXPECT_MSG_EQ (second.GetAttributeFailSafe ("Delay", delay), false, "Missing fields should not be set");
+
+  Simulator::Destroy ();
+}
+
+}
@@ -0,0 +1,105 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ndnSIM-zipf-mandelbrot.h"
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/ndnSIM/apps/ndn-consumer-zipf-mandelbrot.h"
+
+#include <cmath>
+#include <vector>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.ZipfMandelbrotTest");
+
+namespace ns3 {
+
+namespace {
+
+/**
+ * @brief Chi-square value that is exceeded with probability of 0.001 (Wilson-Hilferty approximation)
+ */
+double
+ChiSquareCritical (uint32_t degrees)
+{
+  const double z = 3.090; // 0.999 quantile of the standard normal distribution
+  double a = 2.0 / (9.0 * degrees);
+  return degrees * std::pow (1.0 - a + z * std::sqrt (a), 3);
+}
+
+}
+
+void
+ZipfMandelbrotTest::Check (const std::string &sampling, uint32_t contents, double q, double s)
+{
+  Ptr<ndn::ConsumerZipfMandelbrot> app = CreateObject<ndn::ConsumerZipfMandelbrot> ();
+  app->SetAttribute ("Sampling", StringValue (sampling));
+  app->SetAttribute ("NumberOfContents", UintegerValue (contents));
+  app->SetAttribute ("q", DoubleValue (q));
+  app->SetAttribute ("s", DoubleValue (s));
+
+  const uint32_t samples = 200000;
+  std::vector<uint32_t> counts (contents + 1, 0);
+  for (uint32_t i = 0; i < samples; i++)
+    {
+      uint32_t seq = app->GetNextSeq ();
+      NS_TEST_ASSERT_MSG_EQ ((seq >= 1 && seq <= contents), true,
+                             sampling << " sampler returned " << seq << ", outside [1, " << contents << "]");
+      if (seq >= 1 && seq <= contents)
+        counts[seq]++;
+    }
+
+  double total = 0.0;
+  for (uint32_t k = 1; k <= contents; k++)
+    total += 1.0 / std::pow (k + q, s);
+
+  double chiSquare = 0.0;
+  for (uint32_t k = 1; k <= contents; k++)
+    {
+      double expected = samples / std::pow (k + q, s) / total;
+      chiSquare += (counts[k] - expected) * (counts[k] - expected) / expected;
+    }
+
+  if (contents == 1)
+    return; // nothing to compare
+
+  NS_LOG_DEBUG (sampling << " N=" << contents << " q=" << q << " s=" << s << ": chi-square " << chiSquare
+                << ", critical " << ChiSquareCritical (contents - 1));
+  NS_TEST_ASSERT_MSG_LT (chiSquare, ChiSquareCritical (contents - 1),
+                         sampling << " sampler does not follow Zipf-Mandelbrot distribution with N=" << contents
+                         << ", q=" << q << ", s=" << s);
+}
+
+void
+ZipfMandelbrotTest::DoRun ()
+{
+  const char *samplings[] = { "cdf", "alias", "rejection" };
+  for (uint32_t i = 0; i < sizeof (samplings) / sizeof (samplings[0]); i++)
+    {
+      Check (samplings[i], 100, 0.7, 0.7);
+      Check (samplings[i], 100, 0.0, 1.0); // s = 1 is a special case of rejection-inversion
+      Check (samplings[i], 200, 5.0, 1.5);
+      Check (samplings[i], 10, 0.0, 0.2);
+      Check (samplings[i], 1, 0.7, 0.7);
+    }
+
+  // consumers schedule retransmission checks on creation
+  Simulator::Destroy ();
+}
+
+} // namespace ns3
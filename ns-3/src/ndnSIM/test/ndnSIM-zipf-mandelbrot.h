@@ -0,0 +1,45 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NDNSIM_TEST_ZIPF_MANDELBROT_H
+#define NDNSIM_TEST_ZIPF_MANDELBROT_H
+
+#include "ns3/test.h"
+
+#include <string>
+
+namespace ns3 {
+
+class ZipfMandelbrotTest : public TestCase
+{
+public:
+  ZipfMandelbrotTest ()
+    : TestCase ("Zipf-Mandelbrot samplers follow the distribution (chi-square test)")
+  {
+  }
+
+private:
+  virtual void DoRun ();
+
+  void
+  Check (const std::string &sampling, uint32_t contents, double q, double s);
+};
+
+}
+
+#endif // NDNSIM_TEST_ZIPF_MANDELBROT_H
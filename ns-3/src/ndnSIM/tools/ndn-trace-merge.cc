@@ -0,0 +1,142 @@
+/* -*- Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Merge trace files written by every rank of the distributed (MPI) simulation (e.g.,
+// rate-trace-rank0.txt, rate-trace-rank1.txt, ...) into one tab-separated text file, ordered by
+// time (the first column).  Binary traces (*.bin) are converted to text.
+//
+// Usage: ndn-trace-merge --input=rate-trace.txt --ranks=4 [--output=rate-trace-merged.txt]
+
+#include "ns3/core-module.h"
+#include "ns3/binary-trace-writer.h"
+#include "ns3/ndn-partition-helper.h"
+
+#include <boost/shared_ptr.hpp>
+
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <queue>
+#include <sstream>
+#include <vector>
+
+using namespace ns3;
+using namespace std;
+
+struct Trace
+{
+  boost::shared_ptr<istream> m_is;
+  string m_line;
+  double m_time;
+
+  // read the next record, skipping lines that do not start with time
+  bool
+  Next ()
+  {
+    while (getline (*m_is, m_line))
+      {
+        char *end;
+        m_time = strtod (m_line.c_str (), &end);
+        if (end != m_line.c_str ())
+          return true;
+      }
+    return false;
+  }
+};
+
+int main (int argc, char**argv)
+{
+  string input = "";
+  string output = "-";
+  uint32_t ranks = 0;
+
+  CommandLine cmd;
+  cmd.AddValue ("input", "Trace file name, as specified in the simulation scenario", input);
+  cmd.AddValue ("ranks", "Number of ranks of the simulation", ranks);
+  cmd.AddValue ("output", "Output text file (- for standard output)", output);
+  cmd.Parse (argc, argv);
+
+  if (input == "" || ranks == 0)
+    {
+      cerr << "--input and --ranks should be specified" << endl;
+      return 1;
+    }
+
+  vector<Trace> traces (ranks);
+  string header;
+  // (time, rank): records with the same time are ordered by rank
+  priority_queue< pair<double, uint32_t>, vector< pair<double, uint32_t> >, greater< pair<double, uint32_t> > > queue;
+  for (uint32_t rank = 0; rank < ranks; rank++)
+    {
+      string file = ndn::PartitionHelper::GetRankFileName (input, rank);
+      ifstream *is = new ifstream (file.c_str (), ios_base::in | ios_base::binary);
+      traces[rank].m_is.reset (is);
+      if (!is->is_open ())
+        {
+          cerr << "Cannot open " << file << endl;
+          return 1;
+        }
+
+      if (BinaryTraceWriter::IsBinaryFile (file))
+        {
+          stringstream *text = new stringstream ();
+          traces[rank].m_is.reset (text);
+          if (!BinaryTraceWriter::ConvertToTsv (*is, *text))
+            {
+              cerr << file << " is not a valid binary trace" << endl;
+              return 1;
+            }
+        }
+
+      // every rank writes the same header, unless it does not have any traced node
+      string line;
+      if (getline (*traces[rank].m_is, line) && header.empty ())
+        header = line;
+
+      if (traces[rank].Next ())
+        queue.push (make_pair (traces[rank].m_time, rank));
+    }
+
+  ofstream file;
+  if (output != "-")
+    {
+      file.open (output.c_str (), ios_base::out | ios_base::trunc);
+      if (!file.is_open ())
+        {
+          cerr << "Cannot open " << output << endl;
+          return 1;
+        }
+    }
+  ostream &os = (output == "-") ? cout : file;
+
+  if (!header.empty ())
+    os << header << "\n";
+
+  while (!queue.empty ())
+    {
+      uint32_t rank = queue.top ().second;
+      queue.pop ();
+
+      os << traces[rank].m_line << "\n";
+      if (traces[rank].Next ())
+        queue.push (make_pair (traces[rank].m_time, rank));
+    }
+
+  return 0;
+}
@@ -0,0 +1,79 @@
+/* -*- Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Convert binary trace (written by ndnSIM tracers into *.bin files) to tab-separated text,
+// the same as produced by the tracers in text mode
+//
+// Usage: ndn-trace-to-tsv --input=trace.bin [--output=trace.txt]
+
+#include "ns3/core-module.h"
+#include "ns3/binary-trace-writer.h"
+
+#include <fstream>
+#include <iostream>
+
+using namespace ns3;
+using namespace std;
+
+int main (int argc, char**argv)
+{
+  string input = "";
+  string output = "-";
+
+  CommandLine cmd;
+  cmd.AddValue ("input", "Binary trace file", input);
+  cmd.AddValue ("output", "Output text file (- for standard output)", output);
+  cmd.Parse (argc, argv);
+
+  if (input == "")
+    {
+      cerr << "--input should be specified" << endl;
+      return 1;
+    }
+
+  ifstream is (input.c_str (), ios_base::in | ios_base::binary);
+  if (!is.is_open ())
+    {
+      cerr << "Cannot open " << input << endl;
+      return 1;
+    }
+
+  bool ok;
+  if (output == "-")
+    {
+      ok = BinaryTraceWriter::ConvertToTsv (is, cout);
+    }
+  else
+    {
+      ofstream os (output.c_str (), ios_base::out | ios_base::trunc);
+      if (!os.is_open ())
+        {
+          cerr << "Cannot open " << output << endl;
+          return 1;
+        }
+      ok = BinaryTraceWriter::ConvertToTsv (is, os);
+    }
+
+  if (!ok)
+    {
+      cerr << input << " is not a valid binary trace" << endl;
+      return 1;
+    }
+
+  return 0;
+}
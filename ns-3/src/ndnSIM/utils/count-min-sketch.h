@@ -0,0 +1,151 @@
+/* -*- Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef COUNT_MIN_SKETCH_H_
+#define COUNT_MIN_SKETCH_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <stdint.h>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+/**
+ * @brief Approximate frequency counter (count-min sketch with 4-bit counters and aging)
+ *
+ * The sketch has 4 rows of 4-bit saturating counters, 16 counters are packed into one 64-bit
+ * word.  Row width is the smallest power of two not less than the requested number of tracked
+ * items, so the sketch takes about 2 bytes per item.
+ *
+ * After the number of increments reaches 10 times the number of tracked items, all counters
+ * are halved, so the estimate reflects recent popularity (as in TinyLFU).
+ */
+class count_min_sketch
+{
+public:
+  count_min_sketch ()
+    : m_mask (0)
+    , m_additions (0)
+    , m_sampleSize (0)
+  {
+    resize (0);
+  }
+
+  /**
+   * @brief Reset the sketch and size it for the specified number of tracked items
+   */
+  void
+  resize (size_t items)
+  {
+    size_t width = 16;
+    while (width < items)
+      width <<= 1;
+
+    m_mask = width - 1;
+    m_table.assign (Depth * width / CountersPerWord, 0);
+    m_additions = 0;
+    m_sampleSize = 10 * std::max<size_t> (items, 1);
+  }
+
+  /**
+   * @brief Increment frequency of the item with the specified hash
+   */
+  void
+  increment (size_t hash)
+  {
+    bool added = false;
+    for (size_t row = 0; row < Depth; row++)
+      {
+        size_t index = counter_index (row, hash);
+        uint64_t &word = m_table[index / CountersPerWord];
+        size_t shift = (index % CountersPerWord) * 4;
+        if (((word >> shift) & 0xf) != 0xf)
+          {
+            word += static_cast<uint64_t> (1) << shift;
+            added = true;
+          }
+      }
+
+    if (added && ++m_additions >= m_sampleSize)
+      reset ();
+  }
+
+  /**
+   * @brief Get estimated frequency of the item with the specified hash
+   */
+  uint32_t
+  estimate (size_t hash) const
+  {
+    uint32_t frequency = 0xf;
+    for (size_t row = 0; row < Depth; row++)
+      {
+        size_t index = counter_index (row, hash);
+        uint32_t counter = (m_table[index / CountersPerWord] >> ((index % CountersPerWord) * 4)) & 0xf;
+        frequency = std::min (frequency, counter);
+      }
+    return frequency;
+  }
+
+  /**
+   * @brief Get memory occupied by the counters (in bytes)
+   */
+  size_t
+  memory () const
+  {
+    return m_table.size () * sizeof (uint64_t);
+  }
+
+private:
+  enum { Depth = 4, CountersPerWord = 16 };
+
+  size_t
+  counter_index (size_t row, size_t hash) const
+  {
+    // 64-bit finalizer from MurmurHash3, seeded differently for each row
+    uint64_t h = static_cast<uint64_t> (hash) + (row + 1) * 0x9e3779b97f4a7c15ULL;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return row * (m_mask + 1) + (static_cast<size_t> (h) & m_mask);
+  }
+
+  void
+  reset ()
+  {
+    // halve all counters at once: shift the word and drop bits that moved into the neighbor counter
+    for (std::vector<uint64_t>::iterator word = m_table.begin (); word != m_table.end (); word++)
+      *word = (*word >> 1) & 0x7777777777777777ULL;
+    m_additions /= 2;
+  }
+
+private:
+  std::vector<uint64_t> m_table;
+  size_t m_mask;
+  size_t m_additions;
+  size_t m_sampleSize;
+};
+
+} // ndnSIM
+} // ndn
+} // ns3
+
+#endif // COUNT_MIN_SKETCH_H_
@@ -23,6 +23,7 @@
 #include "ns3/log.h"
 #include "ns3/simulator.h"
 #include "ns3/random-variable.h"
+#include "ns3/boolean.h"
 #include "ns3/ndn-face.h"
 #include "ns3/node.h"
 
@@ -46,6 +47,11 @@ LimitsRate::GetTypeId ()
                    MakeTimeAccessor (&LimitsRate::m_leakRandomizationInteral),
                    MakeTimeChecker ())
 
+    .AddAttribute ("LazyLeak", "Calculate token bucket level on demand, instead of leaking it with periodic events",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&LimitsRate::m_lazyLeak),
+                   MakeBooleanChecker ())
+
     ;
   return tid;
 }
@@ -63,7 +69,11 @@ LimitsRate::NotifyNewAggregate ()
 
           m_isLeakScheduled = true;
 
-          if (!m_leakRandomizationInteral.IsZero ())
+          if (m_lazyLeak)
+            {
+              m_lastLeak = Simulator::Now ();
+            }
+          else if (!m_leakRandomizationInteral.IsZero ())
             {
               UniformVariable r (0.0, m_leakRandomizationInteral.ToDouble (Time::S));
               Simulator::ScheduleWithContext (GetObject<Face> ()->GetNode ()->GetId (),
@@ -79,9 +89,19 @@ LimitsRate::NotifyNewAggregate ()
     }
 }
 
+void
+LimitsRate::DoDispose ()
+{
+  m_slotEvent.Cancel ();
+  super::DoDispose ();
+}
+
 void
 LimitsRate::SetLimits (double rate, double delay)
 {
+  if (m_lazyLeak)
+    UpdateBucket ();
+
   super::SetLimits (rate, delay);
 
   // maximum allowed burst
@@ -89,6 +109,12 @@ LimitsRate::SetLimits (double rate, double delay)
 
   // amount of packets allowed every second (leak rate)
   m_bucketLeak = GetMaxRate ();
+
+  if (m_slotEvent.IsRunning ())
+    {
+      m_slotEvent.Cancel ();
+      ScheduleAvailableSlot ();
+    }
 }
 
 
@@ -97,8 +123,17 @@ LimitsRate::UpdateCurrentLimit (double limit)
 {
   NS_ASSERT_MSG (limit >= 0.0, "Limit should be greater or equal to zero");
 
+  if (m_lazyLeak)
+    UpdateBucket ();
+
   m_bucketLeak = std::min (limit, GetMaxRate ());
   m_bucketMax  = m_bucketLeak * GetMaxDelay ();
+
+  if (m_slotEvent.IsRunning ())
+    {
+      m_slotEvent.Cancel ();
+      ScheduleAvailableSlot ();
+    }
 }
 
 bool
@@ -106,6 +141,18 @@ LimitsRate::IsBelowLimit ()
 {
   if (!IsEnabled ()) return true;
 
+  if (m_lazyLeak)
+    {
+      UpdateBucket ();
+      if (m_bucketMax - m_bucket < 1.0)
+        {
+          if (!m_slotEvent.IsRunning () && IsAvailableSlotCallbackSet ())
+            ScheduleAvailableSlot ();
+          return false;
+        }
+      return true;
+    }
+
   return (m_bucketMax - m_bucket >= 1.0);
 }
 
@@ -114,6 +161,9 @@ LimitsRate::BorrowLimit ()
 {
   if (!IsEnabled ()) return;
 
+  if (m_lazyLeak)
+    UpdateBucket ();
+
   NS_ASSERT_MSG (m_bucketMax - m_bucket >= 1.0, "Should not be possible, unless we IsBelowLimit was not checked correctly");
   m_bucket += 1;
 }
@@ -156,5 +206,41 @@ LimitsRate::LeakBucket (double interval)
   Simulator::Schedule (Seconds (newInterval), &LimitsRate::LeakBucket, this, newInterval);
 }
 
+void
+LimitsRate::UpdateBucket ()
+{
+  Time now = Simulator::Now ();
+  m_bucket = std::max (0.0, m_bucket - m_bucketLeak * (now - m_lastLeak).ToDouble (Time::S));
+  m_lastLeak = now;
+}
+
+void
+LimitsRate::ScheduleAvailableSlot ()
+{
+  // limit will never be available (and will be rescheduled if limits are updated)
+  if (m_bucketLeak <= 0.0 || m_bucketMax < 1.0)
+    return;
+
+  double excess = std::max (0.0, m_bucket - (m_bucketMax - 1.0));
+
+  // round up to the next time step, so the token is available when the event fires
+  m_slotEvent = Simulator::Schedule (Seconds (excess / m_bucketLeak) + TimeStep (1),
+                                     &LimitsRate::AvailableSlot, this);
+}
+
+void
+LimitsRate::AvailableSlot ()
+{
+  UpdateBucket ();
+  if (m_bucketMax - m_bucket >= 1.0)
+    {
+      this->FireAvailableSlotCallback ();
+    }
+  else
+    {
+      ScheduleAvailableSlot ();
+    }
+}
+
 } // namespace ndn
 } // namespace ns3
@@ -23,6 +23,7 @@
 
 #include "ndn-limits.h"
 #include <ns3/nstime.h>
+#include <ns3/event-id.h>
 
 namespace ns3 {
 namespace ndn {
@@ -30,6 +31,11 @@ namespace ndn {
 /**
  * \ingroup ndn-fw
  * \brief Structure to manage limits for outstanding interests
+ *
+ * By default, token bucket is leaked by a periodic event (every 1.001/rate seconds).  If
+ * LazyLeak attribute is set, the bucket level is instead calculated from the time of the last
+ * update whenever the limit is checked or borrowed, and the only scheduled event is the one
+ * that fires the available slot callback after the limit was found exhausted.
  */
 class LimitsRate :
     public Limits
@@ -46,6 +52,7 @@ public:
    */
   LimitsRate ()
     : m_isLeakScheduled (false)
+    , m_lazyLeak (false)
     , m_bucketMax (0)
     , m_bucketLeak (1)
     , m_bucket (0)
@@ -108,6 +115,9 @@ protected:
   void
   NotifyNewAggregate ();
 
+  virtual void
+  DoDispose ();
+
 private:
   /**
    * @brief Leak bucket, assuming `interval' seconds between leakages
@@ -117,8 +127,29 @@ private:
   void
   LeakBucket (double interval);
 
+  /**
+   * @brief Leak bucket by the amount accumulated since the last update (LazyLeak mode)
+   */
+  void
+  UpdateBucket ();
+
+  /**
+   * @brief Schedule FireAvailableSlotCallback for the time when a token will become available (LazyLeak mode)
+   */
+  void
+  ScheduleAvailableSlot ();
+
+  /**
+   * @brief Fire available slot callback, if token is available (LazyLeak mode)
+   */
+  void
+  AvailableSlot ();
+
 private:
   bool m_isLeakScheduled;
+  bool m_lazyLeak;      ///< \brief Calculate bucket level on demand instead of leaking it periodically
+  Time m_lastLeak;      ///< \brief Time of the last bucket update (LazyLeak mode)
+  EventId m_slotEvent;  ///< \brief Scheduled notification about available slot (LazyLeak mode)
 
   double m_bucketMax;   ///< \brief Maximum Interest allowance for this face (maximum tokens that can be issued at the same time)
   double m_bucketLeak;  ///< \brief Normalized amount that should be leaked every second (token bucket leak rate)
@@ -184,6 +184,15 @@ public:
 protected:
   void
   FireAvailableSlotCallback ();
+
+  /**
+   * @brief Check whether somebody is waiting for FireAvailableSlotCallback
+   */
+  bool
+  IsAvailableSlotCallbackSet () const
+  {
+    return !m_handler.IsNull ();
+  }
   
 private:
   double m_maxRate;
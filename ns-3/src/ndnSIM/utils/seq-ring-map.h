@@ -0,0 +1,178 @@
+/* -*- Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef SEQ_RING_MAP_H_
+#define SEQ_RING_MAP_H_
+
+#include <boost/unordered_map.hpp>
+
+#include <cstddef>
+#include <stdint.h>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+/**
+ * @brief Map from sequence numbers to values, optimized for a sliding window of sequence numbers
+ *
+ * Values are stored in a power-of-two ring, indexed by sequence number modulo ring size, so for
+ * consumers that request (mostly) consecutive sequence numbers every operation is one or two array
+ * accesses.  Sequence number that collides with an occupied slot goes to the fallback hash table
+ * (e.g., random sequence numbers of Zipf-Mandelbrot consumer), unless the ring is at least half
+ * full, in which case the ring is doubled (up to MaxRingSize slots).
+ *
+ * Pointers returned by find and insert are invalidated by the following insert or erase.
+ */
+template<class T, size_t MaxRingSize = 65536>
+class seq_ring_map
+{
+public:
+  seq_ring_map ()
+    : m_ringSize (0)
+  {
+    m_ring.resize (16);
+  }
+
+  /**
+   * @brief Number of stored values (in the ring and in the fallback table)
+   */
+  size_t
+  size () const
+  {
+    return m_ringSize + m_overflow.size ();
+  }
+
+  bool
+  empty () const
+  {
+    return size () == 0;
+  }
+
+  /**
+   * @brief Find value for the sequence number
+   * @returns pointer to the value or 0, if there is no value for the sequence number
+   */
+  T *
+  find (uint32_t seq)
+  {
+    Slot &slot = m_ring [seq & (m_ring.size () - 1)];
+    if (slot.used && slot.seq == seq)
+      return &slot.value;
+
+    if (m_overflow.empty ())
+      return 0;
+
+    typename overflow_type::iterator item = m_overflow.find (seq);
+    if (item == m_overflow.end ())
+      return 0;
+    return &item->second;
+  }
+
+  /**
+   * @brief Find value for the sequence number or insert a default-constructed value
+   */
+  T &
+  insert (uint32_t seq)
+  {
+    T *existing = find (seq);
+    if (existing != 0)
+      return *existing;
+
+    Slot *slot = &m_ring [seq & (m_ring.size () - 1)];
+    if (slot->used && m_ringSize * 2 >= m_ring.size () && m_ring.size () < MaxRingSize)
+      {
+        grow ();
+        slot = &m_ring [seq & (m_ring.size () - 1)];
+      }
+
+    if (slot->used)
+      return m_overflow [seq];
+
+    slot->used = true;
+    slot->seq = seq;
+    slot->value = T ();
+    m_ringSize ++;
+    return slot->value;
+  }
+
+  /**
+   * @brief Erase value for the sequence number (if any)
+   */
+  void
+  erase (uint32_t seq)
+  {
+    Slot &slot = m_ring [seq & (m_ring.size () - 1)];
+    if (slot.used && slot.seq == seq)
+      {
+        slot.used = false;
+        m_ringSize --;
+      }
+    else if (!m_overflow.empty ())
+      {
+        m_overflow.erase (seq);
+      }
+  }
+
+  void
+  clear ()
+  {
+    for (typename std::vector<Slot>::iterator slot = m_ring.begin (); slot != m_ring.end (); slot++)
+      slot->used = false;
+    m_ringSize = 0;
+    m_overflow.clear ();
+  }
+
+private:
+  void
+  grow ()
+  {
+    // each slot of the old ring maps to a distinct slot of the doubled ring
+    std::vector<Slot> old (m_ring.size () * 2);
+    old.swap (m_ring);
+
+    for (typename std::vector<Slot>::iterator slot = old.begin (); slot != old.end (); slot++)
+      {
+        if (slot->used)
+          m_ring [slot->seq & (m_ring.size () - 1)] = *slot;
+      }
+  }
+
+private:
+  struct Slot
+  {
+    Slot () : used (false), seq (0) { }
+
+    bool used;
+    uint32_t seq;
+    T value;
+  };
+
+  typedef boost::unordered_map<uint32_t, T> overflow_type;
+
+  std::vector<Slot> m_ring;
+  size_t m_ringSize;
+  overflow_type m_overflow;
+};
+
+} // namespace ndnSIM
+} // namespace ndn
+} // namespace ns3
+
+#endif // SEQ_RING_MAP_H_
@@ -0,0 +1,341 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "binary-trace-writer.h"
+
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <iostream>
+
+NS_LOG_COMPONENT_DEFINE ("BinaryTraceWriter");
+
+namespace ns3 {
+
+static const char s_magic[8] = { 'N', 'D', 'N', 'T', 'R', 'A', 'C', 'E' };
+static const uint32_t s_version = 1;
+
+static const char RECORD_TAG = 'R';
+static const char STRING_TAG = 'S';
+
+boost::shared_ptr<BinaryTraceWriter>
+BinaryTraceWriter::Open (const std::string &file, size_t bufferSize/* = 1024 * 1024*/)
+{
+  boost::shared_ptr<BinaryTraceWriter> writer (new BinaryTraceWriter (bufferSize));
+  writer->m_os.open (file.c_str (), std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+  if (!writer->m_os.is_open ())
+    {
+      NS_LOG_ERROR ("File " << file << " cannot be opened for writing");
+      return boost::shared_ptr<BinaryTraceWriter> ();
+    }
+
+  return writer;
+}
+
+template<class T>
+static inline void
+NullDeleter (T *ptr)
+{
+}
+
+bool
+BinaryTraceWriter::OpenTrace (const std::string &file,
+                              boost::shared_ptr<std::ostream> &os, boost::shared_ptr<BinaryTraceWriter> &writer)
+{
+  os.reset ();
+  writer.reset ();
+
+  if (IsBinaryFile (file))
+    {
+      writer = Open (file);
+    }
+  else if (file != "-")
+    {
+      boost::shared_ptr<std::ofstream> fileStream (new std::ofstream ());
+      fileStream->open (file.c_str (), std::ios_base::out | std::ios_base::trunc);
+      if (fileStream->is_open ())
+        os = fileStream;
+    }
+  else
+    {
+      os = boost::shared_ptr<std::ostream> (&std::cout, NullDeleter<std::ostream>);
+    }
+
+  if (!os && !writer)
+    {
+      NS_LOG_ERROR ("File " << file << " cannot be opened for writing. Tracing disabled");
+      return false;
+    }
+  return true;
+}
+
+bool
+BinaryTraceWriter::IsBinaryFile (const std::string &file)
+{
+  static const std::string suffix = ".bin";
+  return file.size () > suffix.size () &&
+    file.compare (file.size () - suffix.size (), suffix.size (), suffix) == 0;
+}
+
+BinaryTraceWriter::BinaryTraceWriter (size_t bufferSize)
+  : m_buffer (std::max<size_t> (bufferSize, 4096))
+  , m_size (0)
+  , m_recordSize (0)
+  , m_recordEnd (0)
+  , m_schemaWritten (false)
+{
+}
+
+BinaryTraceWriter::~BinaryTraceWriter ()
+{
+  if (!m_schemaWritten)
+    WriteSchema (); // even empty trace should have the schema
+  Flush ();
+}
+
+void
+BinaryTraceWriter::AddColumn (const std::string &name, ColumnType type)
+{
+  NS_ASSERT_MSG (!m_schemaWritten, "Columns should be added before anything is written");
+
+  m_columns.push_back (std::make_pair (name, type));
+  m_recordSize += (type == DOUBLE || type == UINT64) ? sizeof (uint64_t) : sizeof (uint32_t);
+}
+
+void
+BinaryTraceWriter::WriteSchema ()
+{
+  std::string schema (s_magic, sizeof (s_magic));
+  schema.append (reinterpret_cast<const char*> (&s_version), sizeof (s_version));
+
+  uint32_t count = m_columns.size ();
+  schema.append (reinterpret_cast<const char*> (&count), sizeof (count));
+  for (std::vector<std::pair<std::string, ColumnType> >::iterator column = m_columns.begin ();
+       column != m_columns.end ();
+       column++)
+    {
+      uint8_t type = column->second;
+      uint32_t length = column->first.size ();
+      schema.append (reinterpret_cast<const char*> (&type), sizeof (type));
+      schema.append (reinterpret_cast<const char*> (&length), sizeof (length));
+      schema.append (column->first);
+    }
+
+  m_schemaWritten = true;
+  m_os.write (schema.data (), schema.size ());
+}
+
+uint32_t
+BinaryTraceWriter::Intern (const std::string &value)
+{
+  NS_ASSERT_MSG (m_size == m_recordEnd, "Strings cannot be added in the middle of a record");
+
+  std::pair<boost::unordered_map<std::string, uint32_t>::iterator, bool> item =
+    m_strings.insert (std::make_pair (value, m_strings.size ()));
+  if (!item.second)
+    return item.first->second;
+
+  if (!m_schemaWritten)
+    WriteSchema ();
+
+  uint32_t id = item.first->second;
+  uint32_t length = value.size ();
+  size_t size = 1 + sizeof (id) + sizeof (length) + length;
+
+  Reserve (size);
+  if (size > m_buffer.size ())
+    {
+      // too large for the buffer, write directly
+      m_os.put (STRING_TAG);
+      m_os.write (reinterpret_cast<const char*> (&id), sizeof (id));
+      m_os.write (reinterpret_cast<const char*> (&length), sizeof (length));
+      m_os.write (value.data (), length);
+      return id;
+    }
+
+  m_buffer[m_size ++] = STRING_TAG;
+  std::memcpy (&m_buffer[m_size], &id, sizeof (id));
+  m_size += sizeof (id);
+  std::memcpy (&m_buffer[m_size], &length, sizeof (length));
+  m_size += sizeof (length);
+  std::memcpy (&m_buffer[m_size], value.data (), length);
+  m_size += length;
+
+  m_recordEnd = m_size;
+  return id;
+}
+
+void
+BinaryTraceWriter::Flush ()
+{
+  NS_ASSERT_MSG (m_size == m_recordEnd, "Cannot flush in the middle of a record");
+
+  m_os.write (&m_buffer[0], m_size);
+  m_os.flush ();
+  m_size = 0;
+  m_recordEnd = 0;
+}
+
+template<class T>
+static inline bool
+ReadValue (std::istream &is, T &value)
+{
+  return !is.read (reinterpret_cast<char*> (&value), sizeof (value)).fail ();
+}
+
+// length comes from the file: read in chunks, so a corrupted length fails at the end of input
+// instead of allocating an arbitrary amount of memory
+static bool
+ReadString (std::istream &is, uint32_t length, std::string &value)
+{
+  value.clear ();
+  char buffer[4096];
+  while (length > 0)
+    {
+      uint32_t chunk = std::min<uint32_t> (length, sizeof (buffer));
+      if (!is.read (buffer, chunk))
+        return false;
+      value.append (buffer, chunk);
+      length -= chunk;
+    }
+  return true;
+}
+
+bool
+BinaryTraceWriter::ConvertToTsv (std::istream &is, std::ostream &os)
+{
+  char magic[sizeof (s_magic)];
+  uint32_t version = 0;
+  if (!is.read (magic, sizeof (magic)) || std::memcmp (magic, s_magic, sizeof (s_magic)) != 0 ||
+      !ReadValue (is, version) || version != s_version)
+    {
+      NS_LOG_ERROR ("Input is not a binary trace file");
+      return false;
+    }
+
+  uint32_t count = 0;
+  if (!ReadValue (is, count))
+    return false;
+
+  // count comes from the file as well: columns are added one by one for the same reason as in
+  // ReadString
+  std::vector<uint8_t> types;
+  for (uint32_t i = 0; i < count; i++)
+    {
+      uint8_t type = 0;
+      uint32_t length = 0;
+      if (!ReadValue (is, type) || !ReadValue (is, length))
+        return false;
+      types.push_back (type);
+
+      std::string name;
+      if (!ReadString (is, length, name))
+        return false;
+
+      os << (i > 0 ? "\t" : "") << name;
+    }
+  os << "\n";
+
+  std::vector<std::string> strings;
+  char tag;
+  while (is.get (tag))
+    {
+      if (tag == STRING_TAG)
+        {
+          uint32_t id = 0, length = 0;
+          if (!ReadValue (is, id) || !ReadValue (is, length))
+            return false;
+
+          // strings are interned with sequential IDs
+          if (id != strings.size ())
+            {
+              NS_LOG_ERROR ("Unexpected string ID " << id << " (expected " << strings.size () << ")");
+              return false;
+            }
+
+          strings.push_back (std::string ());
+          if (!ReadString (is, length, strings.back ()))
+            return false;
+        }
+      else if (tag == RECORD_TAG)
+        {
+          for (uint32_t i = 0; i < count; i++)
+            {
+              if (i > 0)
+                os << "\t";
+
+              switch (types[i])
+                {
+                case DOUBLE:
+                  {
+                    double value;
+                    if (!ReadValue (is, value))
+                      return false;
+                    os << value;
+                    break;
+                  }
+                case INT32:
+                  {
+                    int32_t value;
+                    if (!ReadValue (is, value))
+                      return false;
+                    os << value;
+                    break;
+                  }
+                case UINT32:
+                  {
+                    uint32_t value;
+                    if (!ReadValue (is, value))
+                      return false;
+                    os << value;
+                    break;
+                  }
+                case UINT64:
+                  {
+                    uint64_t value;
+                    if (!ReadValue (is, value))
+                      return false;
+                    os << value;
+                    break;
+                  }
+                case STRING:
+                  {
+                    uint32_t id;
+                    if (!ReadValue (is, id) || id >= strings.size ())
+                      return false;
+                    os << strings[id];
+                    break;
+                  }
+                default:
+                  NS_LOG_ERROR ("Unknown column type " << static_cast<int> (types[i]));
+                  return false;
+                }
+            }
+          os << "\n";
+        }
+      else
+        {
+          NS_LOG_ERROR ("Corrupted binary trace file");
+          return false;
+        }
+    }
+
+  return true;
+}
+
+} // namespace ns3
@@ -25,6 +25,7 @@
 #include "ns3/callback.h"
 #include "ns3/simulator.h"
 #include "ns3/node-list.h"
+#include "ndn-trace-output.h"
 #include "ns3/node.h"
 #include "ns3/log.h"
 
@@ -40,12 +41,6 @@ namespace ns3 {
 
 static std::list< boost::tuple< boost::shared_ptr<std::ostream>, std::list<Ptr<L2RateTracer> > > > g_tracers;
 
-template<class T>
-static inline void
-NullDeleter (T *ptr)
-{
-}
-
 void
 L2RateTracer::Destroy ()
 {
@@ -55,45 +50,33 @@ L2RateTracer::Destroy ()
 void
 L2RateTracer::InstallAll (const std::string &file, Time averagingPeriod/* = Seconds (0.5)*/)
 {
-  std::list<Ptr<L2RateTracer> > tracers;
-  boost::shared_ptr<std::ostream> outputStream;
-  if (file != "-")
-    {
-      boost::shared_ptr<std::ofstream> os (new std::ofstream ());
-      os->open (file.c_str (), std::ios_base::out | std::ios_base::trunc);
-
-      if (!os->is_open ())
-        {
-          NS_LOG_ERROR ("File " << file << " cannot be opened for writing. Tracing disabled");
-          return;
-        }
-
-      outputStream = os;
-    }
-  else
-    {
-      outputStream = boost::shared_ptr<std::ostream> (&std::cout, NullDeleter<std::ostream>);
-    }
+  ndn::TraceOutput output;
+  if (!output.Open (file, NodeContainer::GetGlobal ()))
+    return;
+  if (output.m_writer)
+    DeclareColumns (*output.m_writer);
 
-  for (NodeList::Iterator node = NodeList::Begin ();
-       node != NodeList::End ();
+  std::list<Ptr<L2RateTracer> > tracers;
+  for (NodeContainer::Iterator node = output.m_nodes.Begin ();
+       node != output.m_nodes.End ();
        node++)
     {
       NS_LOG_DEBUG ("Node: " << lexical_cast<string> ((*node)->GetId ()));
 
-      Ptr<L2RateTracer> trace = Create<L2RateTracer> (outputStream, *node);
+      Ptr<L2RateTracer> trace = output.m_writer ?
+        Create<L2RateTracer> (output.m_writer, *node) : Create<L2RateTracer> (output.m_os, *node);
       trace->SetAveragingPeriod (averagingPeriod);
       tracers.push_back (trace);
     }
 
-  if (tracers.size () > 0)
+  if (tracers.size () > 0 && output.m_os)
     {
       // *m_l3RateTrace << "# "; // not necessary for R's read.table
-      tracers.front ()->PrintHeader (*outputStream);
-      *outputStream << "\n";
+      tracers.front ()->PrintHeader (*output.m_os);
+      *output.m_os << "\n";
     }
 
-  g_tracers.push_back (boost::make_tuple (outputStream, tracers));
+  g_tracers.push_back (boost::make_tuple (output.m_os, tracers));
 }
 
 
@@ -104,6 +87,16 @@ L2RateTracer::L2RateTracer (boost::shared_ptr<std::ostream> os, Ptr<Node> node)
   SetAveragingPeriod (Seconds (1.0));
 }
 
+L2RateTracer::L2RateTracer (boost::shared_ptr<BinaryTraceWriter> writer, Ptr<Node> node)
+  : L2Tracer (node)
+  , m_writer (writer)
+{
+  m_nodeString = m_writer->Intern (m_node);
+  m_combinedString = m_writer->Intern ("combined");
+  m_dropString = m_writer->Intern ("Drop");
+  SetAveragingPeriod (Seconds (1.0));
+}
+
 L2RateTracer::~L2RateTracer ()
 {
   m_printEvent.Cancel ();
@@ -120,7 +113,10 @@ L2RateTracer::SetAveragingPeriod (const Time &period)
 void
 L2RateTracer::PeriodicPrinter ()
 {
-  Print (*m_os);
+  if (m_writer)
+    Write (*m_writer);
+  else
+    Print (*m_os);
   Reset ();
 
   m_printEvent = Simulator::Schedule (m_period, &L2RateTracer::PeriodicPrinter, this);
@@ -141,6 +137,21 @@ L2RateTracer::PrintHeader (std::ostream &os) const
      << "KilobytesRaw";
 }
 
+void
+L2RateTracer::DeclareColumns (BinaryTraceWriter &writer)
+{
+  writer.AddColumn ("Time",         BinaryTraceWriter::DOUBLE);
+
+  writer.AddColumn ("Node",         BinaryTraceWriter::STRING);
+  writer.AddColumn ("Interface",    BinaryTraceWriter::STRING);
+
+  writer.AddColumn ("Type",         BinaryTraceWriter::STRING);
+  writer.AddColumn ("Packets",      BinaryTraceWriter::UINT64);
+  writer.AddColumn ("Kilobytes",    BinaryTraceWriter::UINT64);
+  writer.AddColumn ("PacketsRaw",   BinaryTraceWriter::UINT64);
+  writer.AddColumn ("KilobytesRaw", BinaryTraceWriter::DOUBLE);
+}
+
 void
 L2RateTracer::Reset ()
 {
@@ -153,9 +164,12 @@ const double alpha = 0.8;
 #define STATS(INDEX) m_stats.get<INDEX> ()
 #define RATE(INDEX, fieldName) STATS(INDEX).fieldName / m_period.ToDouble (Time::S)
 
-#define PRINTER(printName, fieldName, interface)                        \
+#define UPDATE_RATE(fieldName)                                          \
 STATS(2).fieldName = /*new value*/alpha * RATE(0, fieldName) + /*old value*/(1-alpha) * STATS(2).fieldName; \
-STATS(3).fieldName = /*new value*/alpha * RATE(1, fieldName) / 1024.0 + /*old value*/(1-alpha) * STATS(3).fieldName; \
+STATS(3).fieldName = /*new value*/alpha * RATE(1, fieldName) / 1024.0 + /*old value*/(1-alpha) * STATS(3).fieldName;
+
+#define PRINTER(printName, fieldName, interface)                        \
+UPDATE_RATE(fieldName)                                                  \
                                                                         \
  os << time.ToDouble (Time::S) << "\t"                                  \
  << m_node << "\t"                                                      \
@@ -174,6 +188,28 @@ L2RateTracer::Print (std::ostream &os) const
   PRINTER ("Drop", m_drop, "combined");
 }
 
+#define WRITER(typeString, fieldName, interfaceString)                  \
+UPDATE_RATE(fieldName)                                                  \
+{                                                                       \
+  writer.BeginRecord ();                                                \
+  writer.PutDouble (time.ToDouble (Time::S));                           \
+  writer.PutString (m_nodeString);                                      \
+  writer.PutString (interfaceString);                                   \
+  writer.PutString (typeString);                                        \
+  writer.PutUint64 (STATS(2).fieldName);                                \
+  writer.PutUint64 (STATS(3).fieldName);                                \
+  writer.PutUint64 (STATS(0).fieldName);                                \
+  writer.PutDouble (STATS(1).fieldName / 1024.0);                       \
+}
+
+void
+L2RateTracer::Write (BinaryTraceWriter &writer) const
+{
+  Time time = Simulator::Now ();
+
+  WRITER (m_dropString, m_drop, m_combinedString);
+}
+
 void
 L2RateTracer::Drop (Ptr<const Packet> packet)
 {
@@ -22,6 +22,7 @@
 #define L2_RATE_TRACER_H
 
 #include "l2-tracer.h"
+#include "binary-trace-writer.h"
 
 #include "ns3/nstime.h"
 #include "ns3/event-id.h"
@@ -45,6 +46,12 @@ public:
    * @brief Network layer tracer constructor
    */
   L2RateTracer (boost::shared_ptr<std::ostream> os, Ptr<Node> node);
+
+  /**
+   * @brief Network layer tracer constructor, writing binary trace
+   */
+  L2RateTracer (boost::shared_ptr<BinaryTraceWriter> writer, Ptr<Node> node);
+
   virtual ~L2RateTracer ();
 
   /**
@@ -79,6 +86,18 @@ public:
   virtual void
   Print (std::ostream &os) const;
 
+  /**
+   * @brief Write current trace data into binary trace
+   */
+  void
+  Write (BinaryTraceWriter &writer) const;
+
+  /**
+   * @brief Add columns of the trace to the schema of binary trace
+   */
+  static void
+  DeclareColumns (BinaryTraceWriter &writer);
+
   virtual void
   Drop (Ptr<const Packet>);
 
@@ -91,6 +110,10 @@ private:
 
 private:
   boost::shared_ptr<std::ostream> m_os;
+  boost::shared_ptr<BinaryTraceWriter> m_writer;
+  uint32_t m_nodeString;
+  uint32_t m_combinedString;
+  uint32_t m_dropString;
   Time m_period;
   EventId m_printEvent;
 
@@ -30,6 +30,7 @@
 #include "ns3/ndn-data.h"
 #include "ns3/simulator.h"
 #include "ns3/node-list.h"
+#include "ndn-trace-output.h"
 #include "ns3/log.h"
 
 #include <boost/lexical_cast.hpp>
@@ -46,12 +47,6 @@ namespace ndn {
 
 static std::list< boost::tuple< boost::shared_ptr<std::ostream>, std::list<Ptr<AppDelayTracer> > > > g_tracers;
 
-template<class T>
-static inline void
-NullDeleter (T *ptr)
-{
-}
-
 void
 AppDelayTracer::Destroy ()
 {
@@ -61,138 +56,63 @@ AppDelayTracer::Destroy ()
 void
 AppDelayTracer::InstallAll (const std::string &file)
 {
-  using namespace boost;
-  using namespace std;
-
-  std::list<Ptr<AppDelayTracer> > tracers;
-  boost::shared_ptr<std::ostream> outputStream;
-  if (file != "-")
-    {
-      boost::shared_ptr<std::ofstream> os (new std::ofstream ());
-      os->open (file.c_str (), std::ios_base::out | std::ios_base::trunc);
-
-      if (!os->is_open ())
-        {
-          NS_LOG_ERROR ("File " << file << " cannot be opened for writing. Tracing disabled");
-          return;
-        }
-
-      outputStream = os;
-    }
-  else
-    {
-      outputStream = boost::shared_ptr<std::ostream> (&std::cout, NullDeleter<std::ostream>);
-    }
-
-  for (NodeList::Iterator node = NodeList::Begin ();
-       node != NodeList::End ();
-       node++)
-    {
-      Ptr<AppDelayTracer> trace = Install (*node, outputStream);
-      tracers.push_back (trace);
-    }
-
-  if (tracers.size () > 0)
-    {
-      // *m_l3RateTrace << "# "; // not necessary for R's read.table
-      tracers.front ()->PrintHeader (*outputStream);
-      *outputStream << "\n";
-    }
-
-  g_tracers.push_back (boost::make_tuple (outputStream, tracers));
+  Install (NodeContainer::GetGlobal (), file);
 }
 
 void
 AppDelayTracer::Install (const NodeContainer &nodes, const std::string &file)
 {
-  using namespace boost;
-  using namespace std;
+  TraceOutput output;
+  if (!output.Open (file, nodes))
+    return;
+  if (output.m_writer)
+    DeclareColumns (*output.m_writer);
 
   std::list<Ptr<AppDelayTracer> > tracers;
-  boost::shared_ptr<std::ostream> outputStream;
-  if (file != "-")
-    {
-      boost::shared_ptr<std::ofstream> os (new std::ofstream ());
-      os->open (file.c_str (), std::ios_base::out | std::ios_base::trunc);
-
-      if (!os->is_open ())
-        {
-          NS_LOG_ERROR ("File " << file << " cannot be opened for writing. Tracing disabled");
-          return;
-        }
-
-      outputStream = os;
-    }
-  else
-    {
-      outputStream = boost::shared_ptr<std::ostream> (&std::cout, NullDeleter<std::ostream>);
-    }
-
-  for (NodeContainer::Iterator node = nodes.Begin ();
-       node != nodes.End ();
+  for (NodeContainer::Iterator node = output.m_nodes.Begin ();
+       node != output.m_nodes.End ();
        node++)
     {
-      Ptr<AppDelayTracer> trace = Install (*node, outputStream);
+      Ptr<AppDelayTracer> trace = output.m_writer ?
+        Install (*node, output.m_writer) : Install (*node, output.m_os);
       tracers.push_back (trace);
     }
 
-  if (tracers.size () > 0)
+  if (tracers.size () > 0 && output.m_os)
     {
       // *m_l3RateTrace << "# "; // not necessary for R's read.table
-      tracers.front ()->PrintHeader (*outputStream);
-      *outputStream << "\n";
+      tracers.front ()->PrintHeader (*output.m_os);
+      *output.m_os << "\n";
     }
 
-  g_tracers.push_back (boost::make_tuple (outputStream, tracers));
+  g_tracers.push_back (boost::make_tuple (output.m_os, tracers));
 }
 
 void
 AppDelayTracer::Install (Ptr<Node> node, const std::string &file)
 {
-  using namespace boost;
-  using namespace std;
-
-  std::list<Ptr<AppDelayTracer> > tracers;
-  boost::shared_ptr<std::ostream> outputStream;
-  if (file != "-")
-    {
-      boost::shared_ptr<std::ofstream> os (new std::ofstream ());
-      os->open (file.c_str (), std::ios_base::out | std::ios_base::trunc);
+  Install (NodeContainer (node), file);
+}
 
-      if (!os->is_open ())
-        {
-          NS_LOG_ERROR ("File " << file << " cannot be opened for writing. Tracing disabled");
-          return;
-        }
 
-      outputStream = os;
-    }
-  else
-    {
-      outputStream = boost::shared_ptr<std::ostream> (&std::cout, NullDeleter<std::ostream>);
-    }
-
-  Ptr<AppDelayTracer> trace = Install (node, outputStream);
-  tracers.push_back (trace);
+Ptr<AppDelayTracer>
+AppDelayTracer::Install (Ptr<Node> node,
+                         boost::shared_ptr<std::ostream> outputStream)
+{
+  NS_LOG_DEBUG ("Node: " << node->GetId ());
 
-  if (tracers.size () > 0)
-    {
-      // *m_l3RateTrace << "# "; // not necessary for R's read.table
-      tracers.front ()->PrintHeader (*outputStream);
-      *outputStream << "\n";
-    }
+  Ptr<AppDelayTracer> trace = Create<AppDelayTracer> (outputStream, node);
 
-  g_tracers.push_back (boost::make_tuple (outputStream, tracers));
+  return trace;
 }
 
-
 Ptr<AppDelayTracer>
 AppDelayTracer::Install (Ptr<Node> node,
-                         boost::shared_ptr<std::ostream> outputStream)
+                         boost::shared_ptr<BinaryTraceWriter> writer)
 {
   NS_LOG_DEBUG ("Node: " << node->GetId ());
 
-  Ptr<AppDelayTracer> trace = Create<AppDelayTracer> (outputStream, node);
+  Ptr<AppDelayTracer> trace = Create<AppDelayTracer> (writer, node);
 
   return trace;
 }
@@ -223,6 +143,25 @@ AppDelayTracer::AppDelayTracer (boost::shared_ptr<std::ostream> os, const std::s
   Connect ();
 }
 
+AppDelayTracer::AppDelayTracer (boost::shared_ptr<BinaryTraceWriter> writer, Ptr<Node> node)
+: m_nodePtr (node)
+, m_writer (writer)
+{
+  m_node = boost::lexical_cast<string> (m_nodePtr->GetId ());
+
+  Connect ();
+
+  string name = Names::FindName (node);
+  if (!name.empty ())
+    {
+      m_node = name;
+    }
+
+  m_nodeString = m_writer->Intern (m_node);
+  m_lastDelayString = m_writer->Intern ("LastDelay");
+  m_fullDelayString = m_writer->Intern ("FullDelay");
+}
+
 AppDelayTracer::~AppDelayTracer ()
 {
 };
@@ -253,9 +192,42 @@ AppDelayTracer::PrintHeader (std::ostream &os) const
      << "HopCount"  << "";
 }
 
+void
+AppDelayTracer::DeclareColumns (BinaryTraceWriter &writer)
+{
+  writer.AddColumn ("Time",      BinaryTraceWriter::DOUBLE);
+  writer.AddColumn ("Node",      BinaryTraceWriter::STRING);
+  writer.AddColumn ("AppId",     BinaryTraceWriter::UINT32);
+  writer.AddColumn ("SeqNo",     BinaryTraceWriter::UINT32);
+
+  writer.AddColumn ("Type",      BinaryTraceWriter::STRING);
+  writer.AddColumn ("DelayS",    BinaryTraceWriter::DOUBLE);
+  writer.AddColumn ("DelayUS",   BinaryTraceWriter::DOUBLE);
+  writer.AddColumn ("RetxCount", BinaryTraceWriter::UINT32);
+  writer.AddColumn ("HopCount",  BinaryTraceWriter::INT32);
+}
+
+#define WRITER(typeString, retxCount)                            \
+  m_writer->BeginRecord ();                                     \
+  m_writer->PutDouble (Simulator::Now ().ToDouble (Time::S));   \
+  m_writer->PutString (m_nodeString);                           \
+  m_writer->PutUint32 (app->GetId ());                          \
+  m_writer->PutUint32 (seqno);                                  \
+  m_writer->PutString (typeString);                             \
+  m_writer->PutDouble (delay.ToDouble (Time::S));               \
+  m_writer->PutDouble (delay.ToDouble (Time::US));              \
+  m_writer->PutUint32 (retxCount);                              \
+  m_writer->PutInt32 (hopCount);
+
 void
 AppDelayTracer::LastRetransmittedInterestDataDelay (Ptr<App> app, uint32_t seqno, Time delay, int32_t hopCount)
 {
+  if (m_writer)
+    {
+      WRITER (m_lastDelayString, 1);
+      return;
+    }
+
   *m_os << Simulator::Now ().ToDouble (Time::S) << "\t"
         << m_node << "\t"
         << app->GetId () << "\t"
@@ -270,6 +242,12 @@ AppDelayTracer::LastRetransmittedInterestDataDelay (Ptr<App> app, uint32_t seqno
 void
 AppDelayTracer::FirstInterestDataDelay (Ptr<App> app, uint32_t seqno, Time delay, uint32_t retxCount, int32_t hopCount)
 {
+  if (m_writer)
+    {
+      WRITER (m_fullDelayString, retxCount);
+      return;
+    }
+
   *m_os << Simulator::Now ().ToDouble (Time::S) << "\t"
         << m_node << "\t"
         << app->GetId () << "\t"
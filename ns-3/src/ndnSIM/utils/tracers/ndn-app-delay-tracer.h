@@ -27,6 +27,8 @@
 #include <ns3/event-id.h>
 #include <ns3/node-container.h>
 
+#include "binary-trace-writer.h"
+
 #include <boost/tuple/tuple.hpp>
 #include <boost/shared_ptr.hpp>
 #include <list>
@@ -99,6 +101,15 @@ public:
   static Ptr<AppDelayTracer>
   Install (Ptr<Node> node, boost::shared_ptr<std::ostream> outputStream);
 
+  /**
+   * @brief Helper method to install tracers on a specific simulation node
+   *
+   * @param nodes Nodes on which to install tracer
+   * @param writer Binary trace writer (should be prepared with DeclareColumns)
+   */
+  static Ptr<AppDelayTracer>
+  Install (Ptr<Node> node, boost::shared_ptr<BinaryTraceWriter> writer);
+
   /**
    * @brief Explicit request to remove all statically created tracers
    *
@@ -122,6 +133,13 @@ public:
    */
   AppDelayTracer (boost::shared_ptr<std::ostream> os, const std::string &node);
 
+  /**
+   * @brief Trace constructor that attaches to all applications on the node and writes binary trace
+   * @param writer    binary trace writer
+   * @param node      pointer to the node
+   */
+  AppDelayTracer (boost::shared_ptr<BinaryTraceWriter> writer, Ptr<Node> node);
+
   /**
    * @brief Destructor
    */
@@ -134,7 +152,15 @@ public:
    */
   void
   PrintHeader (std::ostream &os) const;
-  
+
+  /**
+   * @brief Add columns of the trace to the schema of binary trace
+   *
+   * @param writer binary trace writer
+   */
+  static void
+  DeclareColumns (BinaryTraceWriter &writer);
+
 private:
   void
   Connect ();
@@ -150,6 +176,11 @@ private:
   Ptr<Node> m_nodePtr;
 
   boost::shared_ptr<std::ostream> m_os;
+
+  boost::shared_ptr<BinaryTraceWriter> m_writer;
+  uint32_t m_nodeString;
+  uint32_t m_lastDelayString;
+  uint32_t m_fullDelayString;
 };
 
 } // namespace ndn
@@ -32,6 +32,7 @@
 #include "ns3/ndn-content-store.h"
 #include "ns3/simulator.h"
 #include "ns3/node-list.h"
+#include "ndn-trace-output.h"
 #include "ns3/log.h"
 
 #include <boost/lexical_cast.hpp>
@@ -47,12 +48,6 @@ namespace ndn {
 
 static std::list< boost::tuple< boost::shared_ptr<std::ostream>, std::list<Ptr<CsTracer> > > > g_tracers;
 
-template<class T>
-static inline void
-NullDeleter (T *ptr)
-{
-}
-
 void
 CsTracer::Destroy ()
 {
@@ -62,139 +57,66 @@ CsTracer::Destroy ()
 void
 CsTracer::InstallAll (const std::string &file, Time averagingPeriod/* = Seconds (0.5)*/)
 {
-  using namespace boost;
-  using namespace std;
-  
-  std::list<Ptr<CsTracer> > tracers;
-  boost::shared_ptr<std::ostream> outputStream;
-  if (file != "-")
-    {
-      boost::shared_ptr<std::ofstream> os (new std::ofstream ());
-      os->open (file.c_str (), std::ios_base::out | std::ios_base::trunc);
-
-      if (!os->is_open ())
-        {
-          NS_LOG_ERROR ("File " << file << " cannot be opened for writing. Tracing disabled");
-          return;
-        }
-
-      outputStream = os;
-    }
-  else
-    {
-      outputStream = boost::shared_ptr<std::ostream> (&std::cout, NullDeleter<std::ostream>);
-    }
-
-  for (NodeList::Iterator node = NodeList::Begin ();
-       node != NodeList::End ();
-       node++)
-    {
-      Ptr<CsTracer> trace = Install (*node, outputStream, averagingPeriod);
-      tracers.push_back (trace);
-    }
-
-  if (tracers.size () > 0)
-    {
-      // *m_l3RateTrace << "# "; // not necessary for R's read.table
-      tracers.front ()->PrintHeader (*outputStream);
-      *outputStream << "\n";
-    }
-
-  g_tracers.push_back (boost::make_tuple (outputStream, tracers));
+  Install (NodeContainer::GetGlobal (), file, averagingPeriod);
 }
 
 void
 CsTracer::Install (const NodeContainer &nodes, const std::string &file, Time averagingPeriod/* = Seconds (0.5)*/)
 {
-  using namespace boost;
-  using namespace std;
+  TraceOutput output;
+  if (!output.Open (file, nodes))
+    return;
+  if (output.m_writer)
+    DeclareColumns (*output.m_writer);
 
   std::list<Ptr<CsTracer> > tracers;
-  boost::shared_ptr<std::ostream> outputStream;
-  if (file != "-")
-    {
-      boost::shared_ptr<std::ofstream> os (new std::ofstream ());
-      os->open (file.c_str (), std::ios_base::out | std::ios_base::trunc);
-
-      if (!os->is_open ())
-        {
-          NS_LOG_ERROR ("File " << file << " cannot be opened for writing. Tracing disabled");
-          return;
-        }
-
-      outputStream = os;
-    }
-  else
-    {
-      outputStream = boost::shared_ptr<std::ostream> (&std::cout, NullDeleter<std::ostream>);
-    }
-
-  for (NodeContainer::Iterator node = nodes.Begin ();
-       node != nodes.End ();
+  for (NodeContainer::Iterator node = output.m_nodes.Begin ();
+       node != output.m_nodes.End ();
        node++)
     {
-      Ptr<CsTracer> trace = Install (*node, outputStream, averagingPeriod);
+      Ptr<CsTracer> trace = output.m_writer ?
+        Install (*node, output.m_writer, averagingPeriod) : Install (*node, output.m_os, averagingPeriod);
       tracers.push_back (trace);
     }
 
-  if (tracers.size () > 0)
+  if (tracers.size () > 0 && output.m_os)
     {
       // *m_l3RateTrace << "# "; // not necessary for R's read.table
-      tracers.front ()->PrintHeader (*outputStream);
-      *outputStream << "\n";
+      tracers.front ()->PrintHeader (*output.m_os);
+      *output.m_os << "\n";
     }
 
-  g_tracers.push_back (boost::make_tuple (outputStream, tracers));
+  g_tracers.push_back (boost::make_tuple (output.m_os, tracers));
 }
 
 void
 CsTracer::Install (Ptr<Node> node, const std::string &file, Time averagingPeriod/* = Seconds (0.5)*/)
 {
-  using namespace boost;
-  using namespace std;
-
-  std::list<Ptr<CsTracer> > tracers;
-  boost::shared_ptr<std::ostream> outputStream;
-  if (file != "-")
-    {
-      boost::shared_ptr<std::ofstream> os (new std::ofstream ());
-      os->open (file.c_str (), std::ios_base::out | std::ios_base::trunc);
-
-      if (!os->is_open ())
-        {
-          NS_LOG_ERROR ("File " << file << " cannot be opened for writing. Tracing disabled");
-          return;
-        }
+  Install (NodeContainer (node), file, averagingPeriod);
+}
 
-      outputStream = os;
-    }
-  else
-    {
-      outputStream = boost::shared_ptr<std::ostream> (&std::cout, NullDeleter<std::ostream>);
-    }
 
-  Ptr<CsTracer> trace = Install (node, outputStream, averagingPeriod);
-  tracers.push_back (trace);
+Ptr<CsTracer>
+CsTracer::Install (Ptr<Node> node,
+                   boost::shared_ptr<std::ostream> outputStream,
+                   Time averagingPeriod/* = Seconds (0.5)*/)
+{
+  NS_LOG_DEBUG ("Node: " << node->GetId ());
 
-  if (tracers.size () > 0)
-    {
-      // *m_l3RateTrace << "# "; // not necessary for R's read.table
-      tracers.front ()->PrintHeader (*outputStream);
-      *outputStream << "\n";
-    }
+  Ptr<CsTracer> trace = Create<CsTracer> (outputStream, node);
+  trace->SetAveragingPeriod (averagingPeriod);
 
-  g_tracers.push_back (boost::make_tuple (outputStream, tracers));
+  return trace;
 }
 
-
 Ptr<CsTracer>
 CsTracer::Install (Ptr<Node> node,
-                   boost::shared_ptr<std::ostream> outputStream,
+                   boost::shared_ptr<BinaryTraceWriter> writer,
                    Time averagingPeriod/* = Seconds (0.5)*/)
 {
   NS_LOG_DEBUG ("Node: " << node->GetId ());
 
-  Ptr<CsTracer> trace = Create<CsTracer> (outputStream, node);
+  Ptr<CsTracer> trace = Create<CsTracer> (writer, node);
   trace->SetAveragingPeriod (averagingPeriod);
 
   return trace;
@@ -226,6 +148,25 @@ CsTracer::CsTracer (boost::shared_ptr<std::ostream> os, const std::string &node)
   Connect ();
 }
 
+CsTracer::CsTracer (boost::shared_ptr<BinaryTraceWriter> writer, Ptr<Node> node)
+: m_nodePtr (node)
+, m_writer (writer)
+{
+  m_node = boost::lexical_cast<string> (m_nodePtr->GetId ());
+
+  Connect ();
+
+  string name = Names::FindName (node);
+  if (!name.empty ())
+    {
+      m_node = name;
+    }
+
+  m_nodeString = m_writer->Intern (m_node);
+  m_cacheHitsString = m_writer->Intern ("CacheHits");
+  m_cacheMissesString = m_writer->Intern ("CacheMisses");
+}
+
 CsTracer::~CsTracer ()
 {
 };
@@ -253,7 +194,10 @@ CsTracer::SetAveragingPeriod (const Time &period)
 void
 CsTracer::PeriodicPrinter ()
 {
-  Print (*m_os);
+  if (m_writer)
+    Write (*m_writer);
+  else
+    Print (*m_os);
   Reset ();
   
   m_printEvent = Simulator::Schedule (m_period, &CsTracer::PeriodicPrinter, this);
@@ -270,6 +214,17 @@ CsTracer::PrintHeader (std::ostream &os) const
      << "Packets" << "\t";
 }
 
+void
+CsTracer::DeclareColumns (BinaryTraceWriter &writer)
+{
+  writer.AddColumn ("Time",    BinaryTraceWriter::DOUBLE);
+
+  writer.AddColumn ("Node",    BinaryTraceWriter::STRING);
+
+  writer.AddColumn ("Type",    BinaryTraceWriter::STRING);
+  writer.AddColumn ("Packets", BinaryTraceWriter::DOUBLE);
+}
+
 void
 CsTracer::Reset ()
 {
@@ -292,6 +247,24 @@ CsTracer::Print (std::ostream &os) const
   PRINTER ("CacheMisses", m_cacheMisses);
 }
 
+#define WRITER(typeString, fieldName)                   \
+  {                                                     \
+    writer.BeginRecord ();                              \
+    writer.PutDouble (time.ToDouble (Time::S));         \
+    writer.PutString (m_nodeString);                    \
+    writer.PutString (typeString);                      \
+    writer.PutDouble (m_stats.fieldName);               \
+  }
+
+void
+CsTracer::Write (BinaryTraceWriter &writer) const
+{
+  Time time = Simulator::Now ();
+
+  WRITER (m_cacheHitsString,   m_cacheHits);
+  WRITER (m_cacheMissesString, m_cacheMisses);
+}
+
 void 
 CsTracer::CacheHits (Ptr<const Interest>, Ptr<const Data>)
 {
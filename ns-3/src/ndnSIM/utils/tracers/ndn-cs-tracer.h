@@ -28,6 +28,8 @@
 #include <ns3/event-id.h>
 #include <ns3/node-container.h>
 
+#include "binary-trace-writer.h"
+
 #include <boost/tuple/tuple.hpp>
 #include <boost/shared_ptr.hpp>
 #include <map>
@@ -124,6 +126,16 @@ public:
   static Ptr<CsTracer>
   Install (Ptr<Node> node, boost::shared_ptr<std::ostream> outputStream, Time averagingPeriod = Seconds (0.5));
 
+  /**
+   * @brief Helper method to install tracers on a specific simulation node
+   *
+   * @param nodes Nodes on which to install tracer
+   * @param writer Binary trace writer (should be prepared with DeclareColumns)
+   * @param averagingPeriod How often data will be written into the trace file (default, every half second)
+   */
+  static Ptr<CsTracer>
+  Install (Ptr<Node> node, boost::shared_ptr<BinaryTraceWriter> writer, Time averagingPeriod = Seconds (0.5));
+
   /**
    * @brief Explicit request to remove all statically created tracers
    *
@@ -147,6 +159,13 @@ public:
    */
   CsTracer (boost::shared_ptr<std::ostream> os, const std::string &node);
 
+  /**
+   * @brief Trace constructor that attaches to the node using node pointer and writes binary trace
+   * @param writer    binary trace writer
+   * @param node      pointer to the node
+   */
+  CsTracer (boost::shared_ptr<BinaryTraceWriter> writer, Ptr<Node> node);
+
   /**
    * @brief Destructor
    */
@@ -167,7 +186,23 @@ public:
    */
   void
   Print (std::ostream &os) const;
-  
+
+  /**
+   * @brief Write current trace data into binary trace
+   *
+   * @param writer binary trace writer
+   */
+  void
+  Write (BinaryTraceWriter &writer) const;
+
+  /**
+   * @brief Add columns of the trace to the schema of binary trace
+   *
+   * @param writer binary trace writer
+   */
+  static void
+  DeclareColumns (BinaryTraceWriter &writer);
+
 private:
   void
   Connect ();
@@ -193,6 +228,10 @@ private:
   Ptr<Node> m_nodePtr;
 
   boost::shared_ptr<std::ostream> m_os;
+  boost::shared_ptr<BinaryTraceWriter> m_writer;
+  uint32_t m_nodeString;
+  uint32_t m_cacheHitsString;
+  uint32_t m_cacheMissesString;
 
   Time m_period;
   EventId m_printEvent;
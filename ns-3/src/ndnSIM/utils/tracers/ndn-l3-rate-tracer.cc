@@ -26,6 +26,7 @@
 #include "ns3/simulator.h"
 #include "ns3/log.h"
 #include "ns3/node-list.h"
+#include "ndn-trace-output.h"
 
 #include "ns3/ndn-app.h"
 #include "ns3/ndn-face.h"
@@ -34,6 +35,7 @@
 #include "ns3/ndn-pit-entry.h"
 
 #include <fstream>
+#include <sstream>
 #include <boost/lexical_cast.hpp>
 
 using namespace boost;
@@ -44,13 +46,27 @@ NS_LOG_COMPONENT_DEFINE ("ndn.L3RateTracer");
 namespace ns3 {
 namespace ndn {
 
-static std::list< boost::tuple< boost::shared_ptr<std::ostream>, std::list<Ptr<L3RateTracer> > > > g_tracers;
+// record types of the trace (Type column), indexed by RecordType
+static const char *s_recordTypes[] =
+  {
+    "InInterests",
+    "OutInterests",
+    "DropInterests",
+    "InNacks",
+    "OutNacks",
+    "DropNacks",
+    "InData",
+    "OutData",
+    "DropData",
+    "InSatisfiedInterests",
+    "InTimedOutInterests",
+    "OutSatisfiedInterests",
+    "OutTimedOutInterests",
+    "SatisfiedInterests",
+    "TimedOutInterests"
+  };
 
-template<class T>
-static inline void
-NullDeleter (T *ptr)
-{
-}
+static std::list< boost::tuple< boost::shared_ptr<std::ostream>, std::list<Ptr<L3RateTracer> > > > g_tracers;
 
 void
 L3RateTracer::Destroy ()
@@ -61,125 +77,42 @@ L3RateTracer::Destroy ()
 void
 L3RateTracer::InstallAll (const std::string &file, Time averagingPeriod/* = Seconds (0.5)*/)
 {
-  std::list<Ptr<L3RateTracer> > tracers;
-  boost::shared_ptr<std::ostream> outputStream;
-  if (file != "-")
-    {
-      boost::shared_ptr<std::ofstream> os (new std::ofstream ());
-      os->open (file.c_str (), std::ios_base::out | std::ios_base::trunc);
-
-      if (!os->is_open ())
-        {
-          NS_LOG_ERROR ("File " << file << " cannot be opened for writing. Tracing disabled");
-          return;
-        }
-
-      outputStream = os;
-    }
-  else
-    {
-      outputStream = boost::shared_ptr<std::ostream> (&std::cout, NullDeleter<std::ostream>);
-    }
-
-  for (NodeList::Iterator node = NodeList::Begin ();
-       node != NodeList::End ();
-       node++)
-    {
-      Ptr<L3RateTracer> trace = Install (*node, outputStream, averagingPeriod);
-      tracers.push_back (trace);
-    }
-
-  if (tracers.size () > 0)
-    {
-      // *m_l3RateTrace << "# "; // not necessary for R's read.table
-      tracers.front ()->PrintHeader (*outputStream);
-      *outputStream << "\n";
-    }
-
-  g_tracers.push_back (boost::make_tuple (outputStream, tracers));
+  Install (NodeContainer::GetGlobal (), file, averagingPeriod);
 }
 
 void
 L3RateTracer::Install (const NodeContainer &nodes, const std::string &file, Time averagingPeriod/* = Seconds (0.5)*/)
 {
-  using namespace boost;
-  using namespace std;
+  TraceOutput output;
+  if (!output.Open (file, nodes))
+    return;
+  if (output.m_writer)
+    DeclareColumns (*output.m_writer);
 
   std::list<Ptr<L3RateTracer> > tracers;
-  boost::shared_ptr<std::ostream> outputStream;
-  if (file != "-")
-    {
-      boost::shared_ptr<std::ofstream> os (new std::ofstream ());
-      os->open (file.c_str (), std::ios_base::out | std::ios_base::trunc);
-
-      if (!os->is_open ())
-        {
-          NS_LOG_ERROR ("File " << file << " cannot be opened for writing. Tracing disabled");
-          return;
-        }
-
-      outputStream = os;
-    }
-  else
-    {
-      outputStream = boost::shared_ptr<std::ostream> (&std::cout, NullDeleter<std::ostream>);
-    }
-
-  for (NodeContainer::Iterator node = nodes.Begin ();
-       node != nodes.End ();
+  for (NodeContainer::Iterator node = output.m_nodes.Begin ();
+       node != output.m_nodes.End ();
        node++)
     {
-      Ptr<L3RateTracer> trace = Install (*node, outputStream, averagingPeriod);
+      Ptr<L3RateTracer> trace = output.m_writer ?
+        Install (*node, output.m_writer, averagingPeriod) : Install (*node, output.m_os, averagingPeriod);
       tracers.push_back (trace);
     }
 
-  if (tracers.size () > 0)
+  if (tracers.size () > 0 && output.m_os)
     {
       // *m_l3RateTrace << "# "; // not necessary for R's read.table
-      tracers.front ()->PrintHeader (*outputStream);
-      *outputStream << "\n";
+      tracers.front ()->PrintHeader (*output.m_os);
+      *output.m_os << "\n";
     }
 
-  g_tracers.push_back (boost::make_tuple (outputStream, tracers));
+  g_tracers.push_back (boost::make_tuple (output.m_os, tracers));
 }
 
 void
 L3RateTracer::Install (Ptr<Node> node, const std::string &file, Time averagingPeriod/* = Seconds (0.5)*/)
 {
-  using namespace boost;
-  using namespace std;
-
-  std::list<Ptr<L3RateTracer> > tracers;
-  boost::shared_ptr<std::ostream> outputStream;
-  if (file != "-")
-    {
-      boost::shared_ptr<std::ofstream> os (new std::ofstream ());
-      os->open (file.c_str (), std::ios_base::out | std::ios_base::trunc);
-
-      if (!os->is_open ())
-        {
-          NS_LOG_ERROR ("File " << file << " cannot be opened for writing. Tracing disabled");
-          return;
-        }
-
-      outputStream = os;
-    }
-  else
-    {
-      outputStream = boost::shared_ptr<std::ostream> (&std::cout, NullDeleter<std::ostream>);
-    }
-
-  Ptr<L3RateTracer> trace = Install (node, outputStream, averagingPeriod);
-  tracers.push_back (trace);
-
-  if (tracers.size () > 0)
-    {
-      // *m_l3RateTrace << "# "; // not necessary for R's read.table
-      tracers.front ()->PrintHeader (*outputStream);
-      *outputStream << "\n";
-    }
-
-  g_tracers.push_back (boost::make_tuple (outputStream, tracers));
+  Install (NodeContainer (node), file, averagingPeriod);
 }
 
 
@@ -196,10 +129,24 @@ L3RateTracer::Install (Ptr<Node> node,
   return trace;
 }
 
+Ptr<L3RateTracer>
+L3RateTracer::Install (Ptr<Node> node,
+                       boost::shared_ptr<BinaryTraceWriter> writer,
+                       Time averagingPeriod/* = Seconds (0.5)*/)
+{
+  NS_LOG_DEBUG ("Node: " << node->GetId ());
+
+  Ptr<L3RateTracer> trace = Create<L3RateTracer> (writer, node);
+  trace->SetAveragingPeriod (averagingPeriod);
+
+  return trace;
+}
+
 
 L3RateTracer::L3RateTracer (boost::shared_ptr<std::ostream> os, Ptr<Node> node)
   : L3Tracer (node)
   , m_os (os)
+  , m_hasNodeStats (false)
 {
   SetAveragingPeriod (Seconds (1.0));
 }
@@ -207,10 +154,23 @@ L3RateTracer::L3RateTracer (boost::shared_ptr<std::ostream> os, Ptr<Node> node)
 L3RateTracer::L3RateTracer (boost::shared_ptr<std::ostream> os, const std::string &node)
   : L3Tracer (node)
   , m_os (os)
+  , m_hasNodeStats (false)
 {
   SetAveragingPeriod (Seconds (1.0));
 }
 
+L3RateTracer::L3RateTracer (boost::shared_ptr<BinaryTraceWriter> writer, Ptr<Node> node)
+  : L3Tracer (node)
+  , m_writer (writer)
+  , m_hasNodeStats (false)
+{
+  m_nodeString = m_writer->Intern (m_node);
+  m_allFacesString = m_writer->Intern ("all");
+  for (uint32_t type = 0; type < RECORD_TYPES; type++)
+    m_typeStrings[type] = m_writer->Intern (s_recordTypes[type]);
+  SetAveragingPeriod (Seconds (1.0));
+}
+
 L3RateTracer::~L3RateTracer ()
 {
   m_printEvent.Cancel ();
@@ -227,7 +187,10 @@ L3RateTracer::SetAveragingPeriod (const Time &period)
 void
 L3RateTracer::PeriodicPrinter ()
 {
-  Print (*m_os);
+  if (m_writer)
+    Write (*m_writer);
+  else
+    Print (*m_os);
   Reset ();
 
   m_printEvent = Simulator::Schedule (m_period, &L3RateTracer::PeriodicPrinter, this);
@@ -249,16 +212,35 @@ L3RateTracer::PrintHeader (std::ostream &os) const
      << "KilobytesRaw";
 }
 
+void
+L3RateTracer::DeclareColumns (BinaryTraceWriter &writer)
+{
+  writer.AddColumn ("Time",         BinaryTraceWriter::DOUBLE);
+
+  writer.AddColumn ("Node",         BinaryTraceWriter::STRING);
+  writer.AddColumn ("FaceId",       BinaryTraceWriter::INT32);
+  writer.AddColumn ("FaceDescr",    BinaryTraceWriter::STRING);
+
+  writer.AddColumn ("Type",         BinaryTraceWriter::STRING);
+  writer.AddColumn ("Packets",      BinaryTraceWriter::DOUBLE);
+  writer.AddColumn ("Kilobytes",    BinaryTraceWriter::DOUBLE);
+  writer.AddColumn ("PacketRaw",    BinaryTraceWriter::DOUBLE);
+  writer.AddColumn ("KilobytesRaw", BinaryTraceWriter::DOUBLE);
+}
+
 void
 L3RateTracer::Reset ()
 {
-  for (std::map<Ptr<const Face>, boost::tuple<Stats, Stats, Stats, Stats> >::iterator stats = m_stats.begin ();
+  for (std::vector<FaceStats>::iterator stats = m_stats.begin ();
        stats != m_stats.end ();
        stats++)
     {
       stats->second.get<0> ().Reset ();
       stats->second.get<1> ().Reset ();
     }
+
+  m_nodeStats.second.get<0> ().Reset ();
+  m_nodeStats.second.get<1> ().Reset ();
 }
 
 const double alpha = 0.8;
@@ -266,9 +248,12 @@ const double alpha = 0.8;
 #define STATS(INDEX) stats->second.get<INDEX> ()
 #define RATE(INDEX, fieldName) STATS(INDEX).fieldName / m_period.ToDouble (Time::S)
 
-#define PRINTER(printName, fieldName) \
+#define UPDATE_RATE(fieldName) \
   STATS(2).fieldName = /*new value*/alpha * RATE(0, fieldName) + /*old value*/(1-alpha) * STATS(2).fieldName; \
-  STATS(3).fieldName = /*new value*/alpha * RATE(1, fieldName) / 1024.0 + /*old value*/(1-alpha) * STATS(3).fieldName; \
+  STATS(3).fieldName = /*new value*/alpha * RATE(1, fieldName) / 1024.0 + /*old value*/(1-alpha) * STATS(3).fieldName;
+
+#define PRINTER(type, fieldName)                                        \
+  UPDATE_RATE(fieldName)                                                \
                                                                         \
   os << time.ToDouble (Time::S) << "\t"                                 \
   << m_node << "\t";                                                    \
@@ -283,7 +268,7 @@ const double alpha = 0.8;
       os << "-1\tall\t";                                                \
     }                                                                   \
   os                                                                    \
-  << printName << "\t"                                                  \
+  << s_recordTypes[type] << "\t"                                        \
   << STATS(2).fieldName << "\t"                                         \
   << STATS(3).fieldName << "\t"                                         \
   << STATS(0).fieldName << "\t"                                         \
@@ -294,100 +279,195 @@ L3RateTracer::Print (std::ostream &os) const
 {
   Time time = Simulator::Now ();
 
-  for (std::map<Ptr<const Face>, boost::tuple<Stats, Stats, Stats, Stats> >::iterator stats = m_stats.begin ();
+  for (std::vector<FaceStats>::iterator stats = m_stats.begin ();
+       stats != m_stats.end ();
+       stats++)
+    {
+      if (!stats->first)
+        continue;
+
+      PRINTER (IN_INTERESTS,   m_inInterests);
+      PRINTER (OUT_INTERESTS,  m_outInterests);
+      PRINTER (DROP_INTERESTS, m_dropInterests);
+
+      PRINTER (IN_NACKS,   m_inNacks);
+      PRINTER (OUT_NACKS,  m_outNacks);
+      PRINTER (DROP_NACKS, m_dropNacks);
+
+      PRINTER (IN_DATA,   m_inData);
+      PRINTER (OUT_DATA,  m_outData);
+      PRINTER (DROP_DATA, m_dropData);
+
+      PRINTER (IN_SATISFIED_INTERESTS, m_satisfiedInterests);
+      PRINTER (IN_TIMED_OUT_INTERESTS, m_timedOutInterests);
+
+      PRINTER (OUT_SATISFIED_INTERESTS, m_outSatisfiedInterests);
+      PRINTER (OUT_TIMED_OUT_INTERESTS, m_outTimedOutInterests);
+    }
+
+  {
+    FaceStats *stats = &m_nodeStats;
+    if (m_hasNodeStats)
+      {
+        PRINTER (SATISFIED_INTERESTS, m_satisfiedInterests);
+        PRINTER (TIMED_OUT_INTERESTS, m_timedOutInterests);
+      }
+  }
+}
+
+
+#define WRITER(type, fieldName)                                         \
+  UPDATE_RATE(fieldName)                                                \
+  {                                                                     \
+    writer.BeginRecord ();                                              \
+    writer.PutDouble (time.ToDouble (Time::S));                         \
+    writer.PutString (m_nodeString);                                    \
+    writer.PutInt32 (faceId);                                           \
+    writer.PutString (faceString);                                      \
+    writer.PutString (m_typeStrings[type]);                             \
+    writer.PutDouble (STATS(2).fieldName);                              \
+    writer.PutDouble (STATS(3).fieldName);                              \
+    writer.PutDouble (STATS(0).fieldName);                              \
+    writer.PutDouble (STATS(1).fieldName / 1024.0);                     \
+  }
+
+void
+L3RateTracer::Write (BinaryTraceWriter &writer) const
+{
+  Time time = Simulator::Now ();
+
+  for (std::vector<FaceStats>::iterator stats = m_stats.begin ();
        stats != m_stats.end ();
        stats++)
     {
       if (!stats->first)
         continue;
 
-      PRINTER ("InInterests",   m_inInterests);
-      PRINTER ("OutInterests",  m_outInterests);
-      PRINTER ("DropInterests", m_dropInterests);
+      int32_t faceId = stats->first->GetId ();
+      uint32_t faceString = m_faceStrings[faceId];
+
+      WRITER (IN_INTERESTS,   m_inInterests);
+      WRITER (OUT_INTERESTS,  m_outInterests);
+      WRITER (DROP_INTERESTS, m_dropInterests);
 
-      PRINTER ("InNacks",   m_inNacks);
-      PRINTER ("OutNacks",  m_outNacks);
-      PRINTER ("DropNacks", m_dropNacks);
+      WRITER (IN_NACKS,   m_inNacks);
+      WRITER (OUT_NACKS,  m_outNacks);
+      WRITER (DROP_NACKS, m_dropNacks);
 
-      PRINTER ("InData",   m_inData);
-      PRINTER ("OutData",  m_outData);
-      PRINTER ("DropData", m_dropData);
+      WRITER (IN_DATA,   m_inData);
+      WRITER (OUT_DATA,  m_outData);
+      WRITER (DROP_DATA, m_dropData);
 
-      PRINTER ("InSatisfiedInterests", m_satisfiedInterests);
-      PRINTER ("InTimedOutInterests", m_timedOutInterests);
+      WRITER (IN_SATISFIED_INTERESTS, m_satisfiedInterests);
+      WRITER (IN_TIMED_OUT_INTERESTS, m_timedOutInterests);
 
-      PRINTER ("OutSatisfiedInterests", m_outSatisfiedInterests);
-      PRINTER ("OutTimedOutInterests", m_outTimedOutInterests);
+      WRITER (OUT_SATISFIED_INTERESTS, m_outSatisfiedInterests);
+      WRITER (OUT_TIMED_OUT_INTERESTS, m_outTimedOutInterests);
     }
 
   {
-    std::map<Ptr<const Face>, boost::tuple<Stats, Stats, Stats, Stats> >::iterator stats = m_stats.find (Ptr<const Face> (0));
-    if (stats != m_stats.end ())
+    FaceStats *stats = &m_nodeStats;
+    if (m_hasNodeStats)
       {
-        PRINTER ("SatisfiedInterests", m_satisfiedInterests);
-        PRINTER ("TimedOutInterests", m_timedOutInterests);
+        int32_t faceId = -1;
+        uint32_t faceString = m_allFacesString;
+        WRITER (SATISFIED_INTERESTS, m_satisfiedInterests);
+        WRITER (TIMED_OUT_INTERESTS, m_timedOutInterests);
       }
   }
 }
 
 
+boost::tuple<L3RateTracer::Stats, L3RateTracer::Stats, L3RateTracer::Stats, L3RateTracer::Stats> &
+L3RateTracer::GetStats (const Ptr<const Face> &face)
+{
+  uint32_t id = face->GetId ();
+  if (id >= m_stats.size ())
+    {
+      m_stats.resize (id + 1);
+    }
+
+  FaceStats &stats = m_stats[id];
+  if (stats.first == 0)
+    {
+      stats.first = face;
+
+      if (m_writer)
+        {
+          // description of the face is interned once, when the face is seen for the first time
+          std::ostringstream faceDescr;
+          faceDescr << *face;
+          m_faceStrings.resize (m_stats.size ());
+          m_faceStrings[id] = m_writer->Intern (faceDescr.str ());
+        }
+    }
+  return stats.second;
+}
+
+boost::tuple<L3RateTracer::Stats, L3RateTracer::Stats, L3RateTracer::Stats, L3RateTracer::Stats> &
+L3RateTracer::GetNodeStats ()
+{
+  m_hasNodeStats = true;
+  return m_nodeStats.second;
+}
+
 void
 L3RateTracer::OutInterests  (Ptr<const Interest> interest, Ptr<const Face> face)
 {
-  m_stats[face].get<0> ().m_outInterests ++;
+  GetStats (face).get<0> ().m_outInterests ++;
   if (interest->GetWire ())
     {
-      m_stats[face].get<1> ().m_outInterests += interest->GetWire ()->GetSize ();
+      GetStats (face).get<1> ().m_outInterests += interest->GetWire ()->GetSize ();
     }
 }
 
 void
 L3RateTracer::InInterests   (Ptr<const Interest> interest, Ptr<const Face> face)
 {
-  m_stats[face].get<0> ().m_inInterests ++;
+  GetStats (face).get<0> ().m_inInterests ++;
   if (interest->GetWire ())
     {
-      m_stats[face].get<1> ().m_inInterests += interest->GetWire ()->GetSize ();
+      GetStats (face).get<1> ().m_inInterests += interest->GetWire ()->GetSize ();
     }
 }
 
 void
 L3RateTracer::DropInterests (Ptr<const Interest> interest, Ptr<const Face> face)
 {
-  m_stats[face].get<0> ().m_dropInterests ++;
+  GetStats (face).get<0> ().m_dropInterests ++;
   if (interest->GetWire ())
     {
-      m_stats[face].get<1> ().m_dropInterests += interest->GetWire ()->GetSize ();
+      GetStats (face).get<1> ().m_dropInterests += interest->GetWire ()->GetSize ();
     }
 }
 
 void
 L3RateTracer::OutNacks  (Ptr<const Interest> interest, Ptr<const Face> face)
 {
-  m_stats[face].get<0> ().m_outNacks ++;
+  GetStats (face).get<0> ().m_outNacks ++;
   if (interest->GetWire ())
     {
-      m_stats[face].get<1> ().m_outNacks += interest->GetWire ()->GetSize ();
+      GetStats (face).get<1> ().m_outNacks += interest->GetWire ()->GetSize ();
     }
 }
 
 void
 L3RateTracer::InNacks   (Ptr<const Interest> interest, Ptr<const Face> face)
 {
-  m_stats[face].get<0> ().m_inNacks ++;
+  GetStats (face).get<0> ().m_inNacks ++;
   if (interest->GetWire ())
     {
-      m_stats[face].get<1> ().m_inNacks += interest->GetWire ()->GetSize ();
+      GetStats (face).get<1> ().m_inNacks += interest->GetWire ()->GetSize ();
     }
 }
 
 void
 L3RateTracer::DropNacks (Ptr<const Interest> interest, Ptr<const Face> face)
 {
-  m_stats[face].get<0> ().m_dropNacks ++;
+  GetStats (face).get<0> ().m_dropNacks ++;
   if (interest->GetWire ())
     {
-      m_stats[face].get<1> ().m_dropNacks += interest->GetWire ()->GetSize ();
+      GetStats (face).get<1> ().m_dropNacks += interest->GetWire ()->GetSize ();
     }
 }
 
@@ -395,10 +475,10 @@ void
 L3RateTracer::OutData  (Ptr<const Data> data,
                         bool fromCache, Ptr<const Face> face)
 {
-  m_stats[face].get<0> ().m_outData ++;
+  GetStats (face).get<0> ().m_outData ++;
   if (data->GetWire ())
     {
-      m_stats[face].get<1> ().m_outData += data->GetWire ()->GetSize ();
+      GetStats (face).get<1> ().m_outData += data->GetWire ()->GetSize ();
     }
 }
 
@@ -406,10 +486,10 @@ void
 L3RateTracer::InData   (Ptr<const Data> data,
                         Ptr<const Face> face)
 {
-  m_stats[face].get<0> ().m_inData ++;
+  GetStats (face).get<0> ().m_inData ++;
   if (data->GetWire ())
     {
-      m_stats[face].get<1> ().m_inData += data->GetWire ()->GetSize ();
+      GetStats (face).get<1> ().m_inData += data->GetWire ()->GetSize ();
     }
 }
 
@@ -417,52 +497,52 @@ void
 L3RateTracer::DropData (Ptr<const Data> data,
                         Ptr<const Face> face)
 {
-  m_stats[face].get<0> ().m_dropData ++;
+  GetStats (face).get<0> ().m_dropData ++;
   if (data->GetWire ())
     {
-      m_stats[face].get<1> ().m_dropData += data->GetWire ()->GetSize ();
+      GetStats (face).get<1> ().m_dropData += data->GetWire ()->GetSize ();
     }
 }
 
 void
 L3RateTracer::SatisfiedInterests (Ptr<const pit::Entry> entry)
 {
-  m_stats[0].get<0> ().m_satisfiedInterests ++;
+  GetNodeStats ().get<0> ().m_satisfiedInterests ++;
   // no "size" stats
 
   for (pit::Entry::in_container::const_iterator i = entry->GetIncoming ().begin ();
        i != entry->GetIncoming ().end ();
        i++)
     {
-      m_stats[i->m_face].get<0> ().m_satisfiedInterests ++;
+      GetStats (i->m_face).get<0> ().m_satisfiedInterests ++;
 }
 
   for (pit::Entry::out_container::const_iterator i = entry->GetOutgoing ().begin ();
        i != entry->GetOutgoing ().end ();
        i++)
     {
-      m_stats[i->m_face].get<0> ().m_outSatisfiedInterests ++;
+      GetStats (i->m_face).get<0> ().m_outSatisfiedInterests ++;
     }
 }
 
 void
 L3RateTracer::TimedOutInterests (Ptr<const pit::Entry> entry)
 {
-  m_stats[0].get<0> ().m_timedOutInterests ++;
+  GetNodeStats ().get<0> ().m_timedOutInterests ++;
   // no "size" stats
   
   for (pit::Entry::in_container::const_iterator i = entry->GetIncoming ().begin ();
        i != entry->GetIncoming ().end ();
        i++)
     {
-      m_stats[i->m_face].get<0> ().m_timedOutInterests ++;
+      GetStats (i->m_face).get<0> ().m_timedOutInterests ++;
 }
 
   for (pit::Entry::out_container::const_iterator i = entry->GetOutgoing ().begin ();
        i != entry->GetOutgoing ().end ();
        i++)
     {
-      m_stats[i->m_face].get<0> ().m_outTimedOutInterests ++;
+      GetStats (i->m_face).get<0> ().m_outTimedOutInterests ++;
     }
 }
 
@@ -27,9 +27,11 @@
 #include "ns3/event-id.h"
 #include <ns3/node-container.h>
 
+#include "binary-trace-writer.h"
+
 #include <boost/tuple/tuple.hpp>
 #include <boost/shared_ptr.hpp>
-#include <map>
+#include <vector>
 #include <list>
 
 namespace ns3 {
@@ -95,6 +97,13 @@ public:
    */
   L3RateTracer (boost::shared_ptr<std::ostream> os, const std::string &node);
 
+  /**
+   * @brief Trace constructor that attaches to the node using node pointer and writes binary trace
+   * @param writer    binary trace writer
+   * @param node      pointer to the node
+   */
+  L3RateTracer (boost::shared_ptr<BinaryTraceWriter> writer, Ptr<Node> node);
+
   /**
    * @brief Destructor
    */
@@ -112,6 +121,24 @@ public:
    */
   static Ptr<L3RateTracer>
   Install (Ptr<Node> node, boost::shared_ptr<std::ostream> outputStream, Time averagingPeriod = Seconds (0.5));
+
+  /**
+   * @brief Helper method to install tracers on a specific simulation node
+   *
+   * @param nodes Nodes on which to install tracer
+   * @param writer Binary trace writer (should be prepared with DeclareColumns)
+   * @param averagingPeriod How often data will be written into the trace file (default, every half second)
+   */
+  static Ptr<L3RateTracer>
+  Install (Ptr<Node> node, boost::shared_ptr<BinaryTraceWriter> writer, Time averagingPeriod = Seconds (0.5));
+
+  /**
+   * @brief Add columns of the trace to the schema of binary trace
+   *
+   * @param writer binary trace writer
+   */
+  static void
+  DeclareColumns (BinaryTraceWriter &writer);
   
   // from L3Tracer
   virtual void
@@ -120,6 +147,14 @@ public:
   virtual void
   Print (std::ostream &os) const;
 
+  /**
+   * @brief Write current trace data into binary trace
+   *
+   * @param writer binary trace writer
+   */
+  void
+  Write (BinaryTraceWriter &writer) const;
+
 protected:
   // from L3Tracer
   virtual void
@@ -167,10 +202,50 @@ private:
 
 private:
   boost::shared_ptr<std::ostream> m_os;
+  boost::shared_ptr<BinaryTraceWriter> m_writer;
+  uint32_t m_nodeString;
+  uint32_t m_allFacesString;
+
+  /**
+   * @brief Record types of the trace (Type column)
+   */
+  enum RecordType
+    {
+      IN_INTERESTS,
+      OUT_INTERESTS,
+      DROP_INTERESTS,
+      IN_NACKS,
+      OUT_NACKS,
+      DROP_NACKS,
+      IN_DATA,
+      OUT_DATA,
+      DROP_DATA,
+      IN_SATISFIED_INTERESTS,
+      IN_TIMED_OUT_INTERESTS,
+      OUT_SATISFIED_INTERESTS,
+      OUT_TIMED_OUT_INTERESTS,
+      SATISFIED_INTERESTS,
+      TIMED_OUT_INTERESTS,
+      RECORD_TYPES
+    };
+  uint32_t m_typeStrings[RECORD_TYPES]; ///< @brief IDs of the interned record types (binary output only)
+  std::vector<uint32_t> m_faceStrings;  ///< @brief IDs of the interned face descriptions, indexed by face ID
   Time m_period;
   EventId m_printEvent;
 
-  mutable std::map<Ptr<const Face>, boost::tuple<Stats, Stats, Stats, Stats> > m_stats;
+/// @cond include_hidden
+  typedef std::pair<Ptr<const Face>, boost::tuple<Stats, Stats, Stats, Stats> > FaceStats;
+/// @endcond
+
+  boost::tuple<Stats, Stats, Stats, Stats> &
+  GetStats (const Ptr<const Face> &face);
+
+  boost::tuple<Stats, Stats, Stats, Stats> &
+  GetNodeStats ();
+
+  mutable std::vector<FaceStats> m_stats; ///< @brief per-face stats, indexed by face ID (face is 0 for unused IDs)
+  mutable FaceStats m_nodeStats;          ///< @brief stats that are not related to a particular face
+  bool m_hasNodeStats;                    ///< @brief whether m_nodeStats has been updated at least once
 };
 
 } // namespace ndn
@@ -0,0 +1,42 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ndn-trace-output.h"
+
+#include "ns3/ndn-partition-helper.h"
+
+namespace ns3 {
+namespace ndn {
+
+bool
+TraceOutput::Open (const std::string &file, const NodeContainer &nodes)
+{
+  m_nodes = NodeContainer ();
+  if (!BinaryTraceWriter::OpenTrace (PartitionHelper::GetRankFileName (file), m_os, m_writer))
+    return false;
+
+  for (NodeContainer::Iterator node = nodes.Begin (); node != nodes.End (); node++)
+    {
+      if (PartitionHelper::IsLocal (*node)) // other nodes are traced by the processes that simulate them
+        m_nodes.Add (*node);
+    }
+  return true;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,60 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NDN_TRACE_OUTPUT_H
+#define NDN_TRACE_OUTPUT_H
+
+#include "binary-trace-writer.h"
+
+#include "ns3/node-container.h"
+
+#include <boost/shared_ptr.hpp>
+#include <ostream>
+#include <string>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Output shared by the tracers that are installed by one Install call
+ *
+ * The output is opened using BinaryTraceWriter::OpenTrace.  In the distributed simulation,
+ * every process writes its own file (see PartitionHelper::GetRankFileName) and traces only the
+ * nodes that it simulates (see PartitionHelper::IsLocal).
+ */
+struct TraceOutput
+{
+  /**
+   * @brief Open output file and select the nodes that should be traced by the current process
+   * @param file name of the file, as specified in the simulation scenario
+   * @param nodes nodes to trace
+   * @returns false if file cannot be opened
+   */
+  bool
+  Open (const std::string &file, const NodeContainer &nodes);
+
+  boost::shared_ptr<std::ostream> m_os;          ///< @brief Text output (empty pointer for binary traces)
+  boost::shared_ptr<BinaryTraceWriter> m_writer; ///< @brief Binary output (empty pointer for text traces)
+  NodeContainer m_nodes;                         ///< @brief Nodes to be traced by the current process
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_TRACE_OUTPUT_H
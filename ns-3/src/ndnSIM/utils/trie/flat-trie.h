@@ -0,0 +1,815 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef FLAT_TRIE_H_
+#define FLAT_TRIE_H_
+
+#include "trie.h"
+
+#include <boost/functional/hash.hpp>
+#include <boost/tuple/tuple.hpp>
+#include <boost/foreach.hpp>
+
+#include <vector>
+#include <algorithm>
+#include <new>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+template<typename FullKey,
+         typename PayloadTraits,
+         typename PolicyHook >
+class flat_trie;
+
+template<class Trie>
+class flat_trie_iterator;
+
+template<class Trie>
+class flat_trie_point_iterator;
+
+/**
+ * @brief Node arena and child index shared by all nodes of one flat_trie
+ *
+ * Nodes are placement-constructed inside large blocks that never move, so
+ * node pointers (trie iterators) stay valid and policy hooks can be used
+ * exactly as with the node-based trie.  Instead of a bucket array per node,
+ * all parent->child edges are kept in a single open-addressed (linear probing)
+ * table keyed by the pair (parent node, precomputed component hash).
+ */
+template<class Node>
+class flat_trie_storage
+{
+public:
+  typedef typename Node::Key Key;
+
+  flat_trie_storage (size_t capacityHint)
+    : edges_ (0)
+    , next_block_size_ (std::max<size_t> (capacityHint, 16))
+    , current_block_size_ (0)
+    , block_used_ (0)
+  {
+    size_t tableSize = 16;
+    while (tableSize < 2 * capacityHint)
+      tableSize <<= 1;
+    slots_.resize (tableSize);
+  }
+
+  ~flat_trie_storage ()
+  {
+    BOOST_FOREACH (void *block, blocks_)
+      {
+        ::operator delete (block);
+      }
+  }
+
+  /**
+   * @brief Create a new child node and register it in the parent->child index
+   */
+  Node *
+  create (Node *parent, const Key &key, size_t hash)
+  {
+    Node *node = new (allocate ()) Node (key, hash, parent, this);
+
+    if ((edges_ + 1) * 4 > slots_.size () * 3)
+      rehash (slots_.size () * 2);
+    insert_edge (node);
+    return node;
+  }
+
+  /**
+   * @brief Remove node (which must not have any children) from the index and return its memory to the arena
+   */
+  void
+  destroy (Node *node)
+  {
+    node->unlink ();
+    erase_edge (node);
+    node->~Node ();
+    free_.push_back (node);
+  }
+
+  /**
+   * @brief Find child of the parent with the specified key (and precomputed hash of the key)
+   */
+  inline Node *
+  find_child (const Node *parent, const Key &key, size_t hash) const
+  {
+    size_t edgeHash = edge_hash (parent, hash);
+    size_t mask = slots_.size () - 1;
+    for (size_t i = edgeHash & mask; slots_[i].node != 0; i = (i + 1) & mask)
+      {
+        const slot &item = slots_[i];
+        if (item.hash == edgeHash &&
+            item.node->parent_ == parent &&
+            item.node->key_ == key)
+          {
+            return item.node;
+          }
+      }
+    return 0;
+  }
+
+  /**
+   * @brief Number of parent->child edges (i.e., number of non-root nodes)
+   */
+  size_t
+  size () const { return edges_; }
+
+  /**
+   * @brief Current capacity of the edge index
+   */
+  size_t
+  bucket_count () const { return slots_.size (); }
+
+private:
+  struct slot
+  {
+    slot () : hash (0), node (0) {}
+
+    size_t hash;
+    Node *node;
+  };
+
+  static inline size_t
+  edge_hash (const Node *parent, size_t hash)
+  {
+    // 64-bit finalizer from MurmurHash3, applied to the mix of parent address and component hash
+    uint64_t h = static_cast<uint64_t> (reinterpret_cast<size_t> (parent)) ^ (hash * 0x9e3779b97f4a7c15ULL);
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return static_cast<size_t> (h);
+  }
+
+  void *
+  allocate ()
+  {
+    if (!free_.empty ())
+      {
+        Node *node = free_.back ();
+        free_.pop_back ();
+        return node;
+      }
+
+    if (blocks_.empty () || block_used_ == current_block_size_)
+      {
+        current_block_size_ = next_block_size_;
+        next_block_size_ = std::min<size_t> (next_block_size_ * 2, 4096);
+
+        blocks_.push_back (::operator new (sizeof (Node) * current_block_size_));
+        block_used_ = 0;
+      }
+
+    return static_cast<Node*> (blocks_.back ()) + block_used_++;
+  }
+
+  void
+  insert_edge (Node *node)
+  {
+    size_t edgeHash = edge_hash (node->parent_, node->hash_);
+    size_t mask = slots_.size () - 1;
+    size_t i = edgeHash & mask;
+    while (slots_[i].node != 0)
+      i = (i + 1) & mask;
+
+    slots_[i].hash = edgeHash;
+    slots_[i].node = node;
+    edges_ ++;
+  }
+
+  void
+  erase_edge (Node *node)
+  {
+    size_t mask = slots_.size () - 1;
+    size_t i = edge_hash (node->parent_, node->hash_) & mask;
+    while (slots_[i].node != node)
+      i = (i + 1) & mask;
+
+    // backward shift deletion, so no tombstones are necessary
+    size_t j = i;
+    while (true)
+      {
+        slots_[i] = slot ();
+        while (true)
+          {
+            j = (j + 1) & mask;
+            if (slots_[j].node == 0)
+              {
+                edges_ --;
+                return;
+              }
+
+            size_t ideal = slots_[j].hash & mask;
+            bool inRange = (i <= j) ? (i < ideal && ideal <= j) : (i < ideal || ideal <= j);
+            if (!inRange)
+              break;
+          }
+        slots_[i] = slots_[j];
+        i = j;
+      }
+  }
+
+  void
+  rehash (size_t newSize)
+  {
+    std::vector<slot> old (newSize);
+    old.swap (slots_);
+    edges_ = 0;
+
+    BOOST_FOREACH (const slot &item, old)
+      {
+        if (item.node != 0)
+          insert_edge (item.node);
+      }
+  }
+
+private:
+  std::vector<slot> slots_;
+  size_t edges_;
+
+  std::vector<void*> blocks_;
+  std::vector<Node*> free_;
+  size_t next_block_size_;
+  size_t current_block_size_;
+  size_t block_used_;
+};
+
+/**
+ * @brief Alternative trie implementation that keeps all nodes in contiguous arena storage
+ *
+ * The interface is the same as for ndnSIM::trie, so this class can be used as a drop-in
+ * backend for trie_with_policy (see flat_trie_traits).  Each node caches hash of its
+ * name component, and children are located by a single probe into the arena-wide
+ * open-addressed index, instead of a lookup in the per-node intrusive unordered_set.
+ */
+template<typename FullKey,
+         typename PayloadTraits,
+         typename PolicyHook >
+class flat_trie
+{
+public:
+  typedef typename FullKey::partial_type Key;
+
+  typedef flat_trie*       iterator;
+  typedef const flat_trie* const_iterator;
+
+  typedef flat_trie_iterator<flat_trie> recursive_iterator;
+  typedef flat_trie_iterator<const flat_trie> const_recursive_iterator;
+
+  typedef flat_trie_point_iterator<flat_trie> point_iterator;
+  typedef flat_trie_point_iterator<const flat_trie> const_point_iterator;
+
+  typedef PayloadTraits payload_traits;
+
+  typedef flat_trie_storage<flat_trie> storage;
+
+  /**
+   * @brief Create root of the trie
+   * @param key key of the root node (normally empty)
+   * @param bucketSize expected number of nodes (used to size initial arena and index)
+   * @param bucketIncrement ignored, present only for interface compatibility with ndnSIM::trie
+   */
+  inline
+  flat_trie (const Key &key, size_t bucketSize = 1, size_t bucketIncrement = 1)
+    : key_ (key)
+    , hash_ (hash_key (key))
+    , payload_ (PayloadTraits::empty_payload)
+    , parent_ (0)
+    , first_child_ (0)
+    , next_sibling_ (0)
+    , prev_sibling_ (0)
+    , children_ (0)
+    , storage_ (new storage (bucketSize))
+  {
+  }
+
+  inline
+  ~flat_trie ()
+  {
+    payload_ = PayloadTraits::empty_payload; // necessary for smart pointers...
+    if (parent_ == 0)
+      {
+        clear ();
+        delete storage_;
+      }
+  }
+
+  void
+  clear ()
+  {
+    while (first_child_ != 0)
+      {
+        first_child_->destroy_subtree ();
+      }
+  }
+
+  template<class Predicate>
+  void
+  clear_if (Predicate cond)
+  {
+    recursive_iterator trieNode (this);
+    recursive_iterator end (0);
+
+    while (trieNode != end)
+      {
+        if (cond (*trieNode))
+          {
+            trieNode = recursive_iterator (trieNode->erase ());
+          }
+        trieNode ++;
+      }
+  }
+
+  inline std::pair<iterator, bool>
+  insert (const FullKey &key,
+          typename PayloadTraits::insert_type payload)
+  {
+    flat_trie *trieNode = this;
+
+    BOOST_FOREACH (const Key &subkey, key)
+      {
+        size_t hash = hash_key (subkey);
+        flat_trie *child = storage_->find_child (trieNode, subkey, hash);
+        if (child == 0)
+          {
+            child = storage_->create (trieNode, subkey, hash);
+          }
+        trieNode = child;
+      }
+
+    if (trieNode->payload_ == PayloadTraits::empty_payload)
+      {
+        trieNode->payload_ = payload;
+        return std::make_pair (trieNode, true);
+      }
+    else
+      return std::make_pair (trieNode, false);
+  }
+
+  /**
+   * @brief Removes payload (if it exists) and if there are no children, prunes parents trie
+   */
+  inline iterator
+  erase ()
+  {
+    payload_ = PayloadTraits::empty_payload;
+    return prune ();
+  }
+
+  /**
+   * @brief Do exactly as erase, but without erasing the payload
+   */
+  inline iterator
+  prune ()
+  {
+    flat_trie *node = this;
+    while (node->payload_ == PayloadTraits::empty_payload &&
+           node->children_ == 0 &&
+           node->parent_ != 0)
+      {
+        flat_trie *parent = node->parent_;
+        node->storage_->destroy (node);
+        node = parent;
+      }
+    return node;
+  }
+
+  /**
+   * @brief Perform prune of the node, but without attempting to parent of the node
+   */
+  inline void
+  prune_node ()
+  {
+    if (payload_ == PayloadTraits::empty_payload &&
+        children_ == 0 &&
+        parent_ != 0)
+      {
+        storage_->destroy (this);
+      }
+  }
+
+  /**
+   * @brief Perform the longest prefix match
+   * @param key the key for which to perform the longest prefix match
+   *
+   * @return ->second is true if prefix in ->first is longer than key
+   */
+  inline boost::tuple<iterator, bool, iterator>
+  find (const FullKey &key)
+  {
+    flat_trie *trieNode = this;
+    iterator foundNode = (payload_ != PayloadTraits::empty_payload) ? this : 0;
+    bool reachLast = true;
+
+    BOOST_FOREACH (const Key &subkey, key)
+      {
+        flat_trie *child = storage_->find_child (trieNode, subkey, hash_key (subkey));
+        if (child == 0)
+          {
+            reachLast = false;
+            break;
+          }
+
+        trieNode = child;
+        if (trieNode->payload_ != PayloadTraits::empty_payload)
+          foundNode = trieNode;
+      }
+
+    return boost::make_tuple (foundNode, reachLast, trieNode);
+  }
+
+  /**
+   * @brief Perform the longest prefix match satisfying preficate
+   * @param key the key for which to perform the longest prefix match
+   *
+   * @return ->second is true if prefix in ->first is longer than key
+   */
+  template<class Predicate>
+  inline boost::tuple<iterator, bool, iterator>
+  find_if (const FullKey &key, Predicate pred)
+  {
+    flat_trie *trieNode = this;
+    iterator foundNode = (payload_ != PayloadTraits::empty_payload) ? this : 0;
+    bool reachLast = true;
+
+    BOOST_FOREACH (const Key &subkey, key)
+      {
+        flat_trie *child = storage_->find_child (trieNode, subkey, hash_key (subkey));
+        if (child == 0)
+          {
+            reachLast = false;
+            break;
+          }
+
+        trieNode = child;
+        if (trieNode->payload_ != PayloadTraits::empty_payload &&
+            pred (trieNode->payload_))
+          {
+            foundNode = trieNode;
+          }
+      }
+
+    return boost::make_tuple (foundNode, reachLast, trieNode);
+  }
+
+  /**
+   * @brief Find next payload of the sub-trie
+   * @returns end() or a valid iterator pointing to the trie leaf (order is not defined, enumeration )
+   */
+  inline iterator
+  find ()
+  {
+    if (payload_ != PayloadTraits::empty_payload)
+      return this;
+
+    for (flat_trie *subnode = first_child_; subnode != 0; subnode = subnode->next_sibling_)
+      {
+        iterator value = subnode->find ();
+        if (value != 0)
+          return value;
+      }
+
+    return 0;
+  }
+
+  /**
+   * @brief Find next payload of the sub-trie satisfying the predicate
+   * @param pred predicate
+   * @returns end() or a valid iterator pointing to the trie leaf (order is not defined, enumeration )
+   */
+  template<class Predicate>
+  inline const iterator
+  find_if (Predicate pred)
+  {
+    if (payload_ != PayloadTraits::empty_payload && pred (payload_))
+      return this;
+
+    for (flat_trie *subnode = first_child_; subnode != 0; subnode = subnode->next_sibling_)
+      {
+        iterator value = subnode->find_if (pred);
+        if (value != 0)
+          return value;
+      }
+
+    return 0;
+  }
+
+  /**
+   * @brief Find next payload of the sub-trie satisfying the predicate
+   * @param pred predicate
+   *
+   * This version check predicate only for the next level children
+   *
+   * @returns end() or a valid iterator pointing to the trie leaf (order is not defined, enumeration )
+   */
+  template<class Predicate>
+  inline const iterator
+  find_if_next_level (Predicate pred)
+  {
+    for (flat_trie *subnode = first_child_; subnode != 0; subnode = subnode->next_sibling_)
+      {
+        if (pred (subnode->key ()))
+          {
+            return subnode->find ();
+          }
+      }
+
+    return 0;
+  }
+
+  iterator end ()
+  {
+    return 0;
+  }
+
+  const_iterator end () const
+  {
+    return 0;
+  }
+
+  typename PayloadTraits::const_return_type
+  payload () const
+  {
+    return payload_;
+  }
+
+  typename PayloadTraits::return_type
+  payload ()
+  {
+    return payload_;
+  }
+
+  void
+  set_payload (typename PayloadTraits::insert_type payload)
+  {
+    payload_ = payload;
+  }
+
+  Key key () const
+  {
+    return key_;
+  }
+
+  inline void
+  PrintStat (std::ostream &os) const;
+
+public:
+  PolicyHook policy_hook_;
+
+private:
+  friend class flat_trie_storage<flat_trie>;
+
+  template<class Trie>
+  friend class flat_trie_iterator;
+
+  template<class Trie>
+  friend class flat_trie_point_iterator;
+
+  template<typename K, typename P, typename H>
+  friend std::ostream&
+  operator<< (std::ostream &os, const flat_trie<K, P, H> &trie_node);
+
+  /**
+   * @brief Create a non-root node (used only by flat_trie_storage)
+   */
+  flat_trie (const Key &key, size_t hash, flat_trie *parent, storage *storage)
+    : key_ (key)
+    , hash_ (hash)
+    , payload_ (PayloadTraits::empty_payload)
+    , parent_ (parent)
+    , first_child_ (0)
+    , next_sibling_ (parent->first_child_)
+    , prev_sibling_ (0)
+    , children_ (0)
+    , storage_ (storage)
+  {
+    if (next_sibling_ != 0)
+      next_sibling_->prev_sibling_ = this;
+    parent_->first_child_ = this;
+    parent_->children_ ++;
+  }
+
+  // non-copyable
+  flat_trie (const flat_trie &);
+  flat_trie & operator= (const flat_trie &);
+
+  static inline size_t
+  hash_key (const Key &key)
+  {
+    return boost::hash_range (key.begin (), key.end ());
+  }
+
+  /**
+   * @brief Unlink node from the list of parent's children (called by the storage before the node is destroyed)
+   */
+  inline void
+  unlink ()
+  {
+    if (prev_sibling_ != 0)
+      prev_sibling_->next_sibling_ = next_sibling_;
+    else
+      parent_->first_child_ = next_sibling_;
+
+    if (next_sibling_ != 0)
+      next_sibling_->prev_sibling_ = prev_sibling_;
+
+    parent_->children_ --;
+  }
+
+  void
+  destroy_subtree ()
+  {
+    while (first_child_ != 0)
+      {
+        first_child_->destroy_subtree ();
+      }
+    storage_->destroy (this);
+  }
+
+private:
+  ////////////////////////////////////////////////
+  // Actual data
+  ////////////////////////////////////////////////
+
+  Key key_; ///< name component
+  size_t hash_; ///< precomputed hash of the name component
+
+  typename PayloadTraits::storage_type payload_;
+
+  flat_trie *parent_;
+  flat_trie *first_child_;
+  flat_trie *next_sibling_;
+  flat_trie *prev_sibling_;
+  uint32_t children_;
+
+  storage *storage_;
+};
+
+/**
+ * @brief Traits to select flat_trie as a backend for trie_with_policy
+ */
+struct flat_trie_traits
+{
+  /// @brief Prefix that is used to form NS-3 TypeId of the containers using this backend
+  static std::string GetTypeIdPrefix () { return "Flat::"; }
+
+  /// @brief Prefix that is used to form log component name of the containers using this backend
+  static std::string GetLogPrefix () { return "Flat."; }
+
+  template<typename FullKey, typename PayloadTraits, typename PolicyHook>
+  struct trie
+  {
+    typedef flat_trie<FullKey, PayloadTraits, PolicyHook> type;
+  };
+};
+
+
+template<typename FullKey, typename PayloadTraits, typename PolicyHook>
+inline std::ostream&
+operator << (std::ostream &os, const flat_trie<FullKey, PayloadTraits, PolicyHook> &trie_node)
+{
+  os << "# " << trie_node.key_ << ((trie_node.payload_ != PayloadTraits::empty_payload)?"*":"") << std::endl;
+
+  for (const flat_trie<FullKey, PayloadTraits, PolicyHook> *subnode = trie_node.first_child_;
+       subnode != 0;
+       subnode = subnode->next_sibling_)
+    {
+      os << "\"" << &trie_node << "\"" << " [label=\"" << trie_node.key_ << ((trie_node.payload_ != PayloadTraits::empty_payload)?"*":"") << "\"]\n";
+      os << "\"" << subnode << "\"" << " [label=\"" << subnode->key_ << ((subnode->payload_ != PayloadTraits::empty_payload)?"*":"") << "\"]""\n";
+
+      os << "\"" << &trie_node << "\"" << " -> " << "\"" << subnode << "\"" << "\n";
+      os << *subnode;
+    }
+
+  return os;
+}
+
+template<typename FullKey, typename PayloadTraits, typename PolicyHook>
+inline void
+flat_trie<FullKey, PayloadTraits, PolicyHook>
+::PrintStat (std::ostream &os) const
+{
+  os << "# " << key_ << ((payload_ != PayloadTraits::empty_payload)?"*":"") << ": " << children_ << " children";
+  if (parent_ == 0)
+    {
+      os << " (" << storage_->size () << " nodes, " << storage_->bucket_count () << " index slots)";
+    }
+  os << "\n";
+
+  for (const flat_trie *subnode = first_child_; subnode != 0; subnode = subnode->next_sibling_)
+    {
+      subnode->PrintStat (os);
+    }
+}
+
+
+template<class Trie>
+class flat_trie_iterator
+{
+public:
+  flat_trie_iterator () : trie_ (0) {}
+  flat_trie_iterator (Trie *item) : trie_ (item) {}
+  flat_trie_iterator (Trie &item) : trie_ (&item) {}
+
+  Trie & operator* () { return *trie_; }
+  const Trie & operator* () const { return *trie_; }
+  Trie * operator-> () { return trie_; }
+  const Trie * operator-> () const { return trie_; }
+  bool operator== (const flat_trie_iterator<Trie> &other) const { return (trie_ == other.trie_); }
+  bool operator!= (const flat_trie_iterator<Trie> &other) const { return !(*this == other); }
+
+  flat_trie_iterator<Trie> &
+  operator++ (int)
+  {
+    if (trie_->first_child_ != 0)
+      trie_ = trie_->first_child_;
+    else
+      trie_ = goUp ();
+    return *this;
+  }
+
+  flat_trie_iterator<Trie> &
+  operator++ ()
+  {
+    (*this)++;
+    return *this;
+  }
+
+private:
+  Trie* goUp ()
+  {
+    Trie *node = trie_;
+    while (node->parent_ != 0)
+      {
+        if (node->next_sibling_ != 0)
+          return node->next_sibling_;
+        node = node->parent_;
+      }
+    return 0;
+  }
+
+private:
+  Trie *trie_;
+};
+
+
+template<class Trie>
+class flat_trie_point_iterator
+{
+public:
+  flat_trie_point_iterator () : trie_ (0) {}
+  flat_trie_point_iterator (Trie *item) : trie_ (item) {}
+  flat_trie_point_iterator (Trie &item) : trie_ (item.first_child_) {}
+
+  Trie & operator* () { return *trie_; }
+  const Trie & operator* () const { return *trie_; }
+  Trie * operator-> () { return trie_; }
+  const Trie * operator-> () const { return trie_; }
+  bool operator== (const flat_trie_point_iterator<Trie> &other) const { return (trie_ == other.trie_); }
+  bool operator!= (const flat_trie_point_iterator<Trie> &other) const { return !(*this == other); }
+
+  flat_trie_point_iterator<Trie> &
+  operator++ (int)
+  {
+    if (trie_->parent_ != 0)
+      trie_ = trie_->next_sibling_;
+    else
+      trie_ = 0;
+    return *this;
+  }
+
+  flat_trie_point_iterator<Trie> &
+  operator++ ()
+  {
+    (*this)++;
+    return *this;
+  }
+
+private:
+  Trie *trie_;
+};
+
+} // ndnSIM
+} // ndn
+} // ns3
+
+#endif // FLAT_TRIE_H_
@@ -27,22 +27,30 @@ namespace ns3 {
 namespace ndn {
 namespace ndnSIM {
 
+/**
+ * @brief Trie with a replacement/accounting policy attached to it
+ *
+ * TrieTraits selects the underlying trie implementation: node_trie_traits (default) uses
+ * ndnSIM::trie with per-node hash tables, flat_trie_traits uses ndnSIM::flat_trie with
+ * arena-allocated nodes and a single open-addressed child index (see flat-trie.h)
+ */
 template<typename FullKey,
          typename PayloadTraits,
-         typename PolicyTraits
+         typename PolicyTraits,
+         typename TrieTraits = node_trie_traits
          >
 class trie_with_policy
 {
 public:
-  typedef trie< FullKey,
-                PayloadTraits,
-                typename PolicyTraits::policy_hook_type > parent_trie;
+  typedef typename TrieTraits::template trie< FullKey,
+                                              PayloadTraits,
+                                              typename PolicyTraits::policy_hook_type >::type parent_trie;
 
   typedef typename parent_trie::iterator iterator;
   typedef typename parent_trie::const_iterator const_iterator;
 
   typedef typename PolicyTraits::template policy<
-    trie_with_policy<FullKey, PayloadTraits, PolicyTraits>,
+    trie_with_policy<FullKey, PayloadTraits, PolicyTraits, TrieTraits>,
     parent_trie,
     typename PolicyTraits::template container_hook<parent_trie>::type >::type policy_container;
 
@@ -543,6 +543,25 @@ private:
 
 
 
+/**
+ * @brief Traits to select the default node-based trie as a backend for trie_with_policy
+ */
+struct node_trie_traits
+{
+  /// @brief Prefix that is used to form NS-3 TypeId of the containers using this backend
+  static std::string GetTypeIdPrefix () { return ""; }
+
+  /// @brief Prefix that is used to form log component name of the containers using this backend
+  static std::string GetLogPrefix () { return ""; }
+
+  template<typename FullKey, typename PayloadTraits, typename PolicyHook>
+  struct trie
+  {
+    typedef ndnSIM::trie<FullKey, PayloadTraits, PolicyHook> type;
+  };
+};
+
+
 template<typename FullKey, typename PayloadTraits, typename PolicyHook>
 inline std::ostream&
 operator << (std::ostream &os, const trie<FullKey, PayloadTraits, PolicyHook> &trie_node)